@@ -0,0 +1,62 @@
+#include "Utils/AsyncLog.hpp"
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+#include <string>
+
+//------------------------------------------------------------------
+// What a log line costs the thread that writes it. The backend sink
+// discards, and bursts are drained between iterations so the ring
+// never fills: the numbers are the copy, not the drop path.
+//------------------------------------------------------------------
+namespace {
+void quiet_backend() {
+    static const bool configured = [] {
+        AsyncLog::Config cfg;
+        cfg.ring_bytes = 1 << 20;
+        cfg.sink = [](LogLevel, std::string_view line) { benchmark::DoNotOptimize(line.data()); };
+        AsyncLog::configure(std::move(cfg));
+        return true;
+    }();
+    benchmark::DoNotOptimize(configured);
+}
+} // namespace
+
+static void BM_AsyncLog_Burst(benchmark::State& state) {
+    constexpr int kBurst = 1024;
+    quiet_backend();
+    const std::string reason = "stream truncated";
+    for (auto _ : state) {
+        for (int i = 0; i < kBurst; ++i) {
+            OCEAN_LOG_RATE(LogLevel::Info, 0, "[READ ERROR] {} after {} bytes at {:.2f}", reason, i, 101.5);
+        }
+        state.PauseTiming();
+        AsyncLog::flush();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kBurst);
+}
+BENCHMARK(BM_AsyncLog_Burst);
+
+// A parse-error storm past the site's limit: counted, not copied
+static void BM_AsyncLog_Suppressed(benchmark::State& state) {
+    quiet_backend();
+    std::size_t bytes = 0;
+    for (auto _ : state) OCEAN_LOG_RATE(LogLevel::Error, 1, "[PARSE ERROR] Malformed frame ({} bytes)", ++bytes);
+}
+BENCHMARK(BM_AsyncLog_Suppressed);
+
+static void BM_AsyncLog_BelowLevel(benchmark::State& state) {
+    quiet_backend();
+    for (auto _ : state) OCEAN_LOG_DEBUG("[DEBUG] {}", state.iterations());
+}
+BENCHMARK(BM_AsyncLog_BelowLevel);
+
+// The locked, synchronous stream write it replaces
+static void BM_Ostream_Write(benchmark::State& state) {
+    std::ofstream out("/dev/null");
+    const std::string reason = "stream truncated";
+    int i = 0;
+    for (auto _ : state) out << "[READ ERROR] " << reason << " after " << ++i << " bytes at " << 101.5 << '\n';
+}
+BENCHMARK(BM_Ostream_Write);
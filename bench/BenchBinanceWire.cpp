@@ -0,0 +1,67 @@
+#include "Clients/BinanceWire.hpp"
+#include "Sim/DepthGenerator.hpp"
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------
+// Binance JSON on the read path: partial depth at 5/10/20 levels and
+// aggTrade. Frames come from the simulator's encoder, so they carry
+// the same 8-decimal strings the venue sends.
+//------------------------------------------------------------------
+namespace {
+constexpr std::size_t kFrames = 64;
+
+std::vector<std::string> depth_frames(int levels) {
+    DepthGenerator::Config cfg;
+    cfg.levels = levels;
+    DepthGenerator gen(cfg);
+
+    std::vector<std::string> frames(kFrames);
+    for (std::size_t i = 0; i < kFrames; ++i) {
+        gen.next();
+        gen.encode_json(frames[i], 1'700'000'000'000 + i);
+    }
+    return frames;
+}
+
+constexpr std::string_view kAggTrade =
+    R"({"e":"aggTrade","E":1700000000123,"s":"BTCUSDT","a":26129,"p":"67012.34000000",)"
+    R"("q":"0.01200000","f":100,"l":105,"T":1700000000120,"m":true,"M":true})";
+} // namespace
+
+static void BM_BinanceWire_ParseDepth(benchmark::State& state) {
+    const auto frames = depth_frames(static_cast<int>(state.range(0)));
+    std::vector<OrderBook::Order> levels;
+    levels.reserve(64);
+
+    std::size_t i = 0;
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        const std::string& frame = frames[i++ % kFrames];
+        benchmark::DoNotOptimize(BinanceWire::parse_depth(frame, levels));
+        bytes += static_cast<int64_t>(frame.size());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_BinanceWire_ParseDepth)->Arg(5)->Arg(10)->Arg(20);
+
+static void BM_BinanceWire_ParseAggTrade(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BinanceWire::parse_agg_trade(kAggTrade));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BinanceWire_ParseAggTrade);
+
+// What the redundant-feed arbiter pays per frame before any parse
+static void BM_BinanceWire_SequenceId(benchmark::State& state) {
+    const auto frames = depth_frames(20);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BinanceWire::sequence_id(frames[i++ % kFrames]));
+    }
+}
+BENCHMARK(BM_BinanceWire_SequenceId);
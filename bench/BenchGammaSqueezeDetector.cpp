@@ -0,0 +1,46 @@
+#include "Strategy/GammaSqueezeDetector.hpp"
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+struct FeedEvent {
+    uint32_t symbol;
+    bool is_trade;
+    float a;
+    float b;
+};
+
+std::vector<FeedEvent> make_feed(size_t n, uint32_t symbols) {
+    std::mt19937 gen(1);
+    std::uniform_int_distribution<uint32_t> symbol(0, symbols - 1);
+    std::normal_distribution<float> depth(100.0f, 10.0f);
+    std::uniform_real_distribution<float> amount(0.01f, 3.0f);
+    std::vector<FeedEvent> feed(n);
+    for (size_t i = 0; i < n; ++i) {
+        feed[i] = i % 3 == 2
+            ? FeedEvent{symbol(gen), true, amount(gen), static_cast<float>(i & 1)}
+            : FeedEvent{symbol(gen), false, depth(gen), depth(gen)};
+    }
+    return feed;
+}
+} // namespace
+
+// Events/s for one detector per symbol, checking the signal on every event
+static void BM_GammaSqueeze_Stream(benchmark::State& state) {
+    const auto symbols = static_cast<uint32_t>(state.range(0));
+    const auto feed = make_feed(1 << 16, symbols);
+    std::vector<GammaSqueezeDetector> detectors(symbols);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const FeedEvent& e = feed[i++ & (feed.size() - 1)];
+        GammaSqueezeDetector& d = detectors[e.symbol];
+        if (e.is_trade) d.on_trade(e.a, e.b != 0.0f);
+        else d.on_book(e.a, e.b);
+        benchmark::DoNotOptimize(d.signal());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GammaSqueeze_Stream)->Arg(1)->Arg(100)->Arg(1000);
@@ -0,0 +1,62 @@
+#include "Utils/HugePageArena.hpp"
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+
+//------------------------------------------------------------------
+// Order-book-shaped churn: a few thousand price levels, one inserted
+// and one erased per step, nodes scattered the way a live book leaves
+// them. Default heap against the pooled huge-page arena.
+//------------------------------------------------------------------
+namespace {
+constexpr int kLevels = 4096;
+
+template <typename Map>
+void churn(benchmark::State& state, Map& levels) {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> price(0, 4 * kLevels);
+    for (int i = 0; i < kLevels; ++i) levels[static_cast<float>(price(rng))] = 1.0f;
+
+    for (auto _ : state) {
+        levels[static_cast<float>(price(rng))] += 1.0f;
+        if (const auto it = levels.lower_bound(static_cast<float>(price(rng))); it != levels.end()) levels.erase(it);
+        benchmark::DoNotOptimize(levels.begin()->second);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+static void BM_Arena_MapChurn_Heap(benchmark::State& state) {
+    std::map<float, float> levels;
+    churn(state, levels);
+}
+BENCHMARK(BM_Arena_MapChurn_Heap);
+
+static void BM_Arena_MapChurn_HugePages(benchmark::State& state) {
+    HugePageArena arena(HugePageArena::Config{.name = "bench"});
+    std::pmr::map<float, float> levels(&arena);
+    churn(state, levels);
+    state.counters["held_kb"] = static_cast<double>(arena.stats().bytes_held) / 1024.0;
+    state.counters["peak_kb"] = static_cast<double>(arena.stats().high_water) / 1024.0;
+}
+BENCHMARK(BM_Arena_MapChurn_HugePages);
+
+static void BM_Arena_AllocateFree(benchmark::State& state) {
+    HugePageArena arena(HugePageArena::Config{.name = "bench"});
+    for (auto _ : state) {
+        void* p = arena.allocate(48, alignof(std::max_align_t));
+        benchmark::DoNotOptimize(p);
+        arena.deallocate(p, 48, alignof(std::max_align_t));
+    }
+}
+BENCHMARK(BM_Arena_AllocateFree);
+
+static void BM_Arena_AllocateFree_Heap(benchmark::State& state) {
+    for (auto _ : state) {
+        void* p = ::operator new(48);
+        benchmark::DoNotOptimize(p);
+        ::operator delete(p);
+    }
+}
+BENCHMARK(BM_Arena_AllocateFree_Heap);
@@ -0,0 +1,64 @@
+#include "Core/MarketData.hpp"
+#include "Sim/DepthGenerator.hpp"
+#include "Sim/ExchangeSimulator.hpp"
+#include <benchmark/benchmark.h>
+
+#include <vector>
+#include <zlib.h>
+
+//------------------------------------------------------------------
+// MarketData binary frames. CRC is the check every frame pays;
+// decode is the whole receive path (recv, framing, CRC, publish)
+// fed over loopback by the exchange simulator running flat out.
+//------------------------------------------------------------------
+namespace {
+std::vector<std::byte> make_frame(int levels) {
+    DepthGenerator::Config cfg;
+    cfg.levels = levels;
+    DepthGenerator gen(cfg);
+    std::vector<std::byte> frame;
+    gen.encode_binary(frame, 0);
+    return frame;
+}
+} // namespace
+
+static void BM_MarketData_Crc(benchmark::State& state) {
+    const auto frame = make_frame(static_cast<int>(state.range(0)));
+    const auto* data = reinterpret_cast<const Bytef*>(frame.data() + MarketData::kCrcOffset);
+    const auto size = static_cast<uInt>(frame.size() - MarketData::kCrcOffset);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(crc32(0L, data, size));
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_MarketData_Crc)->Arg(5)->Arg(20)->Arg(100);
+
+// Iteration = one book frame published by MarketData
+static void BM_MarketData_Decode(benchmark::State& state) {
+    ExchangeSimulator::Config cfg;
+    cfg.binary_port = 0;
+    cfg.serve_websocket = false;
+    cfg.rate = 1e9;   // Unpaced: the simulator writes as fast as the socket drains
+    cfg.depth.levels = static_cast<int>(state.range(0));
+    ExchangeSimulator sim(cfg);
+    sim.start();
+
+    MarketData market("127.0.0.1", sim.binary_port());
+    const std::size_t book_size = 2 * static_cast<std::size_t>(cfg.depth.levels);
+    std::size_t pending = 0;   // Levels received but not yet counted as frames
+
+    for (auto _ : state) {
+        while (pending < book_size) {
+            market.poll(100);
+            pending += market.get_updates().size();
+        }
+        pending -= book_size;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(make_frame(cfg.depth.levels).size()));
+
+    market.stop();
+    sim.stop();
+}
+BENCHMARK(BM_MarketData_Decode)->Arg(5)->Arg(20)->UseRealTime();
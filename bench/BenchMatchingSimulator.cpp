@@ -0,0 +1,89 @@
+#include "Execution/OrderGateway.hpp"
+#include "Sim/MatchingSimulator.hpp"
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------
+// Backtest replay speed on one core. The stream is a random walk with
+// depth updates around the touch and a trade every few events; the
+// quoting runs keep orders resting through an OrderGateway and requote
+// whenever one fills, so the queue model is exercised on every print.
+//------------------------------------------------------------------
+namespace {
+using Event = MatchingSimulator::MarketEvent;
+using Kind = MatchingSimulator::EventKind;
+
+constexpr std::size_t kEvents = 1 << 20;
+constexpr double kTick = 0.01;
+
+const std::vector<Event>& stream() {
+    static const std::vector<Event> events = [] {
+        std::mt19937_64 gen(42);
+        std::uniform_int_distribution<int> level(0, 9);
+        std::uniform_int_distribution<int> move(-1, 1);
+        std::lognormal_distribution<float> size(-0.5f, 1.0f);
+        std::bernoulli_distribution coin(0.5);
+
+        std::vector<Event> out;
+        out.reserve(kEvents);
+        int64_t mid_ticks = 6'700'000;   // 67000.00
+        uint64_t ts = 0;
+        while (out.size() < kEvents) {
+            ts += 1000;
+            if (out.size() % 64 == 0) mid_ticks += move(gen);
+            if (out.size() % 4 == 3) {
+                const bool buyer = coin(gen);
+                const int64_t at = buyer ? mid_ticks + 1 : mid_ticks - 1;
+                out.push_back({ts, static_cast<double>(at) * kTick, size(gen), Kind::Trade, buyer});
+                continue;
+            }
+            const bool bid = coin(gen);
+            const int64_t at = bid ? mid_ticks - 1 - level(gen) : mid_ticks + 1 + level(gen);
+            out.push_back({ts, static_cast<double>(at) * kTick, size(gen) * 4.0f, Kind::Depth, bid});
+        }
+        return out;
+    }();
+    return events;
+}
+} // namespace
+
+// Book only: the floor every backtest pays
+static void BM_MatchingSimulator_Replay(benchmark::State& state) {
+    const auto& events = stream();
+    for (auto _ : state) {
+        MatchingSimulator sim;
+        for (const auto& ev : events) benchmark::DoNotOptimize(sim.on_market(ev));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+}
+BENCHMARK(BM_MatchingSimulator_Replay)->Unit(benchmark::kMillisecond);
+
+// Passive quotes at the touch, `range(0)` per side, requoted on fill
+static void BM_MatchingSimulator_QuotingBacktest(benchmark::State& state) {
+    const auto& events = stream();
+    const auto per_side = static_cast<std::size_t>(state.range(0));
+    uint64_t fills = 0;
+    for (auto _ : state) {
+        MatchingSimulator sim({.md_latency_ns = 500, .order_latency_ns = 2000, .report_latency_ns = 500});
+        OrderGateway<MatchingSimulator> gateway(sim, 4 * per_side + 16);
+        std::vector<ClientOrderId> bids(per_side, kNoOrder), asks(per_side, kNoOrder);
+
+        for (const auto& ev : events) {
+            const uint64_t seen = sim.on_market(ev);
+            sim.poll(gateway);
+            if (sim.best_bid() <= 0.0 || sim.best_ask() <= 0.0) continue;
+            for (std::size_t i = 0; i < per_side; ++i) {
+                if (!gateway.find(bids[i])) bids[i] = gateway.submit(0, true, 0.01, sim.best_bid(), seen).id;
+                if (!gateway.find(asks[i])) asks[i] = gateway.submit(0, false, 0.01, sim.best_ask(), seen).id;
+            }
+        }
+        sim.drain();
+        sim.poll(gateway);
+        fills = gateway.stats().fills;
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(events.size()));
+    state.counters["fills"] = static_cast<double>(fills);
+}
+BENCHMARK(BM_MatchingSimulator_QuotingBacktest)->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond);
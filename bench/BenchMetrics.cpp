@@ -0,0 +1,44 @@
+#include "Utils/Metrics.hpp"
+#include <benchmark/benchmark.h>
+
+//------------------------------------------------------------------
+// Cost of instrumenting a hot path. Per-slot counters against one
+// shared atomic, which every writer thread would otherwise bounce
+// between cores.
+//------------------------------------------------------------------
+namespace {
+Metrics::Registry& registry() {
+    static Metrics::Registry instance(Metrics::Registry::Config{});
+    return instance;
+}
+
+std::atomic<uint64_t> shared_counter{0};
+} // namespace
+
+static void BM_Metrics_CounterAdd(benchmark::State& state) {
+    static const Metrics::Counter counter = registry().counter("bench_counter_total");
+    for (auto _ : state) counter.add();
+}
+BENCHMARK(BM_Metrics_CounterAdd)->Threads(1)->Threads(4);
+
+static void BM_Metrics_SharedAtomic(benchmark::State& state) {
+    for (auto _ : state) shared_counter.fetch_add(1, std::memory_order_relaxed);
+}
+BENCHMARK(BM_Metrics_SharedAtomic)->Threads(1)->Threads(4);
+
+static void BM_Metrics_HistogramObserve(benchmark::State& state) {
+    static const Metrics::Histogram histogram = registry().histogram("bench_latency_ns");
+    uint64_t v = 0;
+    for (auto _ : state) histogram.observe(++v & 0xfff);
+}
+BENCHMARK(BM_Metrics_HistogramObserve);
+
+static void BM_Metrics_Snapshot(benchmark::State& state) {
+    Metrics::Registry::Config cfg;
+    cfg.path = "/tmp/ocean-metrics-bench";
+    Metrics::Registry file(cfg);
+    for (int i = 0; i < 100; ++i) file.counter("bench_series_" + std::to_string(i) + "_total").add();
+    const Metrics::Reader reader(cfg.path);
+    for (auto _ : state) benchmark::DoNotOptimize(reader.snapshot());
+}
+BENCHMARK(BM_Metrics_Snapshot);
@@ -0,0 +1,73 @@
+#include "Core/OrderBook.hpp"
+#include "Sim/DepthGenerator.hpp"
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------
+// OrderBook at realistic depths: 5/20 are Binance partial depth,
+// 100/1000 a diff-depth book that has been running for a while.
+// Updates cycle through pre-generated frames so the walk moves levels.
+//------------------------------------------------------------------
+namespace {
+constexpr std::size_t kFrames = 256;
+
+std::vector<std::vector<OrderBook::Order>> make_frames(int levels) {
+    DepthGenerator::Config cfg;
+    cfg.levels = levels;
+    DepthGenerator gen(cfg);
+
+    std::vector<std::vector<OrderBook::Order>> frames(kFrames);
+    for (auto& frame : frames) {
+        gen.next();
+        frame.assign(gen.levels().begin(), gen.levels().end());
+    }
+    return frames;
+}
+
+std::unique_ptr<OrderBook> filled_book(int levels) {
+    auto book = std::make_unique<OrderBook>();
+    for (const auto& frame : make_frames(levels)) book->update(frame);
+    return book;
+}
+} // namespace
+
+// One whole frame applied; items are price levels
+static void BM_OrderBook_Update(benchmark::State& state) {
+    const auto frames = make_frames(static_cast<int>(state.range(0)));
+    OrderBook book;
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        book.update(frames[i++ % kFrames]);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(frames[0].size()));
+}
+BENCHMARK(BM_OrderBook_Update)->Arg(5)->Arg(20)->Arg(100)->Arg(1000);
+
+static void BM_OrderBook_GetBbo(benchmark::State& state) {
+    const auto book = filled_book(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->get_bbo());
+    }
+}
+BENCHMARK(BM_OrderBook_GetBbo)->Arg(20)->Arg(1000);
+
+// Both sides, as the strategy reads them
+static void BM_OrderBook_TotalVolume(benchmark::State& state) {
+    const auto book = filled_book(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->total_bid_volume());
+        benchmark::DoNotOptimize(book->total_ask_volume());
+    }
+}
+BENCHMARK(BM_OrderBook_TotalVolume)->Arg(20)->Arg(1000);
+
+static void BM_OrderBook_Snapshot(benchmark::State& state) {
+    const auto book = filled_book(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(book->snapshot(0.001f));
+    }
+}
+BENCHMARK(BM_OrderBook_Snapshot)->Arg(20)->Arg(1000);
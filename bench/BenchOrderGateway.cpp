@@ -0,0 +1,85 @@
+#include "Execution/MockVenue.hpp"
+#include "Execution/OrderGateway.hpp"
+#include <benchmark/benchmark.h>
+
+//------------------------------------------------------------------
+// Order path from decision to wire and back. The mock venue answers
+// in-process, so these are the gateway's own costs: pool, state
+// machine, risk reservation, encoding and PnL booking.
+//------------------------------------------------------------------
+namespace {
+constexpr std::size_t kCapacity = 4096;
+
+uint64_t steady_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Desk {
+    MockVenue venue;
+    OrderGateway<MockVenue> gateway{venue, kCapacity};
+    RiskEngine risk{1, 1};
+    PnlEngine pnl{1, 1e9};
+
+    explicit Desk(MockVenue::Config cfg) : venue(cfg) {
+        risk.startDay(0, 1e9);
+        risk.setSymbolLimits(0, 0, {.maxOrderNotional = 1e12, .maxPosition = 1e12});
+        pnl.attachRisk(risk, 0);
+        gateway.attach_risk(risk, 0);
+        gateway.attach_pnl(pnl);
+    }
+
+    void report_tick_to_wire(benchmark::State& state) const {
+        const auto& s = gateway.stats();
+        if (s.tick_to_wire_count == 0) return;
+        state.counters["tick_to_wire_avg_ns"] =
+            static_cast<double>(s.tick_to_wire_total_ns) / static_cast<double>(s.tick_to_wire_count);
+        state.counters["tick_to_wire_max_ns"] = static_cast<double>(s.tick_to_wire_max_ns);
+    }
+};
+} // namespace
+
+// Submit, ack and fill: one complete order lifecycle per iteration
+static void BM_OrderGateway_SubmitFill(benchmark::State& state) {
+    Desk desk({.fill = true, .fill_slices = static_cast<uint32_t>(state.range(0))});
+    bool buy = true;
+    for (auto _ : state) {
+        const auto sent = desk.gateway.submit(0, buy, 0.01, 67000.0, steady_ns());
+        benchmark::DoNotOptimize(sent);
+        desk.venue.poll(desk.gateway);
+        buy = !buy;   // Keep the position flat
+    }
+    state.SetItemsProcessed(state.iterations());
+    desk.report_tick_to_wire(state);
+}
+BENCHMARK(BM_OrderGateway_SubmitFill)->Arg(1)->Arg(4);
+
+// Submit, ack, cancel, cancel ack
+static void BM_OrderGateway_SubmitCancel(benchmark::State& state) {
+    Desk desk({.fill = false});
+    for (auto _ : state) {
+        const auto sent = desk.gateway.submit(0, true, 0.01, 67000.0, steady_ns());
+        desk.venue.poll(desk.gateway);
+        benchmark::DoNotOptimize(desk.gateway.cancel(sent.id));
+        desk.venue.poll(desk.gateway);
+    }
+    state.SetItemsProcessed(state.iterations());
+    desk.report_tick_to_wire(state);
+}
+BENCHMARK(BM_OrderGateway_SubmitCancel);
+
+// Lookup against a full pool: stays O(1) whatever the open order count
+static void BM_OrderGateway_Find(benchmark::State& state) {
+    Desk desk({.fill = false});
+    std::vector<ClientOrderId> ids;
+    for (int64_t i = 0; i < state.range(0); ++i) ids.push_back(desk.gateway.submit(0, true, 0.01, 67000.0, 0).id);
+    desk.venue.poll(desk.gateway);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(desk.gateway.find(ids[i]));
+        if (++i == ids.size()) i = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OrderGateway_Find)->Arg(16)->Arg(static_cast<int64_t>(kCapacity));
@@ -0,0 +1,63 @@
+#include "Risk/PnlEngine.hpp"
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------
+// Mark-to-market per tick with every symbol holding a position. Cost
+// should not move with the portfolio size; the risk-attached variant
+// adds the equity push a live account pays.
+//------------------------------------------------------------------
+namespace {
+struct Tick {
+    uint32_t symbol;
+    double bid;
+    double ask;
+};
+
+std::vector<Tick> make_ticks(uint32_t symbols) {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<uint32_t> symbol(0, symbols - 1);
+    std::normal_distribution<double> move(0.0, 0.05);
+    std::vector<Tick> ticks(1 << 14);
+    for (auto& t : ticks) {
+        t.symbol = symbol(gen);
+        t.bid = 100.0 + move(gen);
+        t.ask = t.bid + 0.01;
+    }
+    return ticks;
+}
+
+void open_all(PnlEngine& pnl, uint32_t symbols) {
+    for (uint32_t s = 0; s < symbols; ++s) pnl.onFill(s, s % 2 == 0, 1.0 + s % 5, 100.0);
+}
+} // namespace
+
+static void BM_PnlEngine_OnBbo(benchmark::State& state) {
+    const auto symbols = static_cast<uint32_t>(state.range(0));
+    const auto ticks = make_ticks(symbols);
+    RiskEngine risk(1, 1);
+    PnlEngine pnl(symbols, 1e6);
+    if (state.range(1)) pnl.attachRisk(risk, 0);
+    open_all(pnl, symbols);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const Tick& t = ticks[i++ & (ticks.size() - 1)];
+        pnl.onBbo(t.symbol, t.bid, t.ask);
+        benchmark::DoNotOptimize(pnl.dailyLossBreached());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PnlEngine_OnBbo)->ArgNames({"symbols", "risk"})
+    ->Args({10, 0})->Args({500, 0})->Args({500, 1});
+
+static void BM_PnlEngine_Totals(benchmark::State& state) {
+    PnlEngine pnl(500, 1e6);
+    open_all(pnl, 500);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pnl.totals());
+    }
+}
+BENCHMARK(BM_PnlEngine_Totals);
@@ -0,0 +1,58 @@
+#include "Sim/TcpSink.hpp"
+#include "Utils/QuestDBLogger.hpp"
+#include <benchmark/benchmark.h>
+
+//------------------------------------------------------------------
+// Cost of a measurement on the calling thread. The writer ships to a
+// local sink that discards, so the numbers are the ring and nothing
+// else; drops show when producers outrun the writer.
+//------------------------------------------------------------------
+namespace {
+struct Ingest {
+    TcpSink sink{{.keep = false}};
+    std::unique_ptr<QuestDBLogger> logger;
+
+    Ingest() {
+        sink.start();
+        QuestDBLogger::Config cfg;
+        cfg.port = sink.port();
+        cfg.capacity = 65534;
+        logger = std::make_unique<QuestDBLogger>(cfg);
+    }
+};
+
+Ingest& ingest() {
+    static Ingest instance;
+    return instance;
+}
+} // namespace
+
+// Bursts that fit the ring, drained between iterations: the push alone
+static void BM_QuestDBLogger_RecordBurst(benchmark::State& state) {
+    constexpr int64_t kBurst = 1024;
+    QuestDBLogger& logger = *ingest().logger;
+    int64_t value = 0;
+    for (auto _ : state) {
+        for (int64_t i = 0; i < kBurst; ++i) benchmark::DoNotOptimize(logger.record("BM_QuestDBLogger", ++value));
+        state.PauseTiming();
+        logger.flush(std::chrono::seconds(5));
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * kBurst);
+}
+BENCHMARK(BM_QuestDBLogger_RecordBurst);
+
+// Producers flat out: the ring fills and the overflow is dropped, never waited on
+static void BM_QuestDBLogger_RecordSaturated(benchmark::State& state) {
+    QuestDBLogger& logger = *ingest().logger;
+    const uint64_t dropped_before = logger.stats().dropped.load();
+    int64_t value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(logger.record("BM_QuestDBLogger", ++value));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        state.counters["dropped"] = static_cast<double>(logger.stats().dropped.load() - dropped_before);
+    }
+}
+BENCHMARK(BM_QuestDBLogger_RecordSaturated)->Threads(1)->Threads(4);
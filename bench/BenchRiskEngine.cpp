@@ -0,0 +1,55 @@
+#include "Risk/RiskEngine.hpp"
+#include <benchmark/benchmark.h>
+
+//------------------------------------------------------------------
+// Pre-trade checks on the order path. Threaded runs give each thread
+// its own account, then put every thread on one shared slot, which is
+// the worst case for the reserve CAS.
+//------------------------------------------------------------------
+namespace {
+constexpr uint32_t kAccounts = 64;
+constexpr uint32_t kSymbols = 16;
+
+RiskEngine& engine() {
+    static RiskEngine risk(kAccounts, kSymbols);
+    static const bool ready = [] {
+        for (uint32_t a = 0; a < kAccounts; ++a) {
+            risk.startDay(a, 1e6);
+            for (uint32_t s = 0; s < kSymbols; ++s) {
+                risk.setSymbolLimits(a, s, {.maxOrderNotional = 1e9, .maxPosition = 1e9});
+            }
+        }
+        return true;
+    }();
+    (void)ready;
+    return risk;
+}
+
+RiskEngine::Order order_for(uint32_t account) {
+    return {.account = account, .symbol = 3, .isBuy = true, .quantity = 0.5, .price = 67000.0, .stopPrice = 66000.0};
+}
+} // namespace
+
+// Every limit evaluated: the order passes all of them
+static void BM_RiskEngine_Check(benchmark::State& state) {
+    RiskEngine& risk = engine();
+    const auto order = order_for(static_cast<uint32_t>(state.thread_index()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(risk.check(order));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RiskEngine_Check)->Threads(1)->Threads(4);
+
+// Claim and give back, so the headroom never runs out
+static void BM_RiskEngine_ReserveRelease(benchmark::State& state) {
+    RiskEngine& risk = engine();
+    const bool shared = state.range(0) != 0;
+    const auto order = order_for(shared ? 0 : static_cast<uint32_t>(state.thread_index()) + 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(risk.reserve(order));
+        risk.release(order.account, order.symbol, order.isBuy, order.quantity);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RiskEngine_ReserveRelease)->ArgName("shared")->Arg(0)->Arg(1)->Threads(1)->Threads(4);
@@ -0,0 +1,67 @@
+#include "Core/ShmRing.hpp"
+#include <benchmark/benchmark.h>
+
+#include <thread>
+#include <unistd.h>
+
+//------------------------------------------------------------------
+// What the publisher pays per event, with and without readers, and
+// the round trip to a reader polling on another thread.
+//------------------------------------------------------------------
+namespace {
+std::string ring_path() {
+    return "/tmp/ocean-ring-bench-" + std::to_string(::getpid());
+}
+} // namespace
+
+static void BM_ShmRing_Publish(benchmark::State& state) {
+    ShmRingWriter writer(ShmRingWriter::Config{ring_path(), 1 << 16, 32});
+    std::vector<std::unique_ptr<ShmRingReader>> readers;
+    for (int64_t i = 0; i < state.range(0); ++i) readers.push_back(std::make_unique<ShmRingReader>(ring_path()));
+
+    FanoutEvent event;
+    for (auto _ : state) {
+        ++event.ts_ns;
+        writer.publish(event);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShmRing_Publish)->Arg(0)->Arg(8);
+
+static void BM_ShmRing_PublishPoll(benchmark::State& state) {
+    ShmRingWriter writer(ShmRingWriter::Config{ring_path(), 1 << 16, 32});
+    ShmRingReader reader(ring_path());
+
+    FanoutEvent in, out;
+    for (auto _ : state) {
+        ++in.ts_ns;
+        writer.publish(in);
+        benchmark::DoNotOptimize(reader.poll(out));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShmRing_PublishPoll);
+
+// Producer thread streaming while this thread drains; throughput and loss
+static void BM_ShmRing_Stream(benchmark::State& state) {
+    ShmRingWriter writer(ShmRingWriter::Config{ring_path(), 1 << 16, 32});
+    ShmRingReader reader(ring_path());
+    std::atomic<bool> done{false};
+    std::jthread producer([&] {
+        FanoutEvent event;
+        while (!done.load(std::memory_order_relaxed)) {
+            ++event.ts_ns;
+            writer.publish(event);
+        }
+    });
+
+    FanoutEvent out;
+    uint64_t received = 0;
+    for (auto _ : state) {
+        if (reader.poll(out) == ShmRingReader::Status::Ok) ++received;
+    }
+    done = true;
+    state.counters["received"] = static_cast<double>(received);
+    state.counters["lost"] = static_cast<double>(reader.lost());
+}
+BENCHMARK(BM_ShmRing_Stream);
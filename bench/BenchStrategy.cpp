@@ -0,0 +1,128 @@
+#include "Analysis/MarketPhaseDetector.hpp"
+#include "Core/OrderBook.hpp"
+#include "Core/TradeTape.hpp"
+#include "Sim/DepthGenerator.hpp"
+#include "Strategy/LiquidityDetector.hpp"
+#include "Tactics/SunTzuTactics.hpp"
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+//------------------------------------------------------------------
+// Per-tick strategy calls: the raid detector, the phase detector and
+// the Sun Tzu tactics, each on inputs shaped like a live BTCUSDT feed.
+//------------------------------------------------------------------
+namespace {
+constexpr std::size_t kTicks = 1 << 12;
+
+std::vector<float> random_walk(std::size_t n) {
+    std::mt19937 gen(7);
+    std::normal_distribution<float> step(0.0f, 0.8f);
+    std::vector<float> prices(n);
+    float price = 67000.0f;
+    for (auto& p : prices) p = price += step(gen);
+    return prices;
+}
+
+std::vector<Trade> make_trades(std::size_t n) {
+    std::mt19937 gen(3);
+    std::lognormal_distribution<float> size(-1.0f, 1.5f);
+    const auto prices = random_walk(n);
+    std::vector<Trade> trades(n);
+    for (std::size_t i = 0; i < n; ++i) trades[i] = {prices[i], size(gen)};
+    return trades;
+}
+
+std::unique_ptr<OrderBook> depth20_book() {
+    auto book = std::make_unique<OrderBook>();
+    DepthGenerator gen;
+    const std::vector<OrderBook::Order> levels(gen.levels().begin(), gen.levels().end());
+    book->update(levels);
+    return book;
+}
+
+uint64_t steady_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+} // namespace
+
+// One depth20 frame of updates against the mid
+static void BM_LiquidityDetector_DetectRaid(benchmark::State& state) {
+    const LiquidityDetector detector({});
+    DepthGenerator gen;
+    const std::vector<OrderBook::Order> updates(gen.levels().begin(), gen.levels().end());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(detector.detect_raid(updates, 67000.0f));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LiquidityDetector_DetectRaid);
+
+static void BM_MarketPhaseDetector_Update(benchmark::State& state) {
+    const auto prices = random_walk(kTicks);
+    MarketPhaseDetector detector(static_cast<std::size_t>(state.range(0)));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        detector.update(prices[i++ % kTicks]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MarketPhaseDetector_Update)->Arg(100)->Arg(1000);
+
+static void BM_MarketPhaseDetector_GetPhase(benchmark::State& state) {
+    const auto prices = random_walk(kTicks);
+    MarketPhaseDetector detector(static_cast<std::size_t>(state.range(0)));
+    for (float p : prices) detector.update(p);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(detector.getPhase());
+    }
+}
+BENCHMARK(BM_MarketPhaseDetector_GetPhase)->Arg(100)->Arg(1000);
+
+static void BM_SunTzu_IsWeakPoint(benchmark::State& state) {
+    const auto book = depth20_book();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SunTzu::isWeakPoint(*book, 5000.0f));
+    }
+}
+BENCHMARK(BM_SunTzu_IsWeakPoint);
+
+static void BM_SunTzu_StealthEntryPrice(benchmark::State& state) {
+    const auto book = depth20_book();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SunTzu::stealthEntryPrice(*book, true));
+    }
+}
+BENCHMARK(BM_SunTzu_StealthEntryPrice);
+
+static void BM_SunTzu_DetectMarketPhase(benchmark::State& state) {
+    const auto prices = random_walk(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SunTzu::detectMarketPhase(prices));
+    }
+}
+BENCHMARK(BM_SunTzu_DetectMarketPhase)->Arg(100)->Arg(1000);
+
+// Trailing-window volume query over a tape holding the last minute
+static void BM_SunTzu_IsLiquidityRaid(benchmark::State& state) {
+    TradeTape tape;
+    const auto trades = make_trades(static_cast<std::size_t>(state.range(0)));
+    const uint64_t now = steady_ns();
+    const uint64_t spacing = 60'000'000'000ULL / trades.size();
+    for (std::size_t i = 0; i < trades.size(); ++i) {
+        tape.append(now - (trades.size() - i) * spacing, trades[i].price, trades[i].amount, i & 1);
+    }
+    const SunTzu::LiquidityRaidConfig cfg{2.5f, 30.0f, 0.15f};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SunTzu::isLiquidityRaid(tape, cfg));
+    }
+}
+BENCHMARK(BM_SunTzu_IsLiquidityRaid)->Arg(1000)->Arg(60000);
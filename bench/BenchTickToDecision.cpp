@@ -0,0 +1,143 @@
+#include "Analysis/BarAggregator.hpp"
+#include "Core/MarketData.hpp"
+#include "Core/OrderBook.hpp"
+#include "Core/TradeTape.hpp"
+#include "Sim/DepthGenerator.hpp"
+#include "Sim/ExchangeSimulator.hpp"
+#include "Strategy/DetectorPipeline.hpp"
+#include "Strategy/PipelineStages.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+//------------------------------------------------------------------
+// Tick to decision: one book frame through the same stages main.cpp
+// runs. _InProcess starts from decoded levels (book update, features,
+// every detector stage); _Loopback adds the socket and MarketData
+// decode, fed by the exchange simulator.
+//
+//   p50_ns/p99_ns   per-tick wall time of the in-process part
+//------------------------------------------------------------------
+namespace {
+constexpr std::array<BarAggregator::Timeframe, 3> kTimeframes{{
+    {.period = std::chrono::seconds(1)},
+    {.period = std::chrono::minutes(1)},
+    {.period = std::chrono::minutes(5)},
+}};
+constexpr std::size_t kRiskTimeframe = 1;
+
+constexpr SunTzu::LiquidityRaidConfig kRaidConfig{
+    .volume_spike_multiplier = 2.5f,
+    .time_window_seconds = 30.0f,
+    .min_volume_threshold = 0.15f   // BTC, as in main.cpp
+};
+
+using BenchPipeline = DetectorPipeline<
+    PhaseStage<kRiskTimeframe>,
+    WeakPointStage<5000.0f>,
+    UpdateRaidStage,
+    TapeRaidStage<kRaidConfig>,
+    GammaStage<>,
+    RiskPhaseStage,
+    MarkToMarketStage,
+    StealthEntryStage<>
+>;
+
+constexpr std::size_t kFrames = 256;
+
+uint64_t now_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Strategy {
+    Strategy() : risk(1, 1), pnl(1, 10'000.0), bars(kTimeframes),
+        pipeline(PhaseStage<kRiskTimeframe>(bars, tape), WeakPointStage<5000.0f>{}, UpdateRaidStage{},
+                 TapeRaidStage<kRaidConfig>(tape), GammaStage<>(tape), RiskPhaseStage(risk, 0),
+                 MarkToMarketStage(pnl, 0), StealthEntryStage<>{}) {
+        pnl.attachRisk(risk, 0);
+        pnl.onFill(0, true, 0.1, 67000.0);   // Open, so every tick revalues it
+    }
+
+    TickDecision on_frame(std::span<const OrderBook::Order> updates) {
+        batch.assign(updates.begin(), updates.end());
+        book.update(batch);
+        return pipeline.on_tick(make_tick_features(now_ns(), book, updates));
+    }
+
+    OrderBook book;
+    TradeTape tape;
+    RiskEngine risk;
+    PnlEngine pnl;
+    BarAggregator bars;
+    BenchPipeline pipeline;
+    std::vector<OrderBook::Order> batch;
+};
+
+void report_percentiles(benchmark::State& state, std::vector<uint64_t>& samples) {
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    state.counters["p50_ns"] = static_cast<double>(samples[samples.size() / 2]);
+    state.counters["p99_ns"] = static_cast<double>(samples[samples.size() * 99 / 100]);
+}
+} // namespace
+
+static void BM_TickToDecision_InProcess(benchmark::State& state) {
+    DepthGenerator gen;
+    std::vector<std::vector<OrderBook::Order>> frames(kFrames);
+    for (auto& frame : frames) {
+        gen.next();
+        frame.assign(gen.levels().begin(), gen.levels().end());
+    }
+    Strategy strategy;
+    std::vector<uint64_t> samples;
+    samples.reserve(1 << 20);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const uint64_t start = now_ns();
+        benchmark::DoNotOptimize(strategy.on_frame(frames[i++ % kFrames]));
+        if (samples.size() < samples.capacity()) samples.push_back(now_ns() - start);
+    }
+    state.SetItemsProcessed(state.iterations());
+    report_percentiles(state, samples);
+}
+BENCHMARK(BM_TickToDecision_InProcess);
+
+// Iteration = one frame received, decoded and decided on
+static void BM_TickToDecision_Loopback(benchmark::State& state) {
+    ExchangeSimulator::Config cfg;
+    cfg.binary_port = 0;
+    cfg.serve_websocket = false;
+    cfg.rate = 1e9;
+    ExchangeSimulator sim(cfg);
+    sim.start();
+
+    MarketData market("127.0.0.1", sim.binary_port());
+    Strategy strategy;
+    const std::size_t book_size = 2 * static_cast<std::size_t>(cfg.depth.levels);
+    std::vector<OrderBook::Order> pending;
+    std::vector<uint64_t> samples;
+    samples.reserve(1 << 20);
+
+    for (auto _ : state) {
+        while (pending.size() < book_size) {
+            market.poll(100);
+            const auto updates = market.get_updates();
+            pending.insert(pending.end(), updates.begin(), updates.end());
+        }
+        const uint64_t start = now_ns();
+        benchmark::DoNotOptimize(strategy.on_frame(std::span(pending).first(book_size)));
+        if (samples.size() < samples.capacity()) samples.push_back(now_ns() - start);
+        pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(book_size));
+    }
+    state.SetItemsProcessed(state.iterations());
+    report_percentiles(state, samples);
+
+    market.stop();
+    sim.stop();
+}
+BENCHMARK(BM_TickToDecision_Loopback)->UseRealTime();
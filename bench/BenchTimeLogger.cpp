@@ -0,0 +1,44 @@
+#include "Utils/TimeLogger.hpp"
+#include <benchmark/benchmark.h>
+
+//------------------------------------------------------------------
+// What a probe costs the code it measures: an empty scope timed with
+// the TSC and a per-thread histogram, against the steady_clock pair it
+// replaces. The collector never runs here.
+//------------------------------------------------------------------
+
+static void BM_TscTicks(benchmark::State& state) {
+    for (auto _ : state) benchmark::DoNotOptimize(Tsc::ticks());
+}
+BENCHMARK(BM_TscTicks);
+
+static void BM_SteadyClockPair(benchmark::State& state) {
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(std::chrono::steady_clock::now() - start);
+    }
+}
+BENCHMARK(BM_SteadyClockPair);
+
+static void BM_ScopeTimer(benchmark::State& state) {
+    for (auto _ : state) {
+        ScopeTimer<"bench.scope"> timer;
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ScopeTimer);
+
+static void BM_ScopeTimer_Threads(benchmark::State& state) {
+    for (auto _ : state) {
+        ScopeTimer<"bench.scope_threads"> timer;
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ScopeTimer_Threads)->Threads(2)->Threads(4);
+
+static void BM_Record(benchmark::State& state) {
+    const ProbeId probe = TimeLogger::intern("bench.record");
+    uint64_t ticks = 0;
+    for (auto _ : state) TimeLogger::record(probe, ++ticks & 0xffff);
+}
+BENCHMARK(BM_Record);
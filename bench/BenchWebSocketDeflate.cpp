@@ -0,0 +1,134 @@
+#include "Clients/BinanceWSClient.hpp"
+#include "Sim/ExchangeSimulator.hpp"
+#include "TcpCounters.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------
+// Depth stream from the exchange simulator into BinanceWSClient over
+// loopback TLS, with and without permessage-deflate. The simulator
+// pushes frames at its own pace, the way the venue does. Set
+// OCEAN_DEPTH_CAPTURE to a file with one captured frame per line;
+// otherwise synthetic depth20 frames are used.
+//
+//   wire_B/msg   TCP payload bytes received per message (TCP_INFO)
+//   cpu_ns/msg   client thread CPU: read, decrypt, inflate, parse
+//   lat_p50/p99  simulator stamp before compress+send -> depth handler
+//------------------------------------------------------------------
+namespace {
+constexpr double kRate = 5000.0;   // Frames per second the simulator pushes
+constexpr std::string_view kStampKey = R"("T0":)";
+
+uint64_t now_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t thread_cpu_ns() noexcept {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+uint64_t stamp_of(std::string_view frame) {
+    const std::size_t at = frame.find(kStampKey);
+    uint64_t stamp = 0;
+    if (at != std::string_view::npos) {
+        const char* p = frame.data() + at + kStampKey.size();
+        std::from_chars(p, frame.data() + frame.size(), stamp);
+    }
+    return stamp;
+}
+
+double percentile(std::vector<uint64_t>& v, double q) {
+    if (v.empty()) return 0.0;
+    const std::size_t k = static_cast<std::size_t>(q * static_cast<double>(v.size() - 1));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return static_cast<double>(v[k]);
+}
+} // namespace
+
+static void BM_DepthStream(benchmark::State& state) {
+    const bool deflate = state.range(0) != 0;
+
+    ExchangeSimulator::Config cfg;
+    cfg.serve_binary = false;
+    cfg.ws_port = 0;
+    cfg.rate = kRate;
+    cfg.compression = deflate;
+    cfg.stamp_frames = true;
+    if (const char* path = std::getenv("OCEAN_DEPTH_CAPTURE")) cfg.replay_path = path;
+    ExchangeSimulator sim(cfg);
+    sim.start();
+
+    // The client runs on this thread, so its CPU is the thread's CPU
+    net::io_context ioc;
+    ssl::context ctx(ssl::context::tlsv12_client);   // No peer verification
+    BinanceWSClient client(ioc, ctx, "btcusdt");
+    client.set_endpoint("127.0.0.1", std::to_string(sim.ws_port()));
+    client.enable_compression(deflate);
+
+    std::vector<uint64_t> latencies;
+    latencies.reserve(1 << 20);
+    std::size_t payload_bytes = 0;
+    uint64_t stamp = 0;
+    uint64_t books = 0;
+    client.set_frame_filter([&](std::string_view frame) {
+        stamp = stamp_of(frame);   // Inflated already; the handler below runs once it is parsed
+        payload_bytes += frame.size();
+        return true;
+    });
+    client.on_depth([&](std::span<const OrderBook::Order>) {
+        latencies.push_back(now_ns() - stamp);
+        ++books;
+    });
+    client.start();
+
+    // Connected and streaming before the clock starts
+    const auto next_book = [&] {
+        const uint64_t target = books + 1;
+        while (books < target) {
+            if (ioc.run_one_for(std::chrono::seconds(1)) == 0) return false;
+        }
+        return true;
+    };
+    if (!next_book()) {
+        state.SkipWithError("no depth from the simulator");
+        return;
+    }
+    const int fd = client.native_handle();
+    latencies.clear();
+    payload_bytes = 0;
+    books = 0;
+    const uint64_t wire_before = tcp_bytes_received(fd);
+    const uint64_t cpu_before = thread_cpu_ns();
+
+    for (auto _ : state) {
+        if (!next_book()) {
+            state.SkipWithError("depth stream stalled");
+            break;
+        }
+    }
+
+    const double cpu = static_cast<double>(thread_cpu_ns() - cpu_before);
+    const double wire = static_cast<double>(tcp_bytes_received(fd) - wire_before);
+    const double n = static_cast<double>(std::max<uint64_t>(books, 1));
+
+    client.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+
+    state.SetItemsProcessed(static_cast<int64_t>(books));
+    state.counters["json_B/msg"] = static_cast<double>(payload_bytes) / n;
+    state.counters["wire_B/msg"] = wire / n;
+    state.counters["cpu_ns/msg"] = cpu / n;
+    state.counters["lat_p50_ns"] = percentile(latencies, 0.50);
+    state.counters["lat_p99_ns"] = percentile(latencies, 0.99);
+}
+BENCHMARK(BM_DepthStream)->ArgName("deflate")->Arg(0)->Arg(1)->UseRealTime();
@@ -0,0 +1,11 @@
+#include "TcpCounters.hpp"
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+uint64_t tcp_bytes_received(int fd) noexcept {
+    tcp_info info{};
+    socklen_t len = sizeof(info);
+    if (getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &len) != 0) return 0;
+    return info.tcpi_bytes_received;
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <cstdint>
+
+// Payload bytes the kernel has received on a TCP socket (TCP_INFO), so a
+// benchmark can report what actually crossed the wire. Kept in its own
+// translation unit: <linux/tcp.h> clashes with the <netinet/tcp.h> that asio pulls in.
+uint64_t tcp_bytes_received(int fd) noexcept;
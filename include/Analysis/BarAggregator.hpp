@@ -0,0 +1,76 @@
+#pragma once
+#include "Analysis/MarketPhaseDetector.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+// OHLCV bar; start_ns is the bucket start on the feed clock
+struct Bar {
+    uint64_t start_ns = 0;
+    float open = 0.0f;
+    float high = 0.0f;
+    float low = 0.0f;
+    float close = 0.0f;
+    float volume = 0.0f;
+    uint32_t trade_count = 0;
+};
+
+//--------------------------------------------------------------------
+// BAR AGGREGATOR: one pass over the tick stream builds bars for every
+// configured timeframe. Finished bars land in a per-timeframe ring
+// (slot = bucket % history), feed that timeframe's phase detector once,
+// and are published to subscribers.
+//--------------------------------------------------------------------
+class BarAggregator {
+public:
+    struct Timeframe {
+        std::chrono::nanoseconds period;
+        std::size_t history = 256;                                       // closed bars kept
+        std::size_t phase_window = MarketPhaseDetector::kDefaultWindow;  // bars per phase window
+    };
+
+    // Called on the feeding thread for every closed bar
+    using Subscriber = std::function<void(std::size_t timeframe, const Bar& bar)>;
+
+    // Bar rings and phase windows are allocated from `memory`, e.g. the
+    // strategy thread's HugePageArena
+    explicit BarAggregator(std::span<const Timeframe> timeframes,
+                           std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    // Trades move price and volume; book updates only move price
+    void on_trade(uint64_t ts_ns, float price, float amount);
+    void on_quote(uint64_t ts_ns, float mid);
+
+    void subscribe(Subscriber subscriber);
+
+    [[nodiscard]] std::size_t timeframe_count() const noexcept { return frames_.size(); }
+    [[nodiscard]] SunTzu::MarketPhase phase(std::size_t timeframe) const;
+
+    // Bar still being built (nullptr before the first tick)
+    [[nodiscard]] const Bar* current(std::size_t timeframe) const noexcept;
+
+    // back = 0 is the most recently closed bar. nullptr if that bucket had
+    // no ticks or has already been overwritten in the ring.
+    [[nodiscard]] const Bar* closed(std::size_t timeframe, std::size_t back = 0) const noexcept;
+
+private:
+    struct Frame {
+        uint64_t period_ns;
+        std::pmr::vector<Bar> ring;
+        MarketPhaseDetector phase;
+        Bar building{};
+        uint64_t bucket = 0;       // bucket index of `building`
+        uint64_t last_closed = 0;  // bucket index of the newest closed bar
+        bool open = false;
+        bool has_closed = false;
+    };
+
+    void on_tick(uint64_t ts_ns, float price, float amount, uint32_t trades);
+    void close_bar(std::size_t timeframe, Frame& frame);
+
+    std::vector<Frame> frames_;
+    std::vector<Subscriber> subscribers_;
+};
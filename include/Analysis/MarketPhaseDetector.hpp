@@ -1,18 +1,46 @@
 
 #pragma once
 #include "Tactics/SunTzuTactics.hpp"
+#include <cstddef>
+#include <memory_resource>
 #include <vector>
 
 class MarketPhaseDetector {
 public:
+    static constexpr std::size_t kDefaultWindow = 100;
+
+    // Window length is fixed for the lifetime of the detector; storage is
+    // allocated once here, from `memory`, and never touched by the allocator again.
+    explicit MarketPhaseDetector(std::size_t window = kDefaultWindow,
+                                 std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
     void update(float price);
     SunTzu::MarketPhase getPhase() const;
 
+    [[nodiscard]] std::size_t size() const noexcept { return count_; }
+    [[nodiscard]] std::size_t window() const noexcept { return prices_.size(); }
+
 private:
-    std::vector<float> prices_;
+    // Circular window: head_ is the slot of the oldest price once full
+    std::pmr::vector<float> prices_;
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+
+    // Running sums over the price changes currently inside the window
+    double upMoves_ = 0.0;
+    double downMoves_ = 0.0;
+    double absMoves_ = 0.0;
+
+    // Welford state over the prices currently inside the window
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+
     bool isTrending() const;
     bool isChaos() const;
     float getVolatility() const;
+
+    void addMove(double change) noexcept;
+    void removeMove(double change) noexcept;
 };
 
 
@@ -75,4 +103,4 @@ private:
 //     }
 //
 //     float getAverageVolatility() const { /* ... */ }
-// };
\ No newline at end of file
+// };
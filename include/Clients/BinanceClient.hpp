@@ -1,17 +1,55 @@
 #pragma once
 #include "Core/IMarketDataSource.hpp"
 #include <boost/lockfree/spsc_queue.hpp>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "Core/OrderBook.hpp"
 
+// Binance depth as an IMarketDataSource: the asio thread pushes decoded
+// levels into the SPSC queue, the consumer drains them without locking.
+// Each depth20 frame is a whole snapshot and goes in whole or not at all;
+// a second queue carries frame lengths, so the consumer knows where each
+// snapshot ends and can skip the ones a newer frame superseded.
 class BinanceClient final : public IMarketDataSource {
 public:
+    static constexpr std::size_t kQueueCapacity = 1024;
+
     explicit BinanceClient(std::string symbol);
+    ~BinanceClient() override;
+
+    // The newest complete snapshot since the last call, for
+    // OrderBook::apply_snapshot; empty if none arrived. Drains into an
+    // internal buffer reused across calls; the span stays valid until the
+    // next get_updates().
     std::span<const OrderBook::Order> get_updates() noexcept override;
+
+    // Same, into caller-owned storage; returns how many levels were
+    // written. A snapshot longer than `out` is cut short.
+    std::size_t drain(std::span<OrderBook::Order> out) noexcept;
+
     bool start() noexcept override;
     void stop() noexcept override;
+
+    // Connect somewhere other than stream.binance.com:9443, e.g. the local
+    // exchange simulator. Call before start().
+    void set_endpoint(std::string host, std::string port);
+
+    // Depth frames lost because the consumer fell a full queue behind
+    [[nodiscard]] uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
 private:
+    struct Runtime;  // io_context, TLS context, WebSocket client, io thread
+
     std::string symbol_;
-    boost::lockfree::spsc_queue<OrderBook::Order> buffer_{1024};
+    std::string host_;   // Empty: Binance
+    std::string port_;
+    boost::lockfree::spsc_queue<OrderBook::Order> buffer_{kQueueCapacity};
+    boost::lockfree::spsc_queue<std::size_t> frames_{kQueueCapacity};   // Level count per frame
     std::atomic<bool> running_{false};
+    std::atomic<uint64_t> dropped_{0};
+    std::vector<OrderBook::Order> drained_;
+    std::unique_ptr<Runtime> runtime_;
 };
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class OrderBook;
+
+// Stream name -> dense symbol id -> shard and book. Holds no sockets, so the
+// routing rules can be checked without a network; BinanceStreamMux guards it.
+class BinanceStreamDirectory {
+public:
+    using SymbolId = uint32_t;
+    static constexpr SymbolId kNoSymbol = UINT32_MAX;
+
+    // Binance closes combined connections that ask for more than this
+    static constexpr std::size_t kMaxStreamsPerConnection = 1024;
+
+    struct Assignment {
+        SymbolId id = kNoSymbol;
+        std::size_t shard = 0;
+        bool new_shard = false;   // The caller has to open a connection for it
+    };
+
+    // `stream_suffix` is appended to every symbol, e.g. "@depth20@100ms"
+    explicit BinanceStreamDirectory(std::string stream_suffix,
+                                    std::size_t streams_per_shard = kMaxStreamsPerConnection);
+
+    // nullopt if the symbol is already routed. Freed ids and shard slots are
+    // reused first, so ids stay dense and connections stay packed.
+    std::optional<Assignment> add(std::string_view symbol, OrderBook& book);
+    std::optional<Assignment> remove(std::string_view symbol);
+
+    // Hot path: no allocation, one hash of the stream name
+    [[nodiscard]] SymbolId find(std::string_view stream) const noexcept;
+    [[nodiscard]] OrderBook* book(SymbolId id) const noexcept;
+    [[nodiscard]] const std::string& symbol(SymbolId id) const noexcept;
+    [[nodiscard]] const std::string& stream(SymbolId id) const noexcept;
+
+    // Live streams routed over `shard`, in id order
+    [[nodiscard]] std::vector<std::string> streams(std::size_t shard) const;
+
+    [[nodiscard]] std::size_t size() const noexcept { return by_stream_.size(); }
+    [[nodiscard]] std::size_t shards() const noexcept { return shard_load_.size(); }
+    [[nodiscard]] std::size_t shard_load(std::size_t shard) const noexcept;
+    [[nodiscard]] std::size_t streams_per_shard() const noexcept { return per_shard_; }
+
+    //------------------------------------------------------------------
+    // Wire helpers
+    //------------------------------------------------------------------
+    // Stream name of a combined-stream frame without parsing the payload;
+    // empty for control replies such as {"result":null,"id":1}
+    [[nodiscard]] static std::string_view stream_name(std::string_view frame) noexcept;
+
+    // "/stream?streams=a/b/..." holding as many leading streams as fit in
+    // `max_length`; the second member is how many made it in
+    [[nodiscard]] static std::pair<std::string, std::size_t> combined_path(
+        std::span<const std::string> streams, std::size_t max_length);
+
+    // {"method":"SUBSCRIBE","params":[...],"id":N}
+    [[nodiscard]] static std::string control_frame(
+        std::string_view method, std::span<const std::string> streams, uint64_t id);
+
+private:
+    struct Slot {
+        std::string symbol;
+        std::string stream;
+        OrderBook* book = nullptr;
+        std::size_t shard = 0;
+        bool live = false;
+    };
+
+    // Heterogeneous lookup so the read path hashes a string_view directly
+    struct StreamHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept {
+            return std::hash<std::string_view>{}(s);
+        }
+    };
+
+    std::string suffix_;
+    std::size_t per_shard_;
+    std::vector<Slot> slots_;
+    std::vector<SymbolId> free_ids_;
+    std::vector<std::size_t> shard_load_;
+    std::unordered_map<std::string, SymbolId, StreamHash, std::equal_to<>> by_stream_;
+};
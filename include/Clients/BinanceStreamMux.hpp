@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "Clients/BinanceStreamDirectory.hpp"
+#include "Clients/BinanceWSClient.hpp"
+
+//--------------------------------------------------------------------
+// STREAM MUX: many symbols over Binance combined streams. Symbols are
+// packed onto as few TLS connections as the per-connection stream limit
+// allows; each frame is routed by its stream name to a dense symbol id
+// and straight into that symbol's book, replacing it with each partial
+// depth snapshot.
+//--------------------------------------------------------------------
+class BinanceStreamMux {
+public:
+    using SymbolId = BinanceStreamDirectory::SymbolId;
+    static constexpr SymbolId kNoSymbol = BinanceStreamDirectory::kNoSymbol;
+
+    // Levels of one depth message for `id`, after its book was updated;
+    // runs on the io thread of the shard that received it, under the
+    // routing lock, so it must not call subscribe() or unsubscribe()
+    using DepthHandler = std::function<void(SymbolId, std::span<const OrderBook::Order>)>;
+
+    struct Config {
+        int depth_level = 20;
+        std::string update_speed = "100ms";
+        std::size_t streams_per_connection = BinanceStreamDirectory::kMaxStreamsPerConnection;
+        bool compression = false;   // Offer permessage-deflate on every shard
+        // Somewhere other than Binance, e.g. the local exchange simulator.
+        // Also used for SNI and the Host header.
+        std::string host = "stream.binance.com";
+        std::string port = "9443";
+    };
+
+    BinanceStreamMux(net::io_context& ioc, ssl::context& ctx);
+    BinanceStreamMux(net::io_context& ioc, ssl::context& ctx, Config cfg);
+    ~BinanceStreamMux();
+
+    // Routes `symbol` into `book`, which must outlive the mux or the
+    // matching unsubscribe(). Safe while running: the stream is added with a
+    // SUBSCRIBE on an open connection, or a new connection when all are full.
+    // Returns kNoSymbol if the symbol is already subscribed.
+    SymbolId subscribe(std::string_view symbol, OrderBook& book);
+    // Waits for a frame being applied to the symbol's book to finish; once
+    // it returns the book is no longer touched and may be destroyed
+    bool unsubscribe(std::string_view symbol);
+
+    void start();
+    void stop();
+
+    // Call before start()
+    void on_depth(DepthHandler handler);
+
+    [[nodiscard]] std::size_t connections() const;
+    [[nodiscard]] std::size_t symbols() const;
+    [[nodiscard]] SymbolId id_of(std::string_view symbol) const;
+
+    // Bumped after every routed depth message and on connection changes
+    DataNotifier& notifier() noexcept;
+
+    BinanceStreamMux(const BinanceStreamMux&) = delete;
+    BinanceStreamMux& operator=(const BinanceStreamMux&) = delete;
+
+private:
+    class Shard;
+    struct State;
+    std::shared_ptr<State> state_;
+};
@@ -8,6 +8,12 @@
 #include <mutex>
 #include <atomic>
 #include <memory>
+#include <functional>
+#include <span>
+#include <string_view>
+
+#include "Core/DataNotifier.hpp"
+#include "Core/OrderBook.hpp"
 
 namespace net = boost::asio;
 namespace beast = boost::beast;
@@ -16,8 +22,15 @@ namespace ssl = net::ssl;
 using tcp = net::ip::tcp;
 using json = nlohmann::json;
 
+class TradeTape;
+
 class BinanceWSClient {
 public:
+    // Every level of a depth message, bids first; runs on the io thread
+    using DepthHandler = std::function<void(std::span<const OrderBook::Order>)>;
+    // Sees every raw frame before it is parsed; returning false drops it
+    using FrameFilter = std::function<bool(std::string_view frame)>;
+
     struct MarketData {
         double bid = 0.0;
         double ask = 0.0;
@@ -39,10 +52,49 @@ public:
     void stop();
     MarketData& get_market_data() noexcept;
 
+    // Bumped after every depth/trade message and on connection changes
+    DataNotifier& notifier() noexcept;
+
+    // Subscribe to <symbol>@aggTrade on the same connection and append every
+    // print to `tape`. Call before start().
+    void attach_trade_tape(TradeTape& tape);
+
+    // Call before start()
+    void on_depth(DepthHandler handler);
+
+    // Offer permessage-deflate in the handshake; the server may decline.
+    // Frames are inflated straight into the read buffer. Call before start().
+    void enable_compression(bool enabled = true);
+
+    // Call before start()
+    void set_frame_filter(FrameFilter filter);
+
+    // Held from the frame filter through the depth handler or tape append,
+    // so clients sharing it never deliver at the same time, even from
+    // different io threads. Call before start().
+    void set_delivery_lock(std::shared_ptr<std::mutex> lock);
+
+    // Try the resolved addresses starting at this index, so redundant
+    // connections to the same host land on different front ends
+    void set_endpoint_offset(std::size_t offset);
+
+    // Connect somewhere other than stream.binance.com:9443, e.g. the local
+    // exchange simulator. Also used for SNI and the Host header. Call before start().
+    void set_endpoint(const std::string& host, const std::string& port);
+
+    // Extra labels on this connection's metric series, e.g. leg="1", so
+    // clients streaming the same symbol keep separate frame counts and
+    // connected gauges. Call before start().
+    void set_metric_labels(std::string labels);
+
+    // The current connection's TCP socket, or -1 between connections, for
+    // tests and benchmarks that read socket counters. Call on the io thread.
+    [[nodiscard]] int native_handle() const noexcept;
+
     BinanceWSClient(const BinanceWSClient&) = delete;
     BinanceWSClient& operator=(const BinanceWSClient&) = delete;
 
 private:
     class Impl;
-    std::unique_ptr<Impl> pimpl_;
+    std::shared_ptr<Impl> pimpl_;
 };
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Core/OrderBook.hpp"
+
+//--------------------------------------------------------------------
+// BINANCE WIRE: in-place scanners for the few frame shapes we consume.
+// They read the received bytes directly, with no DOM and no temporary
+// strings; numbers go through std::from_chars. Both plain and
+// combined-stream ({"stream":..,"data":..}) frames are accepted.
+//--------------------------------------------------------------------
+namespace BinanceWire {
+
+struct AggTrade {
+    uint64_t trade_time_ms = 0;
+    float price = 0.0f;
+    float quantity = 0.0f;
+    bool buyer_is_maker = false;   // True when the aggressor sold
+};
+
+[[nodiscard]] bool is_agg_trade(std::string_view frame) noexcept;
+
+// Diff depth (<symbol>@depth): levels add to the book. Partial depth
+// (<symbol>@depth<N>) is a snapshot and replaces it.
+[[nodiscard]] bool is_depth_update(std::string_view frame) noexcept;
+
+// Replaces `out` with every bid then every ask of a partial ("bids"/"asks")
+// or diff ("b"/"a") depth frame. Does not allocate once `out` has capacity
+// for the levels. Returns false on a malformed frame.
+[[nodiscard]] bool parse_depth(std::string_view frame, std::vector<OrderBook::Order>& out);
+
+[[nodiscard]] std::optional<AggTrade> parse_agg_trade(std::string_view frame) noexcept;
+
+// Exchange sequence number of a frame: the aggregate trade id for aggTrade,
+// "u" for diff depth, lastUpdateId for partial depth
+[[nodiscard]] std::optional<uint64_t> sequence_id(std::string_view frame) noexcept;
+
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Clients/BinanceWSClient.hpp"
+#include "Clients/FirstArrivalArbiter.hpp"
+#include "Clients/IoContextPool.hpp"
+
+struct ConnectionOptions {
+    int depth_level = 20;
+    std::string update_speed = "100ms";
+    BinanceWSClient::DepthHandler on_depth;   // Runs on the connection's io thread
+    TradeTape* tape = nullptr;
+    bool compression = false;                 // Offer permessage-deflate
+    std::string host;                         // Empty: Binance. E.g. the local exchange simulator
+    std::string port;
+};
+
+//--------------------------------------------------------------------
+// CONNECTION MANAGER: places each BinanceWSClient on the io_context
+// carrying the least traffic. rebalance() moves a connection when one
+// context runs hot. Moving means reconnecting on the new context, so a
+// move happens only when it narrows the spread between the busiest
+// and quietest context.
+//
+// The old session keeps serving until the new one has taken over: its
+// first depth frame, and for a tape, a trade that follows straight on
+// from the last one delivered. The old session is closed right then.
+// Until it is, both deliver under one lock per symbol, and an arbiter
+// on the wire sequence id drops whatever the other already delivered,
+// so the handler is never entered twice at once and no print reaches
+// the tape twice.
+//--------------------------------------------------------------------
+class ConnectionManager {
+public:
+    // Move only once the busiest context carries this multiple of the quietest
+    static constexpr double kImbalance = 1.5;
+
+    ConnectionManager(IoContextPool& pool, ssl::context& ctx);
+    ~ConnectionManager();
+
+    ConnectionManager(const ConnectionManager&) = delete;
+    ConnectionManager& operator=(const ConnectionManager&) = delete;
+
+    // Starts the connection right away on the least-loaded context, then
+    // rebalances. False if the symbol is already connected.
+    bool add(const std::string& symbol, ConnectionOptions options = {});
+    bool remove(std::string_view symbol);
+
+    // Refreshes per-connection message rates and moves at most one
+    // connection from the busiest context to the quietest. Call periodically.
+    bool rebalance();
+
+    // Runs f(BinanceWSClient&) under the manager lock on the client
+    // currently serving the symbol; a move replaces it, so do not keep
+    // the reference
+    template <typename F>
+    bool with_client(std::string_view symbol, F&& f) {
+        std::lock_guard lock(mutex_);
+        const auto it = connections_.find(symbol);
+        if (it == connections_.end()) return false;
+        f(it->second.serving());
+        return true;
+    }
+
+    struct Move {
+        std::size_t connection;   // Index into the spans given to plan_move()
+        std::size_t from;
+        std::size_t to;
+    };
+
+    // The balancing rule on its own. weights[i] is connection i's cost
+    // (message rate + 1 for the idle cost of a TLS session) and
+    // placement[i] its context. Picks the connection whose move leaves the
+    // busiest and quietest context closest to even.
+    [[nodiscard]] static std::optional<Move> plan_move(std::span<const double> weights,
+                                                       std::span<const std::size_t> placement,
+                                                       std::size_t contexts);
+
+    [[nodiscard]] std::size_t connections() const;
+    [[nodiscard]] std::size_t context_of(std::string_view symbol) const;
+    // Messages per second on each context, as of the last rebalance()
+    [[nodiscard]] std::vector<double> context_loads() const;
+
+    // Bumped after every depth message on any connection; unlike a
+    // client's own notifier it survives moves
+    DataNotifier& notifier() noexcept { return *notifier_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // One per symbol, shared by every session that serves it across moves
+    struct Feed {
+        std::shared_ptr<std::mutex> delivery = std::make_shared<std::mutex>();
+        FirstArrivalArbiter depth{2};    // Legs: the old and new session of a move
+        FirstArrivalArbiter trades{2};   // aggTrade ids are their own sequence
+    };
+
+    // One per client, shared with its frame filter, which runs under the
+    // feed's delivery lock
+    struct Session {
+        std::size_t leg = 0;
+        bool trades = false;                         // Carries aggTrade for a tape
+        std::atomic<bool> retired{false};            // Superseded by a move and closed
+        std::weak_ptr<BinanceWSClient> client;
+        std::shared_ptr<Session> replaces;           // Until it is retired
+        uint64_t took_depth_ns = 0;
+        bool took_trades = false;
+    };
+
+    struct Connection {
+        ConnectionOptions options;
+        std::shared_ptr<Feed> feed;
+        std::shared_ptr<BinanceWSClient> client;
+        std::shared_ptr<Session> session;
+        std::shared_ptr<BinanceWSClient> standby;   // Moved away from, until `client` takes over
+        std::shared_ptr<Session> standby_session;
+        std::size_t context = 0;
+        uint32_t last_sequence = 0;
+        double rate = 0.0;   // Messages per second, smoothed
+
+        BinanceWSClient& serving() const {
+            return standby && !standby_session->retired.load(std::memory_order_relaxed) ? *standby : *client;
+        }
+    };
+
+    // A new session on c.context for `session`, which may replace another
+    std::shared_ptr<BinanceWSClient> open(const std::string& symbol, const Connection& c,
+                                          const std::shared_ptr<Session>& session);
+    // Frame filter for one session; runs under the feed's delivery lock
+    static bool admit(Feed& feed, Session& session, std::string_view frame);
+    std::vector<double> loads_locked() const;
+    std::size_t quietest_locked() const;
+
+    IoContextPool& pool_;
+    ssl::context& ctx_;
+    std::shared_ptr<DataNotifier> notifier_;   // Shared with in-flight handlers
+    mutable std::mutex mutex_;
+    std::map<std::string, Connection, std::less<>> connections_;
+    Clock::time_point last_rebalance_ = Clock::now();
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//--------------------------------------------------------------------
+// FIRST ARRIVAL ARBITER: several connections carry the same stream; the
+// first copy of each sequence id wins, later copies are dropped. Lock
+// free, so legs on different io threads never wait on each other.
+//
+// When a duplicate carries an id that won recently, the arbiter records
+// how far behind the winner it arrived. That is each leg's lag. Partial
+// depth snapshots are sampled per connection, so their ids rarely match
+// exactly; diff depth and trades match one to one.
+//--------------------------------------------------------------------
+class FirstArrivalArbiter {
+public:
+    static constexpr std::size_t kMaxLegs = 8;
+    static constexpr std::size_t kHistory = 4096;   // Winning ids kept for lag matching
+
+    struct LegStats {
+        uint64_t wins = 0;
+        uint64_t duplicates = 0;
+        uint64_t lag_samples = 0;
+        double mean_lag_ns = 0.0;
+        uint64_t max_lag_ns = 0;
+    };
+
+    explicit FirstArrivalArbiter(std::size_t legs);
+
+    // True if `id` is newer than anything accepted so far
+    bool accept(std::size_t leg, uint64_t id, uint64_t arrival_ns) noexcept;
+
+    [[nodiscard]] LegStats stats(std::size_t leg) const noexcept;
+    [[nodiscard]] uint64_t last_id() const noexcept { return last_id_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::size_t legs() const noexcept { return legs_; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> id{0};
+        std::atomic<uint64_t> first_ns{0};
+    };
+
+    struct alignas(64) LegCounters {
+        std::atomic<uint64_t> wins{0};
+        std::atomic<uint64_t> duplicates{0};
+        std::atomic<uint64_t> lag_samples{0};
+        std::atomic<uint64_t> lag_sum_ns{0};
+        std::atomic<uint64_t> max_lag_ns{0};
+    };
+
+    std::size_t legs_;
+    alignas(64) std::atomic<uint64_t> last_id_{0};
+    std::array<LegCounters, kMaxLegs> counters_;
+    std::unique_ptr<Slot[]> history_;
+};
@@ -0,0 +1,121 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------------------------
+// HANDLER MEMORY: a few fixed slots that asio/beast operation state is
+// carved from instead of the heap. A read loop allocates and frees the
+// same handful of op objects every cycle, so after the first frame
+// every allocation lands in a slot it already used.
+//
+// Slots are claimed with an atomic flag: asio may free an op on a
+// different thread than the one that allocated it.
+//--------------------------------------------------------------------
+class HandlerMemory {
+public:
+    static constexpr std::size_t kSlotSize = 1024;
+    static constexpr std::size_t kSlots = 4;   // websocket -> tls -> tcp nesting
+
+    HandlerMemory() = default;
+    HandlerMemory(const HandlerMemory&) = delete;
+    HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+    void* allocate(std::size_t size) {
+        if (size <= kSlotSize) {
+            for (std::size_t i = 0; i < kSlots; ++i) {
+                if (!in_use_[i].exchange(true, std::memory_order_acquire)) {
+                    return slots_[i].bytes;
+                }
+            }
+        }
+        fallbacks_.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    void deallocate(void* p) noexcept {
+        for (std::size_t i = 0; i < kSlots; ++i) {
+            if (p == slots_[i].bytes) {
+                in_use_[i].store(false, std::memory_order_release);
+                return;
+            }
+        }
+        ::operator delete(p);
+    }
+
+    // Allocations that did not fit a slot and went to the heap
+    [[nodiscard]] uint64_t fallbacks() const noexcept {
+        return fallbacks_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        alignas(std::max_align_t) std::byte bytes[kSlotSize];
+    };
+
+    std::array<Slot, kSlots> slots_{};
+    std::array<std::atomic<bool>, kSlots> in_use_{};
+    std::atomic<uint64_t> fallbacks_{0};
+};
+
+// Minimal allocator over HandlerMemory; asio rebinds it per op type
+template <class T>
+class HandlerAllocator {
+public:
+    using value_type = T;
+
+    explicit HandlerAllocator(HandlerMemory& memory) noexcept : memory_(&memory) {}
+
+    template <class U>
+    HandlerAllocator(const HandlerAllocator<U>& other) noexcept : memory_(other.memory_) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(memory_->allocate(sizeof(T) * n));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        memory_->deallocate(p);
+    }
+
+    template <class U>
+    bool operator==(const HandlerAllocator<U>& other) const noexcept {
+        return memory_ == other.memory_;
+    }
+
+private:
+    template <class> friend class HandlerAllocator;
+    HandlerMemory* memory_;
+};
+
+// Wraps a completion handler so every op along its async chain allocates
+// from `memory` (found through asio's associated_allocator)
+template <class Handler>
+class RecyclingHandler {
+public:
+    using allocator_type = HandlerAllocator<Handler>;
+
+    RecyclingHandler(HandlerMemory& memory, Handler handler)
+        : memory_(memory), handler_(std::move(handler)) {}
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept {
+        return allocator_type(memory_);
+    }
+
+    template <class... Args>
+    void operator()(Args&&... args) {
+        handler_(std::forward<Args>(args)...);
+    }
+
+private:
+    HandlerMemory& memory_;
+    Handler handler_;
+};
+
+template <class Handler>
+[[nodiscard]] RecyclingHandler<std::decay_t<Handler>> recycling(HandlerMemory& memory, Handler&& handler) {
+    return RecyclingHandler<std::decay_t<Handler>>(memory, std::forward<Handler>(handler));
+}
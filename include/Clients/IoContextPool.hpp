@@ -0,0 +1,45 @@
+#pragma once
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+//--------------------------------------------------------------------
+// IO CONTEXT POOL: one io_context per thread, each thread optionally
+// pinned. A connection lives entirely on one context, so its handlers
+// are serialized without a strand. TLS and parsing for different
+// connections then run on different cores.
+//--------------------------------------------------------------------
+class IoContextPool {
+public:
+    // cpus[i] pins thread i; a missing entry or -1 leaves it unpinned
+    explicit IoContextPool(std::size_t size, std::vector<int> cpus = {});
+    ~IoContextPool();
+
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+
+    void start();
+    // Drops the work guards and joins; pending handlers are abandoned
+    void stop();
+
+    [[nodiscard]] std::size_t size() const noexcept { return workers_.size(); }
+    [[nodiscard]] boost::asio::io_context& context(std::size_t index) noexcept {
+        return workers_[index]->ioc;
+    }
+
+private:
+    using WorkGuard = boost::asio::executor_work_guard<boost::asio::io_context::executor_type>;
+
+    struct Worker {
+        boost::asio::io_context ioc{1};   // Hint: exactly one thread runs it
+        std::optional<WorkGuard> work;
+        std::thread thread;
+        int cpu = -1;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    bool running_ = false;
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Clients/BinanceWSClient.hpp"
+#include "Clients/FirstArrivalArbiter.hpp"
+
+//--------------------------------------------------------------------
+// REDUNDANT FEED: hot-standby connections for one symbol. Every leg
+// streams the same depth (and trades, with a tape attached). A frame is
+// applied only if its sequence id is newer than anything already seen,
+// so a leg that drops and backs off costs nothing while another is up.
+//
+// All legs run on one io_context. Winners are then applied in arrival
+// order on a single thread. Spread feeds over an IoContextPool, not legs.
+//--------------------------------------------------------------------
+class RedundantFeed {
+public:
+    static constexpr std::size_t kDefaultLegs = 2;
+
+    RedundantFeed(
+        net::io_context& ioc,
+        ssl::context& ctx,
+        const std::string& symbol,
+        std::size_t legs = kDefaultLegs,
+        int depth_level = 20,
+        const std::string& update_speed = "100ms"
+    );
+    ~RedundantFeed();
+
+    RedundantFeed(const RedundantFeed&) = delete;
+    RedundantFeed& operator=(const RedundantFeed&) = delete;
+
+    // Both see winning frames only. Call before start().
+    void on_depth(BinanceWSClient::DepthHandler handler);
+    void attach_trade_tape(TradeTape& tape);
+
+    // Every leg connects here instead of Binance, e.g. to the local
+    // exchange simulator. Call before start().
+    void set_endpoint(const std::string& host, const std::string& port);
+
+    void start();
+    void stop();
+
+    [[nodiscard]] std::size_t legs() const noexcept { return legs_.size(); }
+    [[nodiscard]] bool connected() const;          // At least one leg is up
+    [[nodiscard]] std::size_t connected_legs() const;
+
+    // Wins, duplicates and lag behind the winner, per leg
+    [[nodiscard]] FirstArrivalArbiter::LegStats depth_stats(std::size_t leg) const noexcept;
+    [[nodiscard]] FirstArrivalArbiter::LegStats trade_stats(std::size_t leg) const noexcept;
+
+    // Bumped after every winning depth frame
+    DataNotifier& notifier() noexcept;
+
+private:
+    struct Shared;   // Arbiters, handler and notifier; outlives in-flight frames
+    std::shared_ptr<Shared> shared_;
+    std::vector<std::unique_ptr<BinanceWSClient>> legs_;
+    bool started_ = false;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// How a consumer parks while waiting for new data
+enum class WaitPolicy : uint8_t {
+    BusySpin,        // Never sleeps; for a consumer pinned to an isolated core
+    SpinThenFutex,   // Spin briefly, then sleep in the kernel until notified
+    EventFd          // Block on an eventfd that can also sit in an epoll set
+};
+
+//--------------------------------------------------------------------
+// DATA NOTIFIER: single sequence word bumped by the producer on every
+// update. The producer only pays for a syscall when someone is actually
+// asleep on the futex or waiting on the eventfd.
+//--------------------------------------------------------------------
+class DataNotifier {
+public:
+    static constexpr uint32_t kDefaultSpins = 4096;
+
+    DataNotifier() = default;
+    ~DataNotifier();
+
+    DataNotifier(const DataNotifier&) = delete;
+    DataNotifier& operator=(const DataNotifier&) = delete;
+
+    // Producer side
+    void notify() noexcept;
+
+    // Consumer side. Returns the current sequence, which differs from
+    // `seen` unless the timeout expired.
+    [[nodiscard]] uint32_t sequence() const noexcept {
+        return seq_.load(std::memory_order_acquire);
+    }
+    uint32_t wait(uint32_t seen,
+                  WaitPolicy policy,
+                  std::chrono::nanoseconds timeout = std::chrono::milliseconds(100),
+                  uint32_t spins = kDefaultSpins) noexcept;
+
+    // Lazily created. notify() only writes it while someone waits on it:
+    // wait(EventFd) registers itself, and callers that epoll the fd
+    // themselves hold watch_event() for as long as they do, then call
+    // consume_event() after each wakeup.
+    [[nodiscard]] int event_fd() noexcept;
+    void watch_event() noexcept { event_waiters_.fetch_add(1, std::memory_order_seq_cst); }
+    void unwatch_event() noexcept { event_waiters_.fetch_sub(1, std::memory_order_relaxed); }
+    void consume_event() noexcept;
+
+private:
+    uint32_t spin(uint32_t seen, uint32_t spins) const noexcept;
+    uint32_t futex_wait(uint32_t seen, std::chrono::nanoseconds timeout) noexcept;
+    uint32_t eventfd_wait(uint32_t seen, std::chrono::nanoseconds timeout) noexcept;
+
+    alignas(64) std::atomic<uint32_t> seq_{0};
+    alignas(64) std::atomic<uint32_t> sleepers_{0};
+    std::atomic<uint32_t> event_waiters_{0};
+    std::atomic<int> event_fd_{-1};
+};
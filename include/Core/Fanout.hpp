@@ -0,0 +1,100 @@
+#pragma once
+#include "Core/ShmRing.hpp"
+#include "Core/TradingPipeline.hpp"
+#include "Utils/Metrics.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+//--------------------------------------------------------------------
+// FANOUT PUBLISHER: one process runs the feed and the book, every
+// strategy process on the box subscribes to its events instead of
+// opening exchange connections of its own.
+//
+// Two transports per stream:
+//   shm  /dev/shm/ocean-<stream>, a ShmRing. publish() is one slot write.
+//   zmq  optional PUB socket for consumers that can live with a hop
+//        through the kernel. A bridge thread reads the ring like any
+//        other subscriber and sends [topic][FanoutEvent] messages, so a
+//        slow network never reaches the publishing thread.
+//
+// The writer never waits on readers. check_readers() compares each
+// reader's posted position against the head and reports the ones that
+// fell behind or were lapped; call it from a cold path. The bridge holds
+// a reader slot of its own but is reported apart from the subscribers.
+//--------------------------------------------------------------------
+class FanoutPublisher {
+public:
+    struct Config {
+        std::string stream;                 // e.g. "btcusdt.book"; names the ring, topic and metrics
+        std::string ring_path;              // Empty: /dev/shm/ocean-<stream>
+        std::size_t ring_capacity = 1 << 16;
+        std::size_t max_readers = 32;
+        std::string zmq_endpoint;           // e.g. "tcp://127.0.0.1:5556", or port * for any; empty: shm only
+        int zmq_hwm = 100'000;              // Messages queued per subscriber before the bridge drops
+        uint64_t max_lag = 1 << 14;         // Readers further behind are reported slow
+    };
+
+    // Throws std::runtime_error if the ring or the socket can't be set up
+    explicit FanoutPublisher(Config cfg);
+    ~FanoutPublisher();
+
+    FanoutPublisher(const FanoutPublisher&) = delete;
+    FanoutPublisher& operator=(const FanoutPublisher&) = delete;
+
+    // Single publishing thread
+    void publish(const FanoutEvent& event) noexcept {
+        ring_.publish(event);
+        published_metric_.add();
+    }
+
+    // BookStrategy: lets TradingPipeline<FanoutPublisher> drive the ring
+    void on_book(const BookEvent& event) noexcept { publish(book_event(event)); }
+
+    // Matches the MarketData trade handler
+    void on_trade(uint64_t ts_ns, float price, float amount, bool is_buy) noexcept {
+        publish(trade_event(ts_ns, price, amount, is_buy));
+    }
+
+    // Logs readers, the bridge included, that are more than max_lag behind
+    // or lost events since the last call; returns how many. Cold path.
+    std::size_t check_readers();
+
+    [[nodiscard]] uint64_t published() const noexcept { return ring_.published(); }
+    // Subscribers attached to the ring, not counting the bridge
+    [[nodiscard]] std::vector<ShmRingWriter::ReaderState> readers() const;
+    // The bridge's reader; nullopt without a zmq endpoint
+    [[nodiscard]] std::optional<ShmRingWriter::ReaderState> bridge() const;
+    [[nodiscard]] const std::string& ring_path() const noexcept { return ring_path_; }
+    // The endpoint the PUB socket bound, with any wildcard port resolved; empty without zmq
+    [[nodiscard]] const std::string& zmq_endpoint() const noexcept { return zmq_bound_; }
+
+    [[nodiscard]] static FanoutEvent book_event(const BookEvent& event) noexcept;
+    [[nodiscard]] static FanoutEvent trade_event(uint64_t ts_ns, float price, float amount, bool is_buy) noexcept;
+
+private:
+    void bridge_loop(std::stop_token st);
+
+    Config cfg_;
+    std::string ring_path_;
+    ShmRingWriter ring_;
+
+    // zmq, bridge thread only after construction
+    void* zmq_context_ = nullptr;
+    void* zmq_socket_ = nullptr;
+    std::string zmq_bound_;
+    std::unique_ptr<ShmRingReader> bridge_reader_;
+    std::jthread bridge_thread_;
+
+    std::unordered_map<uint32_t, uint64_t> reported_lost_;   // Reader slot -> lost at last check
+
+    Metrics::Counter published_metric_;
+    Metrics::Counter zmq_sent_metric_;
+    Metrics::Counter zmq_dropped_metric_;
+    Metrics::Gauge readers_metric_;
+    Metrics::Gauge slow_readers_metric_;
+    Metrics::Gauge bridge_lag_metric_;
+};
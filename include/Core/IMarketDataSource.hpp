@@ -2,6 +2,7 @@
 #include <span>
 #include <atomic>
 #include "OrderBook.hpp"
+#include "DataNotifier.hpp"
 
 class IMarketDataSource {
 public:
@@ -9,6 +10,10 @@ public:
     virtual bool start() noexcept = 0;
     virtual void stop() noexcept = 0;
     virtual ~IMarketDataSource() = default;
+
+    // Bumped on every new batch; consumers wait on it instead of polling
+    DataNotifier& notifier() noexcept { return notifier_; }
 protected:
     IMarketDataSource() = default;
+    DataNotifier notifier_;
 };
\ No newline at end of file
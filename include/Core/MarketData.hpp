@@ -12,10 +12,17 @@
 #include <chrono>
 #include <random>
 #include <array>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
 
 #include "OrderBook.hpp"
+#include "DataNotifier.hpp"
+#include "Utils/HugePageArena.hpp"
+#include "Utils/Metrics.hpp"
 
 class OrderBook; // Forward declaration
+class TradeTape;
 
 class MarketData {
 public:
@@ -24,6 +31,10 @@ public:
     struct BinMessage;
     struct BinOrder;
 
+    // Frames with kTradeMagic carry prints: BinOrder.side is the aggressor
+    static constexpr uint32_t kBookMagic = 0xDEADBEEF;
+    static constexpr uint32_t kTradeMagic = 0xDEADCAFE;
+
     #pragma pack(push, 1)
     struct BinMessage {
         uint32_t magic = 0xDEADBEEF;  // Network byte order
@@ -38,6 +49,9 @@ public:
     };
 #pragma pack(pop)
 
+    // First byte covered by BinMessage::crc32
+    static constexpr size_t kCrcOffset = offsetof(BinMessage, timestamp);
+
     explicit MarketData(std::string_view endpoint, uint16_t port = 443);
     ~MarketData();
 
@@ -48,14 +62,42 @@ public:
     // Thread-safe interface
     bool start() noexcept;
     void stop() noexcept;
+    // Book levels received since the last call, each batch handed out
+    // once: a wakeup that only carried trades reads an empty span. One
+    // consumer thread; the span stays valid until its next call.
     std::span<const OrderBook::Order> get_updates() noexcept;
+    // Level count of each book frame in the batch get_updates() last
+    // returned, in arrival order; they sum to its size. Same thread and
+    // lifetime as that span.
+    std::span<const uint16_t> frame_sizes() const noexcept { return reading_frames_; }
+
+    // Alternative to start(): drive the socket from the caller's thread.
+    // Waits up to timeout_ms for readability, then handles one read.
+    void poll(int timeout_ms = 0) noexcept;
+
+    // Trade frames are appended here from the io thread; attach before start()
+    void attach_trade_tape(TradeTape& tape) noexcept;
+
+    // Called on the io thread for every print, after the tape; set before start()
+    using TradeHandler = std::function<void(uint64_t ts_ns, float price, float amount, bool is_buy)>;
+    void set_trade_handler(TradeHandler handler) noexcept;
+
+    // Bumped after every accepted frame (book or trades)
+    DataNotifier& notifier() noexcept { return notifier_; }
 
 private:
     void io_thread() noexcept;
+    // Consumes every complete frame at the front of rx_; returns bytes used
+    size_t drain_frames(std::pmr::vector<OrderBook::Order>& book_orders,
+                        std::pmr::vector<uint16_t>& frame_sizes) noexcept;
+    void drop_connection(int fd) noexcept;
     bool try_connect() noexcept;
     uint32_t calculate_crc32(const void* data, size_t length) const noexcept;
     void apply_backoff() noexcept;
 
+    // Receive buffer and order batches; only the io thread allocates
+    HugePageArena arena_{HugePageArena::Config{.name = "marketdata"}};
+
     // Connection state
     std::atomic<int> fd_{-1};
     std::string endpoint_;
@@ -64,10 +106,32 @@ private:
     std::atomic<uint16_t> port_;
     std::jthread io_thread_;
 
-    // Data buffer
-    std::vector<OrderBook::Order> buffer_;
-    std::atomic<size_t> buffer_size_{0};
-    std::mutex buffer_mutex_;  // Protects buffer_ and buffer_size_
+    // Bytes received but not yet framed; TCP may split or coalesce frames
+    std::pmr::vector<std::byte> rx_{&arena_};
+    size_t rx_len_ = 0;
+
+    // Order batches, rotated by swapping so all three keep their capacity.
+    // pending_ collects one read's orders (io thread), buffer_ holds the
+    // batch not yet taken, reading_ the one the consumer's span points
+    // into; the io thread never touches reading_.
+    std::pmr::vector<OrderBook::Order> pending_{&arena_};
+    std::pmr::vector<OrderBook::Order> buffer_{&arena_};
+    std::pmr::vector<OrderBook::Order> reading_{&arena_};
+    // Level count per book frame, rotated alongside the batch it describes
+    std::pmr::vector<uint16_t> pending_frames_{&arena_};
+    std::pmr::vector<uint16_t> buffer_frames_{&arena_};
+    std::pmr::vector<uint16_t> reading_frames_{&arena_};
+    std::mutex buffer_mutex_;  // Protects buffer_*, and the swap into reading_*
+    TradeTape* trade_tape_ = nullptr;
+    TradeHandler trade_handler_;
+    DataNotifier notifier_;
+
+    // Exported as ocean_feed_*{endpoint="host:port"}
+    Metrics::Counter frames_metric_;
+    Metrics::Counter bytes_metric_;
+    Metrics::Counter crc_errors_metric_;
+    Metrics::Counter resyncs_metric_;
+    Metrics::Counter disconnects_metric_;
 
     // Backoff state
     std::atomic<uint32_t> reconnect_attempts_{0};
@@ -76,6 +140,7 @@ private:
 
     // Constants
     static constexpr size_t kRecvBufferSize = 8192;
+    static constexpr size_t kMaxFrameSize = sizeof(BinMessage) + UINT16_MAX * sizeof(BinOrder);
     static constexpr uint32_t kMaxBackoffMs = 5000;
     static constexpr uint32_t kBaseBackoffMs = 100;
 };
\ No newline at end of file
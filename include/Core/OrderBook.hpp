@@ -2,9 +2,14 @@
 #include <stdfloat>       // C++23 fixed-width floats
 #include <vector>
 #include <map>
+#include <memory_resource>
+#include <optional>
 #include <shared_mutex>
+#include <span>
 #include <immintrin.h>
 
+#include "Utils/HugePageArena.hpp"
+
 class OrderBook {
 public:
     struct Order {
@@ -13,12 +18,43 @@ public:
         bool is_bid;
     };
 
+    // Everything the per-tick strategy pass reads, taken under one lock
+    struct Snapshot {
+        float best_bid = 0.0f;
+        float best_ask = 0.0f;
+        float mid = 0.0f;
+        float bid_volume = 0.0f;
+        float ask_volume = 0.0f;
+        float bid_depth = 0.0f;   // Within the near-BBO band
+        float ask_depth = 0.0f;
+    };
+
+    // Level nodes come from a small arena of the book's own; every node
+    // allocation and free happens under the writer lock
+    OrderBook();
+    // Level nodes come from `levels` instead, e.g. one HugePageArena for
+    // all the books a single thread writes. Must outlive the book.
+    explicit OrderBook(std::pmr::memory_resource* levels);
+
+    OrderBook(const OrderBook&) = delete;
+    OrderBook& operator=(const OrderBook&) = delete;
+
     // New methods to get volumes
     [[nodiscard]] float total_bid_volume() const noexcept;
     [[nodiscard]] float total_ask_volume() const noexcept;
     [[nodiscard]]  float get_mid_price() const noexcept;
-    void update(const std::vector<Order>& orders) noexcept;
+    // Diff stream: adds each amount to its level, drops levels at or below zero
+    void update(std::span<const Order> orders) noexcept;
+    // Partial-depth snapshot (e.g. @depth20): both sides become exactly
+    // `levels`, which are absolute amounts
+    void apply_snapshot(std::span<const Order> levels) noexcept;
     [[nodiscard]] std::pair<float, float> get_bbo() const noexcept;
+    // Resting amount within `band` (fraction of price) of each best level
+    [[nodiscard]] std::pair<float, float> depth_near_bbo(float band) const noexcept;
+    [[nodiscard]] Snapshot snapshot(float band) const noexcept;
+
+    // Of the arena the levels live in, shared or not; zero for other resources
+    [[nodiscard]] HugePageArena::Stats memory_stats() const noexcept;
 
 private:
     struct PriceLevel {
@@ -26,7 +62,14 @@ private:
         int order_count{0};
     };
 
-    using BookSide = std::map<std::float32_t, PriceLevel>;
-    alignas(64) BookSide bids_, asks_;
+    // A depth-20 book holds a few KB of nodes: 64 KB of plain pages, not a
+    // 2 MB chunk per book
+    static constexpr std::size_t kOwnArenaBytes = 64 << 10;
+
+    using BookSide = std::pmr::map<std::float32_t, PriceLevel>;
+    std::optional<HugePageArena> own_arena_;   // Only when no resource was given
+    std::pmr::memory_resource* levels_;
+    alignas(64) BookSide bids_{levels_};
+    BookSide asks_{levels_};
     mutable std::shared_mutex mtx_;
 };
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include "Core/DataNotifier.hpp"
+#include <cstdint>
+#include <string>
+
+// Placement and polling for one pipeline thread
+struct StageConfig {
+    int cpu = -1;                                  // -1 = let the scheduler decide
+    WaitPolicy wait = WaitPolicy::SpinThenFutex;
+    uint32_t spins = DataNotifier::kDefaultSpins;  // Spin budget before parking
+    std::size_t ring_size = 4096;                  // Input ring (unused by the feed stage)
+};
+
+// Publisher mode (OceanMain --publish): where the events go
+struct FanoutConfig {
+    std::string stream = "btcusdt";       // Rings /dev/shm/ocean-<stream>.book and .trade
+    std::size_t ring_capacity = 1 << 16;  // Events per ring
+    std::string zmq_endpoint;             // Book PUB socket; empty: shm only
+    std::string zmq_trade_endpoint;       // Trade PUB socket; empty: shm only
+    uint64_t max_lag = 1 << 14;           // Readers further behind are reported slow
+};
+
+struct PipelineConfig {
+    std::string endpoint = "127.0.0.1";
+    uint16_t port = 1337;
+    StageConfig feed;
+    StageConfig book;
+    StageConfig strategy;
+    FanoutConfig fanout;
+};
+
+// JSON file, e.g.
+//   { "endpoint": "127.0.0.1", "port": 1337,
+//     "stages": { "feed":     { "cpu": 2, "wait": "busy_spin" },
+//                 "book":     { "cpu": 3, "wait": "busy_spin", "ring_size": 8192 },
+//                 "strategy": { "cpu": 4, "wait": "spin_then_futex", "spins": 20000 } },
+//     "fanout": { "stream": "btcusdt", "zmq_endpoint": "tcp://127.0.0.1:5556" } }
+// Missing keys keep their defaults. Throws std::runtime_error on bad input.
+PipelineConfig load_pipeline_config(const std::string& path);
@@ -0,0 +1,133 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Normalized market event, the unit of fan-out. Fixed size, no pointers:
+// it is copied as is into shared memory and onto the wire.
+struct FanoutEvent {
+    enum class Kind : uint8_t { Book = 1, Trade = 2 };
+
+    uint64_t ts_ns = 0;          // Book: receive time, steady clock. Trade: frame timestamp
+    Kind kind = Kind::Book;
+    uint8_t is_buy = 0;          // Trade: aggressor side
+    uint16_t symbol_id = 0;
+    uint32_t update_count = 0;   // Book: level updates in the frame
+    float best_bid = 0.0f;       // Book fields
+    float best_ask = 0.0f;
+    float mid = 0.0f;
+    float bid_volume = 0.0f;
+    float ask_volume = 0.0f;
+    float bid_depth = 0.0f;
+    float ask_depth = 0.0f;
+    float update_volume = 0.0f;
+    float price = 0.0f;          // Trade fields
+    float amount = 0.0f;
+};
+static_assert(sizeof(FanoutEvent) == 56);
+
+//--------------------------------------------------------------------
+// SHM RING: one writer, any number of reader processes, over a file in
+// /dev/shm. Every reader sees every event (broadcast, not a work queue).
+//
+// The writer never waits for anyone. Each slot is a seqlock: the writer
+// marks it busy, stores the event and publishes the slot's sequence. A
+// reader copies the event and re-checks the sequence. A reader a whole
+// ring behind finds its slot already rewritten: poll() returns Lapped
+// with the loss counted, and the reader skips to half a ring behind the
+// writer. Readers also post their position in a registry, so the writer
+// can name who is falling behind without waiting for them.
+//
+// Sleeping readers park on a shared futex. The writer only makes the
+// wake syscall while one is actually asleep. Each sleeper also flags its
+// registry slot, so one killed in its sleep is taken off the count by
+// readers() rather than costing a syscall on every publish.
+//--------------------------------------------------------------------
+namespace ShmRingLayout {
+struct Header;
+struct ReaderSlot;
+struct Slot;
+}
+
+class ShmRingWriter {
+public:
+    struct Config {
+        std::string path;                 // e.g. /dev/shm/ocean-btcusdt-book
+        std::size_t capacity = 1 << 16;   // Events; rounded up to a power of two
+        std::size_t max_readers = 32;
+    };
+
+    struct ReaderState {
+        uint32_t slot;       // Index in the reader registry, see ShmRingReader::slot()
+        uint32_t pid;
+        uint64_t position;   // Next sequence the reader will take
+        uint64_t lag;        // Events published but not yet read
+        uint64_t lost;       // Lost to laps so far
+        bool alive;
+    };
+
+    // Replaces any file at the path; throws std::runtime_error
+    explicit ShmRingWriter(const Config& cfg);
+    ~ShmRingWriter();   // Marks the ring closed and unlinks it; readers keep their mapping
+
+    ShmRingWriter(const ShmRingWriter&) = delete;
+    ShmRingWriter& operator=(const ShmRingWriter&) = delete;
+
+    void publish(const FanoutEvent& event) noexcept;
+
+    [[nodiscard]] uint64_t published() const noexcept { return next_; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+    // Attached readers; cold path, for monitoring. Also gives back the
+    // sleeper count of readers that died waiting.
+    [[nodiscard]] std::vector<ReaderState> readers() const;
+    [[nodiscard]] uint32_t sleepers() const noexcept;
+
+private:
+    std::string path_;
+    std::size_t bytes_ = 0;
+    std::byte* map_ = nullptr;
+    ShmRingLayout::Header* header_ = nullptr;
+    ShmRingLayout::ReaderSlot* readers_ = nullptr;
+    ShmRingLayout::Slot* slots_ = nullptr;
+    uint64_t mask_ = 0;
+    uint64_t next_ = 0;
+};
+
+class ShmRingReader {
+public:
+    enum class Status : uint8_t { Ok, Empty, Lapped, Closed };
+
+    // Starts at the newest event; throws std::runtime_error if the ring
+    // is missing or every reader slot is taken
+    explicit ShmRingReader(const std::string& path);
+    ~ShmRingReader();   // Frees the reader slot
+
+    ShmRingReader(const ShmRingReader&) = delete;
+    ShmRingReader& operator=(const ShmRingReader&) = delete;
+
+    // Ok fills `out`. Lapped means events were overwritten before we got
+    // to them; lost() grew and the next poll() resumes further on.
+    [[nodiscard]] Status poll(FanoutEvent& out) noexcept;
+
+    // Spins, then sleeps until the writer publishes or `timeout` passes
+    void wait(std::chrono::nanoseconds timeout, uint32_t spins = 4096) noexcept;
+
+    [[nodiscard]] uint64_t position() const noexcept { return position_; }
+    [[nodiscard]] uint64_t lost() const noexcept { return lost_; }
+    [[nodiscard]] uint32_t slot() const noexcept { return slot_index_; }
+
+private:
+    std::size_t bytes_ = 0;
+    std::byte* map_ = nullptr;
+    ShmRingLayout::Header* header_ = nullptr;
+    ShmRingLayout::ReaderSlot* slot_ = nullptr;
+    ShmRingLayout::Slot* slots_ = nullptr;
+    uint64_t mask_ = 0;
+    uint64_t position_ = 0;
+    uint64_t lost_ = 0;
+    uint32_t slot_index_ = 0;
+};
@@ -0,0 +1,8 @@
+#pragma once
+#include <string_view>
+
+// Pin the calling thread to one CPU. cpu < 0 leaves affinity untouched.
+bool pin_current_thread(int cpu) noexcept;
+
+// Shows up in top/perf; truncated to the kernel's 15 characters
+void name_current_thread(std::string_view name) noexcept;
@@ -0,0 +1,103 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <shared_mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+//--------------------------------------------------------------------
+// TRADE TAPE: per-symbol ring of timestamped prints. Running volume and
+// notional totals make any time-range sum a difference of two slots;
+// a min/max segment tree over the ring answers range extremes.
+// One writer (the feed thread), any number of readers.
+//--------------------------------------------------------------------
+class TradeTape {
+public:
+    struct Print {
+        uint64_t ts_ns;
+        float price;
+        float amount;
+        bool is_buy;    // Aggressor side
+    };
+
+    struct WindowStats {
+        std::size_t count = 0;
+        double volume = 0.0;
+        double notional = 0.0;
+        float vwap = 0.0f;
+        float high = 0.0f;
+        float low = 0.0f;
+    };
+
+    // A trailing window and the history before it, read in one go
+    struct TrailingStats {
+        WindowStats recent;         // The last span, ending at the newest print
+        WindowStats baseline;       // Up to `windows` spans before it
+        uint64_t baseline_ns = 0;   // How much of the baseline the tape holds; short after a start
+    };
+
+    // Capacity is rounded up to a power of two and allocated once
+    explicit TradeTape(std::size_t capacity = 1 << 16);
+
+    // Timestamps are clamped to be non-decreasing so lookups stay sorted
+    void append(uint64_t ts_ns, float price, float amount, bool is_buy) noexcept;
+
+    // Inclusive time range [from_ns, to_ns]; O(log n)
+    [[nodiscard]] WindowStats window(uint64_t from_ns, uint64_t to_ns) const noexcept;
+
+    // Trailing window ending at the newest print
+    [[nodiscard]] WindowStats last(std::chrono::nanoseconds span) const noexcept;
+
+    // last(span) plus the `windows` spans before it, under one reader lock,
+    // so an append between the two can't shift one window against the other
+    [[nodiscard]] TrailingStats trailing(std::chrono::nanoseconds span, std::size_t windows) const noexcept;
+
+    // Prints in [from_ns, to_ns] as at most two contiguous pieces (ring wrap).
+    // Views into the ring: only valid while the caller holds off the writer,
+    // i.e. on the feeding thread.
+    [[nodiscard]] std::pair<std::span<const Print>, std::span<const Print>>
+    prints(uint64_t from_ns, uint64_t to_ns) const noexcept;
+
+    // Visits the prints appended since sequence number `cursor`, oldest
+    // first, and advances it. Prints the ring already overwrote are
+    // skipped. Runs under the reader lock: `visit` must not append here.
+    template <typename Visit>
+    void read_since(uint64_t& cursor, Visit&& visit) const {
+        std::shared_lock lock(mtx_);
+        cursor = std::max(cursor, head_ - std::min<uint64_t>(head_, ring_.size()));
+        for (; cursor < head_; ++cursor) visit(ring_[cursor & mask_]);
+    }
+
+    // Sequence number the next print will get; a cursor starting here
+    // reads only what arrives from now on
+    [[nodiscard]] uint64_t sequence() const noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+    [[nodiscard]] std::size_t capacity() const noexcept { return ring_.size(); }
+    [[nodiscard]] uint64_t latest_ns() const noexcept;
+    // Oldest print still in the ring; 0 when empty
+    [[nodiscard]] uint64_t oldest_ns() const noexcept;
+
+private:
+    struct Extremes {
+        float low;
+        float high;
+    };
+
+    // Sequence range [first, last) of prints inside [from_ns, to_ns]
+    std::pair<uint64_t, uint64_t> locate(uint64_t from_ns, uint64_t to_ns) const noexcept;
+    WindowStats stats(uint64_t first, uint64_t last) const noexcept;
+    Extremes extremes(std::size_t lo, std::size_t hi) const noexcept; // Slot range [lo, hi)
+
+    std::vector<Print> ring_;
+    std::vector<double> cum_volume_;    // Running totals through each print
+    std::vector<double> cum_notional_;
+    std::vector<Extremes> tree_;        // Segment tree, leaves at [capacity, 2*capacity)
+    std::size_t mask_;
+    uint64_t head_ = 0;                 // Sequence number of the next print
+    double total_volume_ = 0.0;
+    double total_notional_ = 0.0;
+    mutable std::shared_mutex mtx_;
+};
@@ -0,0 +1,218 @@
+#pragma once
+#include "Core/DataNotifier.hpp"
+#include "Core/MarketData.hpp"
+#include "Core/OrderBook.hpp"
+#include "Core/PipelineConfig.hpp"
+#include "Core/ThreadAffinity.hpp"
+#include <boost/lockfree/spsc_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <immintrin.h>
+#include <thread>
+#include <vector>
+
+// Per-stage counters; written only by the stage's own thread
+struct StageMetrics {
+    std::atomic<uint64_t> processed{0};        // Items consumed from the input ring
+    std::atomic<uint64_t> stalls{0};           // Pushes that found the output ring full
+    std::atomic<uint64_t> queue_depth{0};      // Input ring occupancy after the last pop
+    std::atomic<uint64_t> max_queue_depth{0};
+};
+
+// feed-decode -> book-build: one level update
+struct FeedEvent {
+    OrderBook::Order order;
+    uint64_t recv_ns;
+    bool end_of_frame;
+};
+
+// book-build -> strategy: the book after one whole frame was applied
+struct BookEvent {
+    uint64_t recv_ns;
+    OrderBook::Snapshot book;
+    float update_volume;
+    uint32_t update_count;
+};
+
+template <typename S>
+concept BookStrategy = requires(S strategy, const BookEvent& event) {
+    strategy.on_book(event);
+};
+
+//--------------------------------------------------------------------
+// TRADING PIPELINE: feed-decode -> book-build -> strategy, one thread
+// each, joined by bounded lock-free SPSC rings. Core, wait policy and
+// ring size per stage come from PipelineConfig.
+//--------------------------------------------------------------------
+template <BookStrategy Strategy>
+class TradingPipeline {
+public:
+    static constexpr float kDepthBand = 0.001f; // 10 bps around the BBO
+
+    TradingPipeline(const PipelineConfig& cfg, MarketData& market, OrderBook& book, Strategy& strategy)
+        : cfg_(cfg), market_(market), book_(book), strategy_(strategy),
+          feed_ring_(cfg.book.ring_size), book_ring_(cfg.strategy.ring_size) {
+        batch_.reserve(1024);
+    }
+
+    ~TradingPipeline() { stop(); }
+
+    TradingPipeline(const TradingPipeline&) = delete;
+    TradingPipeline& operator=(const TradingPipeline&) = delete;
+
+    // Consumers first so nothing is produced into an unread ring
+    void start() {
+        strategy_thread_ = std::jthread([this](std::stop_token st) { strategy_loop(st); });
+        book_thread_ = std::jthread([this](std::stop_token st) { book_loop(st); });
+        feed_thread_ = std::jthread([this](std::stop_token st) { feed_loop(st); });
+    }
+
+    void stop() {
+        for (auto* t : {&feed_thread_, &book_thread_, &strategy_thread_}) {
+            if (t->joinable()) {
+                t->request_stop();
+                t->join();
+            }
+        }
+    }
+
+    [[nodiscard]] const StageMetrics& feed_metrics() const noexcept { return feed_metrics_; }
+    [[nodiscard]] const StageMetrics& book_metrics() const noexcept { return book_metrics_; }
+    [[nodiscard]] const StageMetrics& strategy_metrics() const noexcept { return strategy_metrics_; }
+
+private:
+    static uint64_t now_ns() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static void enter_stage(const char* name, const StageConfig& cfg) noexcept {
+        name_current_thread(name);
+        pin_current_thread(cfg.cpu);
+    }
+
+    // Backpressure: spin until the consumer frees a slot. Never drops.
+    template <typename Ring, typename T>
+    static bool push(Ring& ring, const T& item, StageMetrics& metrics, const std::stop_token& st) noexcept {
+        if (ring.push(item)) return true;
+        metrics.stalls.fetch_add(1, std::memory_order_relaxed);
+        while (!ring.push(item)) {
+            if (st.stop_requested()) return false;
+            _mm_pause();
+        }
+        return true;
+    }
+
+    template <typename Ring>
+    static void record_pop(Ring& ring, StageMetrics& metrics) noexcept {
+        const uint64_t depth = ring.read_available();
+        metrics.processed.fetch_add(1, std::memory_order_relaxed);
+        metrics.queue_depth.store(depth, std::memory_order_relaxed);
+        if (depth > metrics.max_queue_depth.load(std::memory_order_relaxed)) {
+            metrics.max_queue_depth.store(depth, std::memory_order_relaxed);
+        }
+    }
+
+    //----------------------------------------------------------------
+    // FEED: drive the socket on this core, fan each frame into the ring
+    //----------------------------------------------------------------
+    void feed_loop(std::stop_token st) {
+        enter_stage("ocean-feed", cfg_.feed);
+        const int poll_ms = cfg_.feed.wait == WaitPolicy::BusySpin ? 0 : 1;
+        uint32_t seen = market_.notifier().sequence();
+
+        while (!st.stop_requested()) {
+            market_.poll(poll_ms);
+            const uint32_t current = market_.notifier().sequence();
+            if (current == seen) continue;
+            seen = current;
+
+            const auto updates = market_.get_updates();
+            if (updates.empty()) continue;
+
+            // A batch can hold several frames coalesced by TCP or by a slow
+            // consumer; each keeps its own boundary, so each gets a snapshot
+            const uint64_t recv = now_ns();
+            std::size_t i = 0;
+            for (const uint16_t frame : market_.frame_sizes()) {
+                for (const std::size_t end = i + frame; i < end; ++i) {
+                    const FeedEvent event{updates[i], recv, i + 1 == end};
+                    if (!push(feed_ring_, event, feed_metrics_, st)) return;
+                }
+            }
+            feed_metrics_.processed.fetch_add(1, std::memory_order_relaxed);
+            feed_ready_.notify();
+        }
+    }
+
+    //----------------------------------------------------------------
+    // BOOK: apply whole frames, publish one snapshot per frame
+    //----------------------------------------------------------------
+    void book_loop(std::stop_token st) {
+        enter_stage("ocean-book", cfg_.book);
+
+        while (!st.stop_requested()) {
+            const uint32_t seen = feed_ready_.sequence();
+            FeedEvent event;
+            if (!feed_ring_.pop(event)) {
+                feed_ready_.wait(seen, cfg_.book.wait, std::chrono::milliseconds(100), cfg_.book.spins);
+                continue;
+            }
+            record_pop(feed_ring_, book_metrics_);
+
+            batch_.push_back(event.order);
+            if (!event.end_of_frame) continue;
+
+            book_.update(batch_);
+            BookEvent out{
+                .recv_ns = event.recv_ns,
+                .book = book_.snapshot(kDepthBand),
+                .update_volume = 0.0f,
+                .update_count = static_cast<uint32_t>(batch_.size())
+            };
+            for (const auto& order : batch_) out.update_volume += order.amount;
+            batch_.clear();
+
+            if (!push(book_ring_, out, book_metrics_, st)) return;
+            book_ready_.notify();
+        }
+    }
+
+    //----------------------------------------------------------------
+    // STRATEGY: hand each book event to the strategy, in order
+    //----------------------------------------------------------------
+    void strategy_loop(std::stop_token st) {
+        enter_stage("ocean-strategy", cfg_.strategy);
+
+        while (!st.stop_requested()) {
+            const uint32_t seen = book_ready_.sequence();
+            BookEvent event;
+            if (!book_ring_.pop(event)) {
+                book_ready_.wait(seen, cfg_.strategy.wait, std::chrono::milliseconds(100), cfg_.strategy.spins);
+                continue;
+            }
+            record_pop(book_ring_, strategy_metrics_);
+            strategy_.on_book(event);
+        }
+    }
+
+    PipelineConfig cfg_;
+    MarketData& market_;
+    OrderBook& book_;
+    Strategy& strategy_;
+
+    boost::lockfree::spsc_queue<FeedEvent> feed_ring_;
+    boost::lockfree::spsc_queue<BookEvent> book_ring_;
+    DataNotifier feed_ready_;
+    DataNotifier book_ready_;
+    std::vector<OrderBook::Order> batch_;   // Book thread only
+
+    alignas(64) StageMetrics feed_metrics_;
+    alignas(64) StageMetrics book_metrics_;
+    alignas(64) StageMetrics strategy_metrics_;
+
+    std::jthread strategy_thread_;
+    std::jthread book_thread_;
+    std::jthread feed_thread_;
+};
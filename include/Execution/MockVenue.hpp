@@ -0,0 +1,62 @@
+#pragma once
+#include "Execution/OrderWire.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+//--------------------------------------------------------------------
+// MOCK VENUE: an in-process OrderTransport for tests and paper trading.
+// It decodes the gateway's wire bytes, answers every order with an ack
+// and fills it at its limit in `fill_slices` pieces, and queues the
+// reports until poll() hands them back. Nothing is matched against a
+// book, so fills say nothing about queue position or slippage.
+//--------------------------------------------------------------------
+class MockVenue {
+public:
+    struct Config {
+        bool fill = true;              // false: orders rest until canceled
+        uint32_t fill_slices = 1;      // Partial fills per order
+        bool reject_all = false;
+    };
+
+    MockVenue();
+    explicit MockVenue(Config cfg);
+
+    // OrderTransport
+    bool send(std::span<const std::byte> bytes);
+
+    // Delivers queued reports to `sink.on_report()`; returns how many
+    template <typename Sink>
+    std::size_t poll(Sink& sink) {
+        const std::size_t n = reports_.size();
+        for (const auto& report : reports_) sink.on_report(report);
+        reports_.clear();
+        return n;
+    }
+
+    void set_connected(bool connected) noexcept { connected_ = connected; }
+
+    [[nodiscard]] uint64_t messages_received() const noexcept { return messages_; }
+    [[nodiscard]] uint64_t bytes_received() const noexcept { return bytes_; }
+    [[nodiscard]] std::size_t resting() const noexcept { return resting_.size(); }
+
+private:
+    void on_new(const OrderWire::NewOrder& msg);
+    void on_cancel(const OrderWire::CancelOrder& msg);
+    void report(OrderWire::ExecType exec, uint64_t client_id, uint64_t venue_id,
+                double quantity = 0.0, double price = 0.0);
+
+    struct Resting {
+        uint64_t client_id;
+        uint64_t venue_id;
+    };
+
+    Config cfg_;
+    bool connected_ = true;
+    uint64_t next_venue_id_ = 1;
+    uint64_t messages_ = 0;
+    uint64_t bytes_ = 0;
+    std::vector<OrderWire::Report> reports_;
+    std::vector<Resting> resting_;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+
+//--------------------------------------------------------------------
+// ORDER: one working order as the gateway tracks it, and the state
+// machine it moves through. Ids are 64 bits: the high half is a slot
+// generation, the low half the slot in the OrderPool, so lookup by id
+// is an index and a stale id never matches a reused slot.
+//--------------------------------------------------------------------
+using ClientOrderId = uint64_t;
+inline constexpr ClientOrderId kNoOrder = 0;
+
+enum class OrderState : uint8_t {
+    PendingNew,       // Sent, not yet acknowledged
+    New,
+    PartiallyFilled,
+    PendingCancel,    // Cancel sent; fills may still arrive
+    Filled,
+    Canceled,
+    Rejected
+};
+
+enum class OrderEvent : uint8_t {
+    Ack,
+    Fill,             // Partial or complete, decided by the remaining quantity
+    CancelRequest,
+    CancelAck,
+    CancelReject,
+    Reject
+};
+
+struct Order {
+    ClientOrderId id = kNoOrder;
+    uint64_t venue_id = 0;
+    uint32_t symbol = 0;
+    uint32_t generation = 0;
+    OrderState state = OrderState::PendingNew;
+    bool is_buy = true;
+
+    double price = 0.0;
+    double quantity = 0.0;
+    double filled = 0.0;
+    double average_fill = 0.0;
+
+    uint64_t tick_ns = 0;   // Book update that led to the order
+    uint64_t wire_ns = 0;   // Handed to the transport
+
+    [[nodiscard]] double remaining() const noexcept { return quantity - filled; }
+};
+
+[[nodiscard]] constexpr bool is_terminal(OrderState s) noexcept {
+    return s == OrderState::Filled || s == OrderState::Canceled || s == OrderState::Rejected;
+}
+
+// Next state, or nullopt when the event is not valid in `s`. `complete`
+// says whether a fill leaves nothing remaining.
+[[nodiscard]] constexpr std::optional<OrderState> next_state(
+    OrderState s, OrderEvent e, bool complete = false, bool any_filled = false) noexcept {
+    using S = OrderState;
+    using E = OrderEvent;
+    const S after_fill = complete ? S::Filled : S::PartiallyFilled;
+
+    switch (s) {
+        case S::PendingNew:
+            if (e == E::Ack) return S::New;
+            if (e == E::Reject) return S::Rejected;
+            if (e == E::Fill) return after_fill;          // Fill can overtake the ack
+            if (e == E::CancelRequest) return S::PendingCancel;
+            break;
+        case S::New:
+        case S::PartiallyFilled:
+            if (e == E::Fill) return after_fill;
+            if (e == E::CancelRequest) return S::PendingCancel;
+            if (e == E::Ack) return s;                    // Late ack after an early fill
+            break;
+        case S::PendingCancel:
+            if (e == E::Fill) return complete ? S::Filled : S::PendingCancel;
+            if (e == E::CancelAck) return S::Canceled;
+            if (e == E::CancelReject) return any_filled ? S::PartiallyFilled : S::New;
+            if (e == E::Ack) return s;
+            if (e == E::Reject) return S::Rejected;
+            break;
+        case S::Filled:
+        case S::Canceled:
+        case S::Rejected:
+            break;
+    }
+    return std::nullopt;
+}
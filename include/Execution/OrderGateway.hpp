@@ -0,0 +1,219 @@
+#pragma once
+#include "Execution/Order.hpp"
+#include "Execution/OrderPool.hpp"
+#include "Execution/OrderWire.hpp"
+#include "Risk/PnlEngine.hpp"
+#include "Risk/RiskEngine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <span>
+
+// Anything that can put encoded order bytes on its wire. false = not
+// sent (disconnected, send buffer full); the gateway fails the order.
+template <typename T>
+concept OrderTransport = requires(T transport, std::span<const std::byte> bytes) {
+    { transport.send(bytes) } -> std::same_as<bool>;
+};
+
+//--------------------------------------------------------------------
+// ORDER GATEWAY: turns decisions into wire messages and venue reports
+// back into order state. Orders come from a fixed pool, client ids map
+// to slots in O(1), and every report is checked against the order
+// state machine. With a RiskEngine attached, headroom is reserved
+// before sending and settled on fills, cancels and rejects; with a
+// PnlEngine attached, fills are booked as they arrive.
+//
+// Single-threaded: call submit(), cancel() and on_report() from the
+// strategy thread that owns the gateway.
+//--------------------------------------------------------------------
+template <OrderTransport Transport>
+class OrderGateway {
+public:
+    enum class SubmitStatus : uint8_t { Sent, PoolExhausted, RiskRejected, TransportFailed };
+
+    struct Submitted {
+        ClientOrderId id = kNoOrder;
+        SubmitStatus status = SubmitStatus::Sent;
+        RiskEngine::Verdict verdict = RiskEngine::Verdict::Accepted;
+    };
+
+    struct Stats {
+        uint64_t sent = 0;
+        uint64_t acked = 0;
+        uint64_t fills = 0;
+        uint64_t filled = 0;
+        uint64_t canceled = 0;
+        uint64_t rejected = 0;
+        uint64_t risk_rejected = 0;
+        uint64_t pool_exhausted = 0;
+        uint64_t transport_failures = 0;
+        uint64_t protocol_errors = 0;   // Reports for unknown ids or invalid transitions
+
+        // Book update -> bytes handed to the transport
+        uint64_t tick_to_wire_count = 0;
+        uint64_t tick_to_wire_total_ns = 0;
+        uint64_t tick_to_wire_max_ns = 0;
+    };
+
+    OrderGateway(Transport& transport, std::size_t capacity) : transport_(transport), pool_(capacity) {}
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    void attach_risk(RiskEngine& risk, RiskEngine::AccountId account) noexcept {
+        risk_ = &risk;
+        account_ = account;
+    }
+    void attach_pnl(PnlEngine& pnl) noexcept { pnl_ = &pnl; }
+
+    // `tick_ns` is the steady-clock time the book update behind the order
+    // was received; a `stop_price` also puts the order under the max-risk limit
+    Submitted submit(uint32_t symbol, bool is_buy, double quantity, double price, uint64_t tick_ns,
+                     double stop_price = 0.0) noexcept {
+        if (risk_) {
+            const RiskEngine::Order check{.account = account_, .symbol = symbol, .isBuy = is_buy,
+                                          .quantity = quantity, .price = price, .stopPrice = stop_price};
+            if (const auto v = risk_->reserve(check); v != RiskEngine::Verdict::Accepted) {
+                ++stats_.risk_rejected;
+                return {kNoOrder, SubmitStatus::RiskRejected, v};
+            }
+        }
+
+        Order* order = pool_.acquire();
+        if (!order) {
+            unreserve(symbol, is_buy, quantity);
+            ++stats_.pool_exhausted;
+            return {kNoOrder, SubmitStatus::PoolExhausted};
+        }
+        order->symbol = symbol;
+        order->is_buy = is_buy;
+        order->quantity = quantity;
+        order->price = price;
+        order->tick_ns = tick_ns;
+
+        const OrderWire::NewOrder msg{
+            .client_id = order->id, .symbol = symbol, .is_buy = is_buy, .price = price, .quantity = quantity};
+        if (!transport_.send(OrderWire::bytes_of(msg))) {
+            unreserve(symbol, is_buy, quantity);
+            pool_.release(*order);
+            ++stats_.transport_failures;
+            return {kNoOrder, SubmitStatus::TransportFailed};
+        }
+
+        order->wire_ns = now_ns();
+        record_tick_to_wire(order->wire_ns - std::min(tick_ns, order->wire_ns));
+        ++stats_.sent;
+        return {order->id, SubmitStatus::Sent};
+    }
+
+    bool cancel(ClientOrderId id) noexcept {
+        Order* order = pool_.find(id);
+        if (!order) return false;
+        const auto next = next_state(order->state, OrderEvent::CancelRequest);
+        if (!next) return false;
+
+        const OrderWire::CancelOrder msg{.client_id = id};
+        if (!transport_.send(OrderWire::bytes_of(msg))) {
+            ++stats_.transport_failures;
+            return false;
+        }
+        order->state = *next;
+        return true;
+    }
+
+    void on_report(const OrderWire::Report& report) noexcept {
+        Order* order = pool_.find(report.client_id);
+        if (!order) {
+            ++stats_.protocol_errors;
+            return;
+        }
+
+        const OrderEvent event = event_of(report.exec);
+        double fill = 0.0;
+        if (event == OrderEvent::Fill) fill = std::min(report.last_quantity, order->remaining());
+        const bool complete = event == OrderEvent::Fill && order->remaining() - fill <= order->quantity * kFillTolerance;
+
+        const auto next = next_state(order->state, event, complete, order->filled > 0.0);
+        if (!next || (event == OrderEvent::Fill && fill <= 0.0)) {
+            ++stats_.protocol_errors;
+            return;
+        }
+
+        switch (event) {
+            case OrderEvent::Ack:
+                order->venue_id = report.venue_id;
+                ++stats_.acked;
+                break;
+            case OrderEvent::Fill:
+                book_fill(*order, fill, report.last_price);
+                break;
+            case OrderEvent::CancelAck:
+                ++stats_.canceled;
+                unreserve(order->symbol, order->is_buy, order->remaining());
+                break;
+            case OrderEvent::Reject:
+                ++stats_.rejected;
+                unreserve(order->symbol, order->is_buy, order->remaining());
+                break;
+            case OrderEvent::CancelReject:
+            case OrderEvent::CancelRequest:
+                break;
+        }
+
+        order->state = *next;
+        if (*next == OrderState::Filled) ++stats_.filled;
+        if (is_terminal(*next)) pool_.release(*order);
+    }
+
+    [[nodiscard]] const Order* find(ClientOrderId id) const noexcept { return pool_.find(id); }
+    [[nodiscard]] std::size_t open_orders() const noexcept { return pool_.in_use(); }
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+
+private:
+    // Unfilled fraction treated as done, so summed partials that miss the
+    // order quantity by rounding still complete it
+    static constexpr double kFillTolerance = 1e-9;
+
+    static uint64_t now_ns() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static OrderEvent event_of(OrderWire::ExecType exec) noexcept {
+        switch (exec) {
+            case OrderWire::ExecType::Ack:            return OrderEvent::Ack;
+            case OrderWire::ExecType::Fill:           return OrderEvent::Fill;
+            case OrderWire::ExecType::Canceled:       return OrderEvent::CancelAck;
+            case OrderWire::ExecType::Rejected:       return OrderEvent::Reject;
+            case OrderWire::ExecType::CancelRejected: return OrderEvent::CancelReject;
+        }
+        return OrderEvent::Reject;
+    }
+
+    void book_fill(Order& order, double quantity, double price) noexcept {
+        const double total = order.filled + quantity;
+        order.average_fill = (order.average_fill * order.filled + price * quantity) / total;
+        order.filled = total;
+        ++stats_.fills;
+        if (risk_) risk_->onFill(account_, order.symbol, order.is_buy, quantity);
+        if (pnl_) pnl_->onFill(order.symbol, order.is_buy, quantity, price);
+    }
+
+    void unreserve(uint32_t symbol, bool is_buy, double quantity) noexcept {
+        if (risk_ && quantity > 0.0) risk_->release(account_, symbol, is_buy, quantity);
+    }
+
+    void record_tick_to_wire(uint64_t ns) noexcept {
+        ++stats_.tick_to_wire_count;
+        stats_.tick_to_wire_total_ns += ns;
+        stats_.tick_to_wire_max_ns = std::max(stats_.tick_to_wire_max_ns, ns);
+    }
+
+    Transport& transport_;
+    OrderPool pool_;
+    RiskEngine* risk_ = nullptr;
+    RiskEngine::AccountId account_ = 0;
+    PnlEngine* pnl_ = nullptr;
+    Stats stats_;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include "Execution/Order.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//--------------------------------------------------------------------
+// ORDER POOL: every order lives in a slot allocated at construction.
+// acquire() pops a free slot, release() pushes it back with a bumped
+// generation. Nothing is allocated per order.
+//--------------------------------------------------------------------
+class OrderPool {
+public:
+    explicit OrderPool(std::size_t capacity);
+
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    // Fresh order with its id assigned; nullptr when every slot is in use
+    [[nodiscard]] Order* acquire() noexcept;
+    void release(Order& order) noexcept;
+
+    // O(1); nullptr for ids of released or never-issued orders
+    [[nodiscard]] Order* find(ClientOrderId id) noexcept;
+    [[nodiscard]] const Order* find(ClientOrderId id) const noexcept;
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return slots_.size(); }
+    [[nodiscard]] std::size_t in_use() const noexcept { return slots_.size() - free_.size(); }
+
+private:
+    [[nodiscard]] static uint32_t slot_of(ClientOrderId id) noexcept { return static_cast<uint32_t>(id); }
+    [[nodiscard]] static uint32_t generation_of(ClientOrderId id) noexcept { return static_cast<uint32_t>(id >> 32); }
+
+    std::vector<Order> slots_;
+    std::vector<uint32_t> free_;   // Stack of free slot indices
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+
+//--------------------------------------------------------------------
+// ORDER WIRE: fixed-size binary messages between the gateway and a
+// venue, little-endian, no framing beyond the leading type byte.
+//--------------------------------------------------------------------
+namespace OrderWire {
+
+enum class MsgType : uint8_t { New = 1, Cancel = 2, Report = 3 };
+enum class ExecType : uint8_t { Ack, Fill, Canceled, Rejected, CancelRejected };
+
+#pragma pack(push, 1)
+struct NewOrder {
+    MsgType type = MsgType::New;
+    uint64_t client_id;
+    uint32_t symbol;
+    uint8_t is_buy;
+    double price;
+    double quantity;
+};
+
+struct CancelOrder {
+    MsgType type = MsgType::Cancel;
+    uint64_t client_id;
+};
+
+struct Report {
+    MsgType type = MsgType::Report;
+    ExecType exec;
+    uint64_t client_id;
+    uint64_t venue_id;
+    double last_quantity;
+    double last_price;
+};
+#pragma pack(pop)
+
+template <typename Msg>
+[[nodiscard]] inline std::span<const std::byte> bytes_of(const Msg& msg) noexcept {
+    return std::as_bytes(std::span(&msg, 1));
+}
+
+template <typename Msg>
+[[nodiscard]] inline std::optional<Msg> decode(std::span<const std::byte> bytes) noexcept {
+    if (bytes.size() < sizeof(Msg)) return std::nullopt;
+    Msg msg;
+    std::memcpy(&msg, bytes.data(), sizeof(Msg));
+    if (msg.type != Msg{}.type) return std::nullopt;
+    return msg;
+}
+
+} // namespace OrderWire
@@ -0,0 +1,111 @@
+#pragma once
+#include "Risk/RiskEngine.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//--------------------------------------------------------------------
+// PNL ENGINE: positions, realized/unrealized PnL and exposure for one
+// account, kept incrementally. A fill or a BBO change touches only its
+// symbol's slot and adjusts the portfolio totals by the difference, so
+// every update is O(1) however many positions are open.
+//
+// Single writer (the thread that sees fills and ticks). Other threads
+// read totals() through a seqlock and always get one consistent set.
+// Longs are marked at the bid and shorts at the ask: unrealized PnL is
+// what closing now would realize.
+//--------------------------------------------------------------------
+class PnlEngine {
+public:
+    using SymbolId = RiskEngine::SymbolId;
+
+    struct Totals {
+        double realized = 0.0;
+        double unrealized = 0.0;
+        double equity = 0.0;         // Cash + realized today + unrealized
+        double netExposure = 0.0;    // Sum of qty * mid
+        double grossExposure = 0.0;  // Sum of |qty * mid|
+        double peakEquity = 0.0;
+        double dailyLoss = 0.0;      // (start - equity) / start, 0 while up
+        double drawdown = 0.0;       // (peak - equity) / peak
+    };
+
+    struct Position {
+        double quantity = 0.0;       // Signed: short < 0
+        double averagePrice = 0.0;
+        double realized = 0.0;
+        double unrealized = 0.0;
+        double bid = 0.0;
+        double ask = 0.0;
+    };
+
+    PnlEngine(std::size_t symbols, double startingBalance);
+
+    PnlEngine(const PnlEngine&) = delete;
+    PnlEngine& operator=(const PnlEngine&) = delete;
+
+    // Publish equity to this account of `risk` after every update, so its
+    // daily-loss check sees marked PnL on every tick
+    void attachRisk(RiskEngine& risk, RiskEngine::AccountId account) noexcept;
+
+    // Rolls the day: realized resets, open positions carry over at their marks
+    void startDay() noexcept;
+
+    void onFill(SymbolId symbol, bool isBuy, double quantity, double price, double fee = 0.0) noexcept;
+    void onBbo(SymbolId symbol, double bid, double ask) noexcept;
+
+    // Writer thread only
+    [[nodiscard]] const Position& position(SymbolId symbol) const noexcept { return positions_[symbol]; }
+    [[nodiscard]] double equity() const noexcept { return equity(work_); }
+
+    // Any thread
+    [[nodiscard]] Totals totals() const noexcept;
+    [[nodiscard]] bool dailyLossBreached() const noexcept;
+
+    [[nodiscard]] std::size_t symbols() const noexcept { return positions_.size(); }
+
+    // Floating-point residue from incremental updates is cleared by a
+    // full recompute this often (in updates)
+    static constexpr uint32_t kResyncInterval = 1u << 16;
+
+private:
+    // Running sums the writer adjusts in place
+    struct Work {
+        double realized = 0.0;
+        double unrealized = 0.0;
+        double netExposure = 0.0;
+        double grossExposure = 0.0;
+        double peakEquity = 0.0;
+    };
+
+    [[nodiscard]] double equity(const Work& w) const noexcept { return cash_ + w.realized + w.unrealized; }
+    static double unrealizedOf(const Position& p) noexcept;
+    static double midOf(const Position& p) noexcept;
+
+    // Swap one symbol's contribution out of the sums and back in
+    void remove(const Position& p) noexcept;
+    void add(const Position& p) noexcept;
+    void finishUpdate() noexcept;
+    void resync() noexcept;
+    void publish() noexcept;
+
+    std::vector<Position> positions_;
+    Work work_;
+    double cash_;               // Balance before today's realized PnL
+    double dayStartEquity_;     // Daily-loss baseline, open positions included
+    uint32_t sinceResync_ = 0;
+
+    RiskEngine* risk_ = nullptr;
+    RiskEngine::AccountId account_ = 0;
+
+    // Seqlock-published copy of Totals: odd sequence = write in progress
+    alignas(64) std::atomic<uint64_t> seq_{0};
+    std::atomic<double> realized_{0.0};
+    std::atomic<double> unrealized_{0.0};
+    std::atomic<double> equity_{0.0};
+    std::atomic<double> netExposure_{0.0};
+    std::atomic<double> grossExposure_{0.0};
+    std::atomic<double> peakEquity_{0.0};
+    std::atomic<double> dayStartEquityPublished_{0.0};
+};
@@ -0,0 +1,132 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//--------------------------------------------------------------------
+// RISK ENGINE: pre-trade limits per account and per (account, symbol).
+// Every limit and every piece of state is an atomic in a slot sized at
+// construction, so checks never lock or allocate and any number of
+// strategy threads can share one engine. Limits may be changed from
+// any thread while orders are being checked.
+//
+// "He will win who knows when to fight and when not to fight."
+//--------------------------------------------------------------------
+class RiskEngine {
+public:
+    using AccountId = uint32_t;
+    using SymbolId = uint32_t;
+
+    static constexpr double kMinRiskFraction = 0.002;   // Volatility scaling floor
+
+    struct AccountLimits {
+        double maxRiskFraction = 0.01;        // Entry-to-stop loss per order, of balance
+        double maxDailyLossFraction = 0.03;   // Of the start-of-day balance
+        double maxOrderNotional = 1e6;
+    };
+
+    struct SymbolLimits {
+        double maxOrderNotional = 1e6;
+        double maxPosition = 1e3;             // Absolute, filled plus one side's working
+    };
+
+    struct Order {
+        AccountId account = 0;
+        SymbolId symbol = 0;
+        bool isBuy = true;
+        double quantity = 0.0;
+        double price = 0.0;
+        double stopPrice = 0.0;               // 0 = no stop, max-risk check skipped
+    };
+
+    enum class Verdict : uint8_t {
+        Accepted,
+        Halted,
+        DailyLoss,
+        MaxRisk,
+        Notional,
+        Position,
+        InvalidOrder
+    };
+
+    // Ids are indices in [0, accounts) and [0, symbols)
+    RiskEngine(std::size_t accounts, std::size_t symbols);
+
+    RiskEngine(const RiskEngine&) = delete;
+    RiskEngine& operator=(const RiskEngine&) = delete;
+
+    void setAccountLimits(AccountId account, const AccountLimits& limits) noexcept;
+    void setSymbolLimits(AccountId account, SymbolId symbol, const SymbolLimits& limits) noexcept;
+
+    // New trading day: balance and daily-loss baseline both reset
+    void startDay(AccountId account, double balance) noexcept;
+    void setBalance(AccountId account, double balance) noexcept;
+    void halt(AccountId account, bool halted = true) noexcept;
+
+    // Per-order risk becomes maxRiskFraction / multiplier, floored at kMinRiskFraction
+    void adjustForVolatility(AccountId account, double multiplier) noexcept;
+
+    // Read-only: would this order pass right now?
+    [[nodiscard]] Verdict check(const Order& order) const noexcept;
+
+    // check() plus an atomic claim on the position headroom, so two
+    // strategies racing for the last of it cannot both be accepted
+    [[nodiscard]] Verdict reserve(const Order& order) noexcept;
+
+    // Reserved quantity that will never fill (cancel, reject, expiry)
+    void release(AccountId account, SymbolId symbol, bool isBuy, double quantity) noexcept;
+    // Reserved quantity that filled; moves from working to filled, exposure is unchanged
+    void onFill(AccountId account, SymbolId symbol, bool isBuy, double quantity) noexcept;
+
+    // Units to buy so that hitting the stop loses the current per-order risk
+    [[nodiscard]] double positionSize(AccountId account, double entryPrice, double stopPrice) const noexcept;
+
+    [[nodiscard]] double balance(AccountId account) const noexcept;
+    [[nodiscard]] double currentMaxRisk(AccountId account) const noexcept;
+    [[nodiscard]] double dailyLossFraction(AccountId account) const noexcept;
+    [[nodiscard]] bool dailyLossBreached(AccountId account) const noexcept;
+    [[nodiscard]] double position(AccountId account, SymbolId symbol) const noexcept;   // Filled
+    // Worst case if every working order on one side fills: resting buys and
+    // sells are tracked apart so they never offset each other
+    [[nodiscard]] double exposure(AccountId account, SymbolId symbol) const noexcept;
+
+    [[nodiscard]] std::size_t accounts() const noexcept { return accounts_count_; }
+    [[nodiscard]] std::size_t symbols() const noexcept { return symbols_count_; }
+
+private:
+    // One cache line each: strategies on different accounts or symbols
+    // never write to the same line
+    struct alignas(64) AccountState {
+        std::atomic<double> maxRiskFraction{0.01};
+        std::atomic<double> riskMultiplier{1.0};
+        std::atomic<double> maxDailyLossFraction{0.03};
+        std::atomic<double> maxOrderNotional{1e6};
+        std::atomic<double> balance{0.0};
+        std::atomic<double> dayStartBalance{0.0};
+        std::atomic<bool> halted{false};
+    };
+
+    struct alignas(64) SymbolState {
+        std::atomic<double> maxOrderNotional{1e6};
+        std::atomic<double> maxPosition{1e3};
+        std::atomic<double> workingBuys{0.0};
+        std::atomic<double> workingSells{0.0};
+        std::atomic<double> position{0.0};
+    };
+
+    [[nodiscard]] bool valid(AccountId account, SymbolId symbol) const noexcept {
+        return account < accounts_count_ && symbol < symbols_count_;
+    }
+    [[nodiscard]] SymbolState& cell(AccountId account, SymbolId symbol) const noexcept {
+        return symbols_[static_cast<std::size_t>(account) * symbols_count_ + symbol];
+    }
+    [[nodiscard]] static double worstCase(const SymbolState& s, double buys, double sells) noexcept;
+    [[nodiscard]] static double riskFraction(const AccountState& a) noexcept;
+    [[nodiscard]] static double lossFraction(const AccountState& a) noexcept;
+
+    std::size_t accounts_count_;
+    std::size_t symbols_count_;
+    std::unique_ptr<AccountState[]> accounts_;
+    std::unique_ptr<SymbolState[]> symbols_;
+};
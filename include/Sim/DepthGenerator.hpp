@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Core/OrderBook.hpp"
+
+//--------------------------------------------------------------------
+// DEPTH GENERATOR: the order book the simulator streams. Synthetic
+// books follow a random-walk mid with a ladder of `levels` per side;
+// replayed books come from captured Binance depth frames, one per line.
+// Each update can be encoded for either wire the feed handlers speak.
+//--------------------------------------------------------------------
+class DepthGenerator {
+public:
+    struct Config {
+        float start_price = 67000.0f;
+        float tick = 0.01f;
+        int levels = 20;
+        uint64_t seed = 1;   // Same seed, same stream: redundant legs see identical ids
+    };
+
+    DepthGenerator();
+    explicit DepthGenerator(Config cfg);
+
+    // Replaces the synthetic walk with captured frames, looped forever.
+    // Throws std::runtime_error if the file holds no parsable depth frame.
+    void load_replay(const std::string& path);
+
+    // Advances to the next update; `skip` extra updates are generated but
+    // never shown, which is how the simulator injects gaps
+    void next(uint64_t skip = 0);
+
+    // Carries on from sequence id `id`, as a venue's ids run on across
+    // connections. Only the id moves; the book is not replayed up to it.
+    void resume_at(uint64_t id) noexcept { update_id_ = id; }
+
+    [[nodiscard]] uint64_t update_id() const noexcept { return update_id_; }
+    [[nodiscard]] std::span<const OrderBook::Order> levels() const noexcept { return levels_; }
+
+    // {"lastUpdateId":..,"E":<ms>,"bids":[..],"asks":[..]}, Binance partial depth
+    void encode_json(std::string& out, uint64_t event_ms) const;
+
+    // One MarketData book frame (BinMessage + BinOrders) with a valid CRC
+    void encode_binary(std::vector<std::byte>& out, uint64_t timestamp_ns) const;
+
+private:
+    void step();
+
+    Config cfg_;
+    std::mt19937_64 gen_;
+    double mid_;
+    uint64_t update_id_ = 0;
+    std::vector<OrderBook::Order> levels_;
+
+    std::vector<std::string> replay_;
+    std::size_t replay_pos_ = 0;
+};
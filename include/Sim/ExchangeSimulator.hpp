@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Sim/DepthGenerator.hpp"
+
+//--------------------------------------------------------------------
+// EXCHANGE SIMULATOR: a local stand-in for the venue. It serves
+//   - the MarketData binary protocol over plain TCP, and
+//   - Binance-style depth over a TLS WebSocket (self-signed certificate)
+//     on /ws/<stream> and /stream?streams=<a>/<b>/..., with streams
+//     added and dropped by SUBSCRIBE/UNSUBSCRIBE frames
+// Every client session gets its own paced stream, deflated for clients
+// that ask when compression is on. WebSocket depth ids
+// pick up where the venue is, so a reconnect never goes back in sequence.
+// Disconnects and sequence gaps can be scheduled or injected on demand,
+// so feed handlers can be measured for throughput, recovery and latency
+// without a network.
+//--------------------------------------------------------------------
+class ExchangeSimulator {
+public:
+    struct Config {
+        uint16_t binary_port = 1337;      // 0 picks a free port
+        uint16_t ws_port = 9443;          // 0 picks a free port
+        bool serve_binary = true;
+        bool serve_websocket = true;
+
+        double rate = 1000.0;             // Updates per second, per session
+        DepthGenerator::Config depth;
+        std::string replay_path;          // Captured depth frames; empty = synthetic
+        bool compression = false;         // Accept permessage-deflate from clients that offer it
+        bool stamp_frames = false;        // Lead each depth frame with "T0":<steady ns at send>
+
+        std::chrono::milliseconds disconnect_every{0};   // Per session; 0 = never
+        uint64_t gap_every = 0;           // Skip gap_size updates every N; 0 = never
+        uint64_t gap_size = 10;
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> updates_sent{0};
+        std::atomic<uint64_t> bytes_sent{0};          // Payload bytes, before any deflate
+        std::atomic<uint64_t> sessions_opened{0};
+        std::atomic<uint64_t> sessions_live{0};
+        std::atomic<uint64_t> deflate_sessions{0};    // Sessions that negotiated permessage-deflate
+        std::atomic<uint64_t> disconnects{0};
+        std::atomic<uint64_t> gaps{0};
+    };
+
+    explicit ExchangeSimulator(Config cfg);
+    ~ExchangeSimulator();
+
+    ExchangeSimulator(const ExchangeSimulator&) = delete;
+    ExchangeSimulator& operator=(const ExchangeSimulator&) = delete;
+
+    // Binds the listeners; throws std::runtime_error if a port is taken
+    void start();
+    void stop();
+
+    [[nodiscard]] uint16_t binary_port() const noexcept;
+    [[nodiscard]] uint16_t ws_port() const noexcept;
+
+    // Drop every open session without a close handshake, as a network would
+    void inject_disconnect() noexcept;
+    // Every session skips the next `updates` sequence ids
+    void inject_gap(uint64_t updates) noexcept;
+    void set_rate(double updates_per_second) noexcept;
+
+    [[nodiscard]] const Stats& stats() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
@@ -0,0 +1,190 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Execution/OrderWire.hpp"
+
+//--------------------------------------------------------------------
+// MATCHING SIMULATOR: replays recorded depth and trades against our own
+// orders, for backtests that need to know whether a passive order would
+// really have filled. Each of our resting orders tracks the visible
+// quantity queued ahead of it at its price:
+//   - trades at the level eat the queue before they reach us, and trades
+//     through our price fill us outright;
+//   - a level that shrinks by more than it traded lost the difference to
+//     cancels, taken from the queue ahead in proportion to its size.
+// Orders crossing the book on arrival take visible liquidity as a taker.
+//
+// Time is the recording's. The strategy sees an event `md_latency_ns`
+// after the venue applied it, its orders reach the venue
+// `order_latency_ns` after they were sent, and reports come back
+// `report_latency_ns` later. Each path stays FIFO under jitter.
+//
+// Speaks OrderWire, so an OrderGateway can trade against it unchanged.
+// Single-threaded; prices live on a flat tick ladder so every event is
+// O(1) apart from rescanning for the next best level.
+//--------------------------------------------------------------------
+class MatchingSimulator {
+public:
+    struct Config {
+        double tick = 0.01;
+        uint32_t window_ticks = 1 << 16;   // Ladder width, centered on the first price seen
+
+        uint64_t md_latency_ns = 0;        // Venue -> strategy, market data
+        uint64_t order_latency_ns = 0;     // Strategy -> venue
+        uint64_t report_latency_ns = 0;    // Venue -> strategy, execution reports
+        uint64_t jitter_ns = 0;            // Uniform extra delay per message, every path
+        uint64_t seed = 1;
+    };
+
+    enum class EventKind : uint8_t { Depth, Trade };
+
+    // Fixed-size so recordings can be written and mapped as flat arrays
+    struct MarketEvent {
+        uint64_t ts_ns;
+        double price;
+        float amount;      // Depth: new total at the level (0 removes it); Trade: size
+        EventKind kind;
+        bool is_bid;       // Depth: bid side; Trade: the aggressor bought
+    };
+
+    struct Stats {
+        uint64_t events = 0;
+        uint64_t trades = 0;
+        uint64_t out_of_window = 0;     // Events priced outside the ladder, ignored
+        uint64_t orders = 0;
+        uint64_t rejects = 0;
+        uint64_t cancels = 0;
+        uint64_t passive_fills = 0;
+        uint64_t taker_fills = 0;
+        double filled_quantity = 0.0;
+    };
+
+    MatchingSimulator();
+    explicit MatchingSimulator(Config cfg);
+
+    MatchingSimulator(const MatchingSimulator&) = delete;
+    MatchingSimulator& operator=(const MatchingSimulator&) = delete;
+
+    // Executes every order message that reached the venue by `ev.ts_ns`,
+    // then applies `ev`. Returns the time the strategy sees it, which is
+    // also the send time for any order placed in response.
+    uint64_t on_market(const MarketEvent& ev) noexcept;
+
+    // Strategy-side clock; moves forward only (e.g. to charge decision time)
+    void advance(uint64_t now_ns) noexcept;
+    [[nodiscard]] uint64_t now() const noexcept { return now_; }
+
+    // End of replay: executes every order still in flight and moves the
+    // clock past the last report
+    void drain() noexcept;
+
+    // OrderTransport
+    bool send(std::span<const std::byte> bytes);
+
+    // Delivers reports due by now() to `sink.on_report()`; returns how many
+    template <typename Sink>
+    std::size_t poll(Sink& sink) {
+        std::size_t n = 0;
+        while (reports_head_ < reports_.size() && reports_[reports_head_].deliver_ns <= now_) {
+            sink.on_report(reports_[reports_head_++].report);
+            ++n;
+        }
+        if (reports_head_ == reports_.size()) {
+            reports_.clear();
+            reports_head_ = 0;
+        }
+        return n;
+    }
+
+    [[nodiscard]] double best_bid() const noexcept;
+    [[nodiscard]] double best_ask() const noexcept;
+    [[nodiscard]] double level(double price, bool is_bid) const noexcept;
+    // Visible quantity ahead of one of our resting orders; -1 if not resting
+    [[nodiscard]] double queue_ahead(uint64_t client_id) const noexcept;
+    [[nodiscard]] std::size_t resting() const noexcept { return resting_.size(); }
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+
+    // Flat MarketEvent files, host byte order. Both throw std::runtime_error.
+    static std::vector<MarketEvent> load(const std::string& path);
+    static void save(const std::string& path, std::span<const MarketEvent> events);
+
+private:
+    struct Level {
+        double quantity = 0.0;
+        double traded = 0.0;     // Printed here since the last depth update
+        uint32_t ours = 0;       // Our resting orders at this level
+    };
+
+    struct Inbound {
+        uint64_t arrive_ns;
+        uint64_t client_id;
+        double price;
+        double quantity;
+        OrderWire::MsgType type;
+        bool is_buy;
+    };
+
+    struct Resting {
+        uint64_t client_id;
+        uint64_t venue_id;
+        double price;
+        double remaining;
+        double ahead;
+        int64_t index;
+        bool is_buy;
+    };
+
+    struct Outbound {
+        uint64_t deliver_ns;
+        OrderWire::Report report;
+    };
+
+    void anchor(double price) noexcept;
+    [[nodiscard]] int64_t index_of(double price) const noexcept;   // -1 outside the ladder
+    [[nodiscard]] double price_of(int64_t index) const noexcept;
+    [[nodiscard]] uint64_t delay(uint64_t base) noexcept;
+
+    void execute_until(uint64_t venue_ns) noexcept;
+    void execute(const Inbound& msg) noexcept;
+    void on_new(const Inbound& msg) noexcept;
+    void on_cancel(const Inbound& msg) noexcept;
+    void on_depth(const MarketEvent& ev) noexcept;
+    void on_trade(const MarketEvent& ev) noexcept;
+
+    void set_level(bool is_bid, int64_t index, double quantity) noexcept;
+    void fill(Resting& order, double quantity, double price) noexcept;   // Passive
+    void remove_filled() noexcept;
+    void refresh_extremes() noexcept;
+    void report(OrderWire::ExecType exec, uint64_t client_id, uint64_t venue_id,
+                double quantity = 0.0, double price = 0.0) noexcept;
+
+    Config cfg_;
+    uint64_t rng_;
+    int64_t base_ = 0;               // Ladder index 0 in ticks; set by the first event
+    bool anchored_ = false;
+    std::vector<Level> bids_, asks_;
+    int64_t best_bid_ = -1;
+    int64_t best_ask_ = -1;
+
+    uint64_t venue_ns_ = 0;
+    uint64_t now_ = 0;
+    uint64_t last_md_ns_ = 0;
+    uint64_t last_arrive_ns_ = 0;
+    uint64_t last_deliver_ns_ = 0;
+    uint64_t next_venue_id_ = 1;
+
+    std::vector<Inbound> inbound_;
+    std::size_t inbound_head_ = 0;
+    std::vector<Outbound> reports_;
+    std::size_t reports_head_ = 0;
+
+    std::vector<Resting> resting_;   // Arrival order, which is queue order within a level
+    int64_t top_buy_ = -1;           // Highest resting buy, lowest resting sell: trades
+    int64_t top_sell_ = -1;          // that miss both skip the scan
+
+    Stats stats_;
+};
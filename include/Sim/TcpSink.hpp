@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+//--------------------------------------------------------------------
+// TCP SINK: a local stand-in for a line-oriented ingest port such as
+// QuestDB's ILP listener. It accepts one client at a time on loopback,
+// keeps (or just counts) what arrives, and can drop the connection on
+// demand so writers can be tested for reconnect and retry.
+//--------------------------------------------------------------------
+class TcpSink {
+public:
+    struct Config {
+        uint16_t port = 0;     // 0 picks a free port
+        bool keep = true;      // false: count bytes and lines, store nothing
+    };
+
+    TcpSink();
+    explicit TcpSink(Config cfg);
+    ~TcpSink();
+
+    TcpSink(const TcpSink&) = delete;
+    TcpSink& operator=(const TcpSink&) = delete;
+
+    // Binds the listener; throws std::runtime_error if the port is taken
+    void start();
+    void stop();
+
+    [[nodiscard]] uint16_t port() const noexcept;
+
+    // Close the current client without warning, as a crashed server would
+    void inject_disconnect() noexcept;
+
+    [[nodiscard]] std::string received() const;   // Everything kept so far
+    [[nodiscard]] uint64_t bytes() const noexcept;
+    [[nodiscard]] uint64_t lines() const noexcept;
+    [[nodiscard]] uint64_t connections() const noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "Core/OrderBook.hpp"
+#include "Strategy/GammaSqueezeDetector.hpp"
+#include "Tactics/SunTzuTactics.hpp"
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <utility>
+
+//--------------------------------------------------------------------
+// FEATURES: read the book and scan the updates once per tick; every
+// stage works off this instead of going back to the book.
+//--------------------------------------------------------------------
+struct TickFeatures {
+    uint64_t ts_ns = 0;
+    std::span<const OrderBook::Order> updates;
+    OrderBook::Snapshot book;
+    float update_volume = 0.0f;     // Sum of amounts in `updates`
+    uint32_t update_count = 0;      // Kept when `updates` itself isn't forwarded
+};
+
+[[nodiscard]] inline TickFeatures make_tick_features(
+    uint64_t ts_ns,
+    const OrderBook& book,
+    std::span<const OrderBook::Order> updates,
+    float depth_band = 0.001f) noexcept
+{
+    TickFeatures f{
+        .ts_ns = ts_ns,
+        .updates = updates,
+        .book = book.snapshot(depth_band),
+        .update_count = static_cast<uint32_t>(updates.size())
+    };
+    for (const auto& order : updates) f.update_volume += order.amount;
+    return f;
+}
+
+// What the stages concluded; detectors fill it in, tactics act on it
+struct TickDecision {
+    SunTzu::MarketPhase phase = SunTzu::MarketPhase::RANGING;
+    bool weak_point = false;
+    bool raid = false;
+    GammaSqueezeDetector::Direction squeeze = GammaSqueezeDetector::Direction::NONE;
+
+    bool retreat = false;           // Daily loss limit hit: no new entries
+
+    bool enter = false;
+    bool is_bid = true;
+    float entry_price = 0.0f;
+};
+
+template <typename S>
+concept PipelineStage = requires(S stage, const TickFeatures& features, TickDecision& decision) {
+    { stage.on_tick(features, decision) } -> std::same_as<void>;
+};
+
+//--------------------------------------------------------------------
+// PIPELINE: stages are a type list, run in declaration order through a
+// fold expression. No virtual calls; with constexpr configs baked into
+// the stage types the whole tick pass is visible to the optimiser.
+//--------------------------------------------------------------------
+template <PipelineStage... Stages>
+class DetectorPipeline {
+public:
+    DetectorPipeline() = default;
+    explicit DetectorPipeline(Stages... stages) : stages_(std::move(stages)...) {}
+
+    TickDecision on_tick(const TickFeatures& features) {
+        TickDecision decision;
+        std::apply([&](auto&... stage) { (stage.on_tick(features, decision), ...); }, stages_);
+        return decision;
+    }
+
+    template <typename Stage>
+    [[nodiscard]] Stage& stage() noexcept { return std::get<Stage>(stages_); }
+
+    template <typename Stage>
+    [[nodiscard]] const Stage& stage() const noexcept { return std::get<Stage>(stages_); }
+
+    static constexpr std::size_t size() noexcept { return sizeof...(Stages); }
+
+private:
+    std::tuple<Stages...> stages_;
+};
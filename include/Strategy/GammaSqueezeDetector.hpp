@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+
+//--------------------------------------------------------------------
+// GAMMA SQUEEZE DETECTOR: streaming, constant-state. Three legs must
+// line up on the same side before it fires:
+//   1. Book imbalance accelerating (fast EWMA of near-BBO imbalance
+//      velocity pulling away from its slow EWMA)
+//   2. The opposite side's near-BBO depth draining vs its slow baseline
+//   3. Aggressor flow pushing the same way (signed / gross volume EWMA)
+// on_book() and on_trade() are O(1) and allocation-free.
+//--------------------------------------------------------------------
+class GammaSqueezeDetector {
+public:
+    struct Config {
+        float fast_alpha = 0.2f;               // Fast imbalance velocity EWMA
+        float baseline_alpha = 0.02f;          // Slow velocity and depth baselines
+        float flow_alpha = 0.1f;               // Trade-flow momentum EWMA
+        float acceleration_threshold = 0.01f;  // Fast minus slow velocity, per update
+        float depletion_threshold = 0.4f;      // Fraction of baseline depth gone
+        float flow_threshold = 0.5f;           // |signed| / gross flow
+        float trigger_score = 0.9f;            // Mean of the three legs, each in [0, 1]
+        uint32_t warmup_updates = 50;          // Book updates before baselines count
+    };
+
+    enum class Direction : int8_t { DOWN = -1, NONE = 0, UP = 1 };
+
+    struct Signal {
+        Direction direction = Direction::NONE;
+        float score = 0.0f;
+        float imbalance_acceleration = 0.0f;
+        float bid_depletion = 0.0f;
+        float ask_depletion = 0.0f;
+        float flow_momentum = 0.0f;
+    };
+
+    GammaSqueezeDetector() = default;
+    explicit GammaSqueezeDetector(Config cfg) : cfg_(cfg) {}
+
+    // Depth resting within the near-BBO band on each side
+    void on_book(float bid_depth, float ask_depth) noexcept;
+    void on_trade(float amount, bool is_buy) noexcept;
+
+    [[nodiscard]] Signal signal() const noexcept;
+    [[nodiscard]] bool warmed_up() const noexcept { return book_updates_ >= cfg_.warmup_updates; }
+    void reset() noexcept;
+
+private:
+    Config cfg_{};
+
+    // Imbalance derivatives
+    float imbalance_ = 0.0f;
+    float velocity_ = 0.0f;
+    float slow_velocity_ = 0.0f;
+    float acceleration_ = 0.0f;
+
+    // Depth state
+    float bid_depth_ = 0.0f;
+    float ask_depth_ = 0.0f;
+    float bid_baseline_ = 0.0f;
+    float ask_baseline_ = 0.0f;
+
+    // Flow state
+    float signed_flow_ = 0.0f;
+    float gross_flow_ = 0.0f;
+
+    uint32_t book_updates_ = 0;
+};
@@ -0,0 +1,139 @@
+#pragma once
+#include "Analysis/BarAggregator.hpp"
+#include "Core/TradeTape.hpp"
+#include "Risk/PnlEngine.hpp"
+#include "Risk/RiskEngine.hpp"
+#include "Strategy/DetectorPipeline.hpp"
+#include "Strategy/GammaSqueezeDetector.hpp"
+#include "Tactics/SunTzuTactics.hpp"
+#include <cstddef>
+
+//--------------------------------------------------------------------
+// Stock stages for DetectorPipeline. Build-time settings are template
+// parameters so they fold into the generated code.
+//--------------------------------------------------------------------
+
+// Know the terrain: feeds the bar engine and reads one timeframe's phase.
+// Prints that reached the tape since the last tick go in first, stamped
+// with this tick's time so trades and quotes share the feed clock.
+template <std::size_t Timeframe>
+class PhaseStage {
+public:
+    PhaseStage(BarAggregator& bars, const TradeTape& tape)
+        : bars_(&bars), tape_(&tape), cursor_(tape.sequence()) {}
+
+    void on_tick(const TickFeatures& f, TickDecision& d) {
+        tape_->read_since(cursor_, [&](const TradeTape::Print& p) {
+            bars_->on_trade(f.ts_ns, p.price, p.amount);
+        });
+        bars_->on_quote(f.ts_ns, f.book.mid);
+        d.phase = bars_->phase(Timeframe);
+    }
+
+private:
+    BarAggregator* bars_;
+    const TradeTape* tape_;
+    uint64_t cursor_;
+};
+
+// Attack where the enemy is thin on either side
+template <float LiquidityThreshold>
+struct WeakPointStage {
+    void on_tick(const TickFeatures& f, TickDecision& d) const noexcept {
+        d.weak_point = f.book.bid_volume < LiquidityThreshold ||
+                       f.book.ask_volume < LiquidityThreshold;
+    }
+};
+
+// Same rule as LiquidityRaidDetector::detect_raid(updates, mid), computed
+// from the update volume already summed in the feature pass
+struct UpdateRaidStage {
+    void on_tick(const TickFeatures& f, TickDecision& d) const noexcept {
+        d.raid = d.raid || (f.update_count > 0 && f.update_volume > f.book.mid);
+    }
+};
+
+// Time-windowed raid check over the trade tape
+template <SunTzu::LiquidityRaidConfig Cfg>
+class TapeRaidStage {
+public:
+    explicit TapeRaidStage(const TradeTape& tape) : tape_(&tape) {}
+
+    void on_tick(const TickFeatures&, TickDecision& d) const {
+        d.raid = d.raid || SunTzu::isLiquidityRaid(*tape_, Cfg);
+    }
+
+private:
+    const TradeTape* tape_;
+};
+
+// Squeeze legs: near-BBO depth from the snapshot, aggressor flow from
+// the prints that reached the tape since the last tick
+template <GammaSqueezeDetector::Config Cfg = GammaSqueezeDetector::Config{}>
+class GammaStage {
+public:
+    explicit GammaStage(const TradeTape& tape) : tape_(&tape), cursor_(tape.sequence()) {}
+
+    void on_tick(const TickFeatures& f, TickDecision& d) {
+        tape_->read_since(cursor_, [this](const TradeTape::Print& p) { detector_.on_trade(p.amount, p.is_buy); });
+        detector_.on_book(f.book.bid_depth, f.book.ask_depth);
+        d.squeeze = detector_.signal().direction;
+    }
+
+    [[nodiscard]] GammaSqueezeDetector& detector() noexcept { return detector_; }
+
+private:
+    GammaSqueezeDetector detector_{Cfg};
+    const TradeTape* tape_;
+    uint64_t cursor_;
+};
+
+// Tactic: push one account's risk limits only when the terrain actually changes
+class RiskPhaseStage {
+public:
+    RiskPhaseStage(RiskEngine& risk, RiskEngine::AccountId account) : risk_(&risk), account_(account) {}
+
+    void on_tick(const TickFeatures&, TickDecision& d) noexcept {
+        if (!applied_ || d.phase != last_) {
+            SunTzu::adjustForMarketPhase(*risk_, account_, d.phase);
+            last_ = d.phase;
+            applied_ = true;
+        }
+    }
+
+private:
+    RiskEngine* risk_;
+    RiskEngine::AccountId account_;
+    SunTzu::MarketPhase last_ = SunTzu::MarketPhase::RANGING;
+    bool applied_ = false;
+};
+
+// Know when to retreat: mark the book's symbol on every tick and stand
+// down once the account's daily loss limit is hit
+class MarkToMarketStage {
+public:
+    MarkToMarketStage(PnlEngine& pnl, PnlEngine::SymbolId symbol) : pnl_(&pnl), symbol_(symbol) {}
+
+    void on_tick(const TickFeatures& f, TickDecision& d) noexcept {
+        pnl_->onBbo(symbol_, f.book.best_bid, f.book.best_ask);
+        d.retreat = pnl_->dailyLossBreached();
+    }
+
+private:
+    PnlEngine* pnl_;
+    PnlEngine::SymbolId symbol_;
+};
+
+// Tactic: passive entry off the snapshot BBO (same offsets as
+// SunTzu::stealthEntryPrice) when a weak side is being raided or squeezed
+template <float Offset = 0.002f>
+struct StealthEntryStage {
+    void on_tick(const TickFeatures& f, TickDecision& d) const noexcept {
+        const bool trigger = d.raid || d.squeeze == GammaSqueezeDetector::Direction::UP;
+        if (d.retreat || !d.weak_point || !trigger || f.book.best_bid <= 0.0f) return;
+
+        d.enter = true;
+        d.is_bid = true;
+        d.entry_price = f.book.best_bid * (1.0f - Offset);
+    }
+};
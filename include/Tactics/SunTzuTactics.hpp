@@ -1,10 +1,13 @@
 #pragma once
 #include "Core/OrderBook.hpp"
+#include "Risk/RiskEngine.hpp"
 #include <immintrin.h>
 #include <span>
 #include <vector>
 
 // Forward declarations
+class TradeTape;
+
 struct Trade {
     float price;
     float amount;
@@ -17,7 +20,7 @@ namespace SunTzu {
     struct LiquidityRaidConfig {
         float volume_spike_multiplier;
         float time_window_seconds;
-        float min_volume_threshold;
+        float min_volume_threshold;   // Base-asset quantity in the window, not notional
     };
 
     // Deception Tactics
@@ -26,9 +29,11 @@ namespace SunTzu {
     float stealthEntryPrice(const OrderBook& book, bool is_bid) noexcept;
 
     // Strategic Adaptation
-    void adjustForMarketPhase(MarketPhase phase);
+    // Chaos shrinks per-order risk to a quarter, ranging to half
+    void adjustForMarketPhase(RiskEngine& risk, RiskEngine::AccountId account, MarketPhase phase) noexcept;
     MarketPhase detectMarketPhase(const std::vector<float>& prices);
 
     // Liquidity Analysis
-    LiquidityRaidConfig detectLiquidityRaid(const OrderBook& book, std::span<const Trade> trades);
+    // Volume in the trailing time_window_seconds vs the windows before it
+    bool isLiquidityRaid(const TradeTape& tape, const LiquidityRaidConfig& cfg);
 }
\ No newline at end of file
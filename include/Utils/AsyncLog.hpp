@@ -0,0 +1,209 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include <fmt/format.h>
+#include "Tsc.hpp"
+
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error };
+
+//--------------------------------------------------------------------
+// ASYNC LOG: diagnostics that cost the hot thread a memcpy. Each call
+// site is a static Site holding the format string and level. A call
+// copies the site pointer, a TSC stamp and the raw arguments into the
+// calling thread's ring. A background thread formats them with fmt,
+// orders each pass by timestamp and writes the lines out.
+//
+// Every site has its own rate limit: past `per_second` records in a
+// second the rest are counted, not copied, and the next line that gets
+// through says how many were suppressed. A full ring drops the record
+// and counts it. The caller never blocks.
+//
+//   OCEAN_LOG_WARN("[READ ERROR] {}", ec.message());
+//   OCEAN_LOG_RATE(LogLevel::Error, 10, "[PARSE ERROR] {} bytes", n);
+//
+// Arguments are stored by value: arithmetic types and anything
+// trivially copyable as is, strings (char*, std::string, string_view)
+// as bytes, cut at kMaxString.
+//--------------------------------------------------------------------
+namespace AsyncLog {
+
+constexpr uint32_t kDefaultPerSecond = 100;
+constexpr std::size_t kMaxString = 1024;
+
+struct Site {
+    LogLevel level;
+    std::string_view format;
+    std::string_view file;
+    uint32_t line;
+    uint32_t per_second;   // 0: unlimited
+
+    // Rate limiter, shared by every thread logging here
+    std::atomic<uint64_t> window{0};
+    std::atomic<uint32_t> in_window{0};
+    std::atomic<uint32_t> suppressed{0};
+};
+
+struct Config {
+    LogLevel min_level = LogLevel::Info;
+    std::size_t ring_bytes = 1 << 16;                // Per thread, rounded up to a power of two
+    std::chrono::milliseconds idle_sleep{1};         // Backend pause when every ring is empty
+    // Receives each formatted line, without newline. Default: Warn and up
+    // to stderr, the rest to stdout
+    std::function<void(LogLevel, std::string_view)> sink;
+};
+
+struct Stats {
+    uint64_t written = 0;      // Lines handed to the sink
+    uint64_t dropped = 0;      // Ring full on the caller's side
+    uint64_t suppressed = 0;   // Over a site's rate limit, as reported on later lines
+};
+
+// Takes effect for rings created afterwards; call once at startup
+void configure(Config cfg);
+
+// Returns once everything logged before the call has reached the sink
+void flush();
+
+[[nodiscard]] Stats stats();
+
+namespace detail {
+
+// Sites below this level return before touching the ring
+inline std::atomic<LogLevel> min_level{LogLevel::Info};
+
+using FormatFn = void (*)(std::string_view format, const std::byte* args, fmt::memory_buffer& out);
+
+struct Header {
+    const Site* site;    // nullptr: padding up to the end of the ring
+    FormatFn format;
+    uint64_t ticks;
+    uint32_t size;       // Whole record, header included, multiple of 8
+    uint32_t suppressed;
+};
+
+struct Ring;
+
+// This thread's ring, created (and the backend started) on first use
+Ring& thread_ring();
+[[nodiscard]] std::byte* reserve(Ring& ring, std::size_t bytes) noexcept;
+void commit(Ring& ring) noexcept;
+
+// TSC ticks per rate-limit window (one second), set before any ring exists
+inline uint64_t window_ticks = 1;
+
+template <class T>
+using Stored = std::conditional_t<std::is_convertible_v<const T&, std::string_view>,
+                                  std::string_view, std::remove_cvref_t<T>>;
+
+template <class S, class T>
+[[nodiscard]] std::size_t encoded_size(const T& value) noexcept {
+    if constexpr (std::is_same_v<S, std::string_view>) {
+        return sizeof(uint32_t) + std::min(std::string_view(value).size(), kMaxString);
+    } else {
+        static_assert(std::is_trivially_copyable_v<S>, "log arguments are copied raw; pass a string instead");
+        return sizeof(S);
+    }
+}
+
+template <class S, class T>
+std::byte* encode(std::byte* out, const T& value) noexcept {
+    if constexpr (std::is_same_v<S, std::string_view>) {
+        const std::string_view s(value);
+        const auto n = static_cast<uint32_t>(std::min(s.size(), kMaxString));
+        std::memcpy(out, &n, sizeof(n));
+        std::memcpy(out + sizeof(n), s.data(), n);
+        return out + sizeof(n) + n;
+    } else {
+        const S copy(value);
+        std::memcpy(out, &copy, sizeof(S));
+        return out + sizeof(S);
+    }
+}
+
+template <class S>
+S decode(const std::byte*& in) noexcept {
+    if constexpr (std::is_same_v<S, std::string_view>) {
+        uint32_t n;
+        std::memcpy(&n, in, sizeof(n));
+        const std::string_view s(reinterpret_cast<const char*>(in + sizeof(n)), n);
+        in += sizeof(n) + n;
+        return s;
+    } else {
+        S value;
+        std::memcpy(&value, in, sizeof(S));
+        in += sizeof(S);
+        return value;
+    }
+}
+
+// Runs on the backend: rebuilds the arguments and formats them
+template <class... S>
+void format_record(std::string_view format, [[maybe_unused]] const std::byte* args, fmt::memory_buffer& out) {
+    // Braced initialization decodes left to right
+    const std::tuple<S...> values{decode<S>(args)...};
+    std::apply([&](const auto&... v) { fmt::vformat_to(fmt::appender(out), format, fmt::make_format_args(v...)); },
+               values);
+}
+
+inline bool admit(Site& site, uint64_t ticks) noexcept {
+    if (site.per_second == 0) return true;
+    const uint64_t window = ticks / window_ticks;
+    if (site.window.load(std::memory_order_relaxed) != window) {
+        site.window.store(window, std::memory_order_relaxed);
+        site.in_window.store(0, std::memory_order_relaxed);
+    }
+    if (site.in_window.fetch_add(1, std::memory_order_relaxed) < site.per_second) return true;
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+} // namespace detail
+
+template <class... Args>
+void write(Site& site, fmt::format_string<detail::Stored<Args>...>, const Args&... args) noexcept {
+    if (site.level < detail::min_level.load(std::memory_order_relaxed)) return;
+    detail::Ring& ring = detail::thread_ring();
+
+    const uint64_t ticks = Tsc::ticks();
+    if (!detail::admit(site, ticks)) return;
+
+    const std::size_t size = (sizeof(detail::Header) + ... + detail::encoded_size<detail::Stored<Args>>(args));
+    const std::size_t padded = (size + 7) & ~std::size_t{7};
+    std::byte* out = detail::reserve(ring, padded);
+    if (!out) return;
+
+    detail::Header header{.site = &site, .format = &detail::format_record<detail::Stored<Args>...>,
+                          .ticks = ticks, .size = static_cast<uint32_t>(padded), .suppressed = 0};
+    if (site.suppressed.load(std::memory_order_relaxed) != 0) {
+        header.suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+    }
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    ((out = detail::encode<detail::Stored<Args>>(out, args)), ...);
+    detail::commit(ring);
+}
+
+} // namespace AsyncLog
+
+// One static Site per expansion; the format string is checked at compile time
+#define OCEAN_LOG_RATE(level, per_second, format, ...)                                                   \
+    do {                                                                                                 \
+        static constinit ::AsyncLog::Site ocean_log_site_{(level), (format), __FILE__, __LINE__,         \
+                                                          (per_second)};                                 \
+        ::AsyncLog::write(ocean_log_site_, format __VA_OPT__(, ) __VA_ARGS__);                           \
+    } while (0)
+
+#define OCEAN_LOG(level, format, ...) \
+    OCEAN_LOG_RATE(level, ::AsyncLog::kDefaultPerSecond, format __VA_OPT__(, ) __VA_ARGS__)
+#define OCEAN_LOG_DEBUG(format, ...) OCEAN_LOG(LogLevel::Debug, format __VA_OPT__(, ) __VA_ARGS__)
+#define OCEAN_LOG_INFO(format, ...) OCEAN_LOG(LogLevel::Info, format __VA_OPT__(, ) __VA_ARGS__)
+#define OCEAN_LOG_WARN(format, ...) OCEAN_LOG(LogLevel::Warn, format __VA_OPT__(, ) __VA_ARGS__)
+#define OCEAN_LOG_ERROR(format, ...) OCEAN_LOG(LogLevel::Error, format __VA_OPT__(, ) __VA_ARGS__)
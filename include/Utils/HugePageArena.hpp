@@ -0,0 +1,121 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "Utils/Metrics.hpp"
+
+//--------------------------------------------------------------------
+// HUGE PAGES: anonymous mappings backed by 2 MB pages. MAP_HUGETLB is
+// tried first (needs vm.nr_hugepages); otherwise the mapping is 2 MB
+// aligned and madvise()d for transparent huge pages. Either way it is
+// pre-faulted, so the first touch on the tick path never page-faults.
+//--------------------------------------------------------------------
+namespace HugePages {
+
+constexpr std::size_t kPageSize = std::size_t{2} << 20;
+
+struct Mapping {
+    std::byte* base = nullptr;
+    std::size_t bytes = 0;
+    bool hugetlb = false;   // Reserved huge pages rather than THP or 4K pages
+};
+
+// Throws std::bad_alloc when even normal pages can't be mapped
+[[nodiscard]] Mapping map(std::size_t bytes, bool huge_pages = true);
+void unmap(const Mapping& mapping) noexcept;
+
+// Process-wide, over every arena
+struct Totals {
+    std::size_t bytes_held = 0;
+    std::size_t hugetlb_bytes = 0;
+    std::size_t high_water = 0;   // Most bytes_held at any one time
+};
+[[nodiscard]] Totals totals() noexcept;
+
+}
+
+//--------------------------------------------------------------------
+// HUGE PAGE ARENA: a std::pmr::memory_resource for hot-path containers.
+// Fixed-size pools hand out blocks: 16-byte classes up to 256 bytes,
+// powers of two above. A class refills by carving a slab out of the
+// current huge-page chunk, and a freed block goes onto its class's free
+// list, so allocate and free are a pop and a push. A container that
+// churns at steady size stops calling into the system allocator, and
+// its nodes share a few TLB entries instead of scattering over the heap.
+//
+// Not thread-safe, and meant not to be: an arena belongs to one thread,
+// or to one object whose writes are already serialized (OrderBook's
+// writer lock, a connection's strand). No allocator lock is ever taken.
+// Memory goes back to the OS when the arena is destroyed, except blocks
+// over a quarter chunk, which get a mapping of their own and go back on
+// free. Alignments over 16 bytes are bumped and only reclaimed with the
+// arena.
+//--------------------------------------------------------------------
+class HugePageArena final : public std::pmr::memory_resource {
+public:
+    struct Config {
+        std::string name = "default";                 // Metrics label: ocean_arena_*{arena="..."}
+        std::size_t chunk_bytes = HugePages::kPageSize;
+        bool huge_pages = true;                       // false: plain 4K pages, for tests and small tools
+    };
+
+    struct Stats {
+        std::size_t bytes_held = 0;      // Mapped from the OS
+        std::size_t hugetlb_bytes = 0;   // Of which reserved huge pages
+        std::size_t bytes_in_use = 0;    // Handed out and not yet freed
+        std::size_t high_water = 0;      // Most bytes_in_use at any one time
+        uint64_t allocations = 0;
+    };
+
+    HugePageArena() : HugePageArena(Config{}) {}
+    explicit HugePageArena(Config cfg);
+    ~HugePageArena() override;   // Frees everything, whoever still points into it
+
+    HugePageArena(const HugePageArena&) = delete;
+    HugePageArena& operator=(const HugePageArena&) = delete;
+
+    [[nodiscard]] Stats stats() const noexcept;
+    [[nodiscard]] const std::string& name() const noexcept { return name_; }
+
+private:
+    static constexpr std::size_t kAlign = 16;
+    static constexpr std::size_t kClasses = 16 + 48;   // 16..256 by 16, then 512..2^63
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    [[nodiscard]] static std::size_t class_of(std::size_t bytes) noexcept;
+    [[nodiscard]] static std::size_t class_size(std::size_t cls) noexcept;
+    void refill(std::size_t cls);
+    std::byte* bump(std::size_t bytes, std::size_t alignment);
+    void add_mapping(std::size_t bytes, std::vector<HugePages::Mapping>& into);
+    void track(const HugePages::Mapping& m, int64_t sign) noexcept;
+
+    std::string name_;
+    std::size_t chunk_bytes_;
+    bool huge_pages_;
+    std::array<FreeBlock*, kClasses> free_{};
+    std::byte* cursor_ = nullptr;
+    std::byte* end_ = nullptr;
+    std::vector<HugePages::Mapping> chunks_;   // Slabs are carved from these
+    std::vector<HugePages::Mapping> blocks_;   // One large block each
+
+    std::size_t bytes_held_ = 0;
+    std::size_t hugetlb_bytes_ = 0;
+    std::size_t in_use_ = 0;
+    std::size_t high_water_ = 0;
+    uint64_t allocations_ = 0;
+
+    Metrics::Gauge held_metric_;
+    Metrics::Gauge hugetlb_metric_;
+    Metrics::Gauge peak_metric_;
+};
@@ -1,8 +1,35 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+// Latency distribution of one probe over one collection interval
+struct LatencySummary {
+    std::string_view probe;
+    uint64_t count = 0;
+    uint64_t min_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+};
 
 class ILogger {
 public:
     virtual ~ILogger() = default;
     virtual void log(const std::string& methodName, long durationMs) = 0;
+
+    // Default: one log() per statistic, named "<probe>.p99" and so on, in ns.
+    // Sinks whose log() column has a unit of its own override this.
+    virtual void log_latency(const LatencySummary& s) {
+        const std::string probe(s.probe);
+        log(probe + ".count", static_cast<long>(s.count));
+        log(probe + ".min", static_cast<long>(s.min_ns));
+        log(probe + ".p50", static_cast<long>(s.p50_ns));
+        log(probe + ".p90", static_cast<long>(s.p90_ns));
+        log(probe + ".p99", static_cast<long>(s.p99_ns));
+        log(probe + ".p999", static_cast<long>(s.p999_ns));
+        log(probe + ".max", static_cast<long>(s.max_ns));
+    }
 };
@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+//--------------------------------------------------------------------
+// LATENCY HISTOGRAM: HDR-style log-linear buckets. Every power of two
+// is split into 128 linear sub-buckets, so any recorded value is
+// reported within 1/128 (< 0.8%) of itself, from 1 up to 2^38.
+// Larger values land in the top bucket. Units are the caller's.
+//--------------------------------------------------------------------
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBits = 7;
+    static constexpr unsigned kMaxBits = 38;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBits;
+    static constexpr std::size_t kBuckets = (kMaxBits - kSubBits + 1) * kSubBuckets;
+    static constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxBits) - 1;
+
+    [[nodiscard]] static constexpr std::size_t bucket_of(uint64_t value) noexcept {
+        if (value > kMaxValue) value = kMaxValue;
+        if (value < kSubBuckets) return static_cast<std::size_t>(value);
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - kSubBits;
+        return ((shift + 1) << kSubBits) + static_cast<std::size_t>((value >> shift) - kSubBuckets);
+    }
+
+    // Highest value that maps to `bucket`
+    [[nodiscard]] static constexpr uint64_t value_of(std::size_t bucket) noexcept {
+        if (bucket < kSubBuckets) return bucket;
+        const unsigned shift = static_cast<unsigned>(bucket >> kSubBits) - 1;
+        const uint64_t low = (kSubBuckets + (bucket & (kSubBuckets - 1))) << shift;
+        return low + (uint64_t{1} << shift) - 1;
+    }
+
+    void add(uint64_t value, uint64_t count = 1) noexcept { add_bucket(bucket_of(value), count); }
+    void add_bucket(std::size_t bucket, uint64_t count) noexcept;
+    void merge(const LatencyHistogram& other) noexcept;
+    void clear() noexcept;
+
+    // Value at quantile q in [0, 1]; 0 when empty
+    [[nodiscard]] uint64_t percentile(double q) const noexcept;
+    [[nodiscard]] uint64_t min() const noexcept;
+    [[nodiscard]] uint64_t max() const noexcept;
+    [[nodiscard]] uint64_t count() const noexcept { return total_; }
+    [[nodiscard]] uint64_t count_at(std::size_t bucket) const noexcept { return counts_[bucket]; }
+
+private:
+    std::array<uint64_t, kBuckets> counts_{};
+    uint64_t total_ = 0;
+};
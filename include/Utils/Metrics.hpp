@@ -0,0 +1,184 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//--------------------------------------------------------------------
+// METRICS: counters, gauges and histograms living in a memory-mapped
+// file (by default under /dev/shm), so OceanMetrics or any other
+// process can read them with plain loads while we trade.
+//
+// The value area is split into writer slots. A thread claims a slot on
+// its first write, and each slot is its own run of cache lines. A
+// counter add or histogram observation is one relaxed fetch_add on the
+// calling thread's slot; readers sum the slots. A gauge is a single
+// cell on its own cache line and is stored, not summed.
+//
+// Names are Prometheus series names and may carry labels:
+//   ocean_ws_frames_total{symbol="btcusdt"}
+// Registering a name twice returns the same cells. A default-built
+// handle, or one the registry had no room for, writes to scratch
+// memory nobody reads.
+//--------------------------------------------------------------------
+namespace Metrics {
+
+enum class Kind : uint8_t { Counter = 1, Gauge = 2, Histogram = 3 };
+
+// Histogram bucket b counts values v with bit_width(v) == b: [2^(b-1), 2^b)
+constexpr std::size_t kHistogramBuckets = 64;
+
+namespace detail {
+inline std::array<std::atomic<uint64_t>, kHistogramBuckets> scratch{};
+
+constexpr uint32_t kNoSlot = ~0u;
+inline std::atomic<uint32_t> next_slot{0};
+inline thread_local uint32_t slot = kNoSlot;
+
+[[nodiscard]] inline uint32_t this_slot() noexcept {
+    if (slot == kNoSlot) [[unlikely]] slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+}
+
+// Cells of one metric: slot s starts at base + s * stride
+struct Cells {
+    std::atomic<uint64_t>* base = detail::scratch.data();
+    uint32_t stride = 0;
+    uint32_t slot_mask = 0;
+
+    [[nodiscard]] std::atomic<uint64_t>* mine() const noexcept {
+        return base + static_cast<std::size_t>(detail::this_slot() & slot_mask) * stride;
+    }
+};
+
+class Counter {
+public:
+    Counter() = default;
+    explicit Counter(Cells cells) noexcept : cells_(cells) {}
+
+    void add(uint64_t n = 1) const noexcept { cells_.mine()->fetch_add(n, std::memory_order_relaxed); }
+
+    // Summed over writer slots, for in-process checks; other processes use Reader
+    [[nodiscard]] uint64_t total() const noexcept {
+        uint64_t sum = 0;
+        for (uint32_t s = 0; s <= cells_.slot_mask; ++s) {
+            sum += cells_.base[static_cast<std::size_t>(s) * cells_.stride].load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+private:
+    Cells cells_;
+};
+
+class Gauge {
+public:
+    Gauge() = default;
+    explicit Gauge(Cells cells) noexcept : cell_(cells.base) {}
+
+    void set(int64_t value) const noexcept { cell_->store(static_cast<uint64_t>(value), std::memory_order_relaxed); }
+    void add(int64_t delta) const noexcept { cell_->fetch_add(static_cast<uint64_t>(delta), std::memory_order_relaxed); }
+    [[nodiscard]] int64_t value() const noexcept { return static_cast<int64_t>(cell_->load(std::memory_order_relaxed)); }
+
+private:
+    std::atomic<uint64_t>* cell_ = detail::scratch.data();
+};
+
+class Histogram {
+public:
+    Histogram() = default;
+    explicit Histogram(Cells cells) noexcept : cells_(cells) {}
+
+    [[nodiscard]] static constexpr std::size_t bucket_of(uint64_t value) noexcept {
+        return std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(value)), kHistogramBuckets - 1);
+    }
+
+    void observe(uint64_t value) const noexcept {
+        cells_.mine()[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    Cells cells_;
+};
+
+class Registry {
+public:
+    struct Config {
+        std::string path;                  // Empty: anonymous memory, invisible outside the process
+        uint32_t max_metrics = 512;
+        uint32_t writer_slots = 16;        // Rounded up to a power of two; threads beyond share
+        uint32_t cells_per_slot = 4096;    // 8-byte cells; a histogram takes 64
+    };
+
+    // Replaces any file at `path` and maps it; throws std::runtime_error on failure
+    explicit Registry(Config cfg);
+    ~Registry();   // Unmaps; the file stays for post-mortem reads
+
+    Registry(const Registry&) = delete;
+    Registry& operator=(const Registry&) = delete;
+
+    // Throws std::invalid_argument if `name` exists with another kind
+    [[nodiscard]] Counter counter(std::string_view name, std::string_view help = {});
+    [[nodiscard]] Gauge gauge(std::string_view name, std::string_view help = {});
+    [[nodiscard]] Histogram histogram(std::string_view name, std::string_view help = {});
+
+    [[nodiscard]] const std::string& path() const noexcept { return path_; }
+
+private:
+    Cells add(std::string_view name, std::string_view help, Kind kind);
+
+    std::string path_;
+    std::size_t bytes_ = 0;
+    std::byte* map_ = nullptr;
+    uint32_t slot_mask_ = 0;
+    uint32_t next_cell_ = 0;
+    std::mutex mutex_;
+};
+
+// Maps the process-wide registry at `path`, else $OCEAN_METRICS_PATH,
+// else /dev/shm/ocean-metrics, replacing any file there. Only the process
+// OceanMetrics should watch calls this, before anything touches global().
+// Returns false if global() already ran or the file could not be made;
+// metrics then stay in-process.
+bool publish(std::string path = {});
+
+// The process-wide registry; anonymous memory unless publish() ran first
+Registry& global();
+
+struct Sample {
+    std::string name;
+    std::string help;
+    Kind kind = Kind::Counter;
+    int64_t value = 0;                                   // Counter total or gauge
+    std::array<uint64_t, kHistogramBuckets> buckets{};   // Histogram, summed over slots
+};
+
+// Read-only view of a registry file, from any process
+class Reader {
+public:
+    explicit Reader(const std::string& path);   // Throws std::runtime_error
+    ~Reader();
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    [[nodiscard]] std::vector<Sample> snapshot() const;
+    [[nodiscard]] uint32_t pid() const noexcept;
+
+private:
+    std::size_t bytes_ = 0;
+    const std::byte* map_ = nullptr;
+};
+
+// Prometheus text exposition format, version 0.0.4. Histogram _sum is
+// estimated from bucket midpoints; writers only count.
+[[nodiscard]] std::string to_prometheus(const std::vector<Sample>& samples);
+
+} // namespace Metrics
@@ -1,15 +1,117 @@
 #pragma once
 #include "ILogger.hpp"
-#include <curl/curl.h>
-#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
 
+#include <boost/lockfree/queue.hpp>
+
+//--------------------------------------------------------------------
+// QUESTDB LOGGER: measurements go into a fixed-size lock-free ring on
+// the calling thread and nowhere else. A background thread batches them
+// as InfluxDB Line Protocol over one persistent TCP connection to
+// QuestDB's ILP port, flushing when a batch is full or old enough.
+//
+// A full ring drops the record on the caller's side. A failed send
+// keeps the batch and retries it whole after a backoff. ILP over TCP
+// has no acknowledgement, so a retried batch may duplicate lines that
+// did land, and lines the kernel accepted just before the server went
+// away can still be lost.
+//--------------------------------------------------------------------
 class QuestDBLogger : public ILogger {
 public:
+    struct Config {
+        std::string host = "127.0.0.1";
+        uint16_t port = 9009;
+        std::string table = "execution_times";
+        std::string tag = "methodName";
+        std::string field = "durationMs";
+        std::string latency_table = "latency";   // log_latency() rows: one per probe and interval
+        std::string latency_tag = "probe";
+
+        std::size_t capacity = 1 << 14;                      // Records in flight, at most 65534
+        std::size_t batch_bytes = 64 * 1024;                 // Flush once a batch reaches this
+        std::chrono::milliseconds flush_interval{100};       // ...or its oldest line this age
+        std::chrono::milliseconds reconnect_backoff{500};
+    };
+
+    struct Stats {
+        std::atomic<uint64_t> dropped{0};      // Ring full on record()
+        std::atomic<uint64_t> written{0};      // Lines handed to the socket
+        std::atomic<uint64_t> retried{0};      // Lines re-sent after a broken connection
+        std::atomic<uint64_t> batches{0};
+        std::atomic<uint64_t> connects{0};
+        std::atomic<uint64_t> send_failures{0};
+    };
+
+    // Longer names are truncated so a record stays one cache line
+    static constexpr std::size_t kMaxName = 47;
+
     QuestDBLogger();
-    ~QuestDBLogger() override;
+    explicit QuestDBLogger(Config cfg);
+    ~QuestDBLogger() override;   // Makes one last attempt to send what is queued
+
+    QuestDBLogger(const QuestDBLogger&) = delete;
+    QuestDBLogger& operator=(const QuestDBLogger&) = delete;
+
     void log(const std::string& methodName, long durationMs) override;
 
+    // One row per summary in latency_table, with count and *_ns fields, so
+    // nanoseconds never land in the durationMs column. Not for the hot
+    // path: it formats and locks. Counts as dropped past batch_bytes pending.
+    void log_latency(const LatencySummary& s) override;
+
+    // Hot path: no allocation, no syscall. false when the record was dropped.
+    bool record(std::string_view name, int64_t value) noexcept;
+
+    // Blocks until everything recorded before the call is on the socket;
+    // false if that did not happen within `timeout`
+    bool flush(std::chrono::milliseconds timeout = std::chrono::seconds(1));
+
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+    [[nodiscard]] bool connected() const noexcept { return connected_.load(std::memory_order_relaxed); }
+
 private:
-    CURL* curlHandle;
-    void initializeCurl();
-};
\ No newline at end of file
+    struct Record {
+        uint64_t ts_ns;
+        int64_t value;
+        uint8_t name_size;
+        char name[kMaxName];
+    };
+    static_assert(sizeof(Record) == 64);
+
+    void run(std::stop_token st);
+    bool fill_batch();   // true when the ring was drained
+    void append(const Record& r);
+    bool send_batch();
+    bool connect();
+    void disconnect() noexcept;
+
+    Config cfg_;
+    boost::lockfree::queue<Record, boost::lockfree::fixed_sized<true>> ring_;
+    Stats stats_;
+
+    std::mutex latency_mutex_;
+    std::string latency_lines_;          // Formatted by log_latency(), taken whole by the writer
+    std::size_t latency_pending_ = 0;
+
+    // Writer-thread state
+    std::string line_prefix_;    // "<table>,<tag>="
+    std::string field_prefix_;   // " <field>="
+    std::string batch_;
+    std::size_t batch_lines_ = 0;
+    std::size_t batch_sent_ = 0;                         // Bytes of batch_ already written
+    std::chrono::steady_clock::time_point batch_start_{};
+    std::chrono::steady_clock::time_point retry_at_{};
+    int fd_ = -1;
+    std::atomic<bool> connected_{false};
+
+    std::atomic<uint64_t> flush_requested_{0};
+    std::atomic<uint64_t> flush_done_{0};
+
+    std::jthread writer_;
+};
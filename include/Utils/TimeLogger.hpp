@@ -1,15 +1,86 @@
 #pragma once
+#include <algorithm>
 #include <chrono>
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
 #include "ILogger.hpp"
+#include "LatencyHistogram.hpp"
+#include "Tsc.hpp"
 
+// String literal usable as a template argument: ScopeTimer<"parse_depth">
+template <std::size_t N>
+struct ProbeName {
+    char chars[N]{};
+    constexpr ProbeName(const char (&s)[N]) { std::copy_n(s, N, chars); }
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return {chars, N - 1}; }
+};
+
+using ProbeId = uint16_t;
+
+//--------------------------------------------------------------------
+// TIME LOGGER: latency probes for nanosecond-scale code. A ScopeTimer
+// reads the TSC on entry and exit and bumps one bucket of this
+// thread's histogram for its probe: no lock, no allocation, no shared
+// cache line. Probe names are interned once per name at startup.
+//
+// The TimeLogger itself is the collector. Every interval it merges
+// what each thread recorded since the last pass and hands percentiles
+// in nanoseconds to its ILogger sinks. Run one per process: each pass
+// takes the samples it exports.
+//--------------------------------------------------------------------
 class TimeLogger {
 public:
-    explicit TimeLogger(ILogger& logger, std::string methodName);
-    ~TimeLogger();
+    static constexpr std::size_t kMaxProbes = 256;
+
+    // Id for `name`, the same on every call; 0 ("<overflow>") once the table is full
+    static ProbeId intern(std::string_view name);
+
+    // Hot path: one sample of `ticks` (Tsc::ticks() difference) on this thread.
+    // The first sample of a probe on a thread allocates its histogram.
+    static void record(ProbeId probe, uint64_t ticks) noexcept;
+
+    // Everything recorded for `name` and collected so far, in ns
+    [[nodiscard]] static LatencyHistogram total(std::string_view name);
+
+    explicit TimeLogger(std::chrono::milliseconds interval = std::chrono::seconds(1));
+    ~TimeLogger();   // Runs a last collection
+
+    TimeLogger(const TimeLogger&) = delete;
+    TimeLogger& operator=(const TimeLogger&) = delete;
+
+    // Sinks must outlive the logger
+    void add_sink(ILogger& sink);
+
+    // One collection pass now, on the calling thread
+    void collect();
+
+private:
+    std::chrono::milliseconds interval_;
+    std::mutex sinks_mutex_;
+    std::vector<ILogger*> sinks_;
+    std::jthread collector_;
+};
+
+// Resolved during static initialization; a timer that runs before that
+// records under "<overflow>"
+template <ProbeName Name>
+struct Probe {
+    static inline const ProbeId id = TimeLogger::intern(Name.view());
+};
+
+template <ProbeName Name>
+class ScopeTimer {
+public:
+    ScopeTimer() noexcept : start_(Tsc::ticks()) {}
+    ~ScopeTimer() { TimeLogger::record(Probe<Name>::id, Tsc::ticks() - start_); }
+
+    ScopeTimer(const ScopeTimer&) = delete;
+    ScopeTimer& operator=(const ScopeTimer&) = delete;
 
 private:
-    ILogger& logger;
-    std::string methodName;
-    std::chrono::time_point<std::chrono::high_resolution_clock> start;
-};
\ No newline at end of file
+    uint64_t start_;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//--------------------------------------------------------------------
+// TSC: the cheapest clock there is, for timing code that runs in
+// nanoseconds. Ticks are only meaningful as differences; convert with
+// ns_per_tick(), calibrated once against the steady clock. Without an
+// invariant TSC (or off x86) ticks are steady-clock nanoseconds.
+//
+// rdtsc is not serializing: a sample can be off by the few
+// instructions the CPU reorders around it.
+//--------------------------------------------------------------------
+namespace Tsc {
+
+namespace detail {
+extern const bool invariant;
+}
+
+[[nodiscard]] inline uint64_t ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    if (detail::invariant) return __rdtsc();
+#endif
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Measured on first call (about 10 ms), then cached
+[[nodiscard]] double ns_per_tick() noexcept;
+
+[[nodiscard]] inline uint64_t to_ns(uint64_t ticks) noexcept {
+    return static_cast<uint64_t>(static_cast<double>(ticks) * ns_per_tick());
+}
+
+[[nodiscard]] inline bool is_invariant() noexcept { return detail::invariant; }
+
+} // namespace Tsc
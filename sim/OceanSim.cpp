@@ -0,0 +1,147 @@
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Sim/ExchangeSimulator.hpp"
+
+//--------------------------------------------------------------------
+// OceanSim: the exchange simulator as a standalone process.
+//   OceanSim --rate 200000 --ws-port 9443 --binary-port 1337
+// Point MarketData at 127.0.0.1:<binary-port>, or a BinanceWSClient at
+// set_endpoint("127.0.0.1", "<ws-port>"). While running, stdin takes:
+//   d          drop every session
+//   g [n]      skip n sequence ids (default --gap-size)
+//   r <rate>   change updates per second
+//   s          print stats now
+//   q          quit
+//--------------------------------------------------------------------
+namespace {
+std::atomic<bool> g_running{true};
+
+void on_signal(int) {
+    g_running = false;
+}
+
+template <typename T>
+bool parse(std::string_view text, T& out) {
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc{} && end == text.data() + text.size();
+}
+
+void usage() {
+    std::cerr << "usage: OceanSim [--binary-port P] [--ws-port P] [--rate N] [--levels N]\n"
+                 "                [--replay FILE] [--disconnect-every-ms MS]\n"
+                 "                [--gap-every N] [--gap-size N]\n"
+                 "A port of 0 disables that listener.\n";
+}
+
+bool parse_args(int argc, char** argv, ExchangeSimulator::Config& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view flag = argv[i];
+        if (i + 1 >= argc) return false;
+        const std::string_view value = argv[++i];
+
+        bool ok = true;
+        if (flag == "--binary-port") {
+            ok = parse(value, cfg.binary_port);
+            cfg.serve_binary = cfg.binary_port != 0;
+        } else if (flag == "--ws-port") {
+            ok = parse(value, cfg.ws_port);
+            cfg.serve_websocket = cfg.ws_port != 0;
+        } else if (flag == "--rate") {
+            ok = parse(value, cfg.rate);
+        } else if (flag == "--levels") {
+            ok = parse(value, cfg.depth.levels);
+        } else if (flag == "--replay") {
+            cfg.replay_path = value;
+        } else if (flag == "--disconnect-every-ms") {
+            int64_t ms = 0;
+            ok = parse(value, ms);
+            cfg.disconnect_every = std::chrono::milliseconds(ms);
+        } else if (flag == "--gap-every") {
+            ok = parse(value, cfg.gap_every);
+        } else if (flag == "--gap-size") {
+            ok = parse(value, cfg.gap_size);
+        } else {
+            ok = false;
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+void print_stats(const ExchangeSimulator::Stats& stats, uint64_t& last_updates, uint64_t& last_bytes) {
+    const uint64_t updates = stats.updates_sent.load();
+    const uint64_t bytes = stats.bytes_sent.load();
+    std::cout << "[SIM] " << updates - last_updates << " upd/s, "
+              << (bytes - last_bytes) / 1024 << " KiB/s, sessions "
+              << stats.sessions_live.load() << " live / " << stats.sessions_opened.load()
+              << " opened, disconnects " << stats.disconnects.load()
+              << ", gaps " << stats.gaps.load() << "\n";
+    last_updates = updates;
+    last_bytes = bytes;
+}
+
+void read_commands(ExchangeSimulator& sim, const ExchangeSimulator::Config& cfg) {
+    for (std::string line; g_running && std::getline(std::cin, line);) {
+        std::istringstream in(line);
+        std::string cmd;
+        in >> cmd;
+        if (cmd == "d" || cmd == "disconnect") {
+            sim.inject_disconnect();
+        } else if (cmd == "g" || cmd == "gap") {
+            uint64_t n = cfg.gap_size;
+            in >> n;
+            sim.inject_gap(n);
+        } else if (cmd == "r" || cmd == "rate") {
+            double rate = 0;
+            if (in >> rate) sim.set_rate(rate);
+        } else if (cmd == "s" || cmd == "stats") {
+            const auto& s = sim.stats();
+            std::cout << "[SIM] total " << s.updates_sent.load() << " updates, "
+                      << s.bytes_sent.load() << " bytes\n";
+        } else if (cmd == "q" || cmd == "quit") {
+            break;
+        }
+    }
+    g_running = false;
+}
+}
+
+int main(int argc, char** argv) {
+    ExchangeSimulator::Config cfg;
+    if (!parse_args(argc, argv, cfg)) {
+        usage();
+        return 2;
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    ExchangeSimulator sim(cfg);
+    try {
+        sim.start();
+    } catch (const std::exception& e) {
+        std::cerr << "[SIM] " << e.what() << "\n";
+        return 1;
+    }
+    if (cfg.serve_binary) std::cout << "[SIM] Binary feed on 127.0.0.1:" << sim.binary_port() << "\n";
+    if (cfg.serve_websocket) std::cout << "[SIM] WebSocket feed on wss://127.0.0.1:" << sim.ws_port() << "\n";
+
+    // Detached: std::getline cannot be interrupted, and exit tears it down
+    std::thread(read_commands, std::ref(sim), std::cref(cfg)).detach();
+
+    uint64_t last_updates = 0, last_bytes = 0;
+    while (g_running) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        print_stats(sim.stats(), last_updates, last_bytes);
+    }
+
+    sim.stop();
+    return 0;
+}
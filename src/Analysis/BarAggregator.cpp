@@ -0,0 +1,109 @@
+#include "Analysis/BarAggregator.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+// Marks ring slots that never held a bar so bucket 0 can't alias them
+constexpr Bar kEmptySlot{.start_ns = std::numeric_limits<uint64_t>::max()};
+}
+
+BarAggregator::BarAggregator(std::span<const Timeframe> timeframes, std::pmr::memory_resource* memory) {
+    if (timeframes.empty()) {
+        throw std::invalid_argument("BarAggregator needs at least one timeframe");
+    }
+
+    frames_.reserve(timeframes.size());
+    for (const auto& tf : timeframes) {
+        if (tf.period.count() <= 0 || tf.history == 0) {
+            throw std::invalid_argument("Timeframe period and history must be positive");
+        }
+        frames_.push_back(Frame{
+            .period_ns = static_cast<uint64_t>(tf.period.count()),
+            .ring = std::pmr::vector<Bar>(tf.history, kEmptySlot, memory),
+            .phase = MarketPhaseDetector(tf.phase_window, memory),
+        });
+    }
+}
+
+void BarAggregator::on_trade(uint64_t ts_ns, float price, float amount) {
+    on_tick(ts_ns, price, amount, 1);
+}
+
+void BarAggregator::on_quote(uint64_t ts_ns, float mid) {
+    if (mid <= 0.0f) return; // One-sided or empty book
+    on_tick(ts_ns, mid, 0.0f, 0);
+}
+
+void BarAggregator::subscribe(Subscriber subscriber) {
+    subscribers_.push_back(std::move(subscriber));
+}
+
+//--------------------------------------------------------------------
+// ONE PASS: every timeframe sees the tick once. A tick in a later bucket
+// closes the bar being built; late ticks fold into the current bar.
+//--------------------------------------------------------------------
+void BarAggregator::on_tick(uint64_t ts_ns, float price, float amount, uint32_t trades) {
+    for (std::size_t i = 0; i < frames_.size(); ++i) {
+        Frame& frame = frames_[i];
+        const uint64_t bucket = ts_ns / frame.period_ns;
+
+        if (frame.open && bucket > frame.bucket) {
+            close_bar(i, frame);
+        }
+
+        if (!frame.open) {
+            frame.bucket = bucket;
+            frame.building = Bar{
+                .start_ns = bucket * frame.period_ns,
+                .open = price, .high = price, .low = price, .close = price,
+                .volume = amount, .trade_count = trades
+            };
+            frame.open = true;
+            continue;
+        }
+
+        Bar& bar = frame.building;
+        bar.high = std::max(bar.high, price);
+        bar.low = std::min(bar.low, price);
+        bar.close = price;
+        bar.volume += amount;
+        bar.trade_count += trades;
+    }
+}
+
+void BarAggregator::close_bar(std::size_t timeframe, Frame& frame) {
+    frame.ring[frame.bucket % frame.ring.size()] = frame.building;
+    frame.last_closed = frame.bucket;
+    frame.has_closed = true;
+    frame.open = false;
+
+    // Higher timeframes pay one phase update per bar, not per tick
+    frame.phase.update(frame.building.close);
+
+    for (const auto& subscriber : subscribers_) {
+        subscriber(timeframe, frame.building);
+    }
+}
+
+SunTzu::MarketPhase BarAggregator::phase(std::size_t timeframe) const {
+    return frames_.at(timeframe).phase.getPhase();
+}
+
+const Bar* BarAggregator::current(std::size_t timeframe) const noexcept {
+    if (timeframe >= frames_.size() || !frames_[timeframe].open) return nullptr;
+    return &frames_[timeframe].building;
+}
+
+const Bar* BarAggregator::closed(std::size_t timeframe, std::size_t back) const noexcept {
+    if (timeframe >= frames_.size()) return nullptr;
+
+    const Frame& frame = frames_[timeframe];
+    if (!frame.has_closed || back >= frame.ring.size() || back > frame.last_closed) {
+        return nullptr;
+    }
+
+    const uint64_t bucket = frame.last_closed - back;
+    const Bar& bar = frame.ring[bucket % frame.ring.size()];
+    return bar.start_ns == bucket * frame.period_ns ? &bar : nullptr;
+}
@@ -1,12 +1,62 @@
 #include "Analysis/MarketPhaseDetector.hpp"
-#include <numeric>
 #include <cmath>
 #include <algorithm> // For std::max/min
 
+MarketPhaseDetector::MarketPhaseDetector(std::size_t window, std::pmr::memory_resource* memory)
+    : prices_(std::max<std::size_t>(window, 2), 0.0f, memory) {}
+
+//--------------------------------------------------------------------
+// UPDATE: O(1) slide of the window. The evicted price takes its move
+// and its Welford contribution with it; the new price adds its own.
+//--------------------------------------------------------------------
 void MarketPhaseDetector::update(float price) {
-    prices_.push_back(price);
-    if (prices_.size() > 100) {
-        prices_.erase(prices_.begin());
+    const std::size_t capacity = prices_.size();
+
+    if (count_ < capacity) {
+        std::size_t tail = head_ + count_;
+        if (tail >= capacity) tail -= capacity;
+
+        if (count_ > 0) {
+            const std::size_t last = tail == 0 ? capacity - 1 : tail - 1;
+            addMove(static_cast<double>(price) - prices_[last]);
+        }
+        prices_[tail] = price;
+        ++count_;
+
+        // Welford: grow
+        const double delta = price - mean_;
+        mean_ += delta / static_cast<double>(count_);
+        m2_ += delta * (price - mean_);
+        return;
+    }
+
+    const std::size_t next = head_ + 1 == capacity ? 0 : head_ + 1;
+    const std::size_t last = head_ == 0 ? capacity - 1 : head_ - 1;
+    const float evicted = prices_[head_];
+
+    removeMove(static_cast<double>(prices_[next]) - evicted);
+    addMove(static_cast<double>(price) - prices_[last]);
+
+    prices_[head_] = price;
+    head_ = next;
+
+    // Welford: replace evicted with price at constant n
+    const double n = static_cast<double>(count_);
+    const double oldMean = mean_;
+    const double delta = static_cast<double>(price) - evicted;
+    mean_ += delta / n;
+    m2_ = std::max(0.0, m2_ + delta * ((price - mean_) + (evicted - oldMean)));
+
+    // Resync once per full lap so rounding drift stays bounded (amortised O(1))
+    if (head_ == 0) {
+        upMoves_ = downMoves_ = absMoves_ = 0.0;
+        mean_ = m2_ = 0.0;
+        for (std::size_t i = 0; i < capacity; ++i) {
+            if (i > 0) addMove(static_cast<double>(prices_[i]) - prices_[i - 1]);
+            const double d = prices_[i] - mean_;
+            mean_ += d / static_cast<double>(i + 1);
+            m2_ += d * (prices_[i] - mean_);
+        }
     }
 }
 
@@ -16,21 +66,27 @@ SunTzu::MarketPhase MarketPhaseDetector::getPhase() const {
     return SunTzu::MarketPhase::RANGING;
 }
 
+void MarketPhaseDetector::addMove(double change) noexcept {
+    upMoves_ += std::max(change, 0.0);
+    downMoves_ += std::max(-change, 0.0);
+    absMoves_ += std::abs(change);
+}
+
+void MarketPhaseDetector::removeMove(double change) noexcept {
+    upMoves_ = std::max(0.0, upMoves_ - std::max(change, 0.0));
+    downMoves_ = std::max(0.0, downMoves_ - std::max(-change, 0.0));
+    absMoves_ = std::max(0.0, absMoves_ - std::abs(change));
+}
+
 //--------------------------------------------------------------------
 // TRENDING DETECTION: "Is the market making sustained directional moves?"
 //--------------------------------------------------------------------
 bool MarketPhaseDetector::isTrending() const {
-    if (prices_.size() < 20) return false; // Not enough data
-
-    // Calculate Average Directional Movement (ADX-like logic)
-    float avgUpMove = 0.0f, avgDownMove = 0.0f;
-    for (size_t i = 1; i < prices_.size(); ++i) {
-        const float change = prices_[i] - prices_[i-1];
-        avgUpMove += std::max(change, 0.0f);    // Upward movement
-        avgDownMove += std::abs(std::min(change, 0.0f)); // Downward movement
-    }
-    avgUpMove /= prices_.size();
-    avgDownMove /= prices_.size();
+    if (count_ < 20) return false; // Not enough data
+
+    // Average Directional Movement (ADX-like logic) from the running sums
+    const float avgUpMove = static_cast<float>(upMoves_ / count_);
+    const float avgDownMove = static_cast<float>(downMoves_ / count_);
 
     // Trending if one side dominates by 30%
     const float strength = std::abs(avgUpMove - avgDownMove) /
@@ -42,35 +98,19 @@ bool MarketPhaseDetector::isTrending() const {
 // CHAOS DETECTION: "Is the market erratic and volatile?"
 //--------------------------------------------------------------------
 bool MarketPhaseDetector::isChaos() const {
-    if (prices_.size() < 10) return false;
+    if (count_ < 10) return false;
 
-    // Calculate average true range (ATR-like)
-    float avgRange = 0.0f;
-    for (size_t i = 1; i < prices_.size(); ++i) {
-        avgRange += std::abs(prices_[i] - prices_[i-1]);
-    }
-    avgRange /= prices_.size();
+    // Average true range (ATR-like) from the running absolute moves
+    const float avgRange = static_cast<float>(absMoves_ / count_);
 
     // Chaos = volatility spikes (2x average)
     return avgRange > 2.0f * getVolatility();
 }
 
 //--------------------------------------------------------------------
-// VOLATILITY CALCULATION: Standard deviation of prices
+// VOLATILITY CALCULATION: Standard deviation of prices (Welford)
 //--------------------------------------------------------------------
 float MarketPhaseDetector::getVolatility() const {
-    if (prices_.empty()) return 0.0f;
-
-    // Calculate mean
-    const float mean = std::accumulate(prices_.begin(), prices_.end(), 0.0f)
-                     / prices_.size();
-
-    // Calculate variance
-    float variance = 0.0f;
-    for (float price : prices_) {
-        variance += std::pow(price - mean, 2);
-    }
-    variance /= prices_.size();
-
-    return std::sqrt(variance); // Standard deviation
-}
\ No newline at end of file
+    if (count_ == 0) return 0.0f;
+    return static_cast<float>(std::sqrt(m2_ / count_)); // Standard deviation
+}
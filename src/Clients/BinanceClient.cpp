@@ -0,0 +1,109 @@
+#include "Clients/BinanceClient.hpp"
+#include "Clients/BinanceWSClient.hpp"
+#include "Utils/AsyncLog.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <string_view>
+#include <thread>
+
+namespace {
+// Spot quote assets; anything else is rejected before we open a socket
+constexpr std::array<std::string_view, 8> kQuoteAssets{
+    "usdt", "fdusd", "usdc", "busd", "btc", "eth", "bnb", "try"
+};
+
+bool is_valid_symbol(std::string_view symbol) {
+    if (symbol.size() < 5 || symbol.size() > 20) return false;
+    if (!std::all_of(symbol.begin(), symbol.end(),
+                     [](unsigned char c) { return std::isalnum(c); })) {
+        return false;
+    }
+    return std::any_of(kQuoteAssets.begin(), kQuoteAssets.end(), [&](std::string_view quote) {
+        return symbol.size() > quote.size() && symbol.ends_with(quote);
+    });
+}
+}
+
+struct BinanceClient::Runtime {
+    net::io_context ioc;
+    ssl::context ctx{ssl::context::tlsv12_client};
+    net::executor_work_guard<net::io_context::executor_type> work{net::make_work_guard(ioc)};
+    std::unique_ptr<BinanceWSClient> ws;
+    std::thread io_thread;
+};
+
+BinanceClient::BinanceClient(std::string symbol) : symbol_(std::move(symbol)) {
+    std::transform(symbol_.begin(), symbol_.end(), symbol_.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    drained_.resize(kQueueCapacity);
+}
+
+BinanceClient::~BinanceClient() {
+    stop();
+}
+
+bool BinanceClient::start() noexcept {
+    if (!is_valid_symbol(symbol_)) return false;
+    if (running_.exchange(true)) return false;  // Already running
+
+    try {
+        runtime_ = std::make_unique<Runtime>();
+        runtime_->ctx.set_default_verify_paths();
+        runtime_->ws = std::make_unique<BinanceWSClient>(runtime_->ioc, runtime_->ctx, symbol_);
+        if (!host_.empty()) runtime_->ws->set_endpoint(host_, port_);
+
+        // io thread: the only producer into buffer_ and frames_. Levels go
+        // first, so a length the consumer pops always has its levels behind it.
+        runtime_->ws->on_depth([this](std::span<const OrderBook::Order> levels) {
+            if (buffer_.write_available() < levels.size() || frames_.write_available() == 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);   // Never half a snapshot
+                return;
+            }
+            buffer_.push(levels.data(), levels.size());
+            frames_.push(levels.size());
+            notifier_.notify();
+        });
+
+        runtime_->ws->start();
+        runtime_->io_thread = std::thread([rt = runtime_.get()] { rt->ioc.run(); });
+        return true;
+    } catch (const std::exception& e) {
+        OCEAN_LOG_ERROR("[BINANCE] Start failed: {}", e.what());
+        runtime_.reset();
+        running_ = false;
+        return false;
+    }
+}
+
+void BinanceClient::stop() noexcept {
+    if (!running_.exchange(false) || !runtime_) return;
+
+    runtime_->ws->stop();
+    runtime_->work.reset();
+    runtime_->ioc.stop();
+    if (runtime_->io_thread.joinable()) runtime_->io_thread.join();
+
+    runtime_->ws.reset();
+    runtime_.reset();
+}
+
+void BinanceClient::set_endpoint(std::string host, std::string port) {
+    host_ = std::move(host);
+    port_ = std::move(port);
+}
+
+std::size_t BinanceClient::drain(std::span<OrderBook::Order> out) noexcept {
+    // Snapshots are absolute: each frame overwrites the one before it
+    std::size_t newest = 0;
+    std::size_t levels = 0;
+    while (frames_.pop(levels)) {
+        newest = buffer_.pop(out.data(), std::min(levels, out.size()));
+        for (std::size_t i = newest; i < levels; ++i) buffer_.consume_one([](const OrderBook::Order&) {});
+    }
+    return newest;
+}
+
+std::span<const OrderBook::Order> BinanceClient::get_updates() noexcept {
+    return {drained_.data(), drain(drained_)};
+}
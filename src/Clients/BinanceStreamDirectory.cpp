@@ -0,0 +1,140 @@
+#include "Clients/BinanceStreamDirectory.hpp"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+const std::string kEmpty;
+
+std::string lowercase(std::string_view s) {
+    std::string out(s);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+}
+
+BinanceStreamDirectory::BinanceStreamDirectory(std::string stream_suffix, std::size_t streams_per_shard)
+    : suffix_(std::move(stream_suffix)),
+      per_shard_(std::clamp<std::size_t>(streams_per_shard, 1, kMaxStreamsPerConnection)) {}
+
+std::optional<BinanceStreamDirectory::Assignment>
+BinanceStreamDirectory::add(std::string_view symbol, OrderBook& book) {
+    std::string name = lowercase(symbol);
+    std::string stream_name = name + suffix_;
+    if (by_stream_.contains(stream_name)) return std::nullopt;
+
+    Assignment a;
+    // First shard with room keeps connections packed after unsubscribes
+    const auto open = std::find_if(shard_load_.begin(), shard_load_.end(),
+                                   [&](std::size_t load) { return load < per_shard_; });
+    if (open == shard_load_.end()) {
+        a.shard = shard_load_.size();
+        a.new_shard = true;
+        shard_load_.push_back(0);
+    } else {
+        a.shard = static_cast<std::size_t>(open - shard_load_.begin());
+    }
+    ++shard_load_[a.shard];
+
+    if (!free_ids_.empty()) {
+        a.id = free_ids_.back();
+        free_ids_.pop_back();
+    } else {
+        a.id = static_cast<SymbolId>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    by_stream_.emplace(stream_name, a.id);
+    slots_[a.id] = Slot{std::move(name), std::move(stream_name), &book, a.shard, true};
+    return a;
+}
+
+std::optional<BinanceStreamDirectory::Assignment>
+BinanceStreamDirectory::remove(std::string_view symbol) {
+    const auto it = by_stream_.find(lowercase(symbol) + suffix_);
+    if (it == by_stream_.end()) return std::nullopt;
+
+    Slot& slot = slots_[it->second];
+    const Assignment a{it->second, slot.shard, false};
+    --shard_load_[slot.shard];
+    slot.live = false;
+    slot.book = nullptr;
+    free_ids_.push_back(it->second);
+    by_stream_.erase(it);
+    return a;
+}
+
+BinanceStreamDirectory::SymbolId BinanceStreamDirectory::find(std::string_view stream) const noexcept {
+    const auto it = by_stream_.find(stream);
+    return it == by_stream_.end() ? kNoSymbol : it->second;
+}
+
+OrderBook* BinanceStreamDirectory::book(SymbolId id) const noexcept {
+    return id < slots_.size() ? slots_[id].book : nullptr;
+}
+
+const std::string& BinanceStreamDirectory::symbol(SymbolId id) const noexcept {
+    return id < slots_.size() && slots_[id].live ? slots_[id].symbol : kEmpty;
+}
+
+const std::string& BinanceStreamDirectory::stream(SymbolId id) const noexcept {
+    return id < slots_.size() && slots_[id].live ? slots_[id].stream : kEmpty;
+}
+
+std::vector<std::string> BinanceStreamDirectory::streams(std::size_t shard) const {
+    std::vector<std::string> out;
+    out.reserve(shard_load(shard));
+    for (const Slot& slot : slots_) {
+        if (slot.live && slot.shard == shard) out.push_back(slot.stream);
+    }
+    return out;
+}
+
+std::size_t BinanceStreamDirectory::shard_load(std::size_t shard) const noexcept {
+    return shard < shard_load_.size() ? shard_load_[shard] : 0;
+}
+
+//------------------------------------------------------------------
+// Wire helpers
+//------------------------------------------------------------------
+std::string_view BinanceStreamDirectory::stream_name(std::string_view frame) noexcept {
+    constexpr std::string_view kKey = "\"stream\":\"";
+    const std::size_t begin = frame.find(kKey);
+    if (begin == std::string_view::npos) return {};
+
+    const std::size_t from = begin + kKey.size();
+    const std::size_t end = frame.find('"', from);
+    if (end == std::string_view::npos) return {};
+    return frame.substr(from, end - from);
+}
+
+std::pair<std::string, std::size_t> BinanceStreamDirectory::combined_path(
+    std::span<const std::string> streams, std::size_t max_length) {
+    std::string path = "/stream?streams=";
+    std::size_t included = 0;
+    for (const std::string& s : streams) {
+        const std::size_t extra = s.size() + (included ? 1 : 0);
+        if (path.size() + extra > max_length) break;
+        if (included) path += '/';
+        path += s;
+        ++included;
+    }
+    return {std::move(path), included};
+}
+
+std::string BinanceStreamDirectory::control_frame(
+    std::string_view method, std::span<const std::string> streams, uint64_t id) {
+    std::string frame = "{\"method\":\"";
+    frame += method;
+    frame += "\",\"params\":[";
+    for (std::size_t i = 0; i < streams.size(); ++i) {
+        if (i) frame += ',';
+        frame += '"';
+        frame += streams[i];
+        frame += '"';
+    }
+    frame += "],\"id\":";
+    frame += std::to_string(id);
+    frame += '}';
+    return frame;
+}
@@ -0,0 +1,471 @@
+#include "Clients/BinanceStreamMux.hpp"
+#include "Clients/BinanceWire.hpp"
+#include "Clients/HandlerMemory.hpp"
+#include "Utils/AsyncLog.hpp"
+#include <algorithm>
+#include <cctype>
+#include <optional>
+#include <shared_mutex>
+
+namespace {
+// Streams that do not fit in the handshake path go out as SUBSCRIBE frames
+constexpr std::size_t kMaxPathLength = 2048;
+// Binance drops connections sending more than 5 control messages a second
+constexpr std::size_t kControlBatch = 200;
+constexpr auto kControlInterval = std::chrono::milliseconds(250);
+
+std::string lowercase(std::string_view s) {
+    std::string out(s);
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return out;
+}
+}
+
+struct BinanceStreamMux::State {
+    State(net::io_context& io, ssl::context& tls, Config c)
+        : ioc(io), ctx(tls), cfg(std::move(c)),
+          suffix("@depth" + std::to_string(cfg.depth_level) + "@" + cfg.update_speed),
+          directory(suffix, cfg.streams_per_connection) {}
+
+    net::io_context& ioc;
+    ssl::context& ctx;
+    Config cfg;
+    std::string suffix;
+
+    mutable std::shared_mutex mutex;   // Guards directory and shards
+    BinanceStreamDirectory directory;
+    std::vector<std::shared_ptr<Shard>> shards;
+
+    DepthHandler handler;
+    DataNotifier notifier;
+    std::atomic<bool> running{false};
+};
+
+//------------------------------------------------------------------
+// One TLS connection carrying up to streams_per_connection streams.
+// Every handler runs on the shard's strand.
+//------------------------------------------------------------------
+class BinanceStreamMux::Shard : public std::enable_shared_from_this<Shard> {
+public:
+    Shard(const std::shared_ptr<State>& state, std::size_t index)
+        : state_(state),
+          index_(index),
+          host_(state->cfg.host),
+          port_(state->cfg.port),
+          strand_(net::make_strand(state->ioc)),
+          resolver_(strand_),
+          reconnect_timer_(strand_),
+          control_timer_(strand_) {
+        levels_.reserve(2 * static_cast<std::size_t>(state->cfg.depth_level));
+    }
+
+    // Connects if idle; a connection in progress picks the stream up when
+    // it reconciles after the handshake
+    void request(bool subscribe, std::string stream) {
+        net::post(strand_, [self = shared_from_this(), subscribe, stream = std::move(stream)]() mutable {
+            if (!self->active_) return self->wake_on_strand();
+            if (!self->live_) return;
+            self->queue(subscribe, std::move(stream));
+            if (!subscribe && self->directory_streams().empty()) return self->close_idle();
+            self->flush();
+        });
+    }
+
+    void wake() {
+        net::post(strand_, [self = shared_from_this()] { self->wake_on_strand(); });
+    }
+
+    void stop() {
+        net::post(strand_, [self = shared_from_this()] {
+            self->stopping_ = true;
+            self->active_ = false;
+            self->live_ = false;
+            self->reconnect_timer_.cancel();
+            self->control_timer_.cancel();
+            if (!self->closing_ && self->ws_ && self->ws_->is_open()) {
+                self->ws_->async_close(websocket::close_code::normal, [self](beast::error_code ec) {
+                    if (ec) OCEAN_LOG_WARN("[MUX {}] Close error: {}", self->index_, ec.message());
+                });
+            }
+        });
+    }
+
+private:
+    // Typed on the strand rather than tcp_stream's any_io_executor, which
+    // is too small to hold a strand and copies it to the heap in every
+    // read op (see BinanceWSClient)
+    using Strand = net::strand<net::io_context::executor_type>;
+    using Stream = websocket::stream<beast::ssl_stream<beast::basic_stream<tcp, Strand>>>;
+
+    std::weak_ptr<State> state_;
+    const std::size_t index_;
+    const std::string host_;
+    const std::string port_;
+    Strand strand_;
+    tcp::resolver resolver_;
+    net::steady_timer reconnect_timer_;
+    net::steady_timer control_timer_;
+    std::optional<Stream> ws_;   // Rebuilt per attempt; a failed TLS stream can't be reused
+    beast::flat_buffer buffer_;
+    HandlerMemory read_memory_;
+    std::vector<OrderBook::Order> levels_;  // Reused for every depth message
+
+    std::vector<std::string> in_path_;      // Streams named in the handshake path
+    std::vector<std::string> pending_subscribe_;
+    std::vector<std::string> pending_unsubscribe_;
+    std::string outbox_;
+    uint64_t next_request_id_ = 1;
+    int reconnect_attempts_ = 0;
+
+    bool active_ = false;     // Connected or trying to be
+    bool live_ = false;       // Handshake done, reading
+    bool writing_ = false;
+    bool pacing_ = false;
+    bool stopping_ = false;
+    bool reading_ = false;
+    bool parked_ = false;     // Closed for want of streams, until it connects again
+    bool closing_ = false;    // That close is still in flight
+
+    std::vector<std::string> directory_streams() const {
+        const auto state = state_.lock();
+        if (!state) return {};
+        std::shared_lock lock(state->mutex);
+        return state->directory.streams(index_);
+    }
+
+    void set_connected(bool connected) {
+        live_ = connected;
+        if (const auto state = state_.lock()) state->notifier.notify();
+    }
+
+    void wake_on_strand() {
+        stopping_ = false;
+        if (active_) return;
+        active_ = true;
+        if (parked_) return reopen();
+        run();
+    }
+
+    // Nothing is routed here any more: hang up instead of holding a TLS
+    // session open, and connect again on the next subscribe
+    void close_idle() {
+        OCEAN_LOG_INFO("[MUX {}] No streams left, closing", index_);
+        active_ = false;
+        parked_ = closing_ = true;
+        pending_subscribe_.clear();
+        pending_unsubscribe_.clear();
+        control_timer_.cancel();
+        set_connected(false);
+        ws_->async_close(websocket::close_code::normal, [self = shared_from_this()](beast::error_code ec) {
+            if (ec) OCEAN_LOG_WARN("[MUX {}] Close error: {}", self->index_, ec.message());
+            self->closing_ = false;
+            self->reopen();
+        });
+    }
+
+    // Connects a parked shard that was asked for again, once the close and
+    // the last read are done with the old stream
+    void reopen() {
+        if (closing_ || reading_ || !active_ || stopping_) return;
+        parked_ = false;
+        run();
+    }
+
+    void run() {
+        if (stopping_) return;
+        // Nothing routed here (everything unsubscribed): stay idle until asked
+        if (directory_streams().empty()) {
+            active_ = false;
+            return;
+        }
+        resolver_.async_resolve(host_, port_,
+            beast::bind_front_handler(&Shard::on_resolve, shared_from_this()));
+    }
+
+    void schedule_reconnect() {
+        live_ = false;
+        pending_subscribe_.clear();
+        pending_unsubscribe_.clear();
+        if (stopping_) return;
+
+        const int delay_ms = std::min(1000 * (1 << std::min(reconnect_attempts_, 5)), 30000);
+        ++reconnect_attempts_;
+        OCEAN_LOG_INFO("[MUX {}] Reconnect {} in {}ms", index_, reconnect_attempts_, delay_ms);
+
+        reconnect_timer_.expires_after(std::chrono::milliseconds(delay_ms));
+        reconnect_timer_.async_wait([self = shared_from_this()](beast::error_code ec) {
+            if (ec || self->stopping_) return;
+            self->run();
+        });
+    }
+
+    void on_resolve(beast::error_code ec, tcp::resolver::results_type results) {
+        if (stopping_) return;
+        if (ec) {
+            OCEAN_LOG_ERROR("[MUX {}] Resolve error: {}", index_, ec.message());
+            return schedule_reconnect();
+        }
+        const auto state = state_.lock();
+        if (!state) return;
+
+        ws_.emplace(strand_, state->ctx);
+        beast::get_lowest_layer(*ws_).expires_after(std::chrono::seconds(5));
+        beast::get_lowest_layer(*ws_).async_connect(results,
+            beast::bind_front_handler(&Shard::on_connect, shared_from_this()));
+    }
+
+    void on_connect(beast::error_code ec, tcp::endpoint) {
+        if (stopping_) return;
+        if (ec) {
+            OCEAN_LOG_ERROR("[MUX {}] Connect error: {}", index_, ec.message());
+            return schedule_reconnect();
+        }
+        beast::get_lowest_layer(*ws_).expires_never();
+
+        if (!SSL_set_tlsext_host_name(ws_->next_layer().native_handle(), host_.c_str())) {
+            OCEAN_LOG_ERROR("[MUX {}] Failed to set SNI", index_);
+            return schedule_reconnect();
+        }
+        ws_->next_layer().async_handshake(ssl::stream_base::client,
+            beast::bind_front_handler(&Shard::on_ssl_handshake, shared_from_this()));
+    }
+
+    void on_ssl_handshake(beast::error_code ec) {
+        if (stopping_) return;
+        if (ec) {
+            OCEAN_LOG_ERROR("[MUX {}] TLS handshake error: {}", index_, ec.message());
+            return schedule_reconnect();
+        }
+        ws_->set_option(websocket::stream_base::timeout::suggested(beast::role_type::client));
+        if (const auto state = state_.lock(); state && state->cfg.compression) {
+            websocket::permessage_deflate pmd;
+            pmd.client_enable = true;
+            ws_->set_option(pmd);
+        }
+
+        // Snapshot now; anything that changes before the handshake completes
+        // is reconciled with SUBSCRIBE/UNSUBSCRIBE in on_handshake()
+        std::vector<std::string> streams = directory_streams();
+        auto [path, included] = BinanceStreamDirectory::combined_path(streams, kMaxPathLength);
+        streams.resize(included);
+        in_path_ = std::move(streams);
+
+        ws_->async_handshake(host_, path,
+            beast::bind_front_handler(&Shard::on_handshake, shared_from_this()));
+    }
+
+    void on_handshake(beast::error_code ec) {
+        if (stopping_) return;
+        if (ec) {
+            OCEAN_LOG_ERROR("[MUX {}] WebSocket handshake error: {}", index_, ec.message());
+            return schedule_reconnect();
+        }
+        reconnect_attempts_ = 0;
+        writing_ = pacing_ = false;
+        set_connected(true);
+
+        std::vector<std::string> wanted = directory_streams();
+        std::sort(wanted.begin(), wanted.end());
+        std::sort(in_path_.begin(), in_path_.end());
+        std::set_difference(wanted.begin(), wanted.end(), in_path_.begin(), in_path_.end(),
+                            std::back_inserter(pending_subscribe_));
+        std::set_difference(in_path_.begin(), in_path_.end(), wanted.begin(), wanted.end(),
+                            std::back_inserter(pending_unsubscribe_));
+        // Everything was unsubscribed while connecting
+        if (wanted.empty()) return close_idle();
+        OCEAN_LOG_INFO("[MUX {}] Live with {} streams", index_, wanted.size());
+
+        flush();
+        do_read();
+    }
+
+    //------------------------------------------------------------------
+    // Control frames: batched and paced under the per-connection limit
+    //------------------------------------------------------------------
+    void queue(bool subscribe, std::string stream) {
+        auto& add = subscribe ? pending_subscribe_ : pending_unsubscribe_;
+        auto& cancel = subscribe ? pending_unsubscribe_ : pending_subscribe_;
+        // A request still waiting to go out is simply withdrawn
+        if (const auto it = std::find(cancel.begin(), cancel.end(), stream); it != cancel.end()) {
+            cancel.erase(it);
+        }
+        add.push_back(std::move(stream));
+    }
+
+    void flush() {
+        if (!live_ || writing_ || pacing_) return;
+
+        const bool unsubscribe = !pending_unsubscribe_.empty();
+        auto& pending = unsubscribe ? pending_unsubscribe_ : pending_subscribe_;
+        if (pending.empty()) return;
+
+        const std::size_t n = std::min(pending.size(), kControlBatch);
+        outbox_ = BinanceStreamDirectory::control_frame(
+            unsubscribe ? "UNSUBSCRIBE" : "SUBSCRIBE",
+            std::span<const std::string>(pending.data(), n), next_request_id_++);
+        pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(n));
+
+        writing_ = true;
+        ws_->async_write(net::buffer(outbox_),
+            beast::bind_front_handler(&Shard::on_write, shared_from_this()));
+    }
+
+    void on_write(beast::error_code ec, std::size_t) {
+        writing_ = false;
+        if (ec) {
+            // The read side sees the same failure and reconnects
+            OCEAN_LOG_WARN("[MUX {}] Control write error: {}", index_, ec.message());
+            return;
+        }
+        pacing_ = true;
+        control_timer_.expires_after(kControlInterval);
+        control_timer_.async_wait([self = shared_from_this()](beast::error_code wait_ec) {
+            self->pacing_ = false;
+            if (!wait_ec) self->flush();
+        });
+    }
+
+    //------------------------------------------------------------------
+    // Read path: stream name -> id -> book
+    //------------------------------------------------------------------
+    void do_read() {
+        if (stopping_) return;
+        reading_ = true;
+        ws_->async_read(buffer_,
+            recycling(read_memory_, beast::bind_front_handler(&Shard::on_read, shared_from_this())));
+    }
+
+    void on_read(beast::error_code ec, std::size_t) {
+        reading_ = false;
+        if (ec && parked_) return reopen();
+        if (ec) {
+            if (ec != websocket::error::closed) {
+                OCEAN_LOG_ERROR("[MUX {}] Read error: {}", index_, ec.message());
+            }
+            set_connected(false);
+            return schedule_reconnect();
+        }
+
+        const auto data = buffer_.cdata();
+        route(std::string_view(static_cast<const char*>(data.data()), data.size()));
+        buffer_.consume(buffer_.size());
+        do_read();
+    }
+
+    void route(std::string_view frame) {
+        const std::string_view stream = BinanceStreamDirectory::stream_name(frame);
+        if (stream.empty()) return;  // SUBSCRIBE/UNSUBSCRIBE acknowledgement
+
+        const auto state = state_.lock();
+        if (!state) return;
+
+        if (!BinanceWire::parse_depth(frame, levels_)) {
+            // A bad feed can fail every frame; the limit keeps this off the read loop's back
+            OCEAN_LOG_RATE(LogLevel::Error, 10, "[MUX {}] Malformed frame on {}", index_, stream);
+            return;
+        }
+
+        {
+            // Held until the handler returns: unsubscribe() takes the lock
+            // exclusively, so once it returns nothing here still uses the book
+            std::shared_lock lock(state->mutex);
+            const SymbolId id = state->directory.find(stream);
+            if (id == kNoSymbol) return;  // In flight when it was unsubscribed
+            OrderBook* book = state->directory.book(id);
+
+            // Partial depth is absolute: adding it would grow every level on each
+            // frame and keep levels that left the top N
+            if (BinanceWire::is_depth_update(frame)) {
+                book->update(levels_);
+            } else {
+                book->apply_snapshot(levels_);
+            }
+            if (state->handler) state->handler(id, levels_);
+        }
+        state->notifier.notify();
+    }
+};
+
+//------------------------------------------------------------------
+// BinanceStreamMux
+//------------------------------------------------------------------
+BinanceStreamMux::BinanceStreamMux(net::io_context& ioc, ssl::context& ctx)
+    : BinanceStreamMux(ioc, ctx, Config{}) {}
+
+BinanceStreamMux::BinanceStreamMux(net::io_context& ioc, ssl::context& ctx, Config cfg)
+    : state_(std::make_shared<State>(ioc, ctx, std::move(cfg))) {}
+
+BinanceStreamMux::~BinanceStreamMux() {
+    stop();
+}
+
+BinanceStreamMux::SymbolId BinanceStreamMux::subscribe(std::string_view symbol, OrderBook& book) {
+    std::shared_ptr<Shard> shard;
+    std::string stream;
+    SymbolId id;
+    {
+        std::unique_lock lock(state_->mutex);
+        const auto assignment = state_->directory.add(symbol, book);
+        if (!assignment) return kNoSymbol;
+
+        if (assignment->new_shard) {
+            state_->shards.push_back(std::make_shared<Shard>(state_, assignment->shard));
+        }
+        shard = state_->shards[assignment->shard];
+        stream = state_->directory.stream(assignment->id);
+        id = assignment->id;
+    }
+
+    if (state_->running.load()) shard->request(true, std::move(stream));
+    return id;
+}
+
+bool BinanceStreamMux::unsubscribe(std::string_view symbol) {
+    std::shared_ptr<Shard> shard;
+    {
+        std::unique_lock lock(state_->mutex);
+        const auto assignment = state_->directory.remove(symbol);
+        if (!assignment) return false;
+        shard = state_->shards[assignment->shard];
+    }
+
+    if (state_->running.load()) shard->request(false, lowercase(symbol) + state_->suffix);
+    return true;
+}
+
+void BinanceStreamMux::start() {
+    if (state_->running.exchange(true)) return;
+    std::shared_lock lock(state_->mutex);
+    for (const auto& shard : state_->shards) shard->wake();
+}
+
+void BinanceStreamMux::stop() {
+    if (!state_->running.exchange(false)) return;
+    std::shared_lock lock(state_->mutex);
+    for (const auto& shard : state_->shards) shard->stop();
+}
+
+void BinanceStreamMux::on_depth(DepthHandler handler) {
+    state_->handler = std::move(handler);
+}
+
+std::size_t BinanceStreamMux::connections() const {
+    std::shared_lock lock(state_->mutex);
+    return state_->shards.size();
+}
+
+std::size_t BinanceStreamMux::symbols() const {
+    std::shared_lock lock(state_->mutex);
+    return state_->directory.size();
+}
+
+BinanceStreamMux::SymbolId BinanceStreamMux::id_of(std::string_view symbol) const {
+    const std::string stream = lowercase(symbol) + state_->suffix;
+    std::shared_lock lock(state_->mutex);
+    return state_->directory.find(stream);
+}
+
+DataNotifier& BinanceStreamMux::notifier() noexcept {
+    return state_->notifier;
+}
@@ -1,16 +1,44 @@
 #include "Clients/BinanceWSClient.hpp"
+#include "Clients/BinanceWire.hpp"
+#include "Clients/HandlerMemory.hpp"
+#include "Core/TradeTape.hpp"
+#include "Utils/AsyncLog.hpp"
+#include "Utils/HugePageArena.hpp"
+#include "Utils/Metrics.hpp"
 #include <boost/beast/core.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/websocket.hpp>
 #include <chrono>
-#include <iostream>
 #include <iomanip>
+#include <optional>
 #include <openssl/err.h>
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 #include <boost/beast/ssl.hpp>
 #include <chrono>  // For std::chrono::seconds
 
+namespace {
+// Per-connection series in the process metrics file (see OceanMetrics).
+// Default-built handles write nowhere until start() registers them.
+struct FeedMetrics {
+    Metrics::Counter frames;
+    Metrics::Counter filtered;
+    Metrics::Counter parse_errors;
+    Metrics::Counter reconnects;
+    Metrics::Gauge connected;
+
+    FeedMetrics() = default;
+    FeedMetrics(const std::string& symbol, const std::string& labels) {
+        Metrics::Registry& r = Metrics::global();
+        const std::string label = "{symbol=\"" + symbol + "\"" + (labels.empty() ? "" : "," + labels) + "}";
+        frames = r.counter("ocean_ws_frames_total" + label, "WebSocket frames read");
+        filtered = r.counter("ocean_ws_frames_filtered_total" + label, "Frames dropped by the frame filter");
+        parse_errors = r.counter("ocean_ws_parse_errors_total" + label, "Frames that failed to parse");
+        reconnects = r.counter("ocean_ws_reconnects_total" + label, "Reconnect attempts scheduled");
+        connected = r.gauge("ocean_ws_connected" + label, "1 while the WebSocket is up");
+    }
+};
+}
 
 class BinanceWSClient::Impl : public std::enable_shared_from_this<BinanceWSClient::Impl> {
 public:
@@ -20,28 +48,35 @@ public:
         const std::string& symbol,
         int depth_level,
         const std::string& update_speed
-    ) : resolver_(net::make_strand(ioc)),
-          ws_(net::make_strand(ioc), ctx),
-          timer_(net::make_strand(ioc)),
+    ) : strand_(net::make_strand(ioc)),
+          resolver_(strand_),
+          ctx_(ctx),
+          timer_(strand_),
           symbol_(symbol),
           depth_level_(depth_level),
           update_speed_(update_speed),
           reconnect_attempts_(0),
           stopping_(false) {
-        std::cout << "[CONSTRUCTOR] BinanceWSClient for " << symbol_
-                  << " (Depth: " << depth_level_ << ", Speed: " << update_speed_ << ")\n";
+        levels_.reserve(2 * static_cast<std::size_t>(depth_level_));
+        OCEAN_LOG_INFO("[CONSTRUCTOR] BinanceWSClient for {} (Depth: {}, Speed: {})",
+                       symbol_, depth_level_, update_speed_);
     }
 
-    ~Impl() {
-        stop();
+    // Owned through shared_ptr so in-flight handlers keep it alive;
+    // the outer client calls stop() before releasing its reference
+    ~Impl() = default;
+
+    void start() {
+        metrics_ = FeedMetrics(symbol_, metric_labels_);
+        run();
     }
 
     void run() {
         if (stopping_.load()) return;
-        std::cout << "[CONNECTING] Starting connection...\n";
+        OCEAN_LOG_INFO("[CONNECTING] Starting connection...");
         resolver_.async_resolve(
-            "stream.binance.com",
-            "9443",
+            host_,
+            port_,
             beast::bind_front_handler(
                 &Impl::on_resolve,
                 shared_from_this()));
@@ -49,17 +84,19 @@ public:
 
     void stop() {
         stopping_.store(true);
-        timer_.cancel();
 
         net::post(
-            ws_.get_executor(),
+            strand_,
             [self = shared_from_this()]() {
-                if (self->ws_.is_open()) {
-                    self->ws_.async_close(
+                // On the strand, so no handler still running can set it back to 1
+                self->metrics_.connected.set(0);
+                self->timer_.cancel();
+                if (self->ws_ && self->ws_->is_open()) {
+                    self->ws_->async_close(
                         websocket::close_code::normal,
                         [](beast::error_code ec) {
                             if (ec) {
-                                std::cerr << "[WARN] Close error: " << ec.message() << "\n";
+                                OCEAN_LOG_WARN("[WARN] Close error: {}", ec.message());
                             }
                         });
                 }
@@ -70,17 +107,83 @@ public:
         return data_;
     }
 
+    DataNotifier& notifier() noexcept {
+        return notifier_;
+    }
+
+    void set_trade_tape(TradeTape& tape) noexcept {
+        trade_tape_ = &tape;
+    }
+
+    void set_depth_handler(DepthHandler handler) {
+        depth_handler_ = std::move(handler);
+    }
+
+    void set_compression(bool enabled) noexcept {
+        compression_ = enabled;
+    }
+
+    void set_frame_filter(FrameFilter filter) {
+        frame_filter_ = std::move(filter);
+    }
+
+    void set_delivery_lock(std::shared_ptr<std::mutex> lock) {
+        delivery_lock_ = std::move(lock);
+    }
+
+    void set_endpoint_offset(std::size_t offset) noexcept {
+        endpoint_offset_ = offset;
+    }
+
+    void set_endpoint(std::string host, std::string port) {
+        host_ = std::move(host);
+        port_ = std::move(port);
+    }
+
+    void set_metric_labels(std::string labels) {
+        metric_labels_ = std::move(labels);
+    }
+
+    int native_handle() noexcept {
+        return ws_ ? beast::get_lowest_layer(*ws_).socket().native_handle() : -1;
+    }
+
 private:
+    // Frame memory; every use is on strand_, so the arena needs no lock.
+    // Chunks are small: a connection holds a few frames' worth at most.
+    HugePageArena arena_{HugePageArena::Config{.name = "ws", .chunk_bytes = 256 << 10}};
+    // One strand for every handler of this connection, so ordering holds
+    // even when the io_context is run by several threads. The stream is
+    // typed on it rather than on any_io_executor: a strand doesn't fit the
+    // type-erased executor's small buffer, so every work guard in a read
+    // op would otherwise copy it to the heap.
+    using Strand = net::strand<net::io_context::executor_type>;
+    using Stream = websocket::stream<beast::ssl_stream<beast::basic_stream<tcp, Strand>>>;
+    Strand strand_;
     tcp::resolver resolver_;
-    websocket::stream<beast::ssl_stream<tcp::socket>> ws_;
+    ssl::context& ctx_;
+    std::optional<Stream> ws_;   // Rebuilt per attempt; a failed TLS stream can't be reused
     net::steady_timer timer_;
     MarketData data_;
     std::string symbol_;
     int depth_level_;
     std::string update_speed_;
-    beast::flat_buffer buffer_;
+    beast::basic_flat_buffer<std::pmr::polymorphic_allocator<char>> buffer_{&arena_};   // Keeps its capacity across frames
+    HandlerMemory read_memory_;             // Op state for the read chain
+    TradeTape* trade_tape_ = nullptr;
+    DepthHandler depth_handler_;
+    bool compression_ = false;
+    FrameFilter frame_filter_;
+    std::shared_ptr<std::mutex> delivery_lock_;
+    std::size_t endpoint_offset_ = 0;
+    std::string host_ = "stream.binance.com";
+    std::string port_ = "9443";
+    std::vector<OrderBook::Order> levels_;  // Reused for every depth message
+    DataNotifier notifier_;
     std::atomic<int> reconnect_attempts_{0};
     std::atomic<bool> stopping_{false};
+    std::string metric_labels_;
+    FeedMetrics metrics_;
 
     void schedule_reconnect() {
         if (stopping_.load()) return;
@@ -93,8 +196,8 @@ private:
         );
 
         reconnect_attempts_++;
-        std::cout << "[RECONNECT] Attempt " << reconnect_attempts_.load()
-                  << " in " << delay_ms << "ms\n";
+        metrics_.reconnects.add();
+        OCEAN_LOG_INFO("[RECONNECT] Attempt {} in {}ms", reconnect_attempts_.load(), delay_ms);
 
         timer_.expires_after(std::chrono::milliseconds(delay_ms));
         timer_.async_wait(
@@ -106,20 +209,29 @@ private:
 
     void on_resolve(beast::error_code ec, tcp::resolver::results_type results) {
         if (ec || stopping_.load()) {
-            std::cerr << "[RESOLVE ERROR] " << ec.message() << "\n";
+            OCEAN_LOG_ERROR("[RESOLVE ERROR] {}", ec.message());
             return schedule_reconnect();
         }
 
-        std::cout << "[CONNECTING] Resolved IPs: ";
-        for (const auto& entry : results) std::cout << entry.endpoint() << " ";
-        std::cout << "\n";
+        std::string resolved;
+        for (const auto& entry : results) resolved += entry.endpoint().address().to_string() + " ";
+        OCEAN_LOG_INFO("[CONNECTING] Resolved IPs: {}", resolved);
+
+        ws_.emplace(strand_, ctx_);
+        buffer_.clear();   // A frame cut off by the last drop is never finished
 
         // ✅ FIXED: Proper timeout syntax on TCP layer
-        beast::get_lowest_layer(ws_).expires_after(std::chrono::seconds(5));
+        beast::get_lowest_layer(*ws_).expires_after(std::chrono::seconds(5));
+
+        std::vector<tcp::endpoint> endpoints(results.begin(), results.end());
+        if (!endpoints.empty()) {
+            std::rotate(endpoints.begin(),
+                        endpoints.begin() + static_cast<std::ptrdiff_t>(endpoint_offset_ % endpoints.size()),
+                        endpoints.end());
+        }
 
-        net::async_connect(
-            beast::get_lowest_layer(ws_),
-            results,
+        beast::get_lowest_layer(*ws_).async_connect(
+            endpoints,
             beast::bind_front_handler(
                 &Impl::on_connect,
                 shared_from_this()));
@@ -129,32 +241,53 @@ private:
 
     void on_connect(beast::error_code ec, tcp::endpoint ep) {
         if (ec || stopping_.load()) {
-            std::cerr << "[CONNECT ERROR] " << ec.message() << "\n";
+            OCEAN_LOG_ERROR("[CONNECT ERROR] {}", ec.message());
             return schedule_reconnect();
         }
 
-        std::cout << "[CONNECTED] TCP to " << ep << "\n";
+        OCEAN_LOG_INFO("[CONNECTED] TCP to {}:{}", ep.address().to_string(), ep.port());
 
         // ✅ FIXED: Disable timeout correctly
-        beast::get_lowest_layer(ws_).expires_never();
-        // ... (rest of the code remains the same)
+        beast::get_lowest_layer(*ws_).expires_never();
+
+        // SNI is mandatory for Binance's TLS front
+        if (!SSL_set_tlsext_host_name(ws_->next_layer().native_handle(), host_.c_str())) {
+            OCEAN_LOG_ERROR("[SSL ERROR] Failed to set SNI");
+            return schedule_reconnect();
+        }
+
+        ws_->next_layer().async_handshake(
+            ssl::stream_base::client,
+            beast::bind_front_handler(
+                &Impl::on_ssl_handshake,
+                shared_from_this()));
     }
 
     void on_ssl_handshake(beast::error_code ec) {
         if (ec || stopping_.load()) {
-            std::cerr << "[SSL HANDSHAKE ERROR] " << ec.message() << "\n";
+            OCEAN_LOG_ERROR("[SSL HANDSHAKE ERROR] {}", ec.message());
             return schedule_reconnect();
         }
 
-        std::cout << "[SECURE] SSL handshake OK\n";
-        ws_.set_option(websocket::stream_base::timeout::suggested(
+        OCEAN_LOG_INFO("[SECURE] SSL handshake OK");
+        ws_->set_option(websocket::stream_base::timeout::suggested(
             beast::role_type::client));
+        if (compression_) {
+            websocket::permessage_deflate pmd;
+            pmd.client_enable = true;
+            ws_->set_option(pmd);
+        }
 
-        const std::string stream = "/ws/" + symbol_ +
+        const std::string depth = symbol_ +
             "@depth" + std::to_string(depth_level_) + "@" + update_speed_;
 
-        ws_.async_handshake(
-            "stream.binance.com",
+        // With a tape attached both streams share one combined connection
+        const std::string stream = trade_tape_
+            ? "/stream?streams=" + depth + "/" + symbol_ + "@aggTrade"
+            : "/ws/" + depth;
+
+        ws_->async_handshake(
+            host_,
             stream,
             beast::bind_front_handler(
                 &Impl::on_handshake,
@@ -163,61 +296,106 @@ private:
 
     void on_handshake(beast::error_code ec) {
         if (ec || stopping_.load()) {
-            std::cerr << "[HANDSHAKE ERROR] " << ec.message() << "\n";
+            OCEAN_LOG_ERROR("[HANDSHAKE ERROR] {}", ec.message());
             return schedule_reconnect();
         }
 
         reconnect_attempts_ = 0;
-        std::cout << "[CONNECTED] WebSocket OK\n";
+        metrics_.connected.set(1);
+        OCEAN_LOG_INFO("[CONNECTED] WebSocket OK");
         {
             std::lock_guard<std::mutex> lock(data_.mutex);
             data_.connected = true;
         }
+        notifier_.notify();
         do_read();
     }
 
     void do_read() {
         if (stopping_.load()) return;
-        ws_.async_read(
+        // Steady state allocates nothing: op state recycles through
+        // read_memory_, the frame lands in buffer_ and is scanned in place
+        ws_->async_read(
             buffer_,
-            beast::bind_front_handler(
+            recycling(read_memory_, beast::bind_front_handler(
                 &Impl::on_read,
-                shared_from_this()));
+                shared_from_this())));
     }
 
-    void on_read(beast::error_code ec, std::size_t bytes_transferred) {
+    void on_read(beast::error_code ec, std::size_t) {
         if (ec) {
             if (ec == websocket::error::closed) {
-                std::cout << "[CLOSED] Server closed connection. Code: "
-                          << ws_.reason().code << ", Reason: "
-                          << ws_.reason().reason << "\n";
+                OCEAN_LOG_WARN("[CLOSED] Server closed connection. Code: {}, Reason: {}",
+                               static_cast<unsigned>(ws_->reason().code),
+                               std::string_view(ws_->reason().reason.data(), ws_->reason().reason.size()));
             } else {
-                std::cerr << "[READ ERROR] " << ec.message() << "\n";
+                OCEAN_LOG_ERROR("[READ ERROR] {}", ec.message());
             }
+            // After stop() the gauge is already 0, and its series may be
+            // another client's by the time this runs
+            if (!stopping_.load()) metrics_.connected.set(0);
             {
                 std::lock_guard<std::mutex> lock(data_.mutex);
                 data_.connected = false;
             }
+            notifier_.notify();
             return schedule_reconnect();
         }
 
-        try {
-            json data = json::parse(beast::buffers_to_string(buffer_.data()));
-            buffer_.consume(buffer_.size());
+        const auto data = buffer_.cdata();
+        const std::string_view frame(static_cast<const char*>(data.data()), data.size());
+        metrics_.frames.add();
 
-            std::lock_guard<std::mutex> lock(data_.mutex);
-            data_.bid = std::stod(data["bids"][0][0].get<std::string>());
-            data_.ask = std::stod(data["asks"][0][0].get<std::string>());
-            data_.timestamp = static_cast<uint64_t>(
-                std::chrono::duration_cast<std::chrono::milliseconds>(
-                    std::chrono::system_clock::now().time_since_epoch())
-                .count());
-
-        } catch (const std::exception& e) {
-            std::cerr << "[PARSE ERROR] " << e.what() << "\n";
+        if (deliver(frame)) notifier_.notify();
+        buffer_.consume(buffer_.size());
+        do_read();
+    }
+
+    // Filter, parse and hand over one frame; true if it reached a handler or the tape
+    bool deliver(std::string_view frame) {
+        std::unique_lock<std::mutex> delivery;
+        if (delivery_lock_) delivery = std::unique_lock(*delivery_lock_);
+
+        if (frame_filter_ && !frame_filter_(frame)) {
+            metrics_.filtered.add();
+            return false;
         }
+        if (BinanceWire::is_agg_trade(frame) ? on_agg_trade(frame) : on_depth(frame)) return true;
 
-        do_read();
+        metrics_.parse_errors.add();
+        // A bad feed can fail every frame; the limit keeps this off the read loop's back
+        OCEAN_LOG_RATE(LogLevel::Error, 10, "[PARSE ERROR] Malformed frame ({} bytes)", frame.size());
+        return false;
+    }
+
+    bool on_depth(std::string_view frame) {
+        if (!BinanceWire::parse_depth(frame, levels_)) return false;
+        if (depth_handler_) depth_handler_(levels_);
+
+        // Bids come first; the first ask follows the last bid
+        const auto first_ask = std::find_if(levels_.begin(), levels_.end(),
+                                            [](const OrderBook::Order& o) { return !o.is_bid; });
+        if (levels_.empty() || !levels_.front().is_bid || first_ask == levels_.end()) return true;
+
+        std::lock_guard<std::mutex> lock(data_.mutex);
+        data_.bid = levels_.front().price;
+        data_.ask = first_ask->price;
+        data_.timestamp = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch())
+            .count());
+        return true;
+    }
+
+    bool on_agg_trade(std::string_view frame) {
+        const auto trade = BinanceWire::parse_agg_trade(frame);
+        if (!trade) return false;
+        if (!trade_tape_) return true;
+
+        // "m": buyer is the maker, so the aggressor sold
+        trade_tape_->append(trade->trade_time_ms * 1'000'000ULL, trade->price, trade->quantity,
+                            !trade->buyer_is_maker);
+        return true;
     }
 };
 
@@ -227,15 +405,15 @@ BinanceWSClient::BinanceWSClient(
     const std::string& symbol,
     int depth_level,
     const std::string& update_speed
-) : pimpl_(std::make_unique<Impl>(ioc, ctx, symbol, depth_level, update_speed)) {}
+) : pimpl_(std::make_shared<Impl>(ioc, ctx, symbol, depth_level, update_speed)) {}
 
 BinanceWSClient::~BinanceWSClient() {
-    std::cout << "[DESTRUCTOR] Shutting down...\n";
+    OCEAN_LOG_INFO("[DESTRUCTOR] Shutting down...");
     pimpl_->stop();
 }
 
 void BinanceWSClient::start() {
-    pimpl_->run();
+    pimpl_->start();
 }
 
 void BinanceWSClient::stop() {
@@ -244,4 +422,44 @@ void BinanceWSClient::stop() {
 
 BinanceWSClient::MarketData& BinanceWSClient::get_market_data() noexcept {
     return pimpl_->get_data();
-}
\ No newline at end of file
+}
+
+DataNotifier& BinanceWSClient::notifier() noexcept {
+    return pimpl_->notifier();
+}
+
+void BinanceWSClient::attach_trade_tape(TradeTape& tape) {
+    pimpl_->set_trade_tape(tape);
+}
+
+void BinanceWSClient::on_depth(DepthHandler handler) {
+    pimpl_->set_depth_handler(std::move(handler));
+}
+
+void BinanceWSClient::enable_compression(bool enabled) {
+    pimpl_->set_compression(enabled);
+}
+
+void BinanceWSClient::set_frame_filter(FrameFilter filter) {
+    pimpl_->set_frame_filter(std::move(filter));
+}
+
+void BinanceWSClient::set_delivery_lock(std::shared_ptr<std::mutex> lock) {
+    pimpl_->set_delivery_lock(std::move(lock));
+}
+
+void BinanceWSClient::set_endpoint_offset(std::size_t offset) {
+    pimpl_->set_endpoint_offset(offset);
+}
+
+void BinanceWSClient::set_endpoint(const std::string& host, const std::string& port) {
+    pimpl_->set_endpoint(host, port);
+}
+
+void BinanceWSClient::set_metric_labels(std::string labels) {
+    pimpl_->set_metric_labels(std::move(labels));
+}
+
+int BinanceWSClient::native_handle() const noexcept {
+    return pimpl_->native_handle();
+}
@@ -0,0 +1,120 @@
+#include "Clients/BinanceWire.hpp"
+#include <charconv>
+
+namespace {
+struct Cursor {
+    const char* p;
+    const char* end;
+};
+
+// Binance sends compact JSON, but tolerate whitespace between tokens
+void skip_ws(Cursor& c) noexcept {
+    while (c.p != c.end && (*c.p == ' ' || *c.p == '\n' || *c.p == '\r' || *c.p == '\t')) ++c.p;
+}
+
+bool expect(Cursor& c, char ch) noexcept {
+    skip_ws(c);
+    if (c.p == c.end || *c.p != ch) return false;
+    ++c.p;
+    return true;
+}
+
+bool quoted_float(Cursor& c, float& out) noexcept {
+    if (!expect(c, '"')) return false;
+    const auto [ptr, ec] = std::from_chars(c.p, c.end, out);
+    if (ec != std::errc{} || ptr == c.end || *ptr != '"') return false;
+    c.p = ptr + 1;
+    return true;
+}
+
+// Cursor just past `key` (which includes its colon), or nullopt
+std::optional<Cursor> after(std::string_view frame, std::string_view key) noexcept {
+    const std::size_t at = frame.find(key);
+    if (at == std::string_view::npos) return std::nullopt;
+    return Cursor{frame.data() + at + key.size(), frame.data() + frame.size()};
+}
+
+// [["price","qty"],...]
+bool levels(Cursor c, bool is_bid, std::vector<OrderBook::Order>& out) {
+    if (!expect(c, '[')) return false;
+    skip_ws(c);
+    if (c.p != c.end && *c.p == ']') return true;
+
+    while (true) {
+        float price, amount;
+        if (!expect(c, '[') || !quoted_float(c, price) || !expect(c, ',') ||
+            !quoted_float(c, amount) || !expect(c, ']')) {
+            return false;
+        }
+        out.push_back({price, amount, is_bid});
+
+        skip_ws(c);
+        if (c.p == c.end) return false;
+        if (*c.p == ']') return true;
+        if (*c.p++ != ',') return false;
+    }
+}
+
+std::optional<uint64_t> number_after(std::string_view frame, std::string_view key) noexcept {
+    auto c = after(frame, key);
+    if (!c) return std::nullopt;
+    skip_ws(*c);
+    uint64_t value = 0;
+    if (std::from_chars(c->p, c->end, value).ec != std::errc{}) return std::nullopt;
+    return value;
+}
+
+std::optional<Cursor> side(std::string_view frame, std::string_view full, std::string_view diff) noexcept {
+    if (auto c = after(frame, full)) return c;
+    return after(frame, diff);
+}
+}
+
+namespace BinanceWire {
+
+bool is_agg_trade(std::string_view frame) noexcept {
+    return frame.find(R"("e":"aggTrade")") != std::string_view::npos;
+}
+
+bool is_depth_update(std::string_view frame) noexcept {
+    return frame.find(R"("e":"depthUpdate")") != std::string_view::npos;
+}
+
+bool parse_depth(std::string_view frame, std::vector<OrderBook::Order>& out) {
+    out.clear();
+    const auto bids = side(frame, R"("bids":)", R"("b":)");
+    const auto asks = side(frame, R"("asks":)", R"("a":)");
+    return bids && asks && levels(*bids, true, out) && levels(*asks, false, out);
+}
+
+std::optional<AggTrade> parse_agg_trade(std::string_view frame) noexcept {
+    AggTrade trade;
+
+    auto price = after(frame, R"("p":)");
+    auto quantity = after(frame, R"("q":)");
+    auto time = after(frame, R"("T":)");
+    auto maker = after(frame, R"("m":)");
+    if (!price || !quantity || !time || !maker) return std::nullopt;
+
+    if (!quoted_float(*price, trade.price) || !quoted_float(*quantity, trade.quantity)) {
+        return std::nullopt;
+    }
+
+    skip_ws(*time);
+    if (std::from_chars(time->p, time->end, trade.trade_time_ms).ec != std::errc{}) {
+        return std::nullopt;
+    }
+
+    skip_ws(*maker);
+    if (maker->p == maker->end) return std::nullopt;
+    trade.buyer_is_maker = *maker->p == 't';
+    return trade;
+}
+
+std::optional<uint64_t> sequence_id(std::string_view frame) noexcept {
+    if (is_agg_trade(frame)) return number_after(frame, R"("a":)");
+    if (auto id = number_after(frame, R"("lastUpdateId":)")) return id;
+    return number_after(frame, R"("u":)");
+}
+
+}
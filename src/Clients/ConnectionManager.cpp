@@ -0,0 +1,230 @@
+#include "Clients/ConnectionManager.hpp"
+#include "Clients/BinanceWire.hpp"
+#include "Utils/AsyncLog.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Smoothing for the per-connection message rate across rebalance() calls
+constexpr double kRateAlpha = 0.5;
+
+// How long a new session's trades may wait to line up with the old
+// session's before it takes them anyway, e.g. from a dead old session
+constexpr uint64_t kTradeTakeoverNs = 1'000'000'000;
+
+double weight(double rate) noexcept {
+    return rate + 1.0;
+}
+
+uint64_t arrival_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}
+
+ConnectionManager::ConnectionManager(IoContextPool& pool, ssl::context& ctx)
+    : pool_(pool), ctx_(ctx), notifier_(std::make_shared<DataNotifier>()) {}
+
+ConnectionManager::~ConnectionManager() {
+    std::lock_guard lock(mutex_);
+    connections_.clear();   // Each client posts its own close
+}
+
+std::shared_ptr<BinanceWSClient> ConnectionManager::open(const std::string& symbol, const Connection& c,
+                                                         const std::shared_ptr<Session>& session) {
+    auto client = std::make_shared<BinanceWSClient>(
+        pool_.context(c.context), ctx_, symbol, c.options.depth_level, c.options.update_speed);
+    if (!c.options.host.empty()) client->set_endpoint(c.options.host, c.options.port);
+    // During a move the old and new session share the symbol, never the context
+    client->set_metric_labels("context=\"" + std::to_string(c.context) + "\"");
+
+    // Runs ahead of parsing, so a frame it drops feeds neither handler nor tape
+    session->client = client;
+    session->trades = c.options.tape != nullptr;
+    client->set_delivery_lock(c.feed->delivery);
+    client->set_frame_filter([feed = c.feed, session](std::string_view frame) {
+        return admit(*feed, *session, frame);
+    });
+
+    client->on_depth([notifier = notifier_, user = c.options.on_depth](
+                         std::span<const OrderBook::Order> levels) {
+        if (user) user(levels);
+        notifier->notify();
+    });
+    if (c.options.tape) client->attach_trade_tape(*c.options.tape);
+    client->enable_compression(c.options.compression);
+
+    client->start();
+    return client;
+}
+
+bool ConnectionManager::admit(Feed& feed, Session& session, std::string_view frame) {
+    if (session.retired.load(std::memory_order_relaxed)) return false;
+    const auto id = BinanceWire::sequence_id(frame);
+    if (!id) return true;   // Control replies
+
+    const bool trade = BinanceWire::is_agg_trade(frame);
+    FirstArrivalArbiter& arbiter = trade ? feed.trades : feed.depth;
+    const uint64_t now = arrival_ns();
+
+    const auto& old = session.replaces;
+    if (old && trade && !session.took_trades) {
+        // Aggregate trade ids are contiguous: until ours pick up right after
+        // the last one delivered, the old session has the prints in between
+        const uint64_t last = arbiter.last_id();
+        const bool grace_over = session.took_depth_ns != 0 && now - session.took_depth_ns >= kTradeTakeoverNs;
+        if (last != 0 && *id != last + 1 && !grace_over) return false;
+    }
+    if (!arbiter.accept(session.leg, *id, now)) return false;
+    if (!old) return true;
+
+    if (trade) session.took_trades = true;
+    else if (session.took_depth_ns == 0) session.took_depth_ns = now;
+
+    if (session.took_depth_ns != 0 && (session.took_trades || !session.trades)) {
+        // Taken over: nothing the old session still has is needed
+        old->retired.store(true, std::memory_order_relaxed);
+        if (const auto client = old->client.lock()) client->stop();
+        session.replaces.reset();
+    }
+    return true;
+}
+
+bool ConnectionManager::add(const std::string& symbol, ConnectionOptions options) {
+    {
+        std::lock_guard lock(mutex_);
+        if (connections_.contains(symbol)) return false;
+
+        Connection c;
+        c.options = std::move(options);
+        c.context = quietest_locked();
+
+        // Until measured, assume a new stream is as busy as the average one
+        double total = 0.0;
+        for (const auto& [_, other] : connections_) total += other.rate;
+        c.rate = connections_.empty() ? 0.0 : total / static_cast<double>(connections_.size());
+
+        c.feed = std::make_shared<Feed>();
+        c.session = std::make_shared<Session>();
+        c.client = open(symbol, c, c.session);
+        c.last_sequence = c.client->notifier().sequence();
+        connections_.emplace(symbol, std::move(c));
+    }
+    rebalance();
+    return true;
+}
+
+bool ConnectionManager::remove(std::string_view symbol) {
+    std::lock_guard lock(mutex_);
+    const auto it = connections_.find(symbol);
+    if (it == connections_.end()) return false;
+    connections_.erase(it);
+    return true;
+}
+
+bool ConnectionManager::rebalance() {
+    std::lock_guard lock(mutex_);
+
+    const auto now = Clock::now();
+    const double elapsed = std::chrono::duration<double>(now - last_rebalance_).count();
+    last_rebalance_ = now;
+
+    // Free the sessions retired since the last call; each was closed then
+    for (auto& [_, c] : connections_) {
+        if (c.standby && c.standby_session->retired.load(std::memory_order_relaxed)) {
+            c.standby.reset();
+            c.standby_session.reset();
+        }
+    }
+
+    std::vector<double> weights;
+    std::vector<std::size_t> placement;
+    for (auto& [_, c] : connections_) {
+        const uint32_t seq = c.client->notifier().sequence();
+        if (elapsed > 0.0) {
+            const double measured = static_cast<double>(seq - c.last_sequence) / elapsed;
+            c.rate = kRateAlpha * measured + (1.0 - kRateAlpha) * c.rate;
+        }
+        c.last_sequence = seq;
+
+        weights.push_back(weight(c.rate));
+        placement.push_back(c.context);
+    }
+
+    const auto move = plan_move(weights, placement, pool_.size());
+    if (!move) return false;
+
+    auto it = connections_.begin();
+    std::advance(it, static_cast<std::ptrdiff_t>(move->connection));
+    Connection& c = it->second;
+    if (c.standby) return false;   // Its last move hasn't been taken over yet
+
+    // The old session keeps serving until the new one takes over
+    c.standby = std::move(c.client);
+    c.standby_session = std::move(c.session);
+    c.context = move->to;
+    c.session = std::make_shared<Session>();
+    c.session->leg = c.standby_session->leg ^ 1;
+    c.session->replaces = c.standby_session;
+    c.client = open(it->first, c, c.session);
+    c.last_sequence = c.client->notifier().sequence();
+
+    OCEAN_LOG_INFO("[IO POOL] Moved {} from context {} to {}", it->first, move->from, move->to);
+    return true;
+}
+
+std::optional<ConnectionManager::Move> ConnectionManager::plan_move(
+    std::span<const double> weights, std::span<const std::size_t> placement, std::size_t contexts) {
+    if (contexts < 2 || weights.size() != placement.size()) return std::nullopt;
+
+    std::vector<double> loads(contexts, 0.0);
+    for (std::size_t i = 0; i < weights.size(); ++i) loads[placement[i]] += weights[i];
+
+    const auto [lo_it, hi_it] = std::minmax_element(loads.begin(), loads.end());
+    const std::size_t lo = static_cast<std::size_t>(lo_it - loads.begin());
+    const std::size_t hi = static_cast<std::size_t>(hi_it - loads.begin());
+    const double gap = *hi_it - *lo_it;
+    if (hi == lo || *hi_it <= kImbalance * *lo_it) return std::nullopt;
+
+    // A move only helps if it is smaller than the gap; the best one is
+    // closest to half of it
+    std::optional<Move> best;
+    double best_distance = gap / 2.0;
+    for (std::size_t i = 0; i < weights.size(); ++i) {
+        if (placement[i] != hi || weights[i] >= gap) continue;
+        const double distance = std::abs(weights[i] - gap / 2.0);
+        if (!best || distance < best_distance) {
+            best = Move{i, hi, lo};
+            best_distance = distance;
+        }
+    }
+    return best;
+}
+
+std::size_t ConnectionManager::connections() const {
+    std::lock_guard lock(mutex_);
+    return connections_.size();
+}
+
+std::size_t ConnectionManager::context_of(std::string_view symbol) const {
+    std::lock_guard lock(mutex_);
+    const auto it = connections_.find(symbol);
+    return it == connections_.end() ? pool_.size() : it->second.context;
+}
+
+std::vector<double> ConnectionManager::context_loads() const {
+    std::lock_guard lock(mutex_);
+    return loads_locked();
+}
+
+std::vector<double> ConnectionManager::loads_locked() const {
+    std::vector<double> loads(pool_.size(), 0.0);
+    for (const auto& [_, c] : connections_) loads[c.context] += c.rate;
+    return loads;
+}
+
+std::size_t ConnectionManager::quietest_locked() const {
+    std::vector<double> loads(pool_.size(), 0.0);
+    for (const auto& [_, c] : connections_) loads[c.context] += weight(c.rate);
+    return static_cast<std::size_t>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+}
@@ -0,0 +1,54 @@
+#include "Clients/FirstArrivalArbiter.hpp"
+#include <stdexcept>
+
+static_assert((FirstArrivalArbiter::kHistory & (FirstArrivalArbiter::kHistory - 1)) == 0,
+              "history is indexed with a mask");
+
+FirstArrivalArbiter::FirstArrivalArbiter(std::size_t legs)
+    : legs_(legs), history_(std::make_unique<Slot[]>(kHistory)) {
+    if (legs == 0 || legs > kMaxLegs) {
+        throw std::invalid_argument("FirstArrivalArbiter supports 1 to 8 legs");
+    }
+}
+
+bool FirstArrivalArbiter::accept(std::size_t leg, uint64_t id, uint64_t arrival_ns) noexcept {
+    LegCounters& c = counters_[leg];
+    Slot& slot = history_[id & (kHistory - 1)];
+
+    uint64_t last = last_id_.load(std::memory_order_acquire);
+    while (id > last) {
+        if (last_id_.compare_exchange_weak(last, id, std::memory_order_acq_rel)) {
+            // Time before id: a reader that matches the id sees this arrival
+            slot.first_ns.store(arrival_ns, std::memory_order_relaxed);
+            slot.id.store(id, std::memory_order_release);
+            c.wins.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    c.duplicates.fetch_add(1, std::memory_order_relaxed);
+    if (slot.id.load(std::memory_order_acquire) == id) {
+        const uint64_t first = slot.first_ns.load(std::memory_order_relaxed);
+        const uint64_t lag = arrival_ns > first ? arrival_ns - first : 0;
+        c.lag_samples.fetch_add(1, std::memory_order_relaxed);
+        c.lag_sum_ns.fetch_add(lag, std::memory_order_relaxed);
+
+        uint64_t max = c.max_lag_ns.load(std::memory_order_relaxed);
+        while (lag > max && !c.max_lag_ns.compare_exchange_weak(max, lag, std::memory_order_relaxed)) {}
+    }
+    return false;
+}
+
+FirstArrivalArbiter::LegStats FirstArrivalArbiter::stats(std::size_t leg) const noexcept {
+    const LegCounters& c = counters_[leg];
+    LegStats s;
+    s.wins = c.wins.load(std::memory_order_relaxed);
+    s.duplicates = c.duplicates.load(std::memory_order_relaxed);
+    s.lag_samples = c.lag_samples.load(std::memory_order_relaxed);
+    s.max_lag_ns = c.max_lag_ns.load(std::memory_order_relaxed);
+    if (s.lag_samples) {
+        s.mean_lag_ns = static_cast<double>(c.lag_sum_ns.load(std::memory_order_relaxed)) /
+                        static_cast<double>(s.lag_samples);
+    }
+    return s;
+}
@@ -0,0 +1,52 @@
+#include "Clients/IoContextPool.hpp"
+#include "Core/ThreadAffinity.hpp"
+#include "Utils/AsyncLog.hpp"
+#include <stdexcept>
+#include <string>
+
+IoContextPool::IoContextPool(std::size_t size, std::vector<int> cpus) {
+    if (size == 0) {
+        throw std::invalid_argument("IoContextPool needs at least one context");
+    }
+    workers_.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->cpu = i < cpus.size() ? cpus[i] : -1;
+        workers_.push_back(std::move(worker));
+    }
+}
+
+IoContextPool::~IoContextPool() {
+    stop();
+}
+
+void IoContextPool::start() {
+    if (running_) return;
+    running_ = true;
+
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        Worker& w = *workers_[i];
+        w.ioc.restart();
+        w.work.emplace(boost::asio::make_work_guard(w.ioc));
+        w.thread = std::thread([&w, i] {
+            name_current_thread("ocean-io-" + std::to_string(i));
+            if (!pin_current_thread(w.cpu)) {
+                OCEAN_LOG_WARN("[IO POOL] Could not pin context {} to cpu {}", i, w.cpu);
+            }
+            w.ioc.run();
+        });
+    }
+}
+
+void IoContextPool::stop() {
+    if (!running_) return;
+    running_ = false;
+
+    for (auto& w : workers_) {
+        w->work.reset();
+        w->ioc.stop();
+    }
+    for (auto& w : workers_) {
+        if (w->thread.joinable()) w->thread.join();
+    }
+}
@@ -0,0 +1,102 @@
+#include "Clients/RedundantFeed.hpp"
+#include "Clients/BinanceWire.hpp"
+#include <chrono>
+
+namespace {
+uint64_t arrival_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+}
+
+struct RedundantFeed::Shared {
+    explicit Shared(std::size_t legs) : depth(legs), trades(legs) {}
+
+    FirstArrivalArbiter depth;
+    FirstArrivalArbiter trades;   // aggTrade ids are their own sequence
+    BinanceWSClient::DepthHandler handler;
+    DataNotifier notifier;
+};
+
+RedundantFeed::RedundantFeed(
+    net::io_context& ioc,
+    ssl::context& ctx,
+    const std::string& symbol,
+    std::size_t legs,
+    int depth_level,
+    const std::string& update_speed
+) : shared_(std::make_shared<Shared>(legs)) {
+    legs_.reserve(legs);
+    for (std::size_t i = 0; i < legs; ++i) {
+        auto leg = std::make_unique<BinanceWSClient>(ioc, ctx, symbol, depth_level, update_speed);
+        leg->set_endpoint_offset(i);
+        leg->set_metric_labels("leg=\"" + std::to_string(i) + "\"");
+
+        // Frames without a sequence id (control replies) pass straight through
+        leg->set_frame_filter([shared = shared_, i](std::string_view frame) {
+            const auto id = BinanceWire::sequence_id(frame);
+            if (!id) return true;
+            auto& arbiter = BinanceWire::is_agg_trade(frame) ? shared->trades : shared->depth;
+            return arbiter.accept(i, *id, arrival_ns());
+        });
+        leg->on_depth([shared = shared_](std::span<const OrderBook::Order> levels) {
+            if (shared->handler) shared->handler(levels);
+            shared->notifier.notify();
+        });
+        legs_.push_back(std::move(leg));
+    }
+}
+
+RedundantFeed::~RedundantFeed() {
+    stop();
+}
+
+void RedundantFeed::on_depth(BinanceWSClient::DepthHandler handler) {
+    shared_->handler = std::move(handler);
+}
+
+void RedundantFeed::attach_trade_tape(TradeTape& tape) {
+    for (auto& leg : legs_) leg->attach_trade_tape(tape);
+}
+
+void RedundantFeed::set_endpoint(const std::string& host, const std::string& port) {
+    for (auto& leg : legs_) leg->set_endpoint(host, port);
+}
+
+void RedundantFeed::start() {
+    if (started_) return;
+    started_ = true;
+    for (auto& leg : legs_) leg->start();
+}
+
+void RedundantFeed::stop() {
+    if (!started_) return;
+    started_ = false;
+    for (auto& leg : legs_) leg->stop();
+}
+
+bool RedundantFeed::connected() const {
+    return connected_legs() > 0;
+}
+
+std::size_t RedundantFeed::connected_legs() const {
+    std::size_t up = 0;
+    for (const auto& leg : legs_) {
+        auto& data = leg->get_market_data();
+        std::lock_guard<std::mutex> lock(data.mutex);
+        up += data.connected ? 1 : 0;
+    }
+    return up;
+}
+
+FirstArrivalArbiter::LegStats RedundantFeed::depth_stats(std::size_t leg) const noexcept {
+    return shared_->depth.stats(leg);
+}
+
+FirstArrivalArbiter::LegStats RedundantFeed::trade_stats(std::size_t leg) const noexcept {
+    return shared_->trades.stats(leg);
+}
+
+DataNotifier& RedundantFeed::notifier() noexcept {
+    return shared_->notifier;
+}
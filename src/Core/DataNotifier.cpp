@@ -0,0 +1,127 @@
+#include "Core/DataNotifier.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <immintrin.h>
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+long futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout) noexcept {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+}
+
+timespec to_timespec(std::chrono::nanoseconds timeout) noexcept {
+    timeout = std::max(timeout, std::chrono::nanoseconds::zero());
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    return timespec{
+        .tv_sec = static_cast<time_t>(secs.count()),
+        .tv_nsec = static_cast<long>((timeout - secs).count())
+    };
+}
+}
+
+DataNotifier::~DataNotifier() {
+    if (const int fd = event_fd_.load(); fd >= 0) close(fd);
+}
+
+void DataNotifier::notify() noexcept {
+    // seq_cst pairs with the sleeper's increment: either it sees the new
+    // sequence before sleeping or we see it registered and wake it
+    seq_.fetch_add(1, std::memory_order_seq_cst);
+
+    if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+        futex(&seq_, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr);
+    }
+    if (event_waiters_.load(std::memory_order_seq_cst) == 0) return;
+    if (const int fd = event_fd_.load(std::memory_order_acquire); fd >= 0) {
+        const uint64_t one = 1;
+        [[maybe_unused]] const ssize_t n = write(fd, &one, sizeof(one));
+    }
+}
+
+uint32_t DataNotifier::wait(uint32_t seen, WaitPolicy policy,
+                            std::chrono::nanoseconds timeout, uint32_t spins) noexcept {
+    switch (policy) {
+        case WaitPolicy::BusySpin: {
+            const auto deadline = std::chrono::steady_clock::now() + timeout;
+            uint32_t current = seen;
+            do {
+                current = spin(seen, spins);
+            } while (current == seen && std::chrono::steady_clock::now() < deadline);
+            return current;
+        }
+        case WaitPolicy::SpinThenFutex: {
+            const uint32_t current = spin(seen, spins);
+            return current != seen ? current : futex_wait(seen, timeout);
+        }
+        case WaitPolicy::EventFd:
+            return eventfd_wait(seen, timeout);
+    }
+    return sequence();
+}
+
+int DataNotifier::event_fd() noexcept {
+    int fd = event_fd_.load(std::memory_order_acquire);
+    if (fd >= 0) return fd;
+
+    const int created = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (created < 0) return -1;
+    if (!event_fd_.compare_exchange_strong(fd, created, std::memory_order_acq_rel)) {
+        close(created);  // Lost the race; `fd` now holds the winner
+        return fd;
+    }
+    return created;
+}
+
+void DataNotifier::consume_event() noexcept {
+    if (const int fd = event_fd_.load(std::memory_order_acquire); fd >= 0) {
+        uint64_t count = 0;
+        [[maybe_unused]] const ssize_t n = read(fd, &count, sizeof(count));
+    }
+}
+
+uint32_t DataNotifier::spin(uint32_t seen, uint32_t spins) const noexcept {
+    for (uint32_t i = 0; i < spins; ++i) {
+        const uint32_t current = seq_.load(std::memory_order_acquire);
+        if (current != seen) return current;
+        _mm_pause();
+    }
+    return seq_.load(std::memory_order_acquire);
+}
+
+uint32_t DataNotifier::futex_wait(uint32_t seen, std::chrono::nanoseconds timeout) noexcept {
+    const timespec ts = to_timespec(timeout);
+
+    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+    if (seq_.load(std::memory_order_seq_cst) == seen) {
+        // Kernel re-checks the word, so a notify() in between can't be lost
+        futex(&seq_, FUTEX_WAIT_PRIVATE, seen, &ts);
+    }
+    sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    return seq_.load(std::memory_order_acquire);
+}
+
+uint32_t DataNotifier::eventfd_wait(uint32_t seen, std::chrono::nanoseconds timeout) noexcept {
+    const int fd = event_fd();
+    if (fd < 0) return futex_wait(seen, timeout);
+
+    // Same handshake as the futex: either notify() sees us registered and
+    // writes, or we see its sequence below. Counts left by notifies we have
+    // already seen are drained first, so they can't end the poll early.
+    watch_event();
+    consume_event();
+    uint32_t current = seq_.load(std::memory_order_seq_cst);
+    if (current == seen) {
+        // ppoll keeps sub-millisecond timeouts; poll() would round them to 0
+        const timespec ts = to_timespec(timeout);
+        pollfd pfd{fd, POLLIN, 0};
+        if (ppoll(&pfd, 1, &ts, nullptr) > 0) consume_event();
+        current = sequence();
+    }
+    unwatch_event();
+    return current;
+}
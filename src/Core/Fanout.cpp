@@ -0,0 +1,163 @@
+#include "Core/Fanout.hpp"
+#include "Utils/AsyncLog.hpp"
+#include <cerrno>
+#include <stdexcept>
+#include <zmq.h>
+
+FanoutPublisher::FanoutPublisher(Config cfg)
+    : cfg_(std::move(cfg)),
+      ring_path_(cfg_.ring_path.empty() ? "/dev/shm/ocean-" + cfg_.stream : cfg_.ring_path),
+      ring_(ShmRingWriter::Config{ring_path_, cfg_.ring_capacity, cfg_.max_readers}) {
+    Metrics::Registry& metrics = Metrics::global();
+    const std::string label = "{stream=\"" + cfg_.stream + "\"}";
+    published_metric_ = metrics.counter("ocean_fanout_published_total" + label, "Events written to the shm ring");
+    zmq_sent_metric_ = metrics.counter("ocean_fanout_zmq_sent_total" + label, "Events sent on the PUB socket");
+    zmq_dropped_metric_ = metrics.counter("ocean_fanout_zmq_dropped_total" + label, "Events the PUB socket refused");
+    readers_metric_ = metrics.gauge("ocean_fanout_readers" + label, "Attached shm readers");
+    slow_readers_metric_ = metrics.gauge("ocean_fanout_slow_readers" + label, "Readers behind or lapped at the last check");
+    bridge_lag_metric_ = metrics.gauge("ocean_fanout_zmq_bridge_lag" + label, "Events the zmq bridge has yet to send");
+
+    if (cfg_.zmq_endpoint.empty()) return;
+
+    zmq_context_ = zmq_ctx_new();
+    zmq_socket_ = zmq_context_ ? zmq_socket(zmq_context_, ZMQ_PUB) : nullptr;
+    const int linger = 0;
+    // Without NODROP a PUB drops past the high-water mark and still reports
+    // success; with it the send fails and the bridge counts the drop
+    const int nodrop = 1;
+    char bound[256];
+    std::size_t bound_size = sizeof(bound);
+    if (!zmq_socket_ ||
+        zmq_setsockopt(zmq_socket_, ZMQ_SNDHWM, &cfg_.zmq_hwm, sizeof(cfg_.zmq_hwm)) != 0 ||
+        zmq_setsockopt(zmq_socket_, ZMQ_LINGER, &linger, sizeof(linger)) != 0 ||
+        zmq_setsockopt(zmq_socket_, ZMQ_XPUB_NODROP, &nodrop, sizeof(nodrop)) != 0 ||
+        zmq_bind(zmq_socket_, cfg_.zmq_endpoint.c_str()) != 0 ||
+        zmq_getsockopt(zmq_socket_, ZMQ_LAST_ENDPOINT, bound, &bound_size) != 0) {
+        const std::string why = zmq_strerror(zmq_errno());
+        if (zmq_socket_) zmq_close(zmq_socket_);
+        if (zmq_context_) zmq_ctx_term(zmq_context_);
+        throw std::runtime_error("Cannot publish " + cfg_.stream + " on " + cfg_.zmq_endpoint + ": " + why);
+    }
+    zmq_bound_ = bound;   // tcp://127.0.0.1:* resolved to the port we got
+
+    // Attached before the first publish, so the bridge sees every event
+    bridge_reader_ = std::make_unique<ShmRingReader>(ring_path_);
+    bridge_thread_ = std::jthread([this](std::stop_token st) { bridge_loop(st); });
+    OCEAN_LOG_INFO("[FANOUT] {} on {} and {}", cfg_.stream, ring_path_, zmq_bound_);
+}
+
+FanoutPublisher::~FanoutPublisher() {
+    if (bridge_thread_.joinable()) {
+        bridge_thread_.request_stop();
+        bridge_thread_.join();
+    }
+    bridge_reader_.reset();
+    if (zmq_socket_) zmq_close(zmq_socket_);
+    if (zmq_context_) zmq_ctx_term(zmq_context_);
+}
+
+//--------------------------------------------------------------------
+// BRIDGE: shm -> zmq. PUB never blocks; once any subscriber is at the
+// high-water mark the send fails and the event is dropped for all of
+// them, which we count. If even that can't keep up, the ring laps us
+// and check_readers() reports the bridge like any slow subscriber.
+//--------------------------------------------------------------------
+void FanoutPublisher::bridge_loop(std::stop_token st) {
+    name_current_thread("ocean-fanout");
+    FanoutEvent event;
+    while (!st.stop_requested()) {
+        switch (bridge_reader_->poll(event)) {
+            case ShmRingReader::Status::Ok:
+                if (zmq_send(zmq_socket_, cfg_.stream.data(), cfg_.stream.size(), ZMQ_SNDMORE | ZMQ_DONTWAIT) >= 0 &&
+                    zmq_send(zmq_socket_, &event, sizeof(event), ZMQ_DONTWAIT) >= 0) {
+                    zmq_sent_metric_.add();
+                } else {
+                    zmq_dropped_metric_.add();
+                }
+                break;
+            case ShmRingReader::Status::Lapped:
+                break;
+            case ShmRingReader::Status::Empty:
+                bridge_reader_->wait(std::chrono::milliseconds(50));
+                break;
+            case ShmRingReader::Status::Closed:
+                return;
+        }
+    }
+}
+
+std::vector<ShmRingWriter::ReaderState> FanoutPublisher::readers() const {
+    auto readers = ring_.readers();
+    if (bridge_reader_) {
+        std::erase_if(readers, [slot = bridge_reader_->slot()](const auto& r) { return r.slot == slot; });
+    }
+    return readers;
+}
+
+std::optional<ShmRingWriter::ReaderState> FanoutPublisher::bridge() const {
+    if (!bridge_reader_) return std::nullopt;
+    for (const auto& r : ring_.readers()) {
+        if (r.slot == bridge_reader_->slot()) return r;
+    }
+    return std::nullopt;
+}
+
+std::size_t FanoutPublisher::check_readers() {
+    const auto readers = ring_.readers();
+    std::size_t attached = 0;
+    std::size_t slow = 0;
+    std::unordered_map<uint32_t, uint64_t> lost;
+    for (const auto& r : readers) {
+        if (!r.alive) continue;   // Its slot goes to the next reader that attaches
+        // Keyed by slot: the bridge, and any subscriber sharing a process, has our pid
+        lost[r.slot] = r.lost;
+        const bool is_bridge = bridge_reader_ && r.slot == bridge_reader_->slot();
+        if (is_bridge) {
+            bridge_lag_metric_.set(static_cast<int64_t>(r.lag));
+        } else {
+            ++attached;
+        }
+
+        const auto it = reported_lost_.find(r.slot);
+        const uint64_t newly_lost = r.lost - (it != reported_lost_.end() && it->second <= r.lost ? it->second : 0);
+        if (r.lag <= cfg_.max_lag && newly_lost == 0) continue;
+        ++slow;
+        if (is_bridge) {
+            OCEAN_LOG_WARN("[FANOUT] {} zmq bridge is {} events behind, {} lost since last check",
+                           cfg_.stream, r.lag, newly_lost);
+        } else {
+            OCEAN_LOG_WARN("[FANOUT] {} reader pid {} is {} events behind, {} lost since last check",
+                           cfg_.stream, r.pid, r.lag, newly_lost);
+        }
+    }
+    reported_lost_ = std::move(lost);
+    readers_metric_.set(static_cast<int64_t>(attached));
+    slow_readers_metric_.set(static_cast<int64_t>(slow));
+    return slow;
+}
+
+FanoutEvent FanoutPublisher::book_event(const BookEvent& event) noexcept {
+    return FanoutEvent{
+        .ts_ns = event.recv_ns,
+        .kind = FanoutEvent::Kind::Book,
+        .update_count = event.update_count,
+        .best_bid = event.book.best_bid,
+        .best_ask = event.book.best_ask,
+        .mid = event.book.mid,
+        .bid_volume = event.book.bid_volume,
+        .ask_volume = event.book.ask_volume,
+        .bid_depth = event.book.bid_depth,
+        .ask_depth = event.book.ask_depth,
+        .update_volume = event.update_volume
+    };
+}
+
+FanoutEvent FanoutPublisher::trade_event(uint64_t ts_ns, float price, float amount, bool is_buy) noexcept {
+    return FanoutEvent{
+        .ts_ns = ts_ns,
+        .kind = FanoutEvent::Kind::Trade,
+        .is_buy = static_cast<uint8_t>(is_buy),
+        .price = price,
+        .amount = amount
+    };
+}
@@ -1,7 +1,8 @@
 #include "Core/MarketData.hpp"
 #include "Core/OrderBook.hpp"
+#include "Core/TradeTape.hpp"
+#include "Utils/AsyncLog.hpp"
 #include <cstring>
-#include <iostream>
 #include <zlib.h>
 #include <arpa/inet.h>
 #include <stdexcept>
@@ -10,10 +11,23 @@
 
 MarketData::MarketData(std::string_view endpoint, uint16_t port)
     : endpoint_(endpoint), port_(port) {
+    pending_.reserve(1024);
     buffer_.reserve(1024);
+    reading_.reserve(1024);
+    pending_frames_.reserve(64);
+    buffer_frames_.reserve(64);
+    reading_frames_.reserve(64);
     if (endpoint.empty()) {
         throw std::invalid_argument("Endpoint cannot be empty");
     }
+
+    Metrics::Registry& metrics = Metrics::global();
+    const std::string label = "{endpoint=\"" + endpoint_ + ":" + std::to_string(port) + "\"}";
+    frames_metric_ = metrics.counter("ocean_feed_frames_total" + label, "Binary frames accepted");
+    bytes_metric_ = metrics.counter("ocean_feed_bytes_total" + label, "Bytes received");
+    crc_errors_metric_ = metrics.counter("ocean_feed_crc_errors_total" + label, "Frames failing CRC32");
+    resyncs_metric_ = metrics.counter("ocean_feed_resyncs_total" + label, "Times framing was lost");
+    disconnects_metric_ = metrics.counter("ocean_feed_disconnects_total" + label, "Connections dropped");
 }
 
 MarketData::~MarketData() {
@@ -74,7 +88,7 @@ bool MarketData::try_connect() noexcept {
 
         // Wait for connection completion
         pollfd pfd{fd, POLLOUT, 0};
-        if (poll(&pfd, 1, 1000) <= 0) {  // 1s timeout
+        if (::poll(&pfd, 1, 1000) <= 0) {  // 1s timeout
             close(fd);
             return false;
         }
@@ -105,66 +119,131 @@ void MarketData::io_thread() noexcept {
         return;
     }
 
-    std::array<std::byte, 8192> recv_buf;
-    ssize_t n = recv(fd, recv_buf.data(), recv_buf.size(), MSG_DONTWAIT);
-    if (n <= 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            return;
-        }
-        connected_.store(false);
-        close(fd);
-        fd_.store(-1);
-        apply_backoff();
-        return;
+    // Keep room for at least one more read behind whatever is pending
+    if (rx_.size() - rx_len_ < kRecvBufferSize) {
+        rx_.resize(std::min(std::max(rx_.size() * 2, rx_len_ + kRecvBufferSize),
+                            kMaxFrameSize + kRecvBufferSize));
     }
 
-    // Full message validation
-    if (n < static_cast<ssize_t>(sizeof(BinMessage))) {
-        std::cerr << "Invalid message: too short\n";
+    const ssize_t n = recv(fd, rx_.data() + rx_len_, rx_.size() - rx_len_, MSG_DONTWAIT);
+    if (n == 0) {  // Orderly shutdown by the peer
+        drop_connection(fd);
         return;
     }
-
-    const auto* msg = reinterpret_cast<const BinMessage*>(recv_buf.data());
-    if (msg->magic != 0xDEADBEEF) {
-        std::cerr << "Invalid message: bad magic\n";
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return;
+        }
+        drop_connection(fd);
         return;
     }
+    rx_len_ += static_cast<size_t>(n);
+    bytes_metric_.add(static_cast<uint64_t>(n));
 
-    const uint32_t expected_crc = msg->crc32;
-    const uint32_t actual_crc = calculate_crc32(
-        reinterpret_cast<const std::byte*>(msg) + sizeof(msg->crc32),
-        sizeof(BinMessage) - sizeof(msg->crc32)
-    );
-    if (expected_crc != actual_crc) {
-        std::cerr << "CRC32 mismatch\n";
-        return;
+    pending_.clear();
+    pending_frames_.clear();
+    const size_t used = drain_frames(pending_, pending_frames_);
+    if (used > 0) {
+        std::memmove(rx_.data(), rx_.data() + used, rx_len_ - used);
+        rx_len_ -= used;
     }
 
-    const size_t expected_size = sizeof(BinMessage) + msg->count * sizeof(BinOrder);
-    if (n < static_cast<ssize_t>(expected_size)) {
-        std::cerr << "Incomplete message\n";
-        return;
+    // Every book frame of this read goes out as one batch; a batch the
+    // consumer hasn't taken yet is extended, never replaced
+    if (!pending_.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            if (buffer_.empty()) {
+                buffer_.swap(pending_);
+                buffer_frames_.swap(pending_frames_);
+            } else {
+                buffer_.insert(buffer_.end(), pending_.begin(), pending_.end());
+                buffer_frames_.insert(buffer_frames_.end(), pending_frames_.begin(), pending_frames_.end());
+            }
+        }
+        notifier_.notify();
     }
+}
 
-    // Process orders
-    std::vector<OrderBook::Order> new_orders;
-    new_orders.reserve(msg->count);
+size_t MarketData::drain_frames(std::pmr::vector<OrderBook::Order>& book_orders,
+                                std::pmr::vector<uint16_t>& frame_sizes) noexcept {
+    size_t pos = 0;
+    bool resyncing = false;
+    while (rx_len_ - pos >= sizeof(BinMessage)) {
+        BinMessage header;
+        std::memcpy(&header, rx_.data() + pos, sizeof(header));
 
-    const auto* orders = reinterpret_cast<const BinOrder*>(msg + 1);
-    for (uint16_t i = 0; i < msg->count; ++i) {
-        new_orders.push_back({
-            .price = orders[i].price,
-            .amount = orders[i].amount,
-            .is_bid = (orders[i].side == 0)
-        });
+        // Lost framing: slide one byte at a time to the next magic
+        if (header.magic != kBookMagic && header.magic != kTradeMagic) {
+            if (!resyncing) {
+                resyncs_metric_.add();
+                OCEAN_LOG_RATE(LogLevel::Warn, 10, "Invalid message: bad magic, resyncing");
+            }
+            resyncing = true;
+            ++pos;
+            continue;
+        }
+        resyncing = false;
+
+        const size_t frame_size = sizeof(BinMessage) + header.count * sizeof(BinOrder);
+        if (rx_len_ - pos < frame_size) {
+            break;  // Rest of the frame is still in flight
+        }
+
+        const std::byte* frame = rx_.data() + pos;
+        pos += frame_size;
+
+        // CRC covers everything after the crc field: rest of header + orders
+        const uint32_t actual_crc = calculate_crc32(frame + kCrcOffset, frame_size - kCrcOffset);
+        if (header.crc32 != actual_crc) {
+            crc_errors_metric_.add();
+            OCEAN_LOG_RATE(LogLevel::Warn, 10, "CRC32 mismatch");
+            continue;
+        }
+
+        const auto* orders = reinterpret_cast<const BinOrder*>(frame + sizeof(BinMessage));
+        frames_metric_.add();
+
+        // Prints go straight to the tape; they never touch the book buffer
+        if (header.magic == kTradeMagic) {
+            if (trade_tape_ || trade_handler_) {
+                for (uint16_t i = 0; i < header.count; ++i) {
+                    const bool is_buy = orders[i].side == 0;
+                    if (trade_tape_) trade_tape_->append(header.timestamp, orders[i].price, orders[i].amount, is_buy);
+                    if (trade_handler_) trade_handler_(header.timestamp, orders[i].price, orders[i].amount, is_buy);
+                }
+                notifier_.notify();
+            }
+            continue;
+        }
+
+        for (uint16_t i = 0; i < header.count; ++i) {
+            book_orders.push_back({
+                .price = orders[i].price,
+                .amount = orders[i].amount,
+                .is_bid = (orders[i].side == 0)
+            });
+        }
+        if (header.count > 0) frame_sizes.push_back(header.count);
     }
+    return pos;
+}
+
+void MarketData::drop_connection(int fd) noexcept {
+    disconnects_metric_.add();
+    connected_.store(false);
+    close(fd);
+    fd_.store(-1);
+    rx_len_ = 0;  // A partial frame never continues on a new connection
+    apply_backoff();
+}
 
-    // Atomic update
-    {
-        std::lock_guard<std::mutex> lock(buffer_mutex_);
-        buffer_ = std::move(new_orders);
-        buffer_size_.store(buffer_.size());
+void MarketData::poll(int timeout_ms) noexcept {
+    if (const int fd = fd_.load(); timeout_ms > 0 && connected_.load() && fd >= 0) {
+        pollfd pfd{fd, POLLIN, 0};
+        if (::poll(&pfd, 1, timeout_ms) == 0) return;
     }
+    io_thread();
 }
 
 uint32_t MarketData::calculate_crc32(const void* data, size_t length) const noexcept {
@@ -184,7 +263,21 @@ void MarketData::apply_backoff() noexcept {
     std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
 }
 
+void MarketData::attach_trade_tape(TradeTape& tape) noexcept {
+    trade_tape_ = &tape;
+}
+
+void MarketData::set_trade_handler(TradeHandler handler) noexcept {
+    trade_handler_ = std::move(handler);
+}
+
 std::span<const OrderBook::Order> MarketData::get_updates() noexcept {
     std::lock_guard<std::mutex> lock(buffer_mutex_);
-    return {buffer_.data(), buffer_size_.load()};
+    // Taken: the next call sees only newer frames. The previous batch's
+    // storage goes back to the io thread; the caller's span into it ends here.
+    reading_.clear();
+    reading_.swap(buffer_);
+    reading_frames_.clear();
+    reading_frames_.swap(buffer_frames_);
+    return reading_;
 }
\ No newline at end of file
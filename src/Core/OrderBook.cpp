@@ -6,7 +6,13 @@
 #include <algorithm>
 #include <mutex>
 
-void OrderBook::update(const std::vector<Order>& orders) noexcept {
+OrderBook::OrderBook()
+    : levels_(&own_arena_.emplace(HugePageArena::Config{
+          .name = "orderbook", .chunk_bytes = kOwnArenaBytes, .huge_pages = false})) {}
+
+OrderBook::OrderBook(std::pmr::memory_resource* levels) : levels_(levels) {}
+
+void OrderBook::update(std::span<const Order> orders) noexcept {
     // Writer lock (exclusive access)
     std::unique_lock lock(mtx_);
 
@@ -31,6 +37,19 @@ void OrderBook::update(const std::vector<Order>& orders) noexcept {
     }
 }
 
+void OrderBook::apply_snapshot(std::span<const Order> levels) noexcept {
+    std::unique_lock lock(mtx_);
+
+    // Nodes go back to the arena's free lists and straight out again
+    bids_.clear();
+    asks_.clear();
+    for (const auto& level : levels) {
+        if (level.amount <= 0.0f) continue;
+        auto& side = level.is_bid ? bids_ : asks_;
+        side.insert_or_assign(level.price, PriceLevel{level.amount, 1});
+    }
+}
+
 // In OrderBook.cpp
 float OrderBook::get_mid_price() const noexcept {
     std::shared_lock lock(mtx_); // Shared lock for thread safety
@@ -55,6 +74,52 @@ std::pair<float, float> OrderBook::get_bbo() const noexcept {
     return {best_bid, best_ask};
 }
 
+std::pair<float, float> OrderBook::depth_near_bbo(float band) const noexcept {
+    std::shared_lock lock(mtx_);
+    float bid_depth = 0.0f, ask_depth = 0.0f;
+
+    if (!bids_.empty()) {
+        const float floor = bids_.rbegin()->first * (1.0f - band);
+        for (auto it = bids_.rbegin(); it != bids_.rend() && it->first >= floor; ++it) {
+            bid_depth += it->second.total_amount;
+        }
+    }
+    if (!asks_.empty()) {
+        const float ceiling = asks_.begin()->first * (1.0f + band);
+        for (auto it = asks_.begin(); it != asks_.end() && it->first <= ceiling; ++it) {
+            ask_depth += it->second.total_amount;
+        }
+    }
+    return {bid_depth, ask_depth};
+}
+
+OrderBook::Snapshot OrderBook::snapshot(float band) const noexcept {
+    std::shared_lock lock(mtx_);
+    Snapshot out;
+
+    // One walk per side covers both the band depth and the totals
+    if (!bids_.empty()) {
+        out.best_bid = bids_.rbegin()->first;
+        const float floor = out.best_bid * (1.0f - band);
+        for (auto it = bids_.rbegin(); it != bids_.rend(); ++it) {
+            out.bid_volume += it->second.total_amount;
+            if (it->first >= floor) out.bid_depth += it->second.total_amount;
+        }
+    }
+    if (!asks_.empty()) {
+        out.best_ask = asks_.begin()->first;
+        const float ceiling = out.best_ask * (1.0f + band);
+        for (const auto& [price, level] : asks_) {
+            out.ask_volume += level.total_amount;
+            if (price <= ceiling) out.ask_depth += level.total_amount;
+        }
+    }
+    if (!bids_.empty() && !asks_.empty()) {
+        out.mid = (out.best_bid + out.best_ask) / 2.0f;
+    }
+    return out;
+}
+
 // In OrderBook.cpp
 float OrderBook::total_bid_volume() const noexcept {
     std::shared_lock lock(mtx_);
@@ -72,4 +137,9 @@ float OrderBook::total_ask_volume() const noexcept {
         total += level.total_amount;
     }
     return total;
-}
\ No newline at end of file
+}
+HugePageArena::Stats OrderBook::memory_stats() const noexcept {
+    std::shared_lock lock(mtx_);
+    const auto* arena = dynamic_cast<const HugePageArena*>(levels_);
+    return arena ? arena->stats() : HugePageArena::Stats{};
+}
@@ -0,0 +1,64 @@
+#include "Core/PipelineConfig.hpp"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+WaitPolicy parse_wait(const std::string& name) {
+    if (name == "busy_spin") return WaitPolicy::BusySpin;
+    if (name == "spin_then_futex") return WaitPolicy::SpinThenFutex;
+    if (name == "eventfd") return WaitPolicy::EventFd;
+    throw std::runtime_error("Unknown wait policy: " + name);
+}
+
+void read_stage(const nlohmann::json& stages, const char* name, StageConfig& out) {
+    if (!stages.contains(name)) return;
+    const auto& stage = stages.at(name);
+
+    out.cpu = stage.value("cpu", out.cpu);
+    out.spins = stage.value("spins", out.spins);
+    out.ring_size = stage.value("ring_size", out.ring_size);
+    if (stage.contains("wait")) out.wait = parse_wait(stage.at("wait").get<std::string>());
+
+    if (out.ring_size < 2) {
+        throw std::runtime_error(std::string("Ring too small for stage ") + name);
+    }
+}
+
+void read_fanout(const nlohmann::json& fanout, FanoutConfig& out) {
+    out.stream = fanout.value("stream", out.stream);
+    out.ring_capacity = fanout.value("ring_capacity", out.ring_capacity);
+    out.zmq_endpoint = fanout.value("zmq_endpoint", out.zmq_endpoint);
+    out.zmq_trade_endpoint = fanout.value("zmq_trade_endpoint", out.zmq_trade_endpoint);
+    out.max_lag = fanout.value("max_lag", out.max_lag);
+
+    if (out.stream.empty() || out.stream.find('/') != std::string::npos) {
+        throw std::runtime_error("Bad fanout stream name: " + out.stream);
+    }
+}
+}
+
+PipelineConfig load_pipeline_config(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open pipeline config: " + path);
+    }
+
+    try {
+        const nlohmann::json root = nlohmann::json::parse(in);
+        PipelineConfig cfg;
+        cfg.endpoint = root.value("endpoint", cfg.endpoint);
+        cfg.port = root.value("port", cfg.port);
+
+        if (root.contains("stages")) {
+            const auto& stages = root.at("stages");
+            read_stage(stages, "feed", cfg.feed);
+            read_stage(stages, "book", cfg.book);
+            read_stage(stages, "strategy", cfg.strategy);
+        }
+        if (root.contains("fanout")) read_fanout(root.at("fanout"), cfg.fanout);
+        return cfg;
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Bad pipeline config " + path + ": " + e.what());
+    }
+}
@@ -0,0 +1,309 @@
+#include "Core/ShmRing.hpp"
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <immintrin.h>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//--------------------------------------------------------------------
+// File layout, each part cache-line aligned:
+//   Header                 geometry, then the writer's head and the
+//                          sleeper count on lines of their own
+//   max_readers ReaderSlot one line per reader, written by that reader
+//                          (and by the writer reclaiming a dead sleeper)
+//   capacity Slot          one line per event
+// The magic is stored last, so a reader never sees a half-made ring.
+//--------------------------------------------------------------------
+namespace ShmRingLayout {
+constexpr uint64_t kMagic = 0x474E'4952'4E41'4543;   // "CEANRING"
+constexpr uint32_t kVersion = 2;
+constexpr std::size_t kWords = sizeof(FanoutEvent) / sizeof(uint64_t);
+
+struct Header {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t max_readers;
+    uint32_t writer_pid;
+    std::atomic<uint32_t> closed;
+    alignas(64) std::atomic<uint64_t> head;   // Events published
+    std::atomic<uint32_t> wake;               // Futex word; bumped only with sleepers
+    alignas(64) std::atomic<uint32_t> sleepers;
+};
+
+struct alignas(64) ReaderSlot {
+    std::atomic<uint32_t> pid;        // 0: free
+    std::atomic<uint32_t> sleeping;   // pid while counted in sleepers, else 0
+    std::atomic<uint64_t> position;
+    std::atomic<uint64_t> lost;
+};
+
+// seq is 2n+1 while event n is written into the slot, 2n+2 once it is whole
+struct alignas(64) Slot {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> words[kWords];
+};
+static_assert(sizeof(Slot) == 64);
+}
+
+using namespace ShmRingLayout;
+
+namespace {
+std::size_t readers_offset() noexcept {
+    return sizeof(Header);
+}
+
+std::size_t slots_offset(std::size_t max_readers) noexcept {
+    return readers_offset() + max_readers * sizeof(ReaderSlot);
+}
+
+std::size_t file_bytes(std::size_t max_readers, std::size_t capacity) noexcept {
+    return slots_offset(max_readers) + capacity * sizeof(Slot);
+}
+
+std::runtime_error system_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+long futex(std::atomic<uint32_t>* word, int op, uint32_t value, const timespec* timeout) noexcept {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value, timeout, nullptr, 0);
+}
+
+// Shared futex: sleepers live in other processes
+void wake_all(Header& h) noexcept {
+    h.wake.fetch_add(1, std::memory_order_release);
+    futex(&h.wake, FUTEX_WAKE, INT_MAX, nullptr);
+}
+
+bool process_alive(uint32_t pid) noexcept {
+    return pid != 0 && (::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+}
+
+// Hands back the sleeper count of a reader that died in wait(). The CAS
+// on its pid means only one of us, it or a reader taking over the slot,
+// gives the count back, and never on behalf of a live sleeper.
+void reclaim_sleeper(Header& h, ReaderSlot& r) noexcept {
+    uint32_t pid = r.sleeping.load(std::memory_order_acquire);
+    if (pid != 0 && !process_alive(pid) && r.sleeping.compare_exchange_strong(pid, 0, std::memory_order_acq_rel)) {
+        h.sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+}
+
+//--------------------------------------------------------------------
+// WRITER
+//--------------------------------------------------------------------
+ShmRingWriter::ShmRingWriter(const Config& cfg) : path_(cfg.path) {
+    const std::size_t capacity = std::bit_ceil(std::max<std::size_t>(cfg.capacity, 2));
+    const std::size_t max_readers = std::max<std::size_t>(cfg.max_readers, 1);
+    if (capacity > UINT32_MAX || max_readers > UINT32_MAX) {
+        throw std::invalid_argument("Ring geometry too large for " + path_);
+    }
+    bytes_ = file_bytes(max_readers, capacity);
+    mask_ = capacity - 1;
+
+    // A fresh inode: readers still mapping a previous run's ring keep it
+    ::unlink(path_.c_str());
+    const int fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) throw system_error("Cannot create ring", path_);
+    void* map = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(bytes_)) == 0) {
+        map = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    }
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        ::unlink(path_.c_str());
+        throw system_error("Cannot map ring", path_);
+    }
+    map_ = static_cast<std::byte*>(map);
+
+    header_ = reinterpret_cast<Header*>(map_);
+    readers_ = reinterpret_cast<ReaderSlot*>(map_ + readers_offset());
+    slots_ = reinterpret_cast<Slot*>(map_ + slots_offset(max_readers));
+
+    header_->version = kVersion;
+    header_->capacity = static_cast<uint32_t>(capacity);
+    header_->max_readers = static_cast<uint32_t>(max_readers);
+    header_->writer_pid = static_cast<uint32_t>(::getpid());
+    header_->magic.store(kMagic, std::memory_order_release);
+}
+
+ShmRingWriter::~ShmRingWriter() {
+    header_->closed.store(1, std::memory_order_release);
+    wake_all(*header_);
+    ::munmap(map_, bytes_);
+    ::unlink(path_.c_str());
+}
+
+void ShmRingWriter::publish(const FanoutEvent& event) noexcept {
+    uint64_t words[kWords];
+    std::memcpy(words, &event, sizeof(event));
+
+    Slot& slot = slots_[next_ & mask_];
+    slot.seq.store(2 * next_ + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < kWords; ++i) slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.seq.store(2 * next_ + 2, std::memory_order_release);
+
+    // seq_cst pairs with a sleeper's increment: either it sees the new
+    // head before sleeping or we see it registered and wake it
+    header_->head.store(++next_, std::memory_order_seq_cst);
+    if (header_->sleepers.load(std::memory_order_seq_cst) > 0) [[unlikely]] wake_all(*header_);
+}
+
+std::vector<ShmRingWriter::ReaderState> ShmRingWriter::readers() const {
+    std::vector<ReaderState> out;
+    uint32_t sleepers = header_->sleepers.load(std::memory_order_acquire);
+    bool any_alive = false;
+    for (uint32_t i = 0; i < header_->max_readers; ++i) {
+        ReaderSlot& r = readers_[i];
+        reclaim_sleeper(*header_, r);
+        const uint32_t pid = r.pid.load(std::memory_order_acquire);
+        if (pid == 0) continue;
+        const uint64_t position = r.position.load(std::memory_order_relaxed);
+        out.push_back({
+            .slot = i,
+            .pid = pid,
+            .position = position,
+            .lag = next_ > position ? next_ - position : 0,
+            .lost = r.lost.load(std::memory_order_relaxed),
+            .alive = process_alive(pid)
+        });
+        any_alive = any_alive || out.back().alive;
+    }
+    // A reader killed between counting itself and posting its flag is
+    // invisible above; with nobody left alive the count must be zero. The
+    // CAS fails if a new reader started sleeping meanwhile.
+    if (!any_alive && sleepers != 0) {
+        header_->sleepers.compare_exchange_strong(sleepers, 0, std::memory_order_acq_rel);
+    }
+    return out;
+}
+
+uint32_t ShmRingWriter::sleepers() const noexcept {
+    return header_->sleepers.load(std::memory_order_acquire);
+}
+
+//--------------------------------------------------------------------
+// READER
+//--------------------------------------------------------------------
+ShmRingReader::ShmRingReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) throw system_error("Cannot open ring", path);
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+        ::close(fd);
+        throw std::runtime_error("Not a ring: " + path);
+    }
+    bytes_ = static_cast<std::size_t>(st.st_size);
+    void* map = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) throw system_error("Cannot map ring", path);
+    map_ = static_cast<std::byte*>(map);
+    header_ = reinterpret_cast<Header*>(map_);
+
+    const auto fail = [&](const std::string& why) {
+        ::munmap(map_, bytes_);
+        return std::runtime_error(why + ": " + path);
+    };
+    if (header_->magic.load(std::memory_order_acquire) != kMagic || header_->version != kVersion ||
+        !std::has_single_bit(header_->capacity) ||
+        file_bytes(header_->max_readers, header_->capacity) != bytes_) {
+        throw fail("Not a ring");
+    }
+    mask_ = header_->capacity - 1;
+    slots_ = reinterpret_cast<Slot*>(map_ + slots_offset(header_->max_readers));
+
+    // Take a free slot, or one left behind by a reader that died
+    auto* table = reinterpret_cast<ReaderSlot*>(map_ + readers_offset());
+    const auto self = static_cast<uint32_t>(::getpid());
+    for (uint32_t i = 0; i < header_->max_readers && !slot_; ++i) {
+        uint32_t pid = table[i].pid.load(std::memory_order_acquire);
+        if (pid != 0 && process_alive(pid)) continue;
+        if (table[i].pid.compare_exchange_strong(pid, self, std::memory_order_acq_rel)) {
+            slot_ = &table[i];
+            slot_index_ = i;
+        }
+    }
+    if (!slot_) throw fail("No free reader slot");
+    reclaim_sleeper(*header_, *slot_);
+
+    position_ = header_->head.load(std::memory_order_acquire);
+    slot_->lost.store(0, std::memory_order_relaxed);
+    slot_->position.store(position_, std::memory_order_relaxed);
+}
+
+ShmRingReader::~ShmRingReader() {
+    slot_->pid.store(0, std::memory_order_release);
+    ::munmap(map_, bytes_);
+}
+
+ShmRingReader::Status ShmRingReader::poll(FanoutEvent& out) noexcept {
+    const Slot& slot = slots_[position_ & mask_];
+    const uint64_t expected = 2 * position_ + 2;
+
+    uint64_t seq = slot.seq.load(std::memory_order_acquire);
+    if (seq == expected) {
+        uint64_t words[kWords];
+        for (std::size_t i = 0; i < kWords; ++i) words[i] = slot.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        seq = slot.seq.load(std::memory_order_relaxed);
+        if (seq == expected) {
+            std::memcpy(&out, words, sizeof(out));
+            slot_->position.store(++position_, std::memory_order_relaxed);
+            return Status::Ok;
+        }
+    }
+    if (seq < expected) {
+        // Older event, or ours half-written
+        return header_->closed.load(std::memory_order_acquire) ? Status::Closed : Status::Empty;
+    }
+
+    // Lapped: resume half a ring behind the writer, out of its way
+    const uint64_t head = header_->head.load(std::memory_order_acquire);
+    const uint64_t resume = std::max(position_ + 1, head - std::min(head, (mask_ + 1) / 2));
+    lost_ += resume - position_;
+    position_ = resume;
+    slot_->lost.store(lost_, std::memory_order_relaxed);
+    slot_->position.store(position_, std::memory_order_relaxed);
+    return Status::Lapped;
+}
+
+void ShmRingReader::wait(std::chrono::nanoseconds timeout, uint32_t spins) noexcept {
+    const auto ready = [&](std::memory_order order) {
+        return header_->head.load(order) > position_ || header_->closed.load(std::memory_order_acquire);
+    };
+    for (uint32_t i = 0; i < spins; ++i) {
+        if (ready(std::memory_order_acquire)) return;
+        _mm_pause();
+    }
+
+    const auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    const timespec ts{
+        .tv_sec = static_cast<time_t>(secs.count()),
+        .tv_nsec = static_cast<long>((timeout - secs).count())
+    };
+    // Counted first, flagged second: a flag always stands for a count, so
+    // the writer can hand ours back if we are killed in here
+    const uint32_t self = slot_->pid.load(std::memory_order_relaxed);
+    const uint32_t wake = header_->wake.load(std::memory_order_acquire);
+    header_->sleepers.fetch_add(1, std::memory_order_seq_cst);
+    slot_->sleeping.store(self, std::memory_order_release);
+    if (!ready(std::memory_order_seq_cst)) {
+        // Kernel re-checks the word, so a publish() in between can't be lost
+        futex(&header_->wake, FUTEX_WAIT, wake, &ts);
+    }
+    uint32_t flagged = self;
+    if (slot_->sleeping.compare_exchange_strong(flagged, 0, std::memory_order_acq_rel)) {
+        header_->sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,22 @@
+#include "Core/ThreadAffinity.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <array>
+
+bool pin_current_thread(int cpu) noexcept {
+    if (cpu < 0) return true;
+    if (cpu >= CPU_SETSIZE) return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+void name_current_thread(std::string_view name) noexcept {
+    std::array<char, 16> buf{};
+    const size_t n = std::min(name.size(), buf.size() - 1);
+    std::copy_n(name.data(), n, buf.data());
+    pthread_setname_np(pthread_self(), buf.data());
+}
@@ -0,0 +1,176 @@
+#include "Core/TradeTape.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <mutex>
+
+namespace {
+constexpr float kNoLow = std::numeric_limits<float>::max();
+constexpr float kNoHigh = std::numeric_limits<float>::lowest();
+}
+
+TradeTape::TradeTape(std::size_t capacity)
+    : ring_(std::bit_ceil(std::max<std::size_t>(capacity, 2))),
+      cum_volume_(ring_.size(), 0.0),
+      cum_notional_(ring_.size(), 0.0),
+      tree_(2 * ring_.size(), Extremes{kNoLow, kNoHigh}),
+      mask_(ring_.size() - 1) {}
+
+void TradeTape::append(uint64_t ts_ns, float price, float amount, bool is_buy) noexcept {
+    std::unique_lock lock(mtx_);
+
+    if (head_ > 0) {
+        ts_ns = std::max(ts_ns, ring_[(head_ - 1) & mask_].ts_ns);
+    }
+
+    const std::size_t slot = head_ & mask_;
+    total_volume_ += amount;
+    total_notional_ += static_cast<double>(price) * amount;
+
+    ring_[slot] = {ts_ns, price, amount, is_buy};
+    cum_volume_[slot] = total_volume_;
+    cum_notional_[slot] = total_notional_;
+
+    // Refresh the leaf and its ancestors
+    std::size_t node = slot + ring_.size();
+    tree_[node] = {price, price};
+    for (node >>= 1; node > 0; node >>= 1) {
+        const Extremes& l = tree_[2 * node];
+        const Extremes& r = tree_[2 * node + 1];
+        tree_[node] = {std::min(l.low, r.low), std::max(l.high, r.high)};
+    }
+
+    ++head_;
+}
+
+TradeTape::WindowStats TradeTape::window(uint64_t from_ns, uint64_t to_ns) const noexcept {
+    std::shared_lock lock(mtx_);
+    const auto [first, last] = locate(from_ns, to_ns);
+    return stats(first, last);
+}
+
+TradeTape::WindowStats TradeTape::last(std::chrono::nanoseconds span) const noexcept {
+    std::shared_lock lock(mtx_);
+    if (head_ == 0) return {};
+
+    const uint64_t newest = ring_[(head_ - 1) & mask_].ts_ns;
+    const auto width = static_cast<uint64_t>(std::max<int64_t>(span.count(), 0));
+    const auto [first, last] = locate(newest > width ? newest - width : 0, newest);
+    return stats(first, last);
+}
+
+TradeTape::TrailingStats TradeTape::trailing(std::chrono::nanoseconds span, std::size_t windows) const noexcept {
+    std::shared_lock lock(mtx_);
+    if (head_ == 0) return {};
+
+    const uint64_t newest = ring_[(head_ - 1) & mask_].ts_ns;
+    const uint64_t oldest = ring_[(head_ - std::min<uint64_t>(head_, ring_.size())) & mask_].ts_ns;
+    const auto width = static_cast<uint64_t>(std::max<int64_t>(span.count(), 0));
+    const uint64_t recent_from = newest > width ? newest - width : 0;
+    const uint64_t history = width * windows;
+    const uint64_t baseline_from = recent_from > history ? recent_from - history : 0;
+
+    const auto [first, last] = locate(recent_from, newest);
+    const uint64_t baseline_first = locate(baseline_from, newest).first;
+
+    TrailingStats out;
+    out.recent = stats(first, last);
+    out.baseline = stats(baseline_first, first);
+    out.baseline_ns = std::min(recent_from > oldest ? recent_from - oldest : 0, history);
+    return out;
+}
+
+std::pair<std::span<const TradeTape::Print>, std::span<const TradeTape::Print>>
+TradeTape::prints(uint64_t from_ns, uint64_t to_ns) const noexcept {
+    std::shared_lock lock(mtx_);
+    const auto [first, last] = locate(from_ns, to_ns);
+    if (first == last) return {};
+
+    const std::size_t lo = first & mask_;
+    const std::size_t count = last - first;
+    if (lo + count <= ring_.size()) {
+        return {std::span(ring_).subspan(lo, count), {}};
+    }
+    return {std::span(ring_).subspan(lo), std::span(ring_).first(lo + count - ring_.size())};
+}
+
+uint64_t TradeTape::sequence() const noexcept {
+    std::shared_lock lock(mtx_);
+    return head_;
+}
+
+std::size_t TradeTape::size() const noexcept {
+    std::shared_lock lock(mtx_);
+    return static_cast<std::size_t>(std::min<uint64_t>(head_, ring_.size()));
+}
+
+uint64_t TradeTape::latest_ns() const noexcept {
+    std::shared_lock lock(mtx_);
+    return head_ == 0 ? 0 : ring_[(head_ - 1) & mask_].ts_ns;
+}
+
+uint64_t TradeTape::oldest_ns() const noexcept {
+    std::shared_lock lock(mtx_);
+    return head_ == 0 ? 0 : ring_[(head_ - std::min<uint64_t>(head_, ring_.size())) & mask_].ts_ns;
+}
+
+//--------------------------------------------------------------------
+// LOOKUP: binary search over sequence numbers; timestamps are sorted
+//--------------------------------------------------------------------
+std::pair<uint64_t, uint64_t> TradeTape::locate(uint64_t from_ns, uint64_t to_ns) const noexcept {
+    const uint64_t oldest = head_ - std::min<uint64_t>(head_, ring_.size());
+    if (from_ns > to_ns) return {oldest, oldest};
+
+    auto search = [this, oldest](auto&& before) {
+        uint64_t lo = oldest, hi = head_;
+        while (lo < hi) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (before(ring_[mid & mask_].ts_ns)) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    };
+
+    const uint64_t first = search([from_ns](uint64_t ts) { return ts < from_ns; });
+    const uint64_t last = search([to_ns](uint64_t ts) { return ts <= to_ns; });
+    return {first, std::max(first, last)};
+}
+
+TradeTape::WindowStats TradeTape::stats(uint64_t first, uint64_t last) const noexcept {
+    if (first >= last) return {};
+
+    const std::size_t lo = first & mask_;
+    const std::size_t hi = (last - 1) & mask_;
+    const Print& head = ring_[lo];
+
+    WindowStats out;
+    out.count = static_cast<std::size_t>(last - first);
+    out.volume = cum_volume_[hi] - (cum_volume_[lo] - head.amount);
+    out.notional = cum_notional_[hi] -
+        (cum_notional_[lo] - static_cast<double>(head.price) * head.amount);
+    out.vwap = out.volume > 0.0 ? static_cast<float>(out.notional / out.volume) : head.price;
+
+    Extremes ext = lo <= hi ? extremes(lo, hi + 1) : extremes(lo, ring_.size());
+    if (lo > hi) {
+        const Extremes wrapped = extremes(0, hi + 1);
+        ext = {std::min(ext.low, wrapped.low), std::max(ext.high, wrapped.high)};
+    }
+    out.low = ext.low;
+    out.high = ext.high;
+    return out;
+}
+
+TradeTape::Extremes TradeTape::extremes(std::size_t lo, std::size_t hi) const noexcept {
+    Extremes out{kNoLow, kNoHigh};
+    for (lo += ring_.size(), hi += ring_.size(); lo < hi; lo >>= 1, hi >>= 1) {
+        if (lo & 1) {
+            out = {std::min(out.low, tree_[lo].low), std::max(out.high, tree_[lo].high)};
+            ++lo;
+        }
+        if (hi & 1) {
+            --hi;
+            out = {std::min(out.low, tree_[hi].low), std::max(out.high, tree_[hi].high)};
+        }
+    }
+    return out;
+}
@@ -0,0 +1,76 @@
+#include "Execution/MockVenue.hpp"
+#include <algorithm>
+
+namespace {
+constexpr std::size_t kReportCapacity = 1024;   // Reports between polls before the queue grows
+}
+
+MockVenue::MockVenue() : MockVenue(Config{}) {}
+
+MockVenue::MockVenue(Config cfg) : cfg_(cfg) {
+    reports_.reserve(kReportCapacity);
+    resting_.reserve(kReportCapacity);
+}
+
+bool MockVenue::send(std::span<const std::byte> bytes) {
+    if (!connected_ || bytes.empty()) return false;
+    ++messages_;
+    bytes_ += bytes.size();
+
+    switch (static_cast<OrderWire::MsgType>(bytes[0])) {
+        case OrderWire::MsgType::New:
+            if (const auto msg = OrderWire::decode<OrderWire::NewOrder>(bytes)) on_new(*msg);
+            break;
+        case OrderWire::MsgType::Cancel:
+            if (const auto msg = OrderWire::decode<OrderWire::CancelOrder>(bytes)) on_cancel(*msg);
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+void MockVenue::on_new(const OrderWire::NewOrder& msg) {
+    const uint64_t venue_id = next_venue_id_++;
+    if (cfg_.reject_all || !(msg.quantity > 0.0) || !(msg.price > 0.0)) {
+        report(OrderWire::ExecType::Rejected, msg.client_id, venue_id);
+        return;
+    }
+    report(OrderWire::ExecType::Ack, msg.client_id, venue_id);
+
+    if (!cfg_.fill) {
+        resting_.push_back({msg.client_id, venue_id});
+        return;
+    }
+    const uint32_t slices = std::max<uint32_t>(cfg_.fill_slices, 1);
+    const double slice = msg.quantity / slices;
+    for (uint32_t i = 1; i < slices; ++i) {
+        report(OrderWire::ExecType::Fill, msg.client_id, venue_id, slice, msg.price);
+    }
+    // Last slice takes the remainder, so the fills sum to the order exactly
+    report(OrderWire::ExecType::Fill, msg.client_id, venue_id, msg.quantity - slice * (slices - 1), msg.price);
+}
+
+void MockVenue::on_cancel(const OrderWire::CancelOrder& msg) {
+    const auto it = std::find_if(resting_.begin(), resting_.end(),
+                                 [&](const Resting& r) { return r.client_id == msg.client_id; });
+    if (it == resting_.end()) {
+        report(OrderWire::ExecType::CancelRejected, msg.client_id, 0);
+        return;
+    }
+    report(OrderWire::ExecType::Canceled, msg.client_id, it->venue_id);
+    *it = resting_.back();
+    resting_.pop_back();
+}
+
+void MockVenue::report(OrderWire::ExecType exec, uint64_t client_id, uint64_t venue_id,
+                       double quantity, double price) {
+    OrderWire::Report r{};
+    r.type = OrderWire::MsgType::Report;
+    r.exec = exec;
+    r.client_id = client_id;
+    r.venue_id = venue_id;
+    r.last_quantity = quantity;
+    r.last_price = price;
+    reports_.push_back(r);
+}
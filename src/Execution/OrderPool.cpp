@@ -0,0 +1,37 @@
+#include "Execution/OrderPool.hpp"
+
+OrderPool::OrderPool(std::size_t capacity) : slots_(capacity) {
+    free_.reserve(capacity);
+    // Lowest slots on top, so a quiet gateway keeps reusing warm lines
+    for (std::size_t i = capacity; i-- > 0;) free_.push_back(static_cast<uint32_t>(i));
+}
+
+Order* OrderPool::acquire() noexcept {
+    if (free_.empty()) return nullptr;
+    const uint32_t slot = free_.back();
+    free_.pop_back();
+
+    Order& order = slots_[slot];
+    const uint32_t generation = order.generation + 1;   // Never 0, so no id equals kNoOrder
+    order = Order{};
+    order.generation = generation;
+    order.id = (static_cast<ClientOrderId>(generation) << 32) | slot;
+    return &order;
+}
+
+void OrderPool::release(Order& order) noexcept {
+    const uint32_t slot = slot_of(order.id);
+    order.id = kNoOrder;   // Generation stays; the next acquire bumps it
+    free_.push_back(slot);
+}
+
+Order* OrderPool::find(ClientOrderId id) noexcept {
+    const uint32_t slot = slot_of(id);
+    if (slot >= slots_.size()) return nullptr;
+    Order& order = slots_[slot];
+    return order.id == id && id != kNoOrder && order.generation == generation_of(id) ? &order : nullptr;
+}
+
+const Order* OrderPool::find(ClientOrderId id) const noexcept {
+    return const_cast<OrderPool*>(this)->find(id);
+}
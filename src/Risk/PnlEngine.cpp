@@ -0,0 +1,178 @@
+#include "Risk/PnlEngine.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr auto kRelaxed = std::memory_order_relaxed;
+constexpr double kFlat = 1e-12;   // Quantities below this are a closed position
+}
+
+PnlEngine::PnlEngine(std::size_t symbols, double startingBalance)
+    : positions_(symbols), cash_(startingBalance), dayStartEquity_(startingBalance) {
+    work_.peakEquity = startingBalance;
+    publish();
+}
+
+void PnlEngine::attachRisk(RiskEngine& risk, RiskEngine::AccountId account) noexcept {
+    risk_ = &risk;
+    account_ = account;
+    risk_->startDay(account_, dayStartEquity_);
+    risk_->setBalance(account_, equity());
+}
+
+void PnlEngine::startDay() noexcept {
+    resync();
+    cash_ += work_.realized;
+    work_.realized = 0.0;
+    for (auto& p : positions_) p.realized = 0.0;
+
+    dayStartEquity_ = equity();
+    work_.peakEquity = dayStartEquity_;
+    if (risk_) risk_->startDay(account_, dayStartEquity_);
+    publish();
+}
+
+double PnlEngine::unrealizedOf(const Position& p) noexcept {
+    if (p.quantity > 0.0 && p.bid > 0.0) return p.quantity * (p.bid - p.averagePrice);
+    if (p.quantity < 0.0 && p.ask > 0.0) return p.quantity * (p.ask - p.averagePrice);
+    return 0.0;
+}
+
+double PnlEngine::midOf(const Position& p) noexcept {
+    if (p.bid > 0.0 && p.ask > 0.0) return 0.5 * (p.bid + p.ask);
+    if (p.bid > 0.0) return p.bid;
+    if (p.ask > 0.0) return p.ask;
+    return p.averagePrice;
+}
+
+void PnlEngine::remove(const Position& p) noexcept {
+    const double notional = p.quantity * midOf(p);
+    work_.unrealized -= p.unrealized;
+    work_.netExposure -= notional;
+    work_.grossExposure -= std::abs(notional);
+}
+
+void PnlEngine::add(const Position& p) noexcept {
+    const double notional = p.quantity * midOf(p);
+    work_.unrealized += p.unrealized;
+    work_.netExposure += notional;
+    work_.grossExposure += std::abs(notional);
+}
+
+//------------------------------------------------------------------
+// Average-cost fills: adding keeps a blended price, reducing realizes
+// against it, crossing through flat reopens at the fill price
+//------------------------------------------------------------------
+void PnlEngine::onFill(SymbolId symbol, bool isBuy, double quantity, double price, double fee) noexcept {
+    if (symbol >= positions_.size() || !(quantity > 0.0)) return;
+    Position& p = positions_[symbol];
+    remove(p);
+
+    const double signedQty = isBuy ? quantity : -quantity;
+    double realized = -fee;
+    if (p.quantity == 0.0 || (p.quantity > 0.0) == isBuy) {
+        const double total = p.quantity + signedQty;
+        p.averagePrice = (p.averagePrice * p.quantity + price * signedQty) / total;
+        p.quantity = total;
+    } else {
+        const double closing = std::min(quantity, std::abs(p.quantity));
+        realized += closing * (price - p.averagePrice) * (p.quantity > 0.0 ? 1.0 : -1.0);
+        p.quantity += signedQty;
+        if (std::abs(p.quantity) < kFlat) {
+            p.quantity = 0.0;
+            p.averagePrice = 0.0;
+        } else if ((p.quantity > 0.0) == isBuy) {
+            p.averagePrice = price;
+        }
+    }
+    p.realized += realized;
+    work_.realized += realized;
+
+    p.unrealized = unrealizedOf(p);
+    add(p);
+    finishUpdate();
+}
+
+void PnlEngine::onBbo(SymbolId symbol, double bid, double ask) noexcept {
+    if (symbol >= positions_.size()) return;
+    Position& p = positions_[symbol];
+    if (p.quantity == 0.0) {
+        // Flat: nothing to revalue, keep the mark for the next fill
+        p.bid = bid;
+        p.ask = ask;
+        return;
+    }
+    remove(p);
+    p.bid = bid;
+    p.ask = ask;
+    p.unrealized = unrealizedOf(p);
+    add(p);
+    finishUpdate();
+}
+
+void PnlEngine::finishUpdate() noexcept {
+    if (++sinceResync_ >= kResyncInterval) resync();
+    work_.peakEquity = std::max(work_.peakEquity, equity());
+    publish();
+    if (risk_) risk_->setBalance(account_, equity());
+}
+
+void PnlEngine::resync() noexcept {
+    Work fresh;
+    fresh.peakEquity = work_.peakEquity;
+    for (const auto& p : positions_) {
+        const double notional = p.quantity * midOf(p);
+        fresh.realized += p.realized;
+        fresh.unrealized += p.unrealized;
+        fresh.netExposure += notional;
+        fresh.grossExposure += std::abs(notional);
+    }
+    work_ = fresh;
+    sinceResync_ = 0;
+}
+
+//------------------------------------------------------------------
+// Seqlock: readers retry while the sequence is odd or moved under them
+//------------------------------------------------------------------
+void PnlEngine::publish() noexcept {
+    const uint64_t seq = seq_.load(kRelaxed);
+    seq_.store(seq + 1, kRelaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    realized_.store(work_.realized, kRelaxed);
+    unrealized_.store(work_.unrealized, kRelaxed);
+    equity_.store(equity(), kRelaxed);
+    netExposure_.store(work_.netExposure, kRelaxed);
+    grossExposure_.store(work_.grossExposure, kRelaxed);
+    peakEquity_.store(work_.peakEquity, kRelaxed);
+    dayStartEquityPublished_.store(dayStartEquity_, kRelaxed);
+
+    seq_.store(seq + 2, std::memory_order_release);
+}
+
+PnlEngine::Totals PnlEngine::totals() const noexcept {
+    Totals t;
+    double dayStart = 0.0;
+    uint64_t before = 0;
+    uint64_t after = 0;
+    do {
+        before = seq_.load(std::memory_order_acquire);
+        t.realized = realized_.load(kRelaxed);
+        t.unrealized = unrealized_.load(kRelaxed);
+        t.equity = equity_.load(kRelaxed);
+        t.netExposure = netExposure_.load(kRelaxed);
+        t.grossExposure = grossExposure_.load(kRelaxed);
+        t.peakEquity = peakEquity_.load(kRelaxed);
+        dayStart = dayStartEquityPublished_.load(kRelaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = seq_.load(kRelaxed);
+    } while ((before & 1) || before != after);
+
+    if (dayStart > 0.0) t.dailyLoss = std::max(0.0, (dayStart - t.equity) / dayStart);
+    if (t.peakEquity > 0.0) t.drawdown = std::max(0.0, (t.peakEquity - t.equity) / t.peakEquity);
+    return t;
+}
+
+bool PnlEngine::dailyLossBreached() const noexcept {
+    return risk_ && risk_->dailyLossBreached(account_);
+}
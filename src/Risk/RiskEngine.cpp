@@ -0,0 +1,163 @@
+#include "Risk/RiskEngine.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr auto kRelaxed = std::memory_order_relaxed;
+}
+
+RiskEngine::RiskEngine(std::size_t accounts, std::size_t symbols)
+    : accounts_count_(accounts),
+      symbols_count_(symbols),
+      accounts_(std::make_unique<AccountState[]>(accounts)),
+      symbols_(std::make_unique<SymbolState[]>(accounts * symbols)) {}
+
+void RiskEngine::setAccountLimits(AccountId account, const AccountLimits& limits) noexcept {
+    if (account >= accounts_count_) return;
+    AccountState& a = accounts_[account];
+    a.maxRiskFraction.store(limits.maxRiskFraction, kRelaxed);
+    a.maxDailyLossFraction.store(limits.maxDailyLossFraction, kRelaxed);
+    a.maxOrderNotional.store(limits.maxOrderNotional, kRelaxed);
+}
+
+void RiskEngine::setSymbolLimits(AccountId account, SymbolId symbol, const SymbolLimits& limits) noexcept {
+    if (!valid(account, symbol)) return;
+    SymbolState& s = cell(account, symbol);
+    s.maxOrderNotional.store(limits.maxOrderNotional, kRelaxed);
+    s.maxPosition.store(limits.maxPosition, kRelaxed);
+}
+
+void RiskEngine::startDay(AccountId account, double balance) noexcept {
+    if (account >= accounts_count_) return;
+    accounts_[account].dayStartBalance.store(balance, kRelaxed);
+    accounts_[account].balance.store(balance, kRelaxed);
+}
+
+void RiskEngine::setBalance(AccountId account, double balance) noexcept {
+    if (account < accounts_count_) accounts_[account].balance.store(balance, kRelaxed);
+}
+
+void RiskEngine::halt(AccountId account, bool halted) noexcept {
+    if (account < accounts_count_) accounts_[account].halted.store(halted, std::memory_order_release);
+}
+
+void RiskEngine::adjustForVolatility(AccountId account, double multiplier) noexcept {
+    if (account < accounts_count_ && multiplier > 0.0) {
+        accounts_[account].riskMultiplier.store(multiplier, kRelaxed);
+    }
+}
+
+double RiskEngine::riskFraction(const AccountState& a) noexcept {
+    const double base = a.maxRiskFraction.load(kRelaxed);
+    const double scaled = std::max(kMinRiskFraction, base / a.riskMultiplier.load(kRelaxed));
+    return std::min(base, scaled);
+}
+
+double RiskEngine::worstCase(const SymbolState& s, double buys, double sells) noexcept {
+    const double position = s.position.load(kRelaxed);
+    return std::max(std::abs(position + buys), std::abs(position - sells));
+}
+
+double RiskEngine::lossFraction(const AccountState& a) noexcept {
+    const double start = a.dayStartBalance.load(kRelaxed);
+    if (start <= 0.0) return 0.0;
+    return (start - a.balance.load(kRelaxed)) / start;
+}
+
+//------------------------------------------------------------------
+// Pre-trade path: a handful of relaxed loads, cheapest rejections first
+//------------------------------------------------------------------
+RiskEngine::Verdict RiskEngine::check(const Order& order) const noexcept {
+    if (!valid(order.account, order.symbol) || !(order.quantity > 0.0) || !(order.price > 0.0)) {
+        return Verdict::InvalidOrder;
+    }
+    const AccountState& a = accounts_[order.account];
+    const SymbolState& s = cell(order.account, order.symbol);
+
+    if (a.halted.load(std::memory_order_acquire)) return Verdict::Halted;
+    if (lossFraction(a) >= a.maxDailyLossFraction.load(kRelaxed)) return Verdict::DailyLoss;
+
+    const double notional = order.quantity * order.price;
+    if (notional > a.maxOrderNotional.load(kRelaxed) || notional > s.maxOrderNotional.load(kRelaxed)) {
+        return Verdict::Notional;
+    }
+
+    if (order.stopPrice > 0.0) {
+        const double loss = order.quantity * std::abs(order.price - order.stopPrice);
+        if (loss > a.balance.load(kRelaxed) * riskFraction(a)) return Verdict::MaxRisk;
+    }
+
+    const double buys = s.workingBuys.load(kRelaxed) + (order.isBuy ? order.quantity : 0.0);
+    const double sells = s.workingSells.load(kRelaxed) + (order.isBuy ? 0.0 : order.quantity);
+    if (worstCase(s, buys, sells) > s.maxPosition.load(kRelaxed)) return Verdict::Position;
+    return Verdict::Accepted;
+}
+
+RiskEngine::Verdict RiskEngine::reserve(const Order& order) noexcept {
+    if (const Verdict v = check(order); v != Verdict::Accepted) return v;
+
+    // Only the order's own side is claimed; the other side is read as-is
+    SymbolState& s = cell(order.account, order.symbol);
+    std::atomic<double>& side = order.isBuy ? s.workingBuys : s.workingSells;
+    std::atomic<double>& other = order.isBuy ? s.workingSells : s.workingBuys;
+    const double limit = s.maxPosition.load(kRelaxed);
+    double current = side.load(kRelaxed);
+    do {
+        const double claimed = current + order.quantity;
+        const double opposite = other.load(kRelaxed);
+        const double worst = order.isBuy ? worstCase(s, claimed, opposite) : worstCase(s, opposite, claimed);
+        if (worst > limit) return Verdict::Position;
+    } while (!side.compare_exchange_weak(current, current + order.quantity, std::memory_order_acq_rel, kRelaxed));
+    return Verdict::Accepted;
+}
+
+void RiskEngine::release(AccountId account, SymbolId symbol, bool isBuy, double quantity) noexcept {
+    if (!valid(account, symbol)) return;
+    SymbolState& s = cell(account, symbol);
+    (isBuy ? s.workingBuys : s.workingSells).fetch_sub(quantity, std::memory_order_acq_rel);
+}
+
+// Filled before working is released: a racing check sees the quantity
+// twice for a moment, never zero times
+void RiskEngine::onFill(AccountId account, SymbolId symbol, bool isBuy, double quantity) noexcept {
+    if (!valid(account, symbol)) return;
+    SymbolState& s = cell(account, symbol);
+    s.position.fetch_add(isBuy ? quantity : -quantity, std::memory_order_acq_rel);
+    (isBuy ? s.workingBuys : s.workingSells).fetch_sub(quantity, std::memory_order_acq_rel);
+}
+
+double RiskEngine::positionSize(AccountId account, double entryPrice, double stopPrice) const noexcept {
+    if (account >= accounts_count_) return 0.0;
+    const double riskPerUnit = entryPrice - stopPrice;
+    if (riskPerUnit <= 0.0) return 0.0;
+    const AccountState& a = accounts_[account];
+    return std::floor(a.balance.load(kRelaxed) * riskFraction(a) / riskPerUnit);
+}
+
+double RiskEngine::balance(AccountId account) const noexcept {
+    return account < accounts_count_ ? accounts_[account].balance.load(kRelaxed) : 0.0;
+}
+
+double RiskEngine::currentMaxRisk(AccountId account) const noexcept {
+    return account < accounts_count_ ? riskFraction(accounts_[account]) : 0.0;
+}
+
+double RiskEngine::dailyLossFraction(AccountId account) const noexcept {
+    return account < accounts_count_ ? lossFraction(accounts_[account]) : 0.0;
+}
+
+bool RiskEngine::dailyLossBreached(AccountId account) const noexcept {
+    if (account >= accounts_count_) return false;
+    const AccountState& a = accounts_[account];
+    return lossFraction(a) >= a.maxDailyLossFraction.load(kRelaxed);
+}
+
+double RiskEngine::position(AccountId account, SymbolId symbol) const noexcept {
+    return valid(account, symbol) ? cell(account, symbol).position.load(kRelaxed) : 0.0;
+}
+
+double RiskEngine::exposure(AccountId account, SymbolId symbol) const noexcept {
+    if (!valid(account, symbol)) return 0.0;
+    const SymbolState& s = cell(account, symbol);
+    return worstCase(s, s.workingBuys.load(kRelaxed), s.workingSells.load(kRelaxed));
+}
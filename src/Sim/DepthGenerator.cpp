@@ -0,0 +1,119 @@
+#include "Sim/DepthGenerator.hpp"
+#include "Clients/BinanceWire.hpp"
+#include "Core/MarketData.hpp"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <zlib.h>
+
+namespace {
+// Binance prints prices and quantities with 8 decimals
+void append_decimal(std::string& out, float value) {
+    char buf[48];
+    const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, 8);
+    if (ec == std::errc{}) out.append(buf, end);
+}
+
+void append_side(std::string& out, std::span<const OrderBook::Order> levels, bool bids) {
+    bool first = true;
+    for (const auto& level : levels) {
+        if (level.is_bid != bids) continue;
+        out += first ? "[\"" : ",[\"";
+        append_decimal(out, level.price);
+        out += "\",\"";
+        append_decimal(out, level.amount);
+        out += "\"]";
+        first = false;
+    }
+}
+}
+
+DepthGenerator::DepthGenerator() : DepthGenerator(Config{}) {}
+
+DepthGenerator::DepthGenerator(Config cfg)
+    : cfg_(cfg), gen_(cfg.seed), mid_(cfg.start_price) {
+    levels_.reserve(2 * static_cast<std::size_t>(cfg_.levels));
+    step();
+}
+
+void DepthGenerator::load_replay(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open replay file: " + path);
+
+    std::vector<OrderBook::Order> probe;
+    std::vector<std::string> frames;
+    for (std::string line; std::getline(in, line);) {
+        if (BinanceWire::parse_depth(line, probe)) frames.push_back(std::move(line));
+    }
+    if (frames.empty()) throw std::runtime_error("No depth frames in " + path);
+
+    replay_ = std::move(frames);
+    replay_pos_ = 0;
+    step();
+}
+
+void DepthGenerator::next(uint64_t skip) {
+    for (uint64_t i = 0; i <= skip; ++i) step();
+}
+
+void DepthGenerator::step() {
+    ++update_id_;
+
+    if (!replay_.empty()) {
+        const std::string& frame = replay_[replay_pos_++ % replay_.size()];
+        (void)BinanceWire::parse_depth(frame, levels_);
+        return;
+    }
+
+    std::normal_distribution<double> drift(0.0, cfg_.tick * 8.0);
+    std::lognormal_distribution<float> size(-0.5f, 1.2f);
+    mid_ = std::max<double>(mid_ + drift(gen_), cfg_.tick * 2.0);
+
+    levels_.clear();
+    for (int side = 0; side < 2; ++side) {
+        const bool bid = side == 0;
+        for (int l = 1; l <= cfg_.levels; ++l) {
+            const double offset = cfg_.tick * l;
+            levels_.push_back({static_cast<float>(bid ? mid_ - offset : mid_ + offset), size(gen_), bid});
+        }
+    }
+}
+
+void DepthGenerator::encode_json(std::string& out, uint64_t event_ms) const {
+    out.clear();
+    out += "{\"lastUpdateId\":";
+    out += std::to_string(update_id_);
+    out += ",\"E\":";
+    out += std::to_string(event_ms);
+    out += ",\"bids\":[";
+    append_side(out, levels_, true);
+    out += "],\"asks\":[";
+    append_side(out, levels_, false);
+    out += "]}";
+}
+
+void DepthGenerator::encode_binary(std::vector<std::byte>& out, uint64_t timestamp_ns) const {
+    using BinMessage = MarketData::BinMessage;
+    using BinOrder = MarketData::BinOrder;
+
+    out.resize(sizeof(BinMessage) + levels_.size() * sizeof(BinOrder));
+
+    BinMessage header{};
+    header.magic = MarketData::kBookMagic;
+    header.timestamp = timestamp_ns;
+    header.count = static_cast<uint16_t>(levels_.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    std::byte* p = out.data() + sizeof(BinMessage);
+    for (const auto& level : levels_) {
+        const BinOrder order{level.price, level.amount, static_cast<uint8_t>(level.is_bid ? 0 : 1)};
+        std::memcpy(p, &order, sizeof(order));
+        p += sizeof(order);
+    }
+
+    const uint32_t crc = static_cast<uint32_t>(crc32(
+        0L, reinterpret_cast<const Bytef*>(out.data() + MarketData::kCrcOffset),
+        static_cast<uInt>(out.size() - MarketData::kCrcOffset)));
+    std::memcpy(out.data() + offsetof(BinMessage, crc32), &crc, sizeof(crc));
+}
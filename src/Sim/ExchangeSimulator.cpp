@@ -0,0 +1,547 @@
+#include "Sim/ExchangeSimulator.hpp"
+#include "Utils/AsyncLog.hpp"
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+#include <openssl/evp.h>
+#include <openssl/ec.h>
+#include <openssl/x509.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace net = boost::asio;
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace websocket = beast::websocket;
+namespace ssl = net::ssl;
+using tcp = net::ip::tcp;
+
+namespace {
+constexpr int kAcceptPollMs = 100;
+constexpr uint64_t kMaxBatch = 1024;            // Updates per write burst when behind schedule
+constexpr uint64_t kMaxBacklog = 16 * kMaxBatch; // Beyond this a slow client just loses updates
+
+uint64_t now_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint64_t wall_ms() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+int listen_on(uint16_t port) {
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) throw std::runtime_error("socket() failed");
+
+    const int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, 64) < 0) {
+        close(fd);
+        throw std::runtime_error("Cannot listen on port " + std::to_string(port));
+    }
+    return fd;
+}
+
+uint16_t bound_port(int fd) noexcept {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (fd < 0 || getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) return 0;
+    return ntohs(addr.sin_port);
+}
+
+bool send_all(int fd, const std::byte* data, size_t size) noexcept {
+    while (size > 0) {
+        const ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Throwaway P-256 key and certificate for CN=localhost, valid for a day.
+// Clients must not verify the peer (the default for a fresh ssl::context).
+void use_self_signed(ssl::context& ctx) {
+    EVP_PKEY* key = EVP_EC_gen("prime256v1");
+    X509* cert = X509_new();
+    if (!key || !cert) throw std::runtime_error("Cannot create self-signed certificate");
+
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), 0);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 24 * 3600);
+    X509_set_pubkey(cert, key);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC,
+                               reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+
+    const bool ok = X509_sign(cert, key, EVP_sha256()) > 0 &&
+                    SSL_CTX_use_certificate(ctx.native_handle(), cert) == 1 &&
+                    SSL_CTX_use_PrivateKey(ctx.native_handle(), key) == 1;
+    X509_free(cert);      // The context keeps its own references
+    EVP_PKEY_free(key);
+    if (!ok) throw std::runtime_error("Cannot install self-signed certificate");
+}
+
+// "/ws/a" -> {a}; "/stream?streams=a/b" -> {a, b}. Only depth streams are served.
+std::vector<std::string> requested_streams(std::string_view target) {
+    std::string_view list;
+    if (target.starts_with("/ws/")) {
+        list = target.substr(4);
+    } else if (const auto q = target.find("streams="); q != std::string_view::npos) {
+        list = target.substr(q + 8);
+    }
+
+    std::vector<std::string> out;
+    while (!list.empty()) {
+        const auto slash = list.find('/');
+        const std::string_view name = list.substr(0, slash);
+        if (name.find("@depth") != std::string_view::npos) out.emplace_back(name);
+        if (slash == std::string_view::npos) break;
+        list.remove_prefix(slash + 1);
+    }
+    return out;
+}
+
+// A SUBSCRIBE/UNSUBSCRIBE request as Binance takes it:
+//   {"method":"SUBSCRIBE","params":["a@depth20@100ms",...],"id":1}
+struct ControlRequest {
+    bool subscribe = true;
+    std::vector<std::string> streams;   // Depth streams only
+    std::string id = "null";
+};
+
+std::optional<ControlRequest> parse_control(std::string_view frame) {
+    ControlRequest req;
+    if (frame.find(R"("method":"UNSUBSCRIBE")") != std::string_view::npos) {
+        req.subscribe = false;
+    } else if (frame.find(R"("method":"SUBSCRIBE")") == std::string_view::npos) {
+        return std::nullopt;
+    }
+
+    const auto open = frame.find('[');
+    const auto close = frame.find(']', open);
+    if (open == std::string_view::npos || close == std::string_view::npos) return std::nullopt;
+    std::string_view params = frame.substr(open + 1, close - open - 1);
+    while (true) {
+        const auto q1 = params.find('"');
+        const auto q2 = q1 == std::string_view::npos ? q1 : params.find('"', q1 + 1);
+        if (q2 == std::string_view::npos) break;
+        const std::string_view name = params.substr(q1 + 1, q2 - q1 - 1);
+        if (name.find("@depth") != std::string_view::npos) req.streams.emplace_back(name);
+        params.remove_prefix(q2 + 1);
+    }
+
+    if (const auto at = frame.find(R"("id":)"); at != std::string_view::npos) {
+        const std::string_view rest = frame.substr(at + 5);
+        req.id.assign(rest.substr(0, rest.find_first_of(",}")));
+    }
+    return req;
+}
+
+// Nonblocking check for a client frame, including bytes OpenSSL already decrypted
+bool client_sent(int fd, SSL* ssl) noexcept {
+    if (SSL_pending(ssl) > 0) return true;
+    pollfd p{fd, POLLIN, 0};
+    return ::poll(&p, 1, 0) > 0;
+}
+
+// Paces one session against the shared rate. A rate change re-anchors
+// the schedule; a client that falls far behind loses the backlog.
+class Pacer {
+public:
+    explicit Pacer(const std::atomic<double>& rate) : rate_(rate) {}
+
+    uint64_t due() {
+        const double rate = rate_.load(std::memory_order_relaxed);
+        const auto now = std::chrono::steady_clock::now();
+        if (rate != anchored_rate_ || now - start_ > std::chrono::hours(1)) {
+            anchored_rate_ = rate;
+            start_ = now;
+            sent_ = 0;
+        }
+        if (rate <= 0.0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return 0;
+        }
+
+        const double elapsed = std::chrono::duration<double>(now - start_).count();
+        const uint64_t target = static_cast<uint64_t>(elapsed * rate) + 1;
+        if (target <= sent_) {
+            const auto next = start_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(sent_) / rate));
+            if (next - now > std::chrono::microseconds(200)) {
+                std::this_thread::sleep_for(next - now - std::chrono::microseconds(100));
+            } else {
+                std::this_thread::yield();
+            }
+            return 0;
+        }
+
+        if (target - sent_ > kMaxBacklog) sent_ = target - kMaxBatch;
+        const uint64_t n = std::min(target - sent_, kMaxBatch);
+        sent_ += n;
+        return n;
+    }
+
+private:
+    const std::atomic<double>& rate_;
+    double anchored_rate_ = -1.0;
+    std::chrono::steady_clock::time_point start_{};
+    uint64_t sent_ = 0;
+};
+}
+
+//------------------------------------------------------------------
+// Impl
+//------------------------------------------------------------------
+struct ExchangeSimulator::Impl {
+    struct Session {
+        int fd = -1;
+        std::jthread thread;
+        std::atomic<bool> done{false};
+    };
+
+    // Fault state a session carries between updates
+    struct Faults {
+        std::chrono::steady_clock::time_point opened = std::chrono::steady_clock::now();
+        uint64_t gap_epoch = 0;
+        uint64_t since_gap = 0;
+    };
+
+    explicit Impl(Config c) : cfg(std::move(c)), rate(cfg.rate) {}
+
+    Config cfg;
+    Stats stats;
+    std::atomic<double> rate;
+    std::atomic<uint64_t> gap_epoch{0};
+    std::atomic<uint64_t> gap_size{0};
+    std::atomic<uint64_t> venue_id{0};   // Newest depth id any WebSocket session showed
+
+    ssl::context tls{ssl::context::tls_server};
+    int binary_listener = -1;
+    int ws_listener = -1;
+    std::jthread acceptor;
+
+    std::mutex sessions_mutex;
+    std::list<std::unique_ptr<Session>> sessions;
+
+    DepthGenerator make_generator(uint64_t stream) const {
+        DepthGenerator::Config depth = cfg.depth;
+        depth.seed += stream;
+        DepthGenerator gen(depth);
+        if (!cfg.replay_path.empty()) gen.load_replay(cfg.replay_path);
+        return gen;
+    }
+
+    // A new WebSocket session picks the id sequence up where the venue is,
+    // so clients that reconnect see ids newer than the ones they lost
+    DepthGenerator make_live_generator(uint64_t stream) const {
+        DepthGenerator gen = make_generator(stream);
+        const uint64_t head = venue_id.load(std::memory_order_relaxed);
+        if (head > gen.update_id()) gen.resume_at(head);
+        return gen;
+    }
+
+    void shown(uint64_t id) noexcept {
+        uint64_t head = venue_id.load(std::memory_order_relaxed);
+        while (id > head && !venue_id.compare_exchange_weak(head, id, std::memory_order_relaxed)) {}
+    }
+
+    bool drop_due(const Faults& f) const noexcept {
+        return cfg.disconnect_every.count() > 0 &&
+               std::chrono::steady_clock::now() - f.opened > cfg.disconnect_every;
+    }
+
+    // Updates to skip before the next one is shown
+    uint64_t next_skip(Faults& f) noexcept {
+        uint64_t skip = 0;
+        if (const uint64_t epoch = gap_epoch.load(std::memory_order_acquire); epoch != f.gap_epoch) {
+            f.gap_epoch = epoch;
+            skip += gap_size.load(std::memory_order_relaxed);
+        }
+        if (cfg.gap_every > 0 && ++f.since_gap >= cfg.gap_every) {
+            f.since_gap = 0;
+            skip += cfg.gap_size;
+        }
+        if (skip) stats.gaps.fetch_add(1, std::memory_order_relaxed);
+        return skip;
+    }
+
+    // Closing under the lock keeps inject_disconnect() off recycled fds
+    void finish(Session& s) noexcept {
+        std::lock_guard lock(sessions_mutex);
+        if (s.fd >= 0) close(s.fd);
+        s.fd = -1;
+        s.done = true;
+        stats.sessions_live.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void accept_loop(std::stop_token st) {
+        std::vector<pollfd> fds;
+        if (binary_listener >= 0) fds.push_back({binary_listener, POLLIN, 0});
+        if (ws_listener >= 0) fds.push_back({ws_listener, POLLIN, 0});
+
+        while (!st.stop_requested()) {
+            if (::poll(fds.data(), fds.size(), kAcceptPollMs) <= 0) continue;
+            for (const pollfd& p : fds) {
+                if (!(p.revents & POLLIN)) continue;
+                const int fd = accept(p.fd, nullptr, nullptr);
+                if (fd < 0) continue;
+                const int one = 1;
+                setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+                spawn(fd, p.fd == ws_listener);
+            }
+        }
+    }
+
+    void spawn(int fd, bool websocket_session) {
+        std::lock_guard lock(sessions_mutex);
+        sessions.remove_if([](const auto& s) { return s->done.load(); });
+
+        auto session = std::make_unique<Session>();
+        Session& s = *session;
+        s.fd = fd;
+        stats.sessions_opened.fetch_add(1, std::memory_order_relaxed);
+        stats.sessions_live.fetch_add(1, std::memory_order_relaxed);
+        s.thread = std::jthread([this, &s, websocket_session](std::stop_token st) {
+            if (websocket_session) run_websocket(s, st);
+            else run_binary(s, st);
+            finish(s);
+        });
+        sessions.push_back(std::move(session));
+    }
+
+    void run_binary(Session& s, std::stop_token st) {
+        DepthGenerator gen = make_generator(0);
+        Pacer pacer(rate);
+        Faults faults;
+        std::vector<std::byte> frame, batch;
+
+        while (!st.stop_requested()) {
+            if (drop_due(faults)) {
+                stats.disconnects.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            const uint64_t n = pacer.due();
+            if (n == 0) continue;
+
+            batch.clear();
+            for (uint64_t i = 0; i < n; ++i) {
+                gen.next(next_skip(faults));
+                gen.encode_binary(frame, now_ns());
+                batch.insert(batch.end(), frame.begin(), frame.end());
+            }
+            if (!send_all(s.fd, batch.data(), batch.size())) return;   // Client gone or dropped
+            stats.updates_sent.fetch_add(n, std::memory_order_relaxed);
+            stats.bytes_sent.fetch_add(batch.size(), std::memory_order_relaxed);
+        }
+    }
+
+    void run_websocket(Session& s, std::stop_token st) {
+        net::io_context ioc;
+        tcp::socket socket(ioc);
+        beast::error_code ec;
+        socket.assign(tcp::v4(), s.fd, ec);
+        if (ec) return;
+
+        websocket::stream<beast::ssl_stream<tcp::socket>> ws(std::move(socket), tls);
+        try {
+            ws.next_layer().handshake(ssl::stream_base::server);
+
+            beast::flat_buffer buffer;
+            http::request<http::string_body> request;
+            http::read(ws.next_layer(), buffer, request);
+            if (cfg.compression) {
+                websocket::permessage_deflate pmd;
+                pmd.server_enable = true;
+                ws.set_option(pmd);
+            }
+            ws.accept(request);
+            if (cfg.compression &&
+                request[http::field::sec_websocket_extensions].find("permessage-deflate") != beast::string_view::npos) {
+                stats.deflate_sessions.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            const std::string target(request.target());
+            std::vector<std::string> streams = requested_streams(target);
+            if (streams.empty()) {
+                ws.close(websocket::close_code::policy_error);
+                release(ws);
+                return;
+            }
+            const bool combined = target.starts_with("/stream");
+
+            std::vector<DepthGenerator> gens;
+            for (std::size_t i = 0; i < streams.size(); ++i) gens.push_back(make_live_generator(i));
+
+            ws.text(true);
+            Pacer pacer(rate);
+            Faults faults;
+            std::string payload, framed;
+            std::size_t turn = 0;
+            beast::flat_buffer control;
+
+            // Streams come and go with SUBSCRIBE/UNSUBSCRIBE, acknowledged like Binance does
+            const auto handle_control = [&] {
+                control.clear();
+                ws.read(control, ec);
+                if (ec) return false;
+                const auto data = control.cdata();
+                const auto req = parse_control(std::string_view(static_cast<const char*>(data.data()), data.size()));
+                if (!req) return true;
+                for (const auto& name : req->streams) {
+                    const auto it = std::find(streams.begin(), streams.end(), name);
+                    if (req->subscribe && it == streams.end()) {
+                        streams.push_back(name);
+                        gens.push_back(make_live_generator(streams.size() - 1));
+                    } else if (!req->subscribe && it != streams.end()) {
+                        gens.erase(gens.begin() + (it - streams.begin()));
+                        streams.erase(it);
+                    }
+                }
+                ws.write(net::buffer("{\"result\":null,\"id\":" + req->id + "}"), ec);
+                return !ec;
+            };
+
+            while (!st.stop_requested()) {
+                if (drop_due(faults)) {
+                    stats.disconnects.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                }
+                if (client_sent(s.fd, ws.next_layer().native_handle()) && !handle_control()) break;
+                const uint64_t n = pacer.due();
+                if (n == 0 || gens.empty()) continue;
+
+                for (uint64_t i = 0; i < n; ++i, ++turn) {
+                    DepthGenerator& gen = gens[turn % gens.size()];
+                    gen.next(next_skip(faults));
+                    gen.encode_json(payload, wall_ms());
+                    if (cfg.stamp_frames) payload.insert(1, "\"T0\":" + std::to_string(now_ns()) + ",");
+                    shown(gen.update_id());
+
+                    const std::string* out = &payload;
+                    if (combined) {
+                        framed = "{\"stream\":\"" + streams[turn % streams.size()] + "\",\"data\":";
+                        framed += payload;
+                        framed += '}';
+                        out = &framed;
+                    }
+                    ws.write(net::buffer(*out), ec);
+                    if (ec) break;
+                    stats.bytes_sent.fetch_add(out->size(), std::memory_order_relaxed);
+                }
+                if (ec) break;
+                stats.updates_sent.fetch_add(n, std::memory_order_relaxed);
+            }
+        } catch (const std::exception& e) {
+            OCEAN_LOG_WARN("[SIM] WebSocket session ended: {}", e.what());
+        }
+        // Dropped without a close frame, like a network failure
+        release(ws);
+    }
+
+    // Hands the fd back to finish(), which closes it under the session lock
+    template <typename Ws>
+    static void release(Ws& ws) noexcept {
+        beast::error_code ec;
+        beast::get_lowest_layer(ws).release(ec);
+    }
+};
+
+//------------------------------------------------------------------
+// ExchangeSimulator
+//------------------------------------------------------------------
+ExchangeSimulator::ExchangeSimulator(Config cfg) : impl_(std::make_unique<Impl>(std::move(cfg))) {}
+
+ExchangeSimulator::~ExchangeSimulator() {
+    stop();
+}
+
+void ExchangeSimulator::start() {
+    if (impl_->acceptor.joinable()) return;
+
+    // Fail on a bad replay file before any client connects
+    if (!impl_->cfg.replay_path.empty()) (void)impl_->make_generator(0);
+
+    if (impl_->cfg.serve_binary) impl_->binary_listener = listen_on(impl_->cfg.binary_port);
+    if (impl_->cfg.serve_websocket) {
+        use_self_signed(impl_->tls);
+        impl_->ws_listener = listen_on(impl_->cfg.ws_port);
+    }
+    impl_->acceptor = std::jthread([impl = impl_.get()](std::stop_token st) { impl->accept_loop(st); });
+}
+
+void ExchangeSimulator::stop() {
+    if (!impl_->acceptor.joinable()) return;
+    impl_->acceptor.request_stop();
+    impl_->acceptor.join();
+
+    for (int* fd : {&impl_->binary_listener, &impl_->ws_listener}) {
+        if (*fd >= 0) close(*fd);
+        *fd = -1;
+    }
+
+    // Unblock sessions stuck in a send, then join them outside the lock
+    std::list<std::unique_ptr<Impl::Session>> sessions;
+    {
+        std::lock_guard lock(impl_->sessions_mutex);
+        for (auto& s : impl_->sessions) {
+            s->thread.request_stop();
+            if (s->fd >= 0) shutdown(s->fd, SHUT_RDWR);
+        }
+        sessions.swap(impl_->sessions);
+    }
+    sessions.clear();
+}
+
+uint16_t ExchangeSimulator::binary_port() const noexcept {
+    return bound_port(impl_->binary_listener);
+}
+
+uint16_t ExchangeSimulator::ws_port() const noexcept {
+    return bound_port(impl_->ws_listener);
+}
+
+void ExchangeSimulator::inject_disconnect() noexcept {
+    std::lock_guard lock(impl_->sessions_mutex);
+    for (auto& s : impl_->sessions) {
+        if (s->fd >= 0 && !s->done) {
+            shutdown(s->fd, SHUT_RDWR);
+            impl_->stats.disconnects.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ExchangeSimulator::inject_gap(uint64_t updates) noexcept {
+    impl_->gap_size.store(updates, std::memory_order_relaxed);
+    impl_->gap_epoch.fetch_add(1, std::memory_order_release);
+}
+
+void ExchangeSimulator::set_rate(double updates_per_second) noexcept {
+    impl_->rate.store(updates_per_second, std::memory_order_relaxed);
+}
+
+const ExchangeSimulator::Stats& ExchangeSimulator::stats() const noexcept {
+    return impl_->stats;
+}
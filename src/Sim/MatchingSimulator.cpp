@@ -0,0 +1,346 @@
+#include "Sim/MatchingSimulator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+constexpr std::size_t kQueueCapacity = 1024;   // Messages in flight before the queues grow
+}
+
+MatchingSimulator::MatchingSimulator() : MatchingSimulator(Config{}) {}
+
+MatchingSimulator::MatchingSimulator(Config cfg)
+    : cfg_(cfg), rng_(cfg.seed | 1), bids_(cfg.window_ticks), asks_(cfg.window_ticks) {
+    inbound_.reserve(kQueueCapacity);
+    reports_.reserve(kQueueCapacity);
+    resting_.reserve(kQueueCapacity);
+}
+
+//------------------------------------------------------------------
+// Clocks
+//------------------------------------------------------------------
+uint64_t MatchingSimulator::on_market(const MarketEvent& ev) noexcept {
+    execute_until(ev.ts_ns);
+    venue_ns_ = std::max(venue_ns_, ev.ts_ns);
+    ++stats_.events;
+
+    anchor(ev.price);
+    if (ev.kind == EventKind::Depth) on_depth(ev);
+    else on_trade(ev);
+
+    last_md_ns_ = std::max(last_md_ns_, ev.ts_ns + delay(cfg_.md_latency_ns));
+    now_ = std::max(now_, last_md_ns_);
+    return now_;
+}
+
+void MatchingSimulator::advance(uint64_t now_ns) noexcept {
+    now_ = std::max(now_, now_ns);
+}
+
+void MatchingSimulator::drain() noexcept {
+    execute_until(UINT64_MAX);
+    now_ = std::max(now_, last_deliver_ns_);
+}
+
+uint64_t MatchingSimulator::delay(uint64_t base) noexcept {
+    if (cfg_.jitter_ns == 0) return base;
+    // xorshift64: cheap and reproducible from the seed
+    rng_ ^= rng_ << 13;
+    rng_ ^= rng_ >> 7;
+    rng_ ^= rng_ << 17;
+    return base + rng_ % (cfg_.jitter_ns + 1);
+}
+
+//------------------------------------------------------------------
+// Order path
+//------------------------------------------------------------------
+bool MatchingSimulator::send(std::span<const std::byte> bytes) {
+    if (bytes.empty()) return false;
+
+    Inbound msg{};
+    switch (static_cast<OrderWire::MsgType>(bytes[0])) {
+        case OrderWire::MsgType::New: {
+            const auto order = OrderWire::decode<OrderWire::NewOrder>(bytes);
+            if (!order) return false;
+            msg.client_id = order->client_id;
+            msg.price = order->price;
+            msg.quantity = order->quantity;
+            msg.type = OrderWire::MsgType::New;
+            msg.is_buy = order->is_buy != 0;
+            break;
+        }
+        case OrderWire::MsgType::Cancel: {
+            const auto cancel = OrderWire::decode<OrderWire::CancelOrder>(bytes);
+            if (!cancel) return false;
+            msg.client_id = cancel->client_id;
+            msg.type = OrderWire::MsgType::Cancel;
+            break;
+        }
+        default:
+            return false;
+    }
+
+    last_arrive_ns_ = std::max(last_arrive_ns_, now_ + delay(cfg_.order_latency_ns));
+    msg.arrive_ns = last_arrive_ns_;
+    inbound_.push_back(msg);
+    execute_until(venue_ns_);   // Zero latency: the venue sees it before the next event
+    return true;
+}
+
+void MatchingSimulator::execute_until(uint64_t venue_ns) noexcept {
+    while (inbound_head_ < inbound_.size() && inbound_[inbound_head_].arrive_ns <= venue_ns) {
+        const Inbound msg = inbound_[inbound_head_++];
+        venue_ns_ = std::max(venue_ns_, msg.arrive_ns);
+        execute(msg);
+    }
+    if (inbound_head_ == inbound_.size()) {
+        inbound_.clear();
+        inbound_head_ = 0;
+    }
+}
+
+void MatchingSimulator::execute(const Inbound& msg) noexcept {
+    if (msg.type == OrderWire::MsgType::New) on_new(msg);
+    else on_cancel(msg);
+}
+
+void MatchingSimulator::on_new(const Inbound& msg) noexcept {
+    ++stats_.orders;
+    anchor(msg.price);
+    const int64_t index = index_of(msg.price);
+    const uint64_t venue_id = next_venue_id_++;
+    if (!(msg.quantity > 0.0) || !(msg.price > 0.0) || index < 0) {
+        ++stats_.rejects;
+        report(OrderWire::ExecType::Rejected, msg.client_id, venue_id);
+        return;
+    }
+    report(OrderWire::ExecType::Ack, msg.client_id, venue_id);
+
+    // Crossing part trades against the visible book, best level first
+    double remaining = msg.quantity;
+    std::vector<Level>& opposite = msg.is_buy ? asks_ : bids_;
+    int64_t& best = msg.is_buy ? best_ask_ : best_bid_;
+    while (remaining > 0.0 && best >= 0 && (msg.is_buy ? best <= index : best >= index)) {
+        const int64_t at = best;
+        const double take = std::min(opposite[at].quantity, remaining);
+        remaining -= take;
+        ++stats_.taker_fills;
+        stats_.filled_quantity += take;
+        report(OrderWire::ExecType::Fill, msg.client_id, venue_id, take, price_of(at));
+        // Consumed until the recording next updates the level
+        set_level(!msg.is_buy, at, opposite[at].quantity - take);
+    }
+    if (remaining <= 0.0) return;
+
+    std::vector<Level>& own = msg.is_buy ? bids_ : asks_;
+    ++own[index].ours;
+    resting_.push_back({.client_id = msg.client_id, .venue_id = venue_id, .price = msg.price,
+                        .remaining = remaining, .ahead = own[index].quantity, .index = index,
+                        .is_buy = msg.is_buy});
+    refresh_extremes();
+}
+
+void MatchingSimulator::on_cancel(const Inbound& msg) noexcept {
+    const auto it = std::find_if(resting_.begin(), resting_.end(),
+                                 [&](const Resting& r) { return r.client_id == msg.client_id; });
+    if (it == resting_.end()) {
+        report(OrderWire::ExecType::CancelRejected, msg.client_id, 0);   // Filled or never rested
+        return;
+    }
+    ++stats_.cancels;
+    report(OrderWire::ExecType::Canceled, it->client_id, it->venue_id);
+    --(it->is_buy ? bids_ : asks_)[it->index].ours;
+    resting_.erase(it);
+    refresh_extremes();
+}
+
+//------------------------------------------------------------------
+// Market path
+//------------------------------------------------------------------
+void MatchingSimulator::on_depth(const MarketEvent& ev) noexcept {
+    const int64_t index = index_of(ev.price);
+    if (index < 0) {
+        ++stats_.out_of_window;
+        return;
+    }
+    Level& level = (ev.is_bid ? bids_ : asks_)[index];
+    const double quantity = std::max(0.0, static_cast<double>(ev.amount));
+
+    if (level.ours > 0) {
+        // Whatever left the level without trading was canceled, spread
+        // over the queue; growth joins behind us
+        const double before = level.quantity;
+        const double canceled = before - quantity - level.traded;
+        for (auto& order : resting_) {
+            if (order.index != index || order.is_buy != ev.is_bid) continue;
+            if (canceled > 0.0 && before > 0.0) order.ahead -= canceled * (order.ahead / before);
+            order.ahead = std::clamp(order.ahead, 0.0, quantity);
+        }
+    }
+    level.traded = 0.0;
+    set_level(ev.is_bid, index, quantity);
+}
+
+void MatchingSimulator::on_trade(const MarketEvent& ev) noexcept {
+    ++stats_.trades;
+    const int64_t index = index_of(ev.price);
+    if (index < 0) {
+        ++stats_.out_of_window;
+        return;
+    }
+    // A buying aggressor lifts asks, a selling one hits bids
+    const bool hits_bids = !ev.is_bid;
+    (hits_bids ? bids_ : asks_)[index].traded += ev.amount;
+
+    const bool reaches_us = hits_bids ? top_buy_ >= 0 && top_buy_ >= index
+                                      : top_sell_ >= 0 && top_sell_ <= index;
+    if (!reaches_us) return;
+
+    const double price = price_of(index);
+    double ours_filled = 0.0;   // Our earlier orders at the level stand ahead of later ones
+    for (auto& order : resting_) {
+        if (order.is_buy != hits_bids) continue;
+        const bool through = hits_bids ? order.index > index : order.index < index;
+        if (through) {
+            fill(order, order.remaining, order.price);
+            continue;
+        }
+        if (order.index != index) continue;
+
+        const double flow = ev.amount - ours_filled;
+        const double eaten = std::min(flow, order.ahead);
+        order.ahead -= eaten;
+        const double quantity = std::min(flow - eaten, order.remaining);
+        if (quantity > 0.0) {
+            fill(order, quantity, price);
+            ours_filled += quantity;
+        }
+    }
+    remove_filled();
+}
+
+//------------------------------------------------------------------
+// Book and bookkeeping
+//------------------------------------------------------------------
+void MatchingSimulator::anchor(double price) noexcept {
+    if (anchored_ || !(price > 0.0)) return;
+    base_ = std::llround(price / cfg_.tick) - static_cast<int64_t>(cfg_.window_ticks / 2);
+    anchored_ = true;
+}
+
+int64_t MatchingSimulator::index_of(double price) const noexcept {
+    if (!anchored_) return -1;
+    const int64_t index = std::llround(price / cfg_.tick) - base_;
+    return index >= 0 && index < static_cast<int64_t>(cfg_.window_ticks) ? index : -1;
+}
+
+double MatchingSimulator::price_of(int64_t index) const noexcept {
+    return static_cast<double>(base_ + index) * cfg_.tick;
+}
+
+void MatchingSimulator::set_level(bool is_bid, int64_t index, double quantity) noexcept {
+    std::vector<Level>& side = is_bid ? bids_ : asks_;
+    int64_t& best = is_bid ? best_bid_ : best_ask_;
+    side[index].quantity = quantity > 0.0 ? quantity : 0.0;
+
+    if (quantity > 0.0) {
+        if (best < 0 || (is_bid ? index > best : index < best)) best = index;
+        return;
+    }
+    if (index != best) return;
+
+    // Best level emptied: walk away from the spread to the next one
+    const int64_t step = is_bid ? -1 : 1;
+    const int64_t end = is_bid ? -1 : static_cast<int64_t>(side.size());
+    best = -1;
+    for (int64_t i = index + step; i != end; i += step) {
+        if (side[i].quantity > 0.0) {
+            best = i;
+            break;
+        }
+    }
+}
+
+void MatchingSimulator::fill(Resting& order, double quantity, double price) noexcept {
+    order.remaining -= quantity;
+    ++stats_.passive_fills;
+    stats_.filled_quantity += quantity;
+    report(OrderWire::ExecType::Fill, order.client_id, order.venue_id, quantity, price);
+}
+
+void MatchingSimulator::remove_filled() noexcept {
+    const auto done = std::remove_if(resting_.begin(), resting_.end(), [&](const Resting& r) {
+        if (r.remaining > 0.0) return false;
+        --(r.is_buy ? bids_ : asks_)[r.index].ours;
+        return true;
+    });
+    if (done == resting_.end()) return;
+    resting_.erase(done, resting_.end());
+    refresh_extremes();
+}
+
+void MatchingSimulator::refresh_extremes() noexcept {
+    top_buy_ = -1;
+    top_sell_ = -1;
+    for (const auto& order : resting_) {
+        if (order.is_buy) top_buy_ = std::max(top_buy_, order.index);
+        else if (top_sell_ < 0 || order.index < top_sell_) top_sell_ = order.index;
+    }
+}
+
+void MatchingSimulator::report(OrderWire::ExecType exec, uint64_t client_id, uint64_t venue_id,
+                               double quantity, double price) noexcept {
+    OrderWire::Report r{};
+    r.type = OrderWire::MsgType::Report;
+    r.exec = exec;
+    r.client_id = client_id;
+    r.venue_id = venue_id;
+    r.last_quantity = quantity;
+    r.last_price = price;
+
+    last_deliver_ns_ = std::max(last_deliver_ns_, venue_ns_ + delay(cfg_.report_latency_ns));
+    reports_.push_back({last_deliver_ns_, r});
+}
+
+//------------------------------------------------------------------
+// Queries and recordings
+//------------------------------------------------------------------
+double MatchingSimulator::best_bid() const noexcept {
+    return best_bid_ < 0 ? 0.0 : price_of(best_bid_);
+}
+
+double MatchingSimulator::best_ask() const noexcept {
+    return best_ask_ < 0 ? 0.0 : price_of(best_ask_);
+}
+
+double MatchingSimulator::level(double price, bool is_bid) const noexcept {
+    const int64_t index = index_of(price);
+    return index < 0 ? 0.0 : (is_bid ? bids_ : asks_)[index].quantity;
+}
+
+double MatchingSimulator::queue_ahead(uint64_t client_id) const noexcept {
+    for (const auto& order : resting_) {
+        if (order.client_id == client_id) return order.ahead;
+    }
+    return -1.0;
+}
+
+std::vector<MatchingSimulator::MarketEvent> MatchingSimulator::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) throw std::runtime_error("Cannot open recording: " + path);
+    const auto size = static_cast<std::size_t>(in.tellg());
+    if (size % sizeof(MarketEvent) != 0) throw std::runtime_error("Truncated recording: " + path);
+
+    std::vector<MarketEvent> events(size / sizeof(MarketEvent));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(events.data()), static_cast<std::streamsize>(size));
+    if (!in) throw std::runtime_error("Cannot read recording: " + path);
+    return events;
+}
+
+void MatchingSimulator::save(const std::string& path, std::span<const MarketEvent> events) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(events.data()), static_cast<std::streamsize>(events.size_bytes()));
+    if (!out) throw std::runtime_error("Cannot write recording: " + path);
+}
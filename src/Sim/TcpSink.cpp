@@ -0,0 +1,134 @@
+#include "Sim/TcpSink.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <mutex>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+constexpr int kPollMs = 20;
+constexpr std::size_t kReadChunk = 64 * 1024;
+}
+
+struct TcpSink::Impl {
+    explicit Impl(Config c) : cfg(c) {}
+
+    Config cfg;
+    int listener = -1;
+    int client = -1;                  // Guarded by mutex; closed only by the loop
+    mutable std::mutex mutex;
+    std::string kept;
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> lines{0};
+    std::atomic<uint64_t> connections{0};
+    std::jthread thread;
+
+    void loop(std::stop_token st) {
+        std::string chunk(kReadChunk, '\0');
+        while (!st.stop_requested()) {
+            pollfd fds[2] = {{listener, POLLIN, 0}, {client, POLLIN, 0}};
+            const nfds_t count = client >= 0 ? 2 : 1;
+            if (::poll(fds, count, kPollMs) <= 0) continue;
+
+            if (fds[0].revents & POLLIN) {
+                const int fd = accept(listener, nullptr, nullptr);
+                if (fd >= 0) {
+                    std::lock_guard lock(mutex);
+                    if (client >= 0) close(client);   // One client at a time: newest wins
+                    client = fd;
+                    connections.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+            if (count == 2 && fds[1].revents) {
+                const ssize_t n = recv(client, chunk.data(), chunk.size(), 0);
+                if (n <= 0) {
+                    std::lock_guard lock(mutex);
+                    close(client);
+                    client = -1;
+                    continue;
+                }
+                const std::string_view data(chunk.data(), static_cast<std::size_t>(n));
+                bytes.fetch_add(data.size(), std::memory_order_relaxed);
+                lines.fetch_add(static_cast<uint64_t>(std::ranges::count(data, '\n')), std::memory_order_relaxed);
+                if (cfg.keep) {
+                    std::lock_guard lock(mutex);
+                    kept.append(data);
+                }
+            }
+        }
+    }
+};
+
+TcpSink::TcpSink() : TcpSink(Config{}) {}
+
+TcpSink::TcpSink(Config cfg) : impl_(std::make_unique<Impl>(cfg)) {}
+
+TcpSink::~TcpSink() {
+    stop();
+}
+
+void TcpSink::start() {
+    if (impl_->thread.joinable()) return;
+
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) throw std::runtime_error("socket() failed");
+    const int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(impl_->cfg.port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, 8) < 0) {
+        close(fd);
+        throw std::runtime_error("Cannot listen on port " + std::to_string(impl_->cfg.port));
+    }
+    impl_->listener = fd;
+    impl_->thread = std::jthread([impl = impl_.get()](std::stop_token st) { impl->loop(st); });
+}
+
+void TcpSink::stop() {
+    if (!impl_->thread.joinable()) return;
+    impl_->thread.request_stop();
+    impl_->thread.join();
+
+    for (int* fd : {&impl_->listener, &impl_->client}) {
+        if (*fd >= 0) close(*fd);
+        *fd = -1;
+    }
+}
+
+uint16_t TcpSink::port() const noexcept {
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    if (impl_->listener < 0 || getsockname(impl_->listener, reinterpret_cast<sockaddr*>(&addr), &len) < 0) return 0;
+    return ntohs(addr.sin_port);
+}
+
+void TcpSink::inject_disconnect() noexcept {
+    std::lock_guard lock(impl_->mutex);
+    if (impl_->client >= 0) shutdown(impl_->client, SHUT_RDWR);
+}
+
+std::string TcpSink::received() const {
+    std::lock_guard lock(impl_->mutex);
+    return impl_->kept;
+}
+
+uint64_t TcpSink::bytes() const noexcept {
+    return impl_->bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t TcpSink::lines() const noexcept {
+    return impl_->lines.load(std::memory_order_relaxed);
+}
+
+uint64_t TcpSink::connections() const noexcept {
+    return impl_->connections.load(std::memory_order_relaxed);
+}
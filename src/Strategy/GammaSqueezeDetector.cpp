@@ -0,0 +1,75 @@
+#include "Strategy/GammaSqueezeDetector.hpp"
+#include <algorithm>
+
+namespace {
+inline float ewma(float prev, float sample, float alpha) noexcept {
+    return prev + alpha * (sample - prev);
+}
+
+inline float unit(float value, float threshold) noexcept {
+    return threshold > 0.0f ? std::clamp(value / threshold, 0.0f, 1.0f) : 0.0f;
+}
+}
+
+void GammaSqueezeDetector::on_book(float bid_depth, float ask_depth) noexcept {
+    const float total = bid_depth + ask_depth;
+    const float imbalance = total > 0.0f ? (bid_depth - ask_depth) / total : 0.0f;
+
+    if (book_updates_ == 0) {
+        // Seed baselines from the first snapshot instead of ramping from zero
+        bid_baseline_ = bid_depth;
+        ask_baseline_ = ask_depth;
+    } else {
+        // Acceleration = fast imbalance velocity running ahead of its slow norm
+        const float step = imbalance - imbalance_;
+        velocity_ = ewma(velocity_, step, cfg_.fast_alpha);
+        slow_velocity_ = ewma(slow_velocity_, step, cfg_.baseline_alpha);
+        acceleration_ = velocity_ - slow_velocity_;
+
+        bid_baseline_ = ewma(bid_baseline_, bid_depth, cfg_.baseline_alpha);
+        ask_baseline_ = ewma(ask_baseline_, ask_depth, cfg_.baseline_alpha);
+    }
+
+    imbalance_ = imbalance;
+    bid_depth_ = bid_depth;
+    ask_depth_ = ask_depth;
+    if (book_updates_ < UINT32_MAX) ++book_updates_;
+}
+
+void GammaSqueezeDetector::on_trade(float amount, bool is_buy) noexcept {
+    if (amount <= 0.0f) return;
+    signed_flow_ = ewma(signed_flow_, is_buy ? amount : -amount, cfg_.flow_alpha);
+    gross_flow_ = ewma(gross_flow_, amount, cfg_.flow_alpha);
+}
+
+//--------------------------------------------------------------------
+// SIGNAL: score each direction as the mean of its three legs
+//--------------------------------------------------------------------
+GammaSqueezeDetector::Signal GammaSqueezeDetector::signal() const noexcept {
+    Signal out;
+    out.imbalance_acceleration = acceleration_;
+    out.bid_depletion = bid_baseline_ > 0.0f ? std::max(0.0f, 1.0f - bid_depth_ / bid_baseline_) : 0.0f;
+    out.ask_depletion = ask_baseline_ > 0.0f ? std::max(0.0f, 1.0f - ask_depth_ / ask_baseline_) : 0.0f;
+    out.flow_momentum = gross_flow_ > 0.0f ? signed_flow_ / gross_flow_ : 0.0f;
+
+    if (!warmed_up()) return out;
+
+    // Up: bids building faster, offers being lifted away, buyers aggressing
+    const float up = (unit(acceleration_, cfg_.acceleration_threshold) +
+                      unit(out.ask_depletion, cfg_.depletion_threshold) +
+                      unit(out.flow_momentum, cfg_.flow_threshold)) / 3.0f;
+
+    const float down = (unit(-acceleration_, cfg_.acceleration_threshold) +
+                        unit(out.bid_depletion, cfg_.depletion_threshold) +
+                        unit(-out.flow_momentum, cfg_.flow_threshold)) / 3.0f;
+
+    out.score = std::max(up, down);
+    if (out.score >= cfg_.trigger_score) {
+        out.direction = up >= down ? Direction::UP : Direction::DOWN;
+    }
+    return out;
+}
+
+void GammaSqueezeDetector::reset() noexcept {
+    *this = GammaSqueezeDetector(cfg_);
+}
@@ -1,5 +1,7 @@
 #include "Tactics/SunTzuTactics.hpp"
-#include "Risk/RiskManager.hpp"
+#include "Core/TradeTape.hpp"
+#include <algorithm>
+#include <chrono>
 
 bool SunTzu::isWeakPoint(const OrderBook& book, float threshold) {
     float bidVol = book.total_bid_volume();
@@ -12,11 +14,11 @@ float SunTzu::stealthEntryPrice(const OrderBook& book, bool is_bid) noexcept {
     return is_bid ? best_bid * 0.998f : best_ask * 1.002f;
 }
 
-void SunTzu::adjustForMarketPhase(MarketPhase phase) {
+void SunTzu::adjustForMarketPhase(RiskEngine& risk, RiskEngine::AccountId account, MarketPhase phase) noexcept {
     switch (phase) {
-        case MarketPhase::CHAOS:    RiskManager::adjustForVolatility(4.0f); break;
-        case MarketPhase::TRENDING: RiskManager::adjustForVolatility(1.0f); break;
-        case MarketPhase::RANGING:  RiskManager::adjustForVolatility(2.0f); break;
+        case MarketPhase::CHAOS:    risk.adjustForVolatility(account, 4.0); break;
+        case MarketPhase::TRENDING: risk.adjustForVolatility(account, 1.0); break;
+        case MarketPhase::RANGING:  risk.adjustForVolatility(account, 2.0); break;
     }
 }
 
@@ -29,14 +31,23 @@ SunTzu::MarketPhase SunTzu::detectMarketPhase(const std::vector<float>& prices)
     return MarketPhase::RANGING; // default
 }
 
-SunTzu::LiquidityRaidConfig SunTzu::detectLiquidityRaid(const OrderBook& book, std::span<const Trade> trades) {
+bool SunTzu::isLiquidityRaid(const TradeTape& tape, const LiquidityRaidConfig& cfg) {
+    // Baseline is the average of the windows preceding the current one
+    constexpr int kBaselineWindows = 10;
 
-    (void)book;
-    (void)trades;
+    const auto window = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<float>(cfg.time_window_seconds));
 
-    return {
-        .volume_spike_multiplier = 2.5f,
-        .time_window_seconds = 30.0f,
-        .min_volume_threshold = 10000.0f
-    };
+    const TradeTape::TrailingStats t = tape.trailing(window, kBaselineWindows);
+    if (t.recent.volume < cfg.min_volume_threshold) return false;
+
+    // After a start or a reconnect the tape covers fewer prior windows;
+    // average over what it holds, not over kBaselineWindows
+    const uint64_t span_ns = static_cast<uint64_t>(window.count());
+    if (t.baseline_ns < span_ns) return false; // Not one full window to call it a spike against
+
+    const double baseline = t.baseline.volume * static_cast<double>(span_ns) / static_cast<double>(t.baseline_ns);
+    if (baseline <= 0.0) return false;
+
+    return t.recent.volume > baseline * cfg.volume_spike_multiplier;
 }
\ No newline at end of file
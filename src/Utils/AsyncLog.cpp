@@ -0,0 +1,291 @@
+#include "Utils/AsyncLog.hpp"
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fmt/chrono.h>
+
+using AsyncLog::detail::Header;
+
+// Single producer (the owning thread), single consumer (the backend).
+// Positions only grow; a record never wraps, the tail end is padded.
+struct AsyncLog::detail::Ring {
+    Ring(std::size_t bytes, uint32_t id)
+        : capacity(std::bit_ceil(std::max<std::size_t>(bytes, 4096))),
+          mask(capacity - 1),
+          id(id),
+          buffer(std::make_unique<std::byte[]>(capacity)) {}
+
+    const std::size_t capacity;
+    const std::size_t mask;
+    const uint32_t id;
+    const std::unique_ptr<std::byte[]> buffer;
+
+    alignas(64) std::atomic<uint64_t> head{0};
+    uint64_t pending = 0;                    // Producer: head once the reserved record commits
+    uint64_t cached_tail = 0;                // Producer: last tail seen
+    std::atomic<uint64_t> dropped{0};        // Producer writes, backend reads
+
+    alignas(64) std::atomic<uint64_t> tail{0};
+    uint64_t dropped_seen = 0;               // Backend
+    std::atomic<bool> retired{false};        // Owner has exited; freed once empty
+};
+
+namespace {
+using AsyncLog::detail::Ring;
+
+constexpr std::string_view level_name(LogLevel level) noexcept {
+    switch (level) {
+        case LogLevel::Debug: return "DEBUG";
+        case LogLevel::Info: return "INFO";
+        case LogLevel::Warn: return "WARN";
+        case LogLevel::Error: return "ERROR";
+    }
+    return "?";
+}
+
+void default_sink(LogLevel level, std::string_view line) {
+    std::FILE* out = level >= LogLevel::Warn ? stderr : stdout;
+    std::fwrite(line.data(), 1, line.size(), out);
+    std::fputc('\n', out);
+}
+
+class Backend {
+public:
+    Backend()
+        : ns_per_tick_(Tsc::ns_per_tick()),
+          anchor_ticks_(Tsc::ticks()),
+          anchor_wall_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::system_clock::now().time_since_epoch()).count()) {
+        AsyncLog::detail::window_ticks = std::max<uint64_t>(1, static_cast<uint64_t>(1e9 / ns_per_tick_));
+        thread_ = std::jthread([this](std::stop_token st) { run(st); });
+    }
+
+    ~Backend() {
+        thread_.request_stop();
+        thread_.join();
+    }
+
+    Ring* attach() {
+        std::lock_guard lock(mutex_);
+        return rings_.emplace_back(std::make_unique<Ring>(cfg_.ring_bytes, next_id_++)).get();
+    }
+
+    void configure(AsyncLog::Config cfg) {
+        std::lock_guard lock(mutex_);
+        AsyncLog::detail::min_level.store(cfg.min_level, std::memory_order_relaxed);
+        cfg_ = std::move(cfg);
+    }
+
+    void flush() {
+        std::unique_lock lock(flush_mutex_);
+        // The pass running now may have started before the caller's
+        // records were committed; the one after cannot have
+        const uint64_t target = passes_ + 2;
+        flushed_.wait(lock, [&] { return passes_ >= target; });
+    }
+
+    [[nodiscard]] AsyncLog::Stats stats() const noexcept {
+        return {.written = written_.load(std::memory_order_relaxed),
+                .dropped = dropped_.load(std::memory_order_relaxed),
+                .suppressed = suppressed_.load(std::memory_order_relaxed)};
+    }
+
+private:
+    struct Entry {
+        uint64_t ticks;
+        LogLevel level;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    void run(const std::stop_token& st) {
+        while (true) {
+            const bool stopping = st.stop_requested();
+            const std::size_t lines = pass();
+            {
+                std::lock_guard lock(flush_mutex_);
+                ++passes_;
+            }
+            flushed_.notify_all();
+            if (stopping) return;   // One last pass after the stop request
+            if (lines == 0) std::this_thread::sleep_for(idle_sleep_);
+        }
+    }
+
+    // Drains every ring, then emits what it found in timestamp order
+    std::size_t pass() {
+        std::vector<Ring*> rings;
+        std::function<void(LogLevel, std::string_view)> sink;
+        {
+            std::lock_guard lock(mutex_);
+            std::erase_if(rings_, [](const std::unique_ptr<Ring>& r) {
+                return r->retired.load(std::memory_order_acquire) &&
+                       r->tail.load(std::memory_order_relaxed) == r->head.load(std::memory_order_acquire) &&
+                       r->dropped_seen == r->dropped.load(std::memory_order_relaxed);
+            });
+            for (const auto& r : rings_) rings.push_back(r.get());
+            sink = cfg_.sink;
+            idle_sleep_ = cfg_.idle_sleep;
+        }
+
+        entries_.clear();
+        text_.clear();
+        for (Ring* ring : rings) drain(*ring);
+        if (entries_.empty()) return 0;
+
+        std::stable_sort(entries_.begin(), entries_.end(),
+                         [](const Entry& a, const Entry& b) { return a.ticks < b.ticks; });
+        for (const Entry& e : entries_) {
+            const std::string_view line(text_.data() + e.begin, e.end - e.begin);
+            if (sink) sink(e.level, line);
+            else default_sink(e.level, line);
+        }
+        std::fflush(stdout);
+        std::fflush(stderr);
+        written_.fetch_add(entries_.size(), std::memory_order_relaxed);
+        return entries_.size();
+    }
+
+    void drain(Ring& ring) {
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        uint64_t suppressed = 0;
+        while (tail < head) {
+            const std::size_t offset = tail & ring.mask;
+            const std::size_t remaining = ring.capacity - offset;
+            if (remaining < sizeof(Header)) {   // Too short for padding: implicit skip
+                tail += remaining;
+                continue;
+            }
+            Header h;
+            std::memcpy(&h, ring.buffer.get() + offset, sizeof(h));
+            if (h.site) {
+                const std::size_t begin = start_line(h.ticks, h.site->level);
+                try {
+                    h.format(h.site->format, ring.buffer.get() + offset + sizeof(h), text_);
+                } catch (const std::exception& e) {
+                    fmt::format_to(fmt::appender(text_), "<{}: {}>", h.site->format, e.what());
+                }
+                if (h.suppressed) fmt::format_to(fmt::appender(text_), " ({} suppressed)", h.suppressed);
+                entries_.push_back({h.ticks, h.site->level, begin, text_.size()});
+                suppressed += h.suppressed;
+            }
+            tail += h.size;
+        }
+        ring.tail.store(tail, std::memory_order_release);
+        suppressed_.fetch_add(suppressed, std::memory_order_relaxed);
+
+        const uint64_t dropped = ring.dropped.load(std::memory_order_relaxed);
+        if (dropped != ring.dropped_seen) {
+            const uint64_t now = Tsc::ticks();
+            const std::size_t begin = start_line(now, LogLevel::Warn);
+            fmt::format_to(fmt::appender(text_), "[ASYNC LOG] Ring {} full, dropped {} records",
+                           ring.id, dropped - ring.dropped_seen);
+            entries_.push_back({now, LogLevel::Warn, begin, text_.size()});
+            dropped_.fetch_add(dropped - ring.dropped_seen, std::memory_order_relaxed);
+            ring.dropped_seen = dropped;
+        }
+    }
+
+    // "2026-01-02 03:04:05.678901 WARN  "; returns where the line begins
+    std::size_t start_line(uint64_t ticks, LogLevel level) {
+        const auto since = static_cast<int64_t>(static_cast<double>(static_cast<int64_t>(ticks - anchor_ticks_)) * ns_per_tick_);
+        const int64_t wall_ns = anchor_wall_ns_ + since;
+        const std::size_t begin = text_.size();
+        fmt::format_to(fmt::appender(text_), "{:%F %T}.{:06} {:<5} ",
+                       fmt::gmtime(static_cast<std::time_t>(wall_ns / 1'000'000'000)),
+                       (wall_ns % 1'000'000'000) / 1000, level_name(level));
+        return begin;
+    }
+
+    const double ns_per_tick_;
+    const uint64_t anchor_ticks_;
+    const int64_t anchor_wall_ns_;
+
+    std::mutex mutex_;
+    AsyncLog::Config cfg_;
+    std::vector<std::unique_ptr<Ring>> rings_;
+    uint32_t next_id_ = 0;
+
+    // Backend thread only
+    std::chrono::milliseconds idle_sleep_{1};
+    std::vector<Entry> entries_;
+    fmt::memory_buffer text_;
+
+    std::mutex flush_mutex_;
+    std::condition_variable flushed_;
+    uint64_t passes_ = 0;
+
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> suppressed_{0};
+
+    std::jthread thread_;   // Last: starts once everything above exists
+};
+
+Backend& backend() {
+    static Backend instance;
+    return instance;
+}
+
+// Hands the ring back to the backend when its thread exits
+struct RingHandle {
+    Ring* ring = backend().attach();
+    ~RingHandle() { ring->retired.store(true, std::memory_order_release); }
+};
+}
+
+AsyncLog::detail::Ring& AsyncLog::detail::thread_ring() {
+    thread_local RingHandle handle;
+    return *handle.ring;
+}
+
+std::byte* AsyncLog::detail::reserve(Ring& r, std::size_t bytes) noexcept {
+    uint64_t pos = r.head.load(std::memory_order_relaxed);
+    const std::size_t offset = pos & r.mask;
+    const std::size_t contiguous = r.capacity - offset;
+    const std::size_t skip = contiguous < bytes ? contiguous : 0;
+
+    const auto drop = [&r] {
+        r.dropped.store(r.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return nullptr;
+    };
+    if (bytes > r.capacity / 2) return drop();
+    if (pos + skip + bytes - r.cached_tail > r.capacity) {
+        r.cached_tail = r.tail.load(std::memory_order_acquire);
+        if (pos + skip + bytes - r.cached_tail > r.capacity) return drop();
+    }
+
+    if (skip) {
+        if (skip >= sizeof(Header)) {
+            const Header pad{.site = nullptr, .format = nullptr, .ticks = 0,
+                             .size = static_cast<uint32_t>(skip), .suppressed = 0};
+            std::memcpy(r.buffer.get() + offset, &pad, sizeof(pad));
+        }
+        pos += skip;
+    }
+    r.pending = pos + bytes;
+    return r.buffer.get() + (pos & r.mask);
+}
+
+void AsyncLog::detail::commit(Ring& r) noexcept {
+    r.head.store(r.pending, std::memory_order_release);
+}
+
+void AsyncLog::configure(Config cfg) {
+    backend().configure(std::move(cfg));
+}
+
+void AsyncLog::flush() {
+    backend().flush();
+}
+
+AsyncLog::Stats AsyncLog::stats() {
+    return backend().stats();
+}
@@ -0,0 +1,203 @@
+#include "Utils/HugePageArena.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <new>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+std::atomic<std::size_t> g_held{0};
+std::atomic<std::size_t> g_hugetlb{0};
+std::atomic<std::size_t> g_high_water{0};
+
+std::size_t round_up(std::size_t n, std::size_t to) noexcept {
+    return (n + to - 1) / to * to;
+}
+
+void account(const HugePages::Mapping& m, bool mapped) noexcept {
+    if (!mapped) {
+        g_held.fetch_sub(m.bytes, std::memory_order_relaxed);
+        if (m.hugetlb) g_hugetlb.fetch_sub(m.bytes, std::memory_order_relaxed);
+        return;
+    }
+    const std::size_t held = g_held.fetch_add(m.bytes, std::memory_order_relaxed) + m.bytes;
+    if (m.hugetlb) g_hugetlb.fetch_add(m.bytes, std::memory_order_relaxed);
+    std::size_t peak = g_high_water.load(std::memory_order_relaxed);
+    while (held > peak && !g_high_water.compare_exchange_weak(peak, held, std::memory_order_relaxed)) {}
+}
+}
+
+//--------------------------------------------------------------------
+// HUGE PAGES
+//--------------------------------------------------------------------
+HugePages::Mapping HugePages::map(std::size_t bytes, bool huge_pages) {
+    constexpr int kProt = PROT_READ | PROT_WRITE;
+    constexpr int kFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+    Mapping m;
+
+    if (huge_pages && bytes >= kPageSize) {
+        m.bytes = round_up(bytes, kPageSize);
+        if (void* p = ::mmap(nullptr, m.bytes, kProt, kFlags | MAP_HUGETLB | MAP_POPULATE, -1, 0); p != MAP_FAILED) {
+            m.base = static_cast<std::byte*>(p);
+            m.hugetlb = true;
+            account(m, true);
+            return m;
+        }
+
+        // Transparent huge pages need 2 MB alignment: over-map, trim both ends
+        const std::size_t span = m.bytes + kPageSize;
+        void* p = ::mmap(nullptr, span, kProt, kFlags | MAP_NORESERVE, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        auto* raw = static_cast<std::byte*>(p);
+        auto* aligned = reinterpret_cast<std::byte*>(round_up(reinterpret_cast<uintptr_t>(raw), kPageSize));
+        if (aligned > raw) ::munmap(raw, static_cast<std::size_t>(aligned - raw));
+        if (const auto tail = static_cast<std::size_t>(raw + span - (aligned + m.bytes))) ::munmap(aligned + m.bytes, tail);
+        ::madvise(aligned, m.bytes, MADV_HUGEPAGE);
+        m.base = aligned;
+    } else {
+        m.bytes = round_up(std::max<std::size_t>(bytes, 1), static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+        void* p = ::mmap(nullptr, m.bytes, kProt, kFlags, -1, 0);
+        if (p == MAP_FAILED) throw std::bad_alloc();
+        m.base = static_cast<std::byte*>(p);
+    }
+
+    // Pre-fault now rather than on the tick path
+    ::madvise(m.base, m.bytes, MADV_WILLNEED);
+    for (std::size_t off = 0; off < m.bytes; off += 4096) m.base[off] = std::byte{0};
+    account(m, true);
+    return m;
+}
+
+void HugePages::unmap(const Mapping& mapping) noexcept {
+    if (!mapping.base) return;
+    ::munmap(mapping.base, mapping.bytes);
+    account(mapping, false);
+}
+
+HugePages::Totals HugePages::totals() noexcept {
+    return Totals{
+        .bytes_held = g_held.load(std::memory_order_relaxed),
+        .hugetlb_bytes = g_hugetlb.load(std::memory_order_relaxed),
+        .high_water = g_high_water.load(std::memory_order_relaxed)
+    };
+}
+
+//--------------------------------------------------------------------
+// ARENA
+//--------------------------------------------------------------------
+namespace {
+Metrics::Gauge arena_gauge(const std::string& metric, const std::string& arena, const char* help) {
+    return Metrics::global().gauge(metric + "{arena=\"" + arena + "\"}", help);
+}
+}
+
+HugePageArena::HugePageArena(Config cfg)
+    : name_(std::move(cfg.name)),
+      chunk_bytes_(std::max<std::size_t>(cfg.chunk_bytes, 4096)),
+      huge_pages_(cfg.huge_pages),
+      held_metric_(arena_gauge("ocean_arena_bytes_held", name_, "Bytes mapped by arenas of this name")),
+      hugetlb_metric_(arena_gauge("ocean_arena_hugetlb_bytes", name_, "Of which reserved huge pages")),
+      peak_metric_(arena_gauge("ocean_arena_bytes_in_use_peak", name_, "Peak bytes in use, summed over arenas of this name")) {}
+
+HugePageArena::~HugePageArena() {
+    for (const auto& m : chunks_) HugePages::unmap(m);
+    for (const auto& m : blocks_) HugePages::unmap(m);
+    held_metric_.add(-static_cast<int64_t>(bytes_held_));
+    hugetlb_metric_.add(-static_cast<int64_t>(hugetlb_bytes_));
+    peak_metric_.add(-static_cast<int64_t>(high_water_));
+}
+
+std::size_t HugePageArena::class_of(std::size_t bytes) noexcept {
+    if (bytes <= 256) return bytes == 0 ? 0 : (bytes - 1) / kAlign;
+    return 16 + static_cast<std::size_t>(std::bit_width(bytes - 1)) - 9;
+}
+
+std::size_t HugePageArena::class_size(std::size_t cls) noexcept {
+    return cls < 16 ? (cls + 1) * kAlign : std::size_t{1} << (cls - 16 + 9);
+}
+
+void* HugePageArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void* p;
+    if (bytes > chunk_bytes_ / 4) {
+        add_mapping(bytes, blocks_);   // Page aligned
+        p = blocks_.back().base;
+    } else if (alignment > kAlign) [[unlikely]] {
+        p = bump(bytes, alignment);
+    } else {
+        const std::size_t cls = class_of(bytes);
+        if (!free_[cls]) [[unlikely]] refill(cls);
+        FreeBlock* block = free_[cls];
+        free_[cls] = block->next;
+        p = block;
+    }
+
+    ++allocations_;
+    in_use_ += bytes;
+    if (in_use_ > high_water_) [[unlikely]] {
+        peak_metric_.add(static_cast<int64_t>(in_use_ - high_water_));
+        high_water_ = in_use_;
+    }
+    return p;
+}
+
+void HugePageArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    in_use_ -= bytes;
+    if (bytes > chunk_bytes_ / 4) {
+        const auto it = std::find_if(blocks_.begin(), blocks_.end(),
+                                     [&](const HugePages::Mapping& m) { return m.base == p; });
+        if (it == blocks_.end()) return;
+        track(*it, -1);
+        HugePages::unmap(*it);
+        blocks_.erase(it);
+    } else if (alignment <= kAlign) {
+        const std::size_t cls = class_of(bytes);
+        free_[cls] = new (p) FreeBlock{free_[cls]};
+    }
+}
+
+// One slab per refill: small classes get a run of blocks, big ones one
+void HugePageArena::refill(std::size_t cls) {
+    const std::size_t size = class_size(cls);
+    const std::size_t count = std::max<std::size_t>(1, std::min<std::size_t>(16 << 10, chunk_bytes_ / 8) / size);
+    std::byte* slab = bump(size * count, kAlign);
+    for (std::size_t i = count; i-- > 0;) free_[cls] = new (slab + i * size) FreeBlock{free_[cls]};
+}
+
+std::byte* HugePageArena::bump(std::size_t bytes, std::size_t alignment) {
+    auto* p = reinterpret_cast<std::byte*>(round_up(reinterpret_cast<uintptr_t>(cursor_), alignment));
+    if (!cursor_ || p + bytes > end_) {
+        add_mapping(std::max(chunk_bytes_, bytes + alignment), chunks_);
+        p = reinterpret_cast<std::byte*>(round_up(reinterpret_cast<uintptr_t>(chunks_.back().base), alignment));
+        end_ = chunks_.back().base + chunks_.back().bytes;
+    }
+    cursor_ = p + bytes;
+    return p;
+}
+
+void HugePageArena::add_mapping(std::size_t bytes, std::vector<HugePages::Mapping>& into) {
+    into.reserve(into.size() + 1);   // Can't throw once the pages are mapped
+    into.push_back(HugePages::map(bytes, huge_pages_));
+    track(into.back(), 1);
+}
+
+void HugePageArena::track(const HugePages::Mapping& m, int64_t sign) noexcept {
+    const auto bytes = static_cast<int64_t>(m.bytes) * sign;
+    bytes_held_ += static_cast<std::size_t>(bytes);
+    held_metric_.add(bytes);
+    if (m.hugetlb) {
+        hugetlb_bytes_ += static_cast<std::size_t>(bytes);
+        hugetlb_metric_.add(bytes);
+    }
+}
+
+HugePageArena::Stats HugePageArena::stats() const noexcept {
+    return Stats{
+        .bytes_held = bytes_held_,
+        .hugetlb_bytes = hugetlb_bytes_,
+        .bytes_in_use = in_use_,
+        .high_water = high_water_,
+        .allocations = allocations_
+    };
+}
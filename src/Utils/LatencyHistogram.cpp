@@ -0,0 +1,44 @@
+#include "Utils/LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+void LatencyHistogram::add_bucket(std::size_t bucket, uint64_t count) noexcept {
+    counts_[std::min(bucket, kBuckets - 1)] += count;
+    total_ += count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) noexcept {
+    for (std::size_t i = 0; i < kBuckets; ++i) counts_[i] += other.counts_[i];
+    total_ += other.total_;
+}
+
+void LatencyHistogram::clear() noexcept {
+    counts_.fill(0);
+    total_ = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const noexcept {
+    if (total_ == 0) return 0;
+    // Rank of the sample at q, 1-based: q=0 is the minimum, q=1 the maximum
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(total_))));
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) return value_of(i);
+    }
+    return value_of(kBuckets - 1);
+}
+
+uint64_t LatencyHistogram::min() const noexcept {
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        if (counts_[i]) return value_of(i);
+    }
+    return 0;
+}
+
+uint64_t LatencyHistogram::max() const noexcept {
+    for (std::size_t i = kBuckets; i-- > 0;) {
+        if (counts_[i]) return value_of(i);
+    }
+    return 0;
+}
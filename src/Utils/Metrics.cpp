@@ -0,0 +1,322 @@
+#include "Utils/Metrics.hpp"
+#include "Utils/AsyncLog.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Metrics;
+
+//--------------------------------------------------------------------
+// File layout, all little-endian and naturally aligned:
+//   [0, 64)            FileHeader
+//   [64, ...)          max_metrics Descriptors, 256 bytes each
+//   [cells, end)       writer_slots runs of cells_per_slot 8-byte cells
+// The magic is stored last, so a reader never sees a half-made header.
+// Descriptors become visible as metric_count grows.
+//--------------------------------------------------------------------
+namespace {
+constexpr uint64_t kMagic = 0x5445'4D4E'4145'434F;   // "OCEANMET"
+constexpr uint32_t kVersion = 1;
+constexpr std::size_t kHeaderBytes = 64;
+constexpr uint32_t kCellsPerLine = 8;
+
+struct FileHeader {
+    std::atomic<uint64_t> magic;
+    uint32_t version;
+    uint32_t max_metrics;
+    uint32_t writer_slots;
+    uint32_t cells_per_slot;
+    std::atomic<uint32_t> metric_count;
+    uint32_t pid;
+};
+static_assert(sizeof(FileHeader) <= kHeaderBytes);
+
+struct Descriptor {
+    char name[128];
+    char help[104];
+    uint32_t first_cell;
+    uint32_t cells;
+    Kind kind;
+    uint8_t reserved[15];
+};
+static_assert(sizeof(Descriptor) == 256);
+
+std::size_t file_bytes(uint32_t max_metrics, uint32_t slots, uint32_t cells_per_slot) noexcept {
+    return kHeaderBytes + std::size_t{max_metrics} * sizeof(Descriptor) +
+           std::size_t{slots} * cells_per_slot * sizeof(uint64_t);
+}
+
+Descriptor* descriptors(std::byte* map) noexcept {
+    return reinterpret_cast<Descriptor*>(map + kHeaderBytes);
+}
+
+std::atomic<uint64_t>* cell_area(std::byte* map, const FileHeader& h) noexcept {
+    return reinterpret_cast<std::atomic<uint64_t>*>(map + kHeaderBytes + std::size_t{h.max_metrics} * sizeof(Descriptor));
+}
+
+uint32_t cells_for(Kind kind) noexcept {
+    switch (kind) {
+        case Kind::Counter: return 1;
+        case Kind::Gauge: return kCellsPerLine;   // Alone on its line: every thread stores to slot 0
+        case Kind::Histogram: return kHistogramBuckets;
+    }
+    return 1;
+}
+
+std::string_view kind_name(Kind kind) noexcept {
+    switch (kind) {
+        case Kind::Counter: return "counter";
+        case Kind::Gauge: return "gauge";
+        case Kind::Histogram: return "histogram";
+    }
+    return "untyped";
+}
+
+std::runtime_error system_error(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+}
+
+Registry::Registry(Config cfg) : path_(std::move(cfg.path)) {
+    const uint32_t slots = std::bit_ceil(std::max(cfg.writer_slots, 1u));
+    const uint32_t cells = (std::max(cfg.cells_per_slot, uint32_t{kHistogramBuckets}) + kCellsPerLine - 1) & ~(kCellsPerLine - 1);
+    bytes_ = file_bytes(cfg.max_metrics, slots, cells);
+    slot_mask_ = slots - 1;
+
+    void* map = MAP_FAILED;
+    if (path_.empty()) {
+        map = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    } else {
+        // A fresh inode: readers mapping the previous run's file keep it intact
+        // instead of faulting on a truncated one
+        ::unlink(path_.c_str());
+        const int fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+        if (fd < 0) throw system_error("Cannot create metrics file", path_);
+        if (::ftruncate(fd, static_cast<off_t>(bytes_)) == 0) {
+            map = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+    }
+    if (map == MAP_FAILED) throw system_error("Cannot map metrics file", path_);
+    map_ = static_cast<std::byte*>(map);
+
+    auto* h = reinterpret_cast<FileHeader*>(map_);
+    h->version = kVersion;
+    h->max_metrics = cfg.max_metrics;
+    h->writer_slots = slots;
+    h->cells_per_slot = cells;
+    h->pid = static_cast<uint32_t>(::getpid());
+    h->magic.store(kMagic, std::memory_order_release);
+}
+
+Registry::~Registry() {
+    ::munmap(map_, bytes_);
+}
+
+Counter Registry::counter(std::string_view name, std::string_view help) {
+    return Counter(add(name, help, Kind::Counter));
+}
+
+Gauge Registry::gauge(std::string_view name, std::string_view help) {
+    return Gauge(add(name, help, Kind::Gauge));
+}
+
+Histogram Registry::histogram(std::string_view name, std::string_view help) {
+    return Histogram(add(name, help, Kind::Histogram));
+}
+
+Cells Registry::add(std::string_view name, std::string_view help, Kind kind) {
+    auto& h = *reinterpret_cast<FileHeader*>(map_);
+    Descriptor* table = descriptors(map_);
+    if (name.empty() || name.size() >= sizeof(Descriptor::name)) {
+        throw std::invalid_argument("Metric name must be 1-127 characters: " + std::string(name));
+    }
+
+    std::lock_guard lock(mutex_);
+    const uint32_t count = h.metric_count.load(std::memory_order_relaxed);
+    const auto cells_of = [&](const Descriptor& d) {
+        return Cells{.base = cell_area(map_, h) + d.first_cell, .stride = h.cells_per_slot, .slot_mask = slot_mask_};
+    };
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (std::string_view(table[i].name) != name) continue;
+        if (table[i].kind != kind) {
+            throw std::invalid_argument("Metric " + std::string(name) + " is already a " + std::string(kind_name(table[i].kind)));
+        }
+        return cells_of(table[i]);
+    }
+
+    const uint32_t need = cells_for(kind);
+    const uint32_t first = kind == Kind::Counter ? next_cell_ : (next_cell_ + kCellsPerLine - 1) & ~(kCellsPerLine - 1);
+    if (count == h.max_metrics || first + need > h.cells_per_slot) {
+        OCEAN_LOG_WARN("[METRICS] Registry full, {} is not exported", name);
+        return {};
+    }
+
+    Descriptor& d = table[count];
+    std::memcpy(d.name, name.data(), name.size());
+    std::memcpy(d.help, help.data(), std::min(help.size(), sizeof(d.help) - 1));
+    d.first_cell = first;
+    d.cells = need;
+    d.kind = kind;
+    next_cell_ = first + need;
+    h.metric_count.store(count + 1, std::memory_order_release);
+    return cells_of(d);
+}
+
+namespace {
+// Set by publish() before global() first runs; empty keeps the registry private
+std::string g_publish_path;
+}
+
+bool Metrics::publish(std::string path) {
+    if (path.empty()) {
+        const char* env = std::getenv("OCEAN_METRICS_PATH");
+        path = env && *env ? env : "/dev/shm/ocean-metrics";
+    }
+    g_publish_path = path;
+    return global().path() == path;
+}
+
+Registry& Metrics::global() {
+    // Never destroyed: threads still counting during exit keep a live mapping
+    static Registry* const instance = [] {
+        Registry::Config cfg;
+        cfg.path = g_publish_path;
+        try {
+            return new Registry(cfg);
+        } catch (const std::runtime_error& e) {
+            OCEAN_LOG_WARN("[METRICS] {}; metrics stay in-process", e.what());
+            cfg.path.clear();
+            return new Registry(cfg);
+        }
+    }();
+    return *instance;
+}
+
+Reader::Reader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) throw system_error("Cannot open metrics file", path);
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kHeaderBytes)) {
+        ::close(fd);
+        throw std::runtime_error("Not a metrics file: " + path);
+    }
+    bytes_ = static_cast<std::size_t>(st.st_size);
+    void* map = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) throw system_error("Cannot map metrics file", path);
+    map_ = static_cast<const std::byte*>(map);
+
+    const auto& h = *reinterpret_cast<const FileHeader*>(map_);
+    if (h.magic.load(std::memory_order_acquire) != kMagic || h.version != kVersion ||
+        bytes_ < file_bytes(h.max_metrics, h.writer_slots, h.cells_per_slot)) {
+        ::munmap(const_cast<std::byte*>(map_), bytes_);
+        throw std::runtime_error("Not a metrics file (or still being created): " + path);
+    }
+}
+
+Reader::~Reader() {
+    ::munmap(const_cast<std::byte*>(map_), bytes_);
+}
+
+uint32_t Reader::pid() const noexcept {
+    return reinterpret_cast<const FileHeader*>(map_)->pid;
+}
+
+std::vector<Sample> Reader::snapshot() const {
+    // The mapping is read-only; loads through these never write
+    std::byte* map = const_cast<std::byte*>(map_);
+    const auto& h = *reinterpret_cast<const FileHeader*>(map);
+    const Descriptor* table = descriptors(map);
+    const std::atomic<uint64_t>* cells = cell_area(map, h);
+    const uint32_t count = std::min(h.metric_count.load(std::memory_order_acquire), h.max_metrics);
+
+    std::vector<Sample> out;
+    out.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const Descriptor& d = table[i];
+        Sample s;
+        s.name.assign(d.name, ::strnlen(d.name, sizeof(d.name)));
+        s.help.assign(d.help, ::strnlen(d.help, sizeof(d.help)));
+        s.kind = d.kind;
+        const auto at = [&](uint32_t slot, uint32_t cell) {
+            return cells[std::size_t{slot} * h.cells_per_slot + d.first_cell + cell].load(std::memory_order_relaxed);
+        };
+
+        if (d.kind == Kind::Gauge) {
+            s.value = static_cast<int64_t>(at(0, 0));
+        } else if (d.kind == Kind::Counter) {
+            uint64_t total = 0;
+            for (uint32_t slot = 0; slot < h.writer_slots; ++slot) total += at(slot, 0);
+            s.value = static_cast<int64_t>(total);
+        } else {
+            for (uint32_t slot = 0; slot < h.writer_slots; ++slot) {
+                for (uint32_t b = 0; b < kHistogramBuckets; ++b) s.buckets[b] += at(slot, b);
+            }
+        }
+        out.push_back(std::move(s));
+    }
+    return out;
+}
+
+std::string Metrics::to_prometheus(const std::vector<Sample>& samples) {
+    std::string out;
+    std::set<std::string, std::less<>> described;
+
+    for (const Sample& s : samples) {
+        // name{labels}: the base names the family, labels go on every line
+        const std::size_t brace = s.name.find('{');
+        const std::string_view base = std::string_view(s.name).substr(0, brace);
+        const std::string_view labels = brace == std::string::npos
+            ? std::string_view{}
+            : std::string_view(s.name).substr(brace + 1, s.name.size() - brace - 2);
+
+        if (!described.contains(base)) {
+            described.emplace(base);
+            if (!s.help.empty()) out.append("# HELP ").append(base).append(" ").append(s.help).append("\n");
+            out.append("# TYPE ").append(base).append(" ").append(kind_name(s.kind)).append("\n");
+        }
+
+        if (s.kind != Kind::Histogram) {
+            out.append(s.name).append(" ").append(std::to_string(s.value)).append("\n");
+            continue;
+        }
+
+        const auto series = [&](std::string_view suffix, std::string_view le) {
+            out.append(base).append(suffix);
+            if (labels.empty() && le.empty()) return;
+            out.append("{").append(labels);
+            if (!le.empty()) out.append(labels.empty() ? "" : ",").append("le=\"").append(le).append("\"");
+            out.append("}");
+        };
+
+        uint64_t cumulative = 0;
+        double sum = 0.0;
+        for (std::size_t b = 0; b + 1 < kHistogramBuckets; ++b) {
+            cumulative += s.buckets[b];
+            // Bucket b holds [2^(b-1), 2^b - 1]; bucket 0 holds only 0
+            const uint64_t upper = b == 0 ? 0 : (uint64_t{1} << b) - 1;
+            if (b > 0) sum += static_cast<double>(s.buckets[b]) * (static_cast<double>(uint64_t{1} << (b - 1)) + static_cast<double>(upper)) / 2.0;
+            series("_bucket", std::to_string(upper));
+            out.append(" ").append(std::to_string(cumulative)).append("\n");
+        }
+        cumulative += s.buckets[kHistogramBuckets - 1];
+        sum += static_cast<double>(s.buckets[kHistogramBuckets - 1]) * static_cast<double>(uint64_t{1} << (kHistogramBuckets - 2));
+
+        series("_bucket", "+Inf");
+        out.append(" ").append(std::to_string(cumulative)).append("\n");
+        series("_sum", {});
+        out.append(" ").append(std::to_string(static_cast<uint64_t>(sum))).append("\n");
+        series("_count", {});
+        out.append(" ").append(std::to_string(cumulative)).append("\n");
+    }
+    return out;
+}
@@ -1,38 +1,226 @@
 #include "Utils/QuestDBLogger.hpp"
-#include <stdexcept>
-#include <curl/curl.h>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <utility>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
-QuestDBLogger::QuestDBLogger() {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    curlHandle = curl_easy_init();
-    if (!curlHandle) {
-        throw std::runtime_error("Failed to initialize CURL");
+namespace {
+constexpr auto kIdleSleep = std::chrono::milliseconds(1);
+constexpr std::size_t kMaxCapacity = 65534;   // Fixed-size lockfree nodes use 16-bit indices
+constexpr std::size_t kMaxLine = 128;         // Longest line append() can produce, plus slack
+
+uint64_t wall_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// ILP tag values escape the characters that delimit them
+void append_tag_value(std::string& out, std::string_view value) {
+    for (const char c : value) {
+        if (c == ',' || c == ' ' || c == '=' || c == '\\') out += '\\';
+        out += c == '\n' ? ' ' : c;
     }
 }
 
+template <typename Int>
+void append_int(std::string& out, Int value) {
+    char buf[24];
+    const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+    if (ec == std::errc{}) out.append(buf, end);
+}
+}
+
+QuestDBLogger::QuestDBLogger() : QuestDBLogger(Config{}) {}
+
+QuestDBLogger::QuestDBLogger(Config cfg)
+    : cfg_(std::move(cfg)), ring_(std::clamp<std::size_t>(cfg_.capacity, 1, kMaxCapacity)) {
+    line_prefix_ = cfg_.table + "," + cfg_.tag + "=";
+    field_prefix_ = " " + cfg_.field + "=";
+    batch_.reserve(cfg_.batch_bytes + kMaxLine);
+    writer_ = std::jthread([this](std::stop_token st) { run(st); });
+}
+
 QuestDBLogger::~QuestDBLogger() {
-    if (curlHandle) curl_easy_cleanup(curlHandle);
-    curl_global_cleanup();
+    writer_.request_stop();
+    if (writer_.joinable()) writer_.join();
 }
 
 void QuestDBLogger::log(const std::string& methodName, long durationMs) {
-    const std::string query =
-        "INSERT INTO execution_times(ts, methodName, durationMs) "
-        "VALUES(systimestamp(), '" + methodName + "', " + std::to_string(durationMs) + ")";
+    record(methodName, durationMs);
+}
 
-    char* escaped = curl_easy_escape(curlHandle, query.c_str(), query.length());
-    if (!escaped) return;
+void QuestDBLogger::log_latency(const LatencySummary& s) {
+    // <latency_table>,<latency_tag>=<probe> count=<n>i,min_ns=<n>i,... <ts>
+    std::string line = cfg_.latency_table + "," + cfg_.latency_tag + "=";
+    append_tag_value(line, s.probe);
+    const std::pair<const char*, uint64_t> fields[] = {
+        {" count=", s.count}, {",min_ns=", s.min_ns}, {",p50_ns=", s.p50_ns}, {",p90_ns=", s.p90_ns},
+        {",p99_ns=", s.p99_ns}, {",p999_ns=", s.p999_ns}, {",max_ns=", s.max_ns},
+    };
+    for (const auto& [key, value] : fields) {
+        line += key;
+        append_int(line, value);
+        line += 'i';
+    }
+    line += ' ';
+    append_int(line, wall_ns());
+    line += '\n';
 
-    const std::string url = "http://localhost:9000/exec?query=" + std::string(escaped);
-    curl_free(escaped);
+    const std::lock_guard lock(latency_mutex_);
+    if (latency_lines_.size() + line.size() > cfg_.batch_bytes) {
+        stats_.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    latency_lines_ += line;
+    ++latency_pending_;
+}
+
+bool QuestDBLogger::record(std::string_view name, int64_t value) noexcept {
+    Record r;
+    r.ts_ns = wall_ns();
+    r.value = value;
+    r.name_size = static_cast<uint8_t>(std::min(name.size(), kMaxName));
+    std::memcpy(r.name, name.data(), r.name_size);
+    if (ring_.bounded_push(r)) return true;
+    stats_.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool QuestDBLogger::flush(std::chrono::milliseconds timeout) {
+    const uint64_t ticket = flush_requested_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (flush_done_.load(std::memory_order_acquire) < ticket) {
+        if (std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(kIdleSleep);
+    }
+    return true;
+}
+
+//------------------------------------------------------------------
+// Writer thread
+//------------------------------------------------------------------
+void QuestDBLogger::run(std::stop_token st) {
+    while (!st.stop_requested()) {
+        // Everything recorded before this ticket is in the ring by now
+        const uint64_t ticket = flush_requested_.load(std::memory_order_acquire);
+        const std::size_t lines_before = batch_lines_;
+        const bool drained = fill_batch();
 
-    curl_easy_setopt(curlHandle, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curlHandle, CURLOPT_WRITEFUNCTION, [](void*, size_t size, size_t nmemb, void*) {
-        return size * nmemb;
-    });
+        const bool flushing = ticket > flush_done_.load(std::memory_order_relaxed);
+        const bool due = batch_lines_ > 0 &&
+            (flushing || batch_.size() >= cfg_.batch_bytes ||
+             std::chrono::steady_clock::now() - batch_start_ >= cfg_.flush_interval);
+        if (due) send_batch();
+
+        if (flushing && drained && batch_lines_ == 0) flush_done_.store(ticket, std::memory_order_release);
+        if (batch_lines_ == lines_before) std::this_thread::sleep_for(kIdleSleep);   // Idle or waiting to reconnect
+    }
 
-    CURLcode res = curl_easy_perform(curlHandle);
-    if (res != CURLE_OK) {
-        // Handle error
+    // Shutdown: one more connection attempt for whatever is left
+    retry_at_ = {};
+    for (bool drained = false; !drained || batch_lines_ > 0;) {
+        drained = fill_batch();
+        if (batch_lines_ > 0 && !send_batch()) break;
     }
-}
\ No newline at end of file
+    disconnect();
+}
+
+bool QuestDBLogger::fill_batch() {
+    {
+        const std::lock_guard lock(latency_mutex_);
+        if (latency_pending_ > 0) {
+            if (batch_lines_ == 0) batch_start_ = std::chrono::steady_clock::now();
+            batch_ += latency_lines_;
+            batch_lines_ += latency_pending_;
+            latency_lines_.clear();
+            latency_pending_ = 0;
+        }
+    }
+    Record r;
+    while (batch_.size() < cfg_.batch_bytes) {
+        if (!ring_.pop(r)) return true;
+        append(r);
+    }
+    return false;
+}
+
+void QuestDBLogger::append(const Record& r) {
+    if (batch_lines_ == 0) batch_start_ = std::chrono::steady_clock::now();
+    // <table>,<tag>=<name> <field>=<value>i <ts>
+    batch_ += line_prefix_;
+    append_tag_value(batch_, std::string_view(r.name, r.name_size));
+    batch_ += field_prefix_;
+    append_int(batch_, r.value);
+    batch_ += "i ";
+    append_int(batch_, r.ts_ns);
+    batch_ += '\n';
+    ++batch_lines_;
+}
+
+bool QuestDBLogger::send_batch() {
+    if (fd_ < 0) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now < retry_at_) return false;
+        if (!connect()) {
+            retry_at_ = now + cfg_.reconnect_backoff;
+            return false;
+        }
+    }
+
+    while (batch_sent_ < batch_.size()) {
+        const ssize_t n = ::send(fd_, batch_.data() + batch_sent_, batch_.size() - batch_sent_, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            // Part of the batch may have landed; resend all of it on the next connection
+            stats_.send_failures.fetch_add(1, std::memory_order_relaxed);
+            stats_.retried.fetch_add(batch_lines_, std::memory_order_relaxed);
+            batch_sent_ = 0;
+            disconnect();
+            retry_at_ = std::chrono::steady_clock::now() + cfg_.reconnect_backoff;
+            return false;
+        }
+        batch_sent_ += static_cast<std::size_t>(n);
+    }
+
+    stats_.written.fetch_add(batch_lines_, std::memory_order_relaxed);
+    stats_.batches.fetch_add(1, std::memory_order_relaxed);
+    batch_.clear();
+    batch_lines_ = 0;
+    batch_sent_ = 0;
+    return true;
+}
+
+bool QuestDBLogger::connect() {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    if (getaddrinfo(cfg_.host.c_str(), std::to_string(cfg_.port).c_str(), &hints, &found) != 0) return false;
+
+    for (addrinfo* a = found; a && fd_ < 0; a = a->ai_next) {
+        const int fd = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) continue;
+        // A stalled server must not hang shutdown
+        const timeval timeout{.tv_sec = 1, .tv_usec = 0};
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        if (::connect(fd, a->ai_addr, a->ai_addrlen) == 0) fd_ = fd;
+        else ::close(fd);
+    }
+    freeaddrinfo(found);
+    if (fd_ < 0) return false;
+
+    stats_.connects.fetch_add(1, std::memory_order_relaxed);
+    connected_.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void QuestDBLogger::disconnect() noexcept {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    connected_.store(false, std::memory_order_relaxed);
+}
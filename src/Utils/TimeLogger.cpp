@@ -0,0 +1,159 @@
+#include "Utils/TimeLogger.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <string>
+
+namespace {
+constexpr std::string_view kOverflowProbe = "<overflow>";
+
+// One thread's samples for one probe. Only the owning thread writes
+// (a plain load and store, no read-modify-write); the collector reads
+// and diffs against what it saw last time, so nothing is ever reset.
+struct ThreadCounts {
+    std::array<std::atomic<uint32_t>, LatencyHistogram::kBuckets> counts{};
+    std::array<uint32_t, LatencyHistogram::kBuckets> collected{};   // Collector-only
+};
+
+struct ThreadSlot {
+    std::array<std::atomic<ThreadCounts*>, TimeLogger::kMaxProbes> probes{};
+    std::array<std::unique_ptr<ThreadCounts>, TimeLogger::kMaxProbes> owned;
+};
+
+// Slots outlive their threads so late samples still get collected
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<ThreadSlot>> threads;
+    std::array<std::unique_ptr<LatencyHistogram>, TimeLogger::kMaxProbes> totals;   // Ticks
+
+    Registry() {
+        names.reserve(TimeLogger::kMaxProbes);   // Never reallocates: summaries view these
+        names.emplace_back(kOverflowProbe);
+    }
+
+    ThreadSlot* attach() {
+        std::lock_guard lock(mutex);
+        return threads.emplace_back(std::make_unique<ThreadSlot>()).get();
+    }
+
+    ThreadCounts* create(ThreadSlot& slot, ProbeId probe) {
+        std::lock_guard lock(mutex);
+        slot.owned[probe] = std::make_unique<ThreadCounts>();
+        slot.probes[probe].store(slot.owned[probe].get(), std::memory_order_release);
+        return slot.owned[probe].get();
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Tick histogram re-bucketed in nanoseconds
+LatencyHistogram to_ns(const LatencyHistogram& ticks) {
+    LatencyHistogram ns;
+    for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+        if (const uint64_t n = ticks.count_at(i)) ns.add(Tsc::to_ns(LatencyHistogram::value_of(i)), n);
+    }
+    return ns;
+}
+
+LatencySummary summarize(std::string_view probe, const LatencyHistogram& ns) {
+    return {.probe = probe, .count = ns.count(), .min_ns = ns.min(), .p50_ns = ns.percentile(0.50),
+            .p90_ns = ns.percentile(0.90), .p99_ns = ns.percentile(0.99), .p999_ns = ns.percentile(0.999),
+            .max_ns = ns.max()};
+}
+}
+
+ProbeId TimeLogger::intern(std::string_view name) {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    for (std::size_t i = 1; i < r.names.size(); ++i) {
+        if (r.names[i] == name) return static_cast<ProbeId>(i);
+    }
+    if (r.names.size() == kMaxProbes) return 0;
+    r.names.emplace_back(name);
+    return static_cast<ProbeId>(r.names.size() - 1);
+}
+
+void TimeLogger::record(ProbeId probe, uint64_t ticks) noexcept {
+    thread_local ThreadSlot* slot = registry().attach();
+    if (probe >= kMaxProbes) probe = 0;
+
+    ThreadCounts* counts = slot->probes[probe].load(std::memory_order_relaxed);
+    if (!counts) [[unlikely]] counts = registry().create(*slot, probe);
+
+    auto& bucket = counts->counts[LatencyHistogram::bucket_of(ticks)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+LatencyHistogram TimeLogger::total(std::string_view name) {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    for (std::size_t i = 0; i < r.names.size(); ++i) {
+        if (r.names[i] == name && r.totals[i]) return to_ns(*r.totals[i]);
+    }
+    return {};
+}
+
+TimeLogger::TimeLogger(std::chrono::milliseconds interval) : interval_(interval) {
+    if (interval_.count() <= 0) return;   // collect() by hand only
+    collector_ = std::jthread([this](std::stop_token st) {
+        std::mutex m;
+        std::condition_variable_any cv;
+        std::unique_lock lock(m);
+        while (!st.stop_requested()) {
+            cv.wait_for(lock, st, interval_, [] { return false; });
+            if (!st.stop_requested()) collect();
+        }
+    });
+}
+
+TimeLogger::~TimeLogger() {
+    if (collector_.joinable()) {
+        collector_.request_stop();
+        collector_.join();
+    }
+    collect();
+}
+
+void TimeLogger::add_sink(ILogger& sink) {
+    std::lock_guard lock(sinks_mutex_);
+    sinks_.push_back(&sink);
+}
+
+void TimeLogger::collect() {
+    std::vector<LatencySummary> summaries;
+    {
+        Registry& r = registry();
+        std::lock_guard lock(r.mutex);
+        auto delta = std::make_unique<LatencyHistogram>();
+        for (std::size_t p = 0; p < r.names.size(); ++p) {
+            delta->clear();
+            for (const auto& slot : r.threads) {
+                ThreadCounts* counts = slot->probes[p].load(std::memory_order_acquire);
+                if (!counts) continue;
+                for (std::size_t i = 0; i < LatencyHistogram::kBuckets; ++i) {
+                    const uint32_t now = counts->counts[i].load(std::memory_order_relaxed);
+                    const uint32_t fresh = now - counts->collected[i];   // Wraps correctly
+                    if (fresh == 0) continue;
+                    counts->collected[i] = now;
+                    delta->add_bucket(i, fresh);
+                }
+            }
+            if (delta->count() == 0) continue;
+
+            if (!r.totals[p]) r.totals[p] = std::make_unique<LatencyHistogram>();
+            r.totals[p]->merge(*delta);
+            summaries.push_back(summarize(r.names[p], to_ns(*delta)));
+        }
+    }
+
+    // Sinks may block; the registry is free again by now
+    std::lock_guard lock(sinks_mutex_);
+    for (ILogger* sink : sinks_) {
+        for (const auto& s : summaries) sink->log_latency(s);
+    }
+}
@@ -0,0 +1,37 @@
+#include "Utils/Tsc.hpp"
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace {
+bool detect_invariant() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    // CPUID 0x80000007 EDX bit 8: constant rate across P/C-states and cores
+    unsigned a = 0, b = 0, c = 0, d = 0;
+    return __get_cpuid(0x80000007, &a, &b, &c, &d) && (d & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+double calibrate() noexcept {
+    if (!Tsc::detail::invariant) return 1.0;
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+    const uint64_t c0 = Tsc::ticks();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    const auto t1 = clock::now();
+    const uint64_t c1 = Tsc::ticks();
+    const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    return c1 > c0 ? ns / static_cast<double>(c1 - c0) : 1.0;
+}
+}
+
+const bool Tsc::detail::invariant = detect_invariant();
+
+double Tsc::ns_per_tick() noexcept {
+    static const double ratio = calibrate();
+    return ratio;
+}
@@ -4,109 +4,371 @@
 #include "csignal"
 #include "vector"
 #include "memory"
+#include "array"
+#include "chrono"
+#include "string_view"
 
 
 
-#include "Strategy/LiquidityRaidDetector.hpp"
-#include "Risk/RiskManager.hpp"
+#include "Strategy/DetectorPipeline.hpp"
+#include "Strategy/PipelineStages.hpp"
+#include "Execution/MockVenue.hpp"
+#include "Execution/OrderGateway.hpp"
+#include "Risk/PnlEngine.hpp"
+#include "Risk/RiskEngine.hpp"
 #include "Tactics/SunTzuTactics.hpp"
-#include "Analysis/MarketPhaseDetector.hpp"
+#include "Analysis/BarAggregator.hpp"
 #include "Clients/BinanceWSClient.hpp"
+#include "Clients/ConnectionManager.hpp"
+#include "Core/Fanout.hpp"
 #include "Core/MarketData.hpp"
+#include "Core/TradeTape.hpp"
+#include "Core/PipelineConfig.hpp"
+#include "Core/TradingPipeline.hpp"
+#include "Utils/AsyncLog.hpp"
+#include "Utils/HugePageArena.hpp"
+#include "Utils/Metrics.hpp"
+#include "Utils/QuestDBLogger.hpp"
+#include "Utils/TimeLogger.hpp"
 
 
-class MarketPhaseDetector;
 class OrderBook;
 class MarketData;
 // Global kill switch with Sun Tzu wisdom
 std::atomic<bool> global_blood_moon{false};
 
+// Terrain is read at several resolutions; risk follows the 1m phase
+constexpr std::array<BarAggregator::Timeframe, 3> kTimeframes{{
+    {.period = std::chrono::seconds(1)},
+    {.period = std::chrono::minutes(1)},
+    {.period = std::chrono::minutes(5)},
+}};
+constexpr std::size_t kRiskTimeframe = 1;
+
+// One account trading one symbol; ids index the risk engine's slots
+constexpr RiskEngine::AccountId kAccount = 0;
+constexpr RiskEngine::SymbolId kSymbol = 0;
+constexpr double kStartingBalance = 300.0;
+constexpr std::size_t kOrderCapacity = 256;
+
+// The account's limits, the marked PnL that feeds them every tick, and
+// the gateway that settles both. Paper trading against the mock venue
+// until a live transport satisfies OrderTransport.
+struct WarChest {
+    RiskEngine risk{1, 1};
+    PnlEngine pnl{1, kStartingBalance};
+    MockVenue venue;
+    OrderGateway<MockVenue> gateway{venue, kOrderCapacity};
+
+    WarChest() {
+        pnl.attachRisk(risk, kAccount);
+        gateway.attach_risk(risk, kAccount);
+        gateway.attach_pnl(pnl);
+    }
+};
+
+constexpr SunTzu::LiquidityRaidConfig kRaidConfig{
+    .volume_spike_multiplier = 2.5f,
+    .time_window_seconds = 30.0f,
+    .min_volume_threshold = 0.15f   // BTC, about $10k at the time of writing
+};
+
+// WebSocket io threads; connections are spread over them by message rate
+constexpr std::size_t kIoThreads = 2;
+constexpr auto kRebalanceInterval = std::chrono::seconds(30);
+
+// Spin on an isolated core with WaitPolicy::BusySpin; futex sleep otherwise
+constexpr WaitPolicy kStrategyWait = WaitPolicy::SpinThenFutex;
+
+// Read from outside the process with OceanMetrics. Initialised ahead of
+// the counters below so the registry is the shared file, not anonymous memory;
+// benches and tests never publish and leave a running OceanMain's file alone.
+static const bool metrics_published = Metrics::publish();
+static const Metrics::Counter book_updates_metric =
+    Metrics::global().counter("ocean_book_updates_total", "Level updates applied to the book");
+static const Metrics::Counter orders_sent_metric =
+    Metrics::global().counter("ocean_orders_sent_total", "Orders the gateway sent to the venue");
+
+static uint64_t feed_clock_ns() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 //------------------------------------------------------------------
 // L I Q U I D   B L O O D   S T R A T E G Y  (SUN TZU EDITION)
 //------------------------------------------------------------------
-void liquid_blood(MarketData& market, OrderBook& book, MarketPhaseDetector& phase_detector) {
-    LiquidityRaidDetector raid_detector({
-        .volume_spike_multiplier = 2.5f,  // This should come first
-           .min_wick_ratio = 1.8f
-    });
+// Stage order matters: detectors fill the decision, tactics act on it.
+// Adding a signal means adding a type here, not editing the loop.
+using LiquidBloodPipeline = DetectorPipeline<
+    PhaseStage<kRiskTimeframe>,        // "Know the terrain"
+    WeakPointStage<5000.0f>,           // "Attack only when strong"
+    UpdateRaidStage,
+    TapeRaidStage<kRaidConfig>,
+    GammaStage<>,
+    RiskPhaseStage,
+    MarkToMarketStage,                 // "Know when to retreat"
+    StealthEntryStage<>                // Deception tactic
+>;
+
+static LiquidBloodPipeline make_liquid_blood(BarAggregator& bars, const TradeTape& tape, WarChest& chest) {
+    return LiquidBloodPipeline(
+        PhaseStage<kRiskTimeframe>(bars, tape), WeakPointStage<5000.0f>{}, UpdateRaidStage{},
+        TapeRaidStage<kRaidConfig>(tape), GammaStage<>(tape), RiskPhaseStage(chest.risk, kAccount),
+        MarkToMarketStage(chest.pnl, kSymbol), StealthEntryStage<>{});
+}
+
+static void strike(const TickDecision& decision, LiquidBloodPipeline& pipeline, WarChest& chest, uint64_t tick_ns) {
+    chest.venue.poll(chest.gateway);   // Settle reports before sizing off the fills
+    if (decision.retreat && !global_blood_moon.exchange(true)) {
+        OCEAN_LOG_ERROR("⚔️ Daily loss limit reached! Withdrawing!");
+        return;
+    }
+
+    if (decision.squeeze == GammaSqueezeDetector::Direction::UP) {
+        OCEAN_LOG_INFO("🌊 SQUEEZE BUILDING! SCORE {}", pipeline.stage<GammaStage<>>().detector().signal().score);
+    }
+
+    if (!decision.enter) return;
+    const float stop_loss = decision.entry_price * 0.95f; // 5% stop
 
+    // Risk-managed position sizing
+    const double size = chest.risk.positionSize(kAccount, decision.entry_price, stop_loss);
+    if (size <= 0.0) return;
+
+    // Execute only if risk parameters allow; the gateway reserves the headroom
+    const auto sent = chest.gateway.submit(kSymbol, decision.is_bid, size, decision.entry_price, tick_ns, stop_loss);
+    if (sent.status == OrderGateway<MockVenue>::SubmitStatus::Sent) {
+        orders_sent_metric.add();
+        OCEAN_LOG_INFO("⚡ RAID DETECTED! ENTERING AT {} SIZE {}", decision.entry_price, size);
+    }
+}
+
+void liquid_blood(MarketData& market, OrderBook& book, BarAggregator& bars, const TradeTape& tape,
+                  WarChest& chest) {
+    LiquidBloodPipeline pipeline = make_liquid_blood(bars, tape, chest);
+
+    uint32_t seen = market.notifier().sequence();
     while (!global_blood_moon) {
-        // Sun Tzu Principle: "Know the terrain"
+        // Wake on the frame itself; the timeout only re-checks the kill switch
+        const uint32_t current = market.notifier().wait(seen, kStrategyWait);
+        if (current == seen) continue;
+        seen = current;
+
         auto updates = market.get_updates();
-        phase_detector.update(book.get_mid_price());
-        SunTzu::adjustForMarketPhase(phase_detector.getPhase());
+        if (updates.empty()) continue;
+        // Stamped on receipt, like the pinned feed stage, so tick-to-wire covers the book update
+        const uint64_t tick_ns = feed_clock_ns();
 
-        if (updates.empty()) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-            continue;
-        }
+        ScopeTimer<"liquid_blood.tick"> timer;
+        book_updates_metric.add(updates.size());
+        book.update(updates);
+        strike(pipeline.on_tick(make_tick_features(tick_ns, book, updates)), pipeline, chest, tick_ns);
+    }
+    OCEAN_LOG_INFO("💀 Strategy terminated with honor");
+}
 
-        // Sun Tzu Principle: "Attack only when strong"
-        if (SunTzu::isWeakPoint(book, 5000.0f)) {
-            // Stealth entry (Deception tactic)
-            float entry = SunTzu::stealthEntryPrice(book, true);
-            float stop_loss = entry * 0.95f; // 5% stop
-
-            // Risk-managed position sizing
-            double size = RiskManager::calculatePositionSize(
-                entry,
-                stop_loss,
-                RiskManager::getAccountBalance()
-            );
-
-            // Execute only if risk parameters allow
-            if (RiskManager::isTradeAllowed(0.01)) { // 1% risk
-                book.update(std::vector<OrderBook::Order>(updates.begin(), updates.end()));
-
-                if (raid_detector.detect_raid(updates, book.get_mid_price())) {
-                    std::cout << "⚡ RAID DETECTED! ENTERING AT " << entry << "\n";
-                    // TODO: Add execution logic with stealth orders
-                }
-            }
-        }
+//------------------------------------------------------------------
+// P I N N E D   F O R M A T I O N
+// feed -> book -> strategy on their own cores (see config/pipeline.json)
+//------------------------------------------------------------------
+struct LiquidBloodStrategy {
+    LiquidBloodPipeline pipeline;
+    WarChest& chest;
+
+    void on_book(const BookEvent& event) {
+        ScopeTimer<"strategy.on_book"> timer;
+        strike(pipeline.on_tick(TickFeatures{
+            .ts_ns = event.recv_ns,
+            .updates = {},
+            .book = event.book,
+            .update_volume = event.update_volume,
+            .update_count = event.update_count
+        }), pipeline, chest, event.recv_ns);
+    }
+};
+
+// The pipeline's own counters, mirrored into the metrics file once a second
+struct StageGauges {
+    Metrics::Gauge processed, depth, max_depth, stalls;
+
+    explicit StageGauges(const std::string& stage) {
+        Metrics::Registry& r = Metrics::global();
+        const std::string label = "{stage=\"" + stage + "\"}";
+        processed = r.gauge("ocean_stage_processed" + label, "Items the stage consumed");
+        depth = r.gauge("ocean_stage_queue_depth" + label, "Input ring occupancy");
+        max_depth = r.gauge("ocean_stage_queue_depth_max" + label, "Highest input ring occupancy");
+        stalls = r.gauge("ocean_stage_stalls" + label, "Pushes that found the output ring full");
     }
-    std::cout << "💀 Strategy terminated with honor\n";
+
+    void set(const StageMetrics& m) const noexcept {
+        processed.set(static_cast<int64_t>(m.processed.load(std::memory_order_relaxed)));
+        depth.set(static_cast<int64_t>(m.queue_depth.load(std::memory_order_relaxed)));
+        max_depth.set(static_cast<int64_t>(m.max_queue_depth.load(std::memory_order_relaxed)));
+        stalls.set(static_cast<int64_t>(m.stalls.load(std::memory_order_relaxed)));
+    }
+};
+
+static void report(const char* stage, const StageMetrics& m) {
+    std::cout << "  " << stage
+              << " processed=" << m.processed.load(std::memory_order_relaxed)
+              << " depth=" << m.queue_depth.load(std::memory_order_relaxed)
+              << " max_depth=" << m.max_queue_depth.load(std::memory_order_relaxed)
+              << " stalls=" << m.stalls.load(std::memory_order_relaxed) << "\n";
+}
+
+static int run_pinned(const PipelineConfig& cfg) {
+    MarketData market(cfg.endpoint, cfg.port);
+    OrderBook book;
+    TradeTape tape;
+    market.attach_trade_tape(tape);
+    HugePageArena strategy_memory(HugePageArena::Config{.name = "strategy"});
+    BarAggregator bars(kTimeframes, &strategy_memory);
+    WarChest chest;
+    LiquidBloodStrategy strategy{make_liquid_blood(bars, tape, chest), chest};
+
+    QuestDBLogger questdb(QuestDBLogger::Config{});
+    TimeLogger probes;
+    probes.add_sink(questdb);
+
+    TradingPipeline<LiquidBloodStrategy> pipeline(cfg, market, book, strategy);
+    std::signal(SIGINT, [](int) { global_blood_moon = true; });
+    pipeline.start();
+    std::cout << "🔥 Pinned formation online\n";
+
+    const StageGauges feed_gauges("feed"), book_gauges("book"), strategy_gauges("strategy");
+    while (!global_blood_moon) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        feed_gauges.set(pipeline.feed_metrics());
+        book_gauges.set(pipeline.book_metrics());
+        strategy_gauges.set(pipeline.strategy_metrics());
+        report("feed    ", pipeline.feed_metrics());
+        report("book    ", pipeline.book_metrics());
+        report("strategy", pipeline.strategy_metrics());
+        const HugePages::Totals memory = HugePages::totals();
+        std::cout << "  memory held=" << memory.bytes_held << " hugetlb=" << memory.hugetlb_bytes
+                  << " high_water=" << memory.high_water << "\n";
+    }
+
+    pipeline.stop();
+    market.stop();
+    std::cout << "🎋 Formation withdrawn\n";
+    return EXIT_SUCCESS;
+}
+
+//------------------------------------------------------------------
+// S I G N A L   T O W E R S
+// Feed and book run once here; strategy processes on this box read the
+// rings (or the PUB sockets) instead of dialing the exchange themselves
+//------------------------------------------------------------------
+static int run_publisher(const PipelineConfig& cfg) {
+    MarketData market(cfg.endpoint, cfg.port);
+    OrderBook book;
+
+    const auto fanout = [&](const char* kind, const std::string& zmq_endpoint) {
+        FanoutPublisher::Config out;
+        out.stream = cfg.fanout.stream + "." + kind;
+        out.ring_capacity = cfg.fanout.ring_capacity;
+        out.zmq_endpoint = zmq_endpoint;
+        out.max_lag = cfg.fanout.max_lag;
+        return out;
+    };
+    FanoutPublisher books(fanout("book", cfg.fanout.zmq_endpoint));
+    FanoutPublisher trades(fanout("trade", cfg.fanout.zmq_trade_endpoint));
+    // Prints are published from the feed thread, books from the strategy
+    // stage: one writer per ring
+    market.set_trade_handler([&trades](uint64_t ts_ns, float price, float amount, bool is_buy) {
+        trades.on_trade(ts_ns, price, amount, is_buy);
+    });
+
+    TradingPipeline<FanoutPublisher> pipeline(cfg, market, book, books);
+    std::signal(SIGINT, [](int) { global_blood_moon = true; });
+    pipeline.start();
+    std::cout << "🗼 Signal towers lit: " << books.ring_path() << ", " << trades.ring_path() << "\n";
+
+    const StageGauges feed_gauges("feed"), book_gauges("book"), strategy_gauges("publish");
+    while (!global_blood_moon) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        feed_gauges.set(pipeline.feed_metrics());
+        book_gauges.set(pipeline.book_metrics());
+        strategy_gauges.set(pipeline.strategy_metrics());
+        const std::size_t slow = books.check_readers() + trades.check_readers();
+        std::cout << "  published books=" << books.published() << " trades=" << trades.published()
+                  << " readers=" << books.readers().size() << " slow=" << slow << "\n";
+    }
+
+    pipeline.stop();
+    market.stop();
+    std::cout << "🎋 Towers dark\n";
+    return EXIT_SUCCESS;
 }
 
 //------------------------------------------------------------------
 // M A I N   W A R   R O O M
 //------------------------------------------------------------------
-int main() {
+int main(int argc, char** argv) {
+    if (!metrics_published) OCEAN_LOG_WARN("[METRICS] Not exported; OceanMetrics cannot see this process");
     try {
+        // OceanMain --publish <pipeline.json>: feed and book only, fanned out to local processes
+        if (argc > 2 && std::string_view(argv[1]) == "--publish") {
+            return run_publisher(load_pipeline_config(argv[2]));
+        }
+        // OceanMain <pipeline.json>: run the pinned thread layout instead
+        if (argc > 1) {
+            return run_pinned(load_pipeline_config(argv[1]));
+        }
 
-        net::io_context ioc;
         ssl::context ctx{ssl::context::tlsv12_client};
         ctx.set_default_verify_paths();
 
-        BinanceWSClient btc_client(ioc, ctx, "btcusdt");
-        btc_client.start();
+        // TLS and parsing spread over kIoThreads cores as symbols are added
+        IoContextPool io_pool(kIoThreads);
+        ConnectionManager connections(io_pool, ctx);
 
-        std::thread ioc_thread([&ioc]{
-            ioc.run();
-        });
-        // Access data in your main loop
-        while (true) {
-            auto& data = btc_client.get_market_data();
-            std::lock_guard<std::mutex> lock(data.mutex);
-            if (data.connected) {
+        TradeTape btc_tape;
+        ConnectionOptions btc_options;
+        btc_options.tape = &btc_tape;
+        connections.add("btcusdt", btc_options);
+        io_pool.start();
 
+        // Access data in your main loop, woken by each message
+        uint32_t seen = connections.notifier().sequence();
+        auto last_rebalance = std::chrono::steady_clock::now();
+        while (true) {
+            seen = connections.notifier().wait(seen, WaitPolicy::SpinThenFutex, std::chrono::seconds(1));
 
+            connections.with_client("btcusdt", [&](BinanceWSClient& client) {
+                auto& data = client.get_market_data();
+                std::lock_guard<std::mutex> lock(data.mutex);
+                if (data.connected) {
+                    std::cout << "BTC/USDT - Bid: " << data.bid
+                              << " | Ask: " << data.ask
+                              << " | VWAP30s: " << btc_tape.last(std::chrono::seconds(30)).vwap
+                              << " | TS: " << data.timestamp << '\n';
+                } else {
+                    std::cout << "Disconnected\n";
+                }
+            });
 
-                std::cout << "BTC/USDT - Bid: " << data.bid
-                          << " | Ask: " << data.ask
-                          << " | TS: " << data.timestamp << '\n';
-            } else {
-                std::cout << "Disconnected\n";
+            if (std::chrono::steady_clock::now() - last_rebalance > kRebalanceInterval) {
+                connections.rebalance();
+                last_rebalance = std::chrono::steady_clock::now();
             }
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
 
-        ioc_thread.join();
+        io_pool.stop();
         // Sun Tzu Principle: "Preparation determines victory"
         MarketData market("127.0.0.1", 1337);
         OrderBook book;
-        MarketPhaseDetector phase_detector;
+        TradeTape tape;
+        market.attach_trade_tape(tape);
+        HugePageArena strategy_memory(HugePageArena::Config{.name = "strategy"});
+        BarAggregator bars(kTimeframes, &strategy_memory);
+        WarChest chest;
+
+        // Tick latency percentiles, shipped once a second
+        QuestDBLogger questdb(QuestDBLogger::Config{});
+        TimeLogger probes;
+        probes.add_sink(questdb);
 
         if (!market.start()) {
             throw std::runtime_error("Market data connection failed");
@@ -115,7 +377,7 @@ int main() {
         // Sun Tzu Principle: "Divide your forces wisely"
         std::vector<std::jthread> strategies;
         strategies.emplace_back([&] {
-            liquid_blood(market, book, phase_detector);
+            liquid_blood(market, book, bars, tape, chest);
         });
 
         std::cout << "🔥 Trading system online (Sun Tzu protocol engaged)\n";
@@ -125,20 +387,13 @@ int main() {
             std::cout << "\n忍 (Enduring the retreat)\n";
             global_blood_moon = true;
         });
-        double initialDailyBalance = 300;/* your initial daily balance */;
-        double currentBalance = 350/* your current balance */;
-        // Emergency stop conditions
+        // The strategy checks the loss limit on every tick; this only reports
         while (!global_blood_moon) {
-
-            double initialDailyBalance = 300;/* your initial daily balance */;
-            double currentBalance = 350/* your current balance */;
-
-            if (RiskManager::shouldStopTrading(RiskManager::getDailyLossPercent(initialDailyBalance, currentBalance))) {
-                std::cerr << "⚔️ Daily loss limit reached! Withdrawing!\n";
-                break;
-            }
-
             std::this_thread::sleep_for(std::chrono::seconds(1));
+            const PnlEngine::Totals t = chest.pnl.totals();
+            std::cout << "💰 Equity " << t.equity << " | Realized " << t.realized
+                      << " | Unrealized " << t.unrealized << " | Gross " << t.grossExposure
+                      << " | Drawdown " << t.drawdown * 100.0 << "%\n";
         }
 
         // Graceful shutdown
@@ -155,12 +410,13 @@ int main() {
 
 // BinanceClient client("BTCUSDT");
 // if (client.start()) {
+//     uint32_t seen = client.notifier().sequence();
 //     while (true) {
+//         seen = client.notifier().wait(seen, WaitPolicy::SpinThenFutex);
 //         auto updates = client.get_updates();
 //         if (!updates.empty()) {
-//             // Process updates
+//             book.apply_snapshot(updates);   // Absolute depth20 levels
 //         }
-//         std::this_thread::sleep_for(std::chrono::milliseconds(100));
 //     }
 // }
 // client.stop();
\ No newline at end of file
@@ -3,70 +3,72 @@
 //
 #include "gtest/gtest.h"
 #include "Clients/BinanceClient.hpp"
-#include <atomic>
+#include "Sim/ExchangeSimulator.hpp"
+#include <array>
+#include <chrono>
+#include <functional>
 #include <thread>
 
-// Mock WebSocket Server for Testing
-class MockWebSocketServer {
-public:
-    void start() {
-        server_thread_ = std::thread([this] {
-            mock_running_ = true;
-            while (mock_running_) {
-                // Simulate periodic WebSocket messages
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                if (mock_running_) {
-                    std::lock_guard<std::mutex> lock(mutex_);
-                    messages_.push_back("{\"e\":\"trade\",\"s\":\"BTCUSDT\",\"p\":\"25000.00\"}");
-                    message_count_++;
-                }
-            }
-        });
-    }
-
-    void stop() {
-        mock_running_ = false;
-        if (server_thread_.joinable()) server_thread_.join();
-    }
-
-    void sendMockMessage(const std::string& message) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        messages_.push_back(message);
-        message_count_++;
-    }
+namespace {
+// depth20 from the simulator: 20 bids, then 20 asks
+constexpr std::size_t kSnapshot = 40;
 
-    std::vector<std::string> getMessages() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return messages_;
+bool wait_until(const std::function<bool()>& done, std::chrono::seconds limit = std::chrono::seconds(10)) {
+    const auto deadline = std::chrono::steady_clock::now() + limit;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (done()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+    return done();
+}
 
-    size_t getMessageCount() const {
-        std::lock_guard<std::mutex> lock(mutex_);  // Now works!
-        return message_count_;
+bool is_whole_snapshot(std::span<const OrderBook::Order> levels) {
+    if (levels.size() != kSnapshot) return false;
+    for (std::size_t i = 0; i < levels.size(); ++i) {
+        if (levels[i].is_bid != (i < kSnapshot / 2)) return false;
     }
+    return levels.front().price < levels[kSnapshot / 2].price;   // Best bid under best ask
+}
+}
 
-    std::atomic<bool> mock_running_{false};
-private:
-    std::thread server_thread_;
-    std::vector<std::string> messages_;
-    size_t message_count_ = 0;
-    mutable std::mutex mutex_;  // Key fix
-};
-
+// Every client runs against the exchange simulator's TLS WebSocket on loopback
 class BinanceClientTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        server_.start();
-        client_ = std::make_unique<BinanceClient>("BTCUSDT");
+        ExchangeSimulator::Config cfg;
+        cfg.serve_binary = false;
+        cfg.ws_port = 0;
+        cfg.rate = 200.0;
+        sim_ = std::make_unique<ExchangeSimulator>(cfg);
+        sim_->start();
+
+        client_ = connect("BTCUSDT");
         ASSERT_TRUE(client_->start()) << "Failed to start client connection";
     }
 
     void TearDown() override {
-        server_.stop();
         client_->stop();
+        sim_->stop();
     }
 
-    MockWebSocketServer server_;
+    std::unique_ptr<BinanceClient> connect(const std::string& symbol) const {
+        auto client = std::make_unique<BinanceClient>(symbol);
+        client->set_endpoint("127.0.0.1", std::to_string(sim_->ws_port()));
+        return client;
+    }
+
+    // Drains until a snapshot comes out; empty on timeout
+    static std::vector<OrderBook::Order> next_snapshot(BinanceClient& client) {
+        std::vector<OrderBook::Order> got;
+        wait_until([&] {
+            const auto levels = client.get_updates();
+            got.assign(levels.begin(), levels.end());
+            return !got.empty();
+        });
+        return got;
+    }
+
+    std::unique_ptr<ExchangeSimulator> sim_;
     std::unique_ptr<BinanceClient> client_;
 };
 
@@ -74,44 +76,35 @@ protected:
 // TEST CASES
 //------------------------------------------------------------------
 TEST_F(BinanceClientTest, StartsConnection) {
-    EXPECT_TRUE(server_.mock_running_);
-    EXPECT_EQ(0, server_.getMessageCount());
+    EXPECT_TRUE(wait_until([&] { return sim_->stats().sessions_live.load() == 1; }));
+    EXPECT_FALSE(next_snapshot(*client_).empty());
 }
 
 TEST_F(BinanceClientTest, StopsGracefully) {
+    ASSERT_FALSE(next_snapshot(*client_).empty());
     client_->stop();
-    EXPECT_FALSE(server_.mock_running_);
-    EXPECT_EQ(0, server_.getMessageCount());
+
+    // Whatever was queued before the stop comes out once, then nothing
+    std::array<OrderBook::Order, kSnapshot> levels{};
+    client_->drain(levels);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(client_->drain(levels), 0u);
+    EXPECT_TRUE(wait_until([&] { return sim_->stats().sessions_live.load() == 0; }));
 }
 
 TEST_F(BinanceClientTest, ReceivesMarketData) {
-    const std::string mockTrade = "{\"e\":\"trade\",\"s\":\"BTCUSDT\",\"p\":\"25000.00\"}";
-    server_.sendMockMessage(mockTrade);
-    
-    // Wait for message processing
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
-    EXPECT_EQ(1, server_.getMessageCount());
-   // EXPECT_TRUE(client_->isConnected());
-    
-    // Verify trade data
-   // double lastPrice = client_->getLastPrice();
-   // EXPECT_EQ(25000.00, lastPrice);
+    const auto levels = next_snapshot(*client_);
+    EXPECT_TRUE(is_whole_snapshot(levels));
 }
 
 TEST_F(BinanceClientTest, HandlesDisconnect) {
-    // Simulate network disconnection
-    server_.stop();
-    
-    // Wait for reconnection attempt
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-    
-  //  EXPECT_FALSE(client_->isConnected());
-    
-    // Restart server and verify reconnection
-    server_.start();
-    std::this_thread::sleep_for(std::chrono::milliseconds(500));
-  //  EXPECT_TRUE(client_->isConnected());
+    ASSERT_FALSE(next_snapshot(*client_).empty());
+
+    sim_->inject_disconnect();
+    ASSERT_TRUE(wait_until([&] { return sim_->stats().sessions_opened.load() == 2; }));
+    client_->get_updates();   // Anything from before the drop
+
+    EXPECT_TRUE(is_whole_snapshot(next_snapshot(*client_)));
 }
 
 TEST_F(BinanceClientTest, HandlesInvalidSymbol) {
@@ -120,22 +113,52 @@ TEST_F(BinanceClientTest, HandlesInvalidSymbol) {
 }
 
 TEST_F(BinanceClientTest, HandlesMultipleSymbols) {
-    MockWebSocketServer server;
-    server.start();
-    
-    BinanceClient btcClient("BTCUSDT");
-    BinanceClient ethClient("ETHUSDT");
-    
-    EXPECT_TRUE(btcClient.start());
-    EXPECT_TRUE(ethClient.start());
-    
-    server.sendMockMessage("{\"e\":\"trade\",\"s\":\"BTCUSDT\",\"p\":\"25000.00\"}");
-    server.sendMockMessage("{\"e\":\"trade\",\"s\":\"ETHUSDT\",\"p\":\"1800.00\"}");
-    
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
- //   EXPECT_EQ(25000.00, btcClient.getLastPrice());
-   // EXPECT_EQ(1800.00, ethClient.getLastPrice());
-    
-    server.stop();
-}
\ No newline at end of file
+    auto ethClient = connect("ETHUSDT");
+    ASSERT_TRUE(ethClient->start());
+
+    EXPECT_TRUE(is_whole_snapshot(next_snapshot(*client_)));
+    EXPECT_TRUE(is_whole_snapshot(next_snapshot(*ethClient)));
+    EXPECT_EQ(sim_->stats().sessions_opened.load(), 2u);
+
+    ethClient->stop();
+}
+
+TEST_F(BinanceClientTest, OnlyWholeSnapshotsComeOut) {
+    for (int i = 0; i < 50; ++i) {
+        const auto levels = next_snapshot(*client_);
+        ASSERT_TRUE(is_whole_snapshot(levels)) << "drain " << i << " gave " << levels.size() << " levels";
+    }
+}
+
+TEST_F(BinanceClientTest, CountsDropsWhileTheConsumerStalls) {
+    // 25 snapshots fill the level queue; nothing drains until the drops show
+    sim_->set_rate(5000.0);
+    ASSERT_TRUE(wait_until([&] { return client_->dropped() > 0; }));
+    client_->stop();
+
+    // Dropped frames never leave half a snapshot behind: the newest queued one comes out whole
+    std::array<OrderBook::Order, BinanceClient::kQueueCapacity> levels{};
+    const std::size_t n = client_->drain(levels);
+    EXPECT_TRUE(is_whole_snapshot(std::span<const OrderBook::Order>(levels.data(), n)));
+    EXPECT_EQ(client_->drain(levels), 0u);
+}
+
+TEST_F(BinanceClientTest, DrainsIntoCallerBuffer) {
+    const uint32_t seen = client_->notifier().sequence();
+    ASSERT_TRUE(wait_until([&] { return client_->notifier().sequence() - seen >= 3; }));
+    client_->stop();
+
+    // A short buffer takes the head of the newest snapshot: its best bids
+    std::array<OrderBook::Order, 8> levels{};
+    ASSERT_EQ(client_->drain(levels), levels.size());
+    for (const auto& level : levels) EXPECT_TRUE(level.is_bid);
+    EXPECT_GT(levels[0].price, levels[7].price);
+
+    // The cut-off tail is discarded, not replayed
+    EXPECT_EQ(client_->drain(levels), 0u);
+    EXPECT_TRUE(client_->get_updates().empty());
+}
+
+TEST_F(BinanceClientTest, RejectsDoubleStart) {
+    EXPECT_FALSE(client_->start());
+}
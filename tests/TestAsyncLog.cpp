@@ -0,0 +1,149 @@
+#include "Utils/AsyncLog.hpp"
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// "2026-01-02 03:04:05.678901 WARN  " is 33 characters
+constexpr std::size_t kPrefix = 33;
+
+struct Captured {
+    std::mutex mutex;
+    std::vector<std::pair<LogLevel, std::string>> lines;
+
+    std::vector<std::string> messages(std::string_view containing = {}) {
+        std::lock_guard lock(mutex);
+        std::vector<std::string> out;
+        for (const auto& [level, line] : lines) {
+            if (line.find(containing) != std::string::npos) out.push_back(line.substr(kPrefix));
+        }
+        return out;
+    }
+};
+
+class AsyncLogTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        AsyncLog::flush();   // Leftovers from an earlier test go to the old sink
+        AsyncLog::Config cfg;
+        cfg.min_level = LogLevel::Debug;
+        cfg.sink = [this](LogLevel level, std::string_view line) {
+            std::lock_guard lock(captured.mutex);
+            captured.lines.emplace_back(level, line);
+        };
+        AsyncLog::configure(std::move(cfg));
+    }
+
+    void TearDown() override {
+        AsyncLog::flush();
+        AsyncLog::configure({});
+    }
+
+    Captured captured;
+};
+}
+
+TEST_F(AsyncLogTest, FormatsArgumentsOnTheBackend) {
+    const std::string symbol = "btcusdt";
+    OCEAN_LOG_WARN("[TEST FORMAT] {} depth={} px={:.2f} ok={} tag={}", symbol, 20, 101.256, true, "raw");
+    AsyncLog::flush();
+
+    const auto lines = captured.messages("[TEST FORMAT]");
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0], "[TEST FORMAT] btcusdt depth=20 px=101.26 ok=true tag=raw");
+    std::lock_guard lock(captured.mutex);
+    EXPECT_EQ(captured.lines.back().first, LogLevel::Warn);
+    EXPECT_EQ(captured.lines.back().second.substr(27, 6), "WARN  ");
+}
+
+TEST_F(AsyncLogTest, LevelsBelowTheMinimumAreSkipped) {
+    AsyncLog::Config cfg;
+    cfg.min_level = LogLevel::Info;
+    cfg.sink = [this](LogLevel level, std::string_view line) {
+        std::lock_guard lock(captured.mutex);
+        captured.lines.emplace_back(level, line);
+    };
+    AsyncLog::configure(std::move(cfg));
+
+    OCEAN_LOG_DEBUG("[TEST LEVEL] hidden");
+    OCEAN_LOG_INFO("[TEST LEVEL] shown");
+    AsyncLog::flush();
+    EXPECT_EQ(captured.messages("[TEST LEVEL]"), std::vector<std::string>{"[TEST LEVEL] shown"});
+}
+
+TEST_F(AsyncLogTest, RateLimitIsPerCallSite) {
+    for (int i = 0; i < 1000; ++i) {
+        OCEAN_LOG_RATE(LogLevel::Error, 10, "[TEST STORM] frame {}", i);
+        OCEAN_LOG_RATE(LogLevel::Info, 0, "[TEST QUIET] frame {}", i);
+    }
+    AsyncLog::flush();
+
+    // A second boundary inside the loop lets one more batch through
+    EXPECT_LE(captured.messages("[TEST STORM]").size(), 20u);
+    EXPECT_EQ(captured.messages("[TEST QUIET]").size(), 1000u);
+}
+
+TEST_F(AsyncLogTest, SuppressedCountRidesOnTheNextLine) {
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 5; ++i) {
+            OCEAN_LOG_RATE(LogLevel::Warn, 1, "[TEST SUPPRESS] round {}", round);
+        }
+        if (round == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    }
+    AsyncLog::flush();
+
+    const auto lines = captured.messages("[TEST SUPPRESS]");
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], "[TEST SUPPRESS] round 0");
+    EXPECT_EQ(lines[1], "[TEST SUPPRESS] round 1 (4 suppressed)");
+}
+
+TEST_F(AsyncLogTest, ThreadsKeepTheirOwnOrder) {
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([t] {
+                for (int i = 0; i < kPerThread; ++i) OCEAN_LOG_RATE(LogLevel::Info, 0, "[TEST THREAD] {} {}", t, i);
+            });
+        }
+    }
+    AsyncLog::flush();
+
+    std::vector<int> next(kThreads, 0);
+    for (const std::string& line : captured.messages("[TEST THREAD]")) {
+        int t = 0, i = 0;
+        ASSERT_EQ(std::sscanf(line.c_str(), "[TEST THREAD] %d %d", &t, &i), 2);
+        EXPECT_EQ(i, next[t]) << line;
+        next[t] = i + 1;
+    }
+    for (int t = 0; t < kThreads; ++t) EXPECT_EQ(next[t], kPerThread);
+}
+
+TEST_F(AsyncLogTest, FullRingDropsInsteadOfBlocking) {
+    AsyncLog::Config cfg;
+    cfg.min_level = LogLevel::Debug;
+    cfg.ring_bytes = 4096;
+    cfg.idle_sleep = std::chrono::milliseconds(50);
+    cfg.sink = [this](LogLevel level, std::string_view line) {
+        std::lock_guard lock(captured.mutex);
+        captured.lines.emplace_back(level, line);
+    };
+    AsyncLog::configure(std::move(cfg));
+
+    constexpr int kRecords = 10'000;
+    const uint64_t dropped_before = AsyncLog::stats().dropped;
+    std::jthread([] {   // A fresh thread gets the small ring
+        for (int i = 0; i < kRecords; ++i) OCEAN_LOG_RATE(LogLevel::Info, 0, "[TEST FULL] {}", i);
+    }).join();
+    AsyncLog::flush();
+
+    const uint64_t dropped = AsyncLog::stats().dropped - dropped_before;
+    EXPECT_EQ(captured.messages("[TEST FULL]").size() + dropped, static_cast<std::size_t>(kRecords));
+    EXPECT_GT(dropped, 0u);
+    EXPECT_FALSE(captured.messages("[ASYNC LOG]").empty());
+}
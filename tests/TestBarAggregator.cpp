@@ -0,0 +1,77 @@
+#include "Analysis/BarAggregator.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+constexpr uint64_t kSec = 1'000'000'000ULL;
+
+const std::array<BarAggregator::Timeframe, 2> kFrames{{
+    {.period = 1s, .history = 8},
+    {.period = 5s, .history = 8},
+}};
+} // namespace
+
+TEST(BarAggregatorTest, BuildsOhlcvPerTimeframe) {
+    BarAggregator bars(kFrames);
+
+    bars.on_trade(0 * kSec + 1, 100.0f, 1.0f);
+    bars.on_trade(0 * kSec + 2, 103.0f, 2.0f);
+    bars.on_quote(0 * kSec + 3, 99.0f);
+    bars.on_trade(0 * kSec + 4, 101.0f, 1.5f);
+    bars.on_trade(1 * kSec, 102.0f, 1.0f); // Closes the first 1s bar
+
+    const Bar* second = bars.closed(0);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second->start_ns, 0u);
+    EXPECT_FLOAT_EQ(second->open, 100.0f);
+    EXPECT_FLOAT_EQ(second->high, 103.0f);
+    EXPECT_FLOAT_EQ(second->low, 99.0f);
+    EXPECT_FLOAT_EQ(second->close, 101.0f);
+    EXPECT_FLOAT_EQ(second->volume, 4.5f);
+    EXPECT_EQ(second->trade_count, 3u);
+
+    // 5s bar is still open and has seen every tick
+    EXPECT_EQ(bars.closed(1), nullptr);
+    ASSERT_NE(bars.current(1), nullptr);
+    EXPECT_FLOAT_EQ(bars.current(1)->volume, 5.5f);
+}
+
+TEST(BarAggregatorTest, PublishesClosedBarsAndSkipsGaps) {
+    BarAggregator bars(kFrames);
+    std::vector<std::pair<std::size_t, uint64_t>> published;
+    bars.subscribe([&](std::size_t tf, const Bar& bar) {
+        published.emplace_back(tf, bar.start_ns);
+    });
+
+    bars.on_trade(0 * kSec, 100.0f, 1.0f);
+    bars.on_trade(1 * kSec, 100.0f, 1.0f);
+    bars.on_trade(7 * kSec, 100.0f, 1.0f); // 2s..6s are empty
+
+    const std::vector<std::pair<std::size_t, uint64_t>> expected{
+        {0, 0}, {0, 1 * kSec}, {1, 0}
+    };
+    EXPECT_EQ(published, expected);
+
+    ASSERT_NE(bars.closed(0, 0), nullptr);
+    EXPECT_EQ(bars.closed(0, 0)->start_ns, 1 * kSec);
+    ASSERT_NE(bars.closed(0, 1), nullptr);
+    EXPECT_EQ(bars.closed(0, 1)->start_ns, 0u);
+    EXPECT_EQ(bars.closed(0, 2), nullptr);
+}
+
+TEST(BarAggregatorTest, PhaseRunsOncePerBar) {
+    BarAggregator bars(kFrames);
+
+    // Thousands of ticks per second still give one phase sample per bar
+    for (uint64_t s = 0; s < 40; ++s) {
+        for (uint64_t t = 0; t < 1000; ++t) {
+            bars.on_quote(s * kSec + t * 1000, 100.0f + s + t * 1e-4f);
+        }
+    }
+    EXPECT_EQ(bars.phase(0), SunTzu::MarketPhase::TRENDING);
+    EXPECT_EQ(bars.phase(1), SunTzu::MarketPhase::RANGING); // Too few 5s bars yet
+}
@@ -0,0 +1,87 @@
+#include "Clients/BinanceStreamDirectory.hpp"
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "Core/OrderBook.hpp"
+
+namespace {
+constexpr const char* kSuffix = "@depth20@100ms";
+}
+
+TEST(BinanceStreamDirectoryTest, AssignsDenseIdsAndRoutesByStreamName) {
+    BinanceStreamDirectory dir(kSuffix);
+    OrderBook btc, eth;
+
+    const auto a = dir.add("BTCUSDT", btc);
+    const auto b = dir.add("ethusdt", eth);
+    ASSERT_TRUE(a && b);
+    EXPECT_EQ(a->id, 0u);
+    EXPECT_EQ(b->id, 1u);
+    EXPECT_TRUE(a->new_shard);
+    EXPECT_FALSE(b->new_shard);
+
+    EXPECT_EQ(dir.find("btcusdt@depth20@100ms"), a->id);
+    EXPECT_EQ(dir.book(dir.find("ethusdt@depth20@100ms")), &eth);
+    EXPECT_EQ(dir.find("solusdt@depth20@100ms"), BinanceStreamDirectory::kNoSymbol);
+    EXPECT_EQ(dir.symbol(a->id), "btcusdt");
+
+    EXPECT_FALSE(dir.add("btcusdt", btc)) << "duplicate subscription";
+}
+
+TEST(BinanceStreamDirectoryTest, ShardsAtTheStreamLimitAndRefillsFreedSlots) {
+    BinanceStreamDirectory dir(kSuffix, 3);
+    std::deque<OrderBook> books(7);
+
+    std::vector<std::size_t> shards;
+    for (int i = 0; i < 7; ++i) {
+        shards.push_back(dir.add("sym" + std::to_string(i) + "usdt", books[i])->shard);
+    }
+    EXPECT_EQ(shards, (std::vector<std::size_t>{0, 0, 0, 1, 1, 1, 2}));
+    EXPECT_EQ(dir.shards(), 3u);
+    EXPECT_EQ(dir.streams(1).size(), 3u);
+
+    const auto gone = dir.remove("SYM1USDT");
+    ASSERT_TRUE(gone);
+    EXPECT_EQ(gone->shard, 0u);
+    EXPECT_EQ(dir.find("sym1usdt@depth20@100ms"), BinanceStreamDirectory::kNoSymbol);
+    EXPECT_EQ(dir.book(gone->id), nullptr);
+    EXPECT_FALSE(dir.remove("sym1usdt"));
+
+    // The freed id and the gap on shard 0 are reused before anything grows
+    OrderBook extra;
+    const auto back = dir.add("newusdt", extra);
+    EXPECT_EQ(back->id, gone->id);
+    EXPECT_EQ(back->shard, 0u);
+    EXPECT_FALSE(back->new_shard);
+    EXPECT_EQ(dir.shards(), 3u);
+    EXPECT_EQ(dir.size(), 7u);
+}
+
+TEST(BinanceStreamDirectoryTest, ExtractsStreamNameWithoutParsing) {
+    EXPECT_EQ(BinanceStreamDirectory::stream_name(
+                  R"({"stream":"btcusdt@depth20@100ms","data":{"lastUpdateId":1,"bids":[],"asks":[]}})"),
+              "btcusdt@depth20@100ms");
+    EXPECT_TRUE(BinanceStreamDirectory::stream_name(R"({"result":null,"id":3})").empty());
+    EXPECT_TRUE(BinanceStreamDirectory::stream_name(R"({"stream":"trunc)").empty());
+}
+
+TEST(BinanceStreamDirectoryTest, PathStopsAtLengthLimit) {
+    const std::vector<std::string> streams{"aaausdt@depth", "bbbusdt@depth", "cccusdt@depth"};
+
+    const auto [all, n_all] = BinanceStreamDirectory::combined_path(streams, 1024);
+    EXPECT_EQ(all, "/stream?streams=aaausdt@depth/bbbusdt@depth/cccusdt@depth");
+    EXPECT_EQ(n_all, 3u);
+
+    const auto [some, n_some] = BinanceStreamDirectory::combined_path(streams, 45);
+    EXPECT_EQ(some, "/stream?streams=aaausdt@depth/bbbusdt@depth");
+    EXPECT_EQ(n_some, 2u);
+}
+
+TEST(BinanceStreamDirectoryTest, BuildsControlFrames) {
+    const std::vector<std::string> streams{"btcusdt@depth20@100ms", "ethusdt@depth20@100ms"};
+    EXPECT_EQ(BinanceStreamDirectory::control_frame("SUBSCRIBE", streams, 7),
+              R"({"method":"SUBSCRIBE","params":["btcusdt@depth20@100ms","ethusdt@depth20@100ms"],"id":7})");
+}
@@ -0,0 +1,199 @@
+#include "Clients/BinanceStreamMux.hpp"
+#include "Sim/ExchangeSimulator.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace {
+struct SymbolSeen {
+    int frames = 0;
+    float bid_volume = 0.0f;   // Of the last snapshot routed here
+};
+}
+
+// Real shards, sockets and routing against the simulator's combined-stream
+// endpoint: two symbols in the handshake path, a third by SUBSCRIBE
+TEST(BinanceStreamMuxTest, RoutesCombinedStreamsIntoTheirBooks) {
+    ExchangeSimulator::Config sim_cfg;
+    sim_cfg.serve_binary = false;
+    sim_cfg.ws_port = 0;
+    sim_cfg.rate = 300.0;
+    ExchangeSimulator sim(sim_cfg);
+    sim.start();
+
+    net::io_context ioc;
+    ssl::context ctx(ssl::context::tlsv12_client);   // No peer verification
+    BinanceStreamMux::Config cfg;
+    cfg.host = "127.0.0.1";
+    cfg.port = std::to_string(sim.ws_port());
+    BinanceStreamMux mux(ioc, ctx, cfg);
+
+    std::array<OrderBook, 3> books;
+    std::array<SymbolSeen, 3> seen{};
+    const auto btc = mux.subscribe("btcusdt", books[0]);
+    const auto eth = mux.subscribe("ethusdt", books[1]);
+    mux.on_depth([&](BinanceStreamMux::SymbolId id, std::span<const OrderBook::Order> levels) {
+        ASSERT_LT(id, seen.size());
+        ++seen[id].frames;
+        seen[id].bid_volume = 0.0f;
+        for (const auto& level : levels) {
+            if (level.is_bid) seen[id].bid_volume += level.amount;
+        }
+    });
+    mux.start();
+
+    const auto run_until = [&](const std::function<bool()>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            ioc.run_for(std::chrono::milliseconds(10));
+        }
+        return done();
+    };
+    ASSERT_TRUE(run_until([&] { return seen[btc].frames >= 20 && seen[eth].frames >= 20; }));
+
+    const auto sol = mux.subscribe("solusdt", books[2]);
+    ASSERT_TRUE(run_until([&] { return seen[sol].frames >= 20; }));
+    EXPECT_EQ(mux.connections(), 1u);
+    EXPECT_EQ(mux.symbols(), 3u);
+
+    // Each book holds exactly its last snapshot: no growth, never crossed
+    for (const auto id : {btc, eth, sol}) {
+        const auto [bid, ask] = books[id].get_bbo();
+        EXPECT_GT(bid, 0.0f);
+        EXPECT_LT(bid, ask);
+        EXPECT_NEAR(books[id].total_bid_volume(), seen[id].bid_volume, 1e-3f * seen[id].bid_volume);
+    }
+
+    mux.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+}
+
+// unsubscribe() and then destroying the book while its frames are still
+// flowing: no frame may reach the book or the handler once it returned
+TEST(BinanceStreamMuxTest, BookCanBeDestroyedOnceUnsubscribeReturns) {
+    ExchangeSimulator::Config sim_cfg;
+    sim_cfg.serve_binary = false;
+    sim_cfg.ws_port = 0;
+    sim_cfg.rate = 4000.0;
+    ExchangeSimulator sim(sim_cfg);
+    sim.start();
+
+    net::io_context ioc;
+    auto work = net::make_work_guard(ioc);
+    ssl::context ctx(ssl::context::tlsv12_client);
+    BinanceStreamMux::Config cfg;
+    cfg.host = "127.0.0.1";
+    cfg.port = std::to_string(sim.ws_port());
+    BinanceStreamMux mux(ioc, ctx, cfg);
+
+    constexpr std::size_t kSymbols = 8;
+    const std::array<std::string, kSymbols> symbols{
+        "btcusdt", "ethusdt", "solusdt", "bnbusdt", "xrpusdt", "adausdt", "dogeusdt", "trxusdt"};
+    std::array<std::unique_ptr<OrderBook>, kSymbols> books;
+    std::array<BinanceStreamMux::SymbolId, kSymbols> ids{};
+    std::array<std::atomic<bool>, kSymbols> live{};
+    std::array<std::atomic<int>, kSymbols> frames{};
+    std::atomic<int> late{0};
+    // The handler parks on this symbol's next frame, so unsubscribe() races a live route
+    std::atomic<BinanceStreamMux::SymbolId> target{BinanceStreamMux::kNoSymbol};
+    std::atomic<bool> parked{false};
+
+    for (std::size_t i = 0; i < kSymbols; ++i) {
+        books[i] = std::make_unique<OrderBook>();
+        ids[i] = mux.subscribe(symbols[i], *books[i]);
+        ASSERT_EQ(ids[i], i);
+        live[i] = true;
+    }
+    mux.on_depth([&](BinanceStreamMux::SymbolId id, std::span<const OrderBook::Order>) {
+        if (id == target.load() && !parked.exchange(true)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        if (!live[id].load()) late.fetch_add(1);
+        frames[id].fetch_add(1);
+    });
+    mux.start();
+    std::thread io([&] { ioc.run(); });
+
+    const auto wait_until = [](const std::function<bool()>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return done();
+    };
+
+    for (std::size_t i = 0; i < kSymbols; ++i) {
+        const int seen = frames[i].load();
+        ASSERT_TRUE(wait_until([&] { return frames[i].load() >= seen + 5; })) << symbols[i];
+
+        parked = false;
+        target = ids[i];
+        ASSERT_TRUE(wait_until([&] { return parked.load(); })) << symbols[i];
+        ASSERT_TRUE(mux.unsubscribe(symbols[i]));
+        live[i] = false;
+        books[i].reset();
+    }
+    // Let whatever was already in flight for the dropped streams arrive
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(late.load(), 0);
+
+    mux.stop();
+    work.reset();
+    io.join();
+    sim.stop();
+}
+
+// A shard whose last symbol goes away hangs up, and dials again for the next
+TEST(BinanceStreamMuxTest, ShardClosesOnceItRoutesNothing) {
+    ExchangeSimulator::Config sim_cfg;
+    sim_cfg.serve_binary = false;
+    sim_cfg.ws_port = 0;
+    sim_cfg.rate = 300.0;
+    ExchangeSimulator sim(sim_cfg);
+    sim.start();
+
+    net::io_context ioc;
+    // A parked shard leaves the context with no work, which would stop it
+    auto work = net::make_work_guard(ioc);
+    ssl::context ctx(ssl::context::tlsv12_client);
+    BinanceStreamMux::Config cfg;
+    cfg.host = "127.0.0.1";
+    cfg.port = std::to_string(sim.ws_port());
+    BinanceStreamMux mux(ioc, ctx, cfg);
+
+    std::array<OrderBook, 2> books;
+    std::array<int, 2> frames{};
+    mux.on_depth([&](BinanceStreamMux::SymbolId id, std::span<const OrderBook::Order>) { ++frames[id]; });
+    const auto btc = mux.subscribe("btcusdt", books[0]);
+    mux.start();
+
+    const auto run_until = [&](const std::function<bool()>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            ioc.run_for(std::chrono::milliseconds(10));
+        }
+        return done();
+    };
+    ASSERT_TRUE(run_until([&] { return frames[btc] >= 5; }));
+    EXPECT_EQ(sim.stats().sessions_live.load(), 1u);
+
+    ASSERT_TRUE(mux.unsubscribe("btcusdt"));
+    EXPECT_TRUE(run_until([&] { return sim.stats().sessions_live.load() == 0; }));
+
+    frames = {};   // The id is handed out again
+    const auto eth = mux.subscribe("ethusdt", books[1]);
+    ASSERT_TRUE(run_until([&] { return frames[eth] >= 5; }));
+    EXPECT_EQ(sim.stats().sessions_opened.load(), 2u);
+    EXPECT_EQ(sim.stats().sessions_live.load(), 1u);
+
+    mux.stop();
+    work.reset();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+}
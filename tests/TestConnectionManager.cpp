@@ -0,0 +1,175 @@
+#include "Clients/ConnectionManager.hpp"
+#include "Sim/ExchangeSimulator.hpp"
+#include "Utils/Metrics.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+TEST(ConnectionManagerTest, BalancedContextsStayPut) {
+    const std::vector<double> weights{10, 10, 12, 9};
+    const std::vector<std::size_t> placement{0, 0, 1, 1};
+    EXPECT_FALSE(ConnectionManager::plan_move(weights, placement, 2));
+}
+
+TEST(ConnectionManagerTest, MovesTheConnectionThatEvensTheSplit) {
+    // Context 0 carries 100, context 1 carries 10: moving the 50 leaves 50/60
+    const std::vector<double> weights{50, 35, 15, 10};
+    const std::vector<std::size_t> placement{0, 0, 0, 1};
+    const auto move = ConnectionManager::plan_move(weights, placement, 2);
+    ASSERT_TRUE(move);
+    EXPECT_EQ(move->connection, 0u);
+    EXPECT_EQ(move->from, 0u);
+    EXPECT_EQ(move->to, 1u);
+}
+
+TEST(ConnectionManagerTest, NeverMovesALoneHotConnection) {
+    // Moving the only stream on a hot context just swaps which one is hot
+    const std::vector<double> weights{100, 1, 1};
+    const std::vector<std::size_t> placement{0, 1, 2};
+    EXPECT_FALSE(ConnectionManager::plan_move(weights, placement, 3));
+}
+
+TEST(ConnectionManagerTest, FillsAnEmptyContext) {
+    const std::vector<double> weights{1, 1, 1, 1};
+    const std::vector<std::size_t> placement{0, 0, 0, 0};
+    const auto move = ConnectionManager::plan_move(weights, placement, 2);
+    ASSERT_TRUE(move);
+    EXPECT_EQ(move->to, 1u);
+}
+
+TEST(ConnectionManagerTest, SpreadsNewConnectionsAcrossContexts) {
+    IoContextPool pool(2);
+    ssl::context ctx{ssl::context::tlsv12_client};
+    ConnectionManager manager(pool, ctx);
+
+    // Clients are created and started but the pool never runs, so no
+    // socket is touched
+    EXPECT_TRUE(manager.add("btcusdt"));
+    EXPECT_TRUE(manager.add("ethusdt"));
+    EXPECT_FALSE(manager.add("btcusdt"));
+    EXPECT_NE(manager.context_of("btcusdt"), manager.context_of("ethusdt"));
+    EXPECT_EQ(manager.connections(), 2u);
+
+    bool seen = false;
+    EXPECT_TRUE(manager.with_client("ethusdt", [&](BinanceWSClient&) { seen = true; }));
+    EXPECT_TRUE(seen);
+
+    EXPECT_TRUE(manager.remove("ethusdt"));
+    EXPECT_FALSE(manager.with_client("ethusdt", [](BinanceWSClient&) {}));
+    EXPECT_EQ(manager.context_of("ethusdt"), pool.size());
+}
+
+TEST(ConnectionManagerTest, MovedConnectionHandsOverWithoutOverlap) {
+    const auto simulator = [](double rate) {
+        ExchangeSimulator::Config cfg;
+        cfg.serve_binary = false;
+        cfg.ws_port = 0;
+        cfg.rate = rate;
+        return std::make_unique<ExchangeSimulator>(cfg);
+    };
+    const auto fast = simulator(1000.0);
+    const auto slow = simulator(20.0);
+    fast->start();
+    slow->start();
+
+    IoContextPool pool(2);
+    ssl::context ctx{ssl::context::tlsv12_client};   // No peer verification
+    ConnectionManager manager(pool, ctx);
+
+    std::map<std::string, std::atomic<int>> frames;
+    std::map<std::string, std::atomic<bool>> inside;
+    std::atomic<int> overlaps{0};
+    const auto options = [&](const std::string& symbol, const ExchangeSimulator& sim) {
+        ConnectionOptions o;
+        o.host = "127.0.0.1";
+        o.port = std::to_string(sim.ws_port());
+        o.on_depth = [&count = frames[symbol], &in = inside[symbol], &overlaps](
+                         std::span<const OrderBook::Order>) {
+            if (in.exchange(true)) ++overlaps;
+            std::this_thread::sleep_for(std::chrono::microseconds(50));   // Widen the window
+            ++count;
+            in.store(false);
+        };
+        return o;
+    };
+    // Both fast streams land on context 0, the slow one on context 1
+    ASSERT_TRUE(manager.add("btcusdt", options("btcusdt", *fast)));
+    ASSERT_TRUE(manager.add("ethusdt", options("ethusdt", *slow)));
+    ASSERT_TRUE(manager.add("solusdt", options("solusdt", *fast)));
+    ASSERT_EQ(manager.context_of("btcusdt"), manager.context_of("solusdt"));
+    pool.start();
+
+    const auto wait_for = [&](const std::string& symbol, int count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (frames[symbol] < count && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return frames[symbol] >= count;
+    };
+    ASSERT_TRUE(wait_for("btcusdt", 200));
+    ASSERT_TRUE(wait_for("solusdt", 200));
+
+    const std::size_t hot = manager.context_of("btcusdt");
+    ASSERT_TRUE(manager.rebalance());
+    const std::string moved = manager.context_of("btcusdt") != hot ? "btcusdt" : "solusdt";
+    EXPECT_NE(manager.context_of(moved), hot);
+
+    // The new session has only just been asked to resolve: the old one serves
+    bool connected = false;
+    manager.with_client(moved, [&](BinanceWSClient& c) {
+        std::lock_guard lock(c.get_market_data().mutex);
+        connected = c.get_market_data().connected;
+    });
+    EXPECT_TRUE(connected);
+
+    const int before = frames[moved];
+    ASSERT_TRUE(wait_for(moved, before + 200));
+
+    // The old session is closed as soon as the new one takes over, with
+    // no further rebalance() call
+    const auto handover = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (fast->stats().sessions_live.load() > 2 && std::chrono::steady_clock::now() < handover) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(fast->stats().sessions_live.load(), 2u);
+    EXPECT_EQ(overlaps.load(), 0);
+
+    manager.with_client(moved, [&](BinanceWSClient& c) {
+        std::lock_guard lock(c.get_market_data().mutex);
+        connected = c.get_market_data().connected;
+    });
+    EXPECT_TRUE(connected);
+
+    // Old and new session report under their own context, so the close
+    // clears the retired series without touching the live one
+    const auto gauge = [&](std::size_t context) {
+        return Metrics::global().gauge("ocean_ws_connected{symbol=\"" + moved +
+                                       "\",context=\"" + std::to_string(context) + "\"}");
+    };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (gauge(hot).value() != 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(gauge(hot).value(), 0);
+    EXPECT_EQ(gauge(manager.context_of(moved)).value(), 1);
+
+    pool.stop();
+    fast->stop();
+    slow->stop();
+}
+
+TEST(IoContextPoolTest, RunsHandlersOnEveryContext) {
+    IoContextPool pool(3);
+    pool.start();
+
+    std::atomic<int> ran{0};
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        boost::asio::post(pool.context(i), [&] { ran.fetch_add(1); });
+    }
+    while (ran.load() < 3) std::this_thread::yield();
+    pool.stop();
+    EXPECT_EQ(ran.load(), 3);
+}
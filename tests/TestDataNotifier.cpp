@@ -0,0 +1,92 @@
+#include "Core/DataNotifier.hpp"
+#include <gtest/gtest.h>
+
+#include <poll.h>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+class DataNotifierTest : public ::testing::TestWithParam<WaitPolicy> {};
+
+TEST_P(DataNotifierTest, TimesOutWithoutNotify) {
+    DataNotifier notifier;
+    const uint32_t seen = notifier.sequence();
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(notifier.wait(seen, GetParam(), 20ms, 16), seen);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST_P(DataNotifierTest, WakesOnNotifyFromAnotherThread) {
+    DataNotifier notifier;
+    uint32_t seen = notifier.sequence();
+
+    for (int round = 0; round < 50; ++round) {
+        std::jthread producer([&] {
+            std::this_thread::sleep_for(100us);
+            notifier.notify();
+        });
+        const uint32_t current = notifier.wait(seen, GetParam(), 5s, 16);
+        ASSERT_NE(current, seen) << "round " << round;
+        seen = current;
+    }
+}
+
+TEST_P(DataNotifierTest, ReturnsImmediatelyIfAlreadyAdvanced) {
+    DataNotifier notifier;
+    const uint32_t seen = notifier.sequence();
+    notifier.notify();
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(notifier.wait(seen, GetParam(), 5s), seen + 1);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllPolicies, DataNotifierTest,
+    ::testing::Values(WaitPolicy::BusySpin, WaitPolicy::SpinThenFutex, WaitPolicy::EventFd));
+
+TEST(DataNotifierEventFdTest, FdIsEpollReadableAfterNotify) {
+    DataNotifier notifier;
+    const int fd = notifier.event_fd();
+    ASSERT_GE(fd, 0);
+    notifier.watch_event();
+
+    pollfd pfd{fd, POLLIN, 0};
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+
+    notifier.notify();
+    EXPECT_EQ(poll(&pfd, 1, 0), 1);
+
+    notifier.consume_event();
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+    notifier.unwatch_event();
+}
+
+TEST(DataNotifierEventFdTest, NotifyLeavesTheFdAloneWithoutAWaiter) {
+    DataNotifier notifier;
+    const int fd = notifier.event_fd();
+    ASSERT_GE(fd, 0);
+
+    notifier.notify();
+    pollfd pfd{fd, POLLIN, 0};
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+}
+
+TEST(DataNotifierEventFdTest, StaleCountDoesNotEndTheNextWait) {
+    DataNotifier notifier;
+    ASSERT_GE(notifier.event_fd(), 0);
+    notifier.watch_event();
+    notifier.notify();   // Readable, and never consumed
+    notifier.unwatch_event();
+
+    const uint32_t seen = notifier.sequence();
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(notifier.wait(seen, WaitPolicy::EventFd, 20ms), seen);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 15ms);
+}
+
+TEST(DataNotifierEventFdTest, SubMillisecondTimeoutStillBlocks) {
+    DataNotifier notifier;
+    const uint32_t seen = notifier.sequence();
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(notifier.wait(seen, WaitPolicy::EventFd, 500us), seen);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 400us);
+}
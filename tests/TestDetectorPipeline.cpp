@@ -0,0 +1,141 @@
+#include "Strategy/DetectorPipeline.hpp"
+#include "Strategy/PipelineStages.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace {
+struct CountingStage {
+    int* calls;
+    void on_tick(const TickFeatures&, TickDecision&) { ++*calls; }
+};
+
+// Sees the decision after every earlier stage has run
+struct OrderProbe {
+    bool saw_weak_point = false;
+    void on_tick(const TickFeatures&, TickDecision& d) { saw_weak_point = d.weak_point; }
+};
+
+void fill_thin_book(OrderBook& book) {
+    book.update(std::vector<OrderBook::Order>{
+        {100.0f, 1.0f, true}, {99.0f, 2.0f, true},
+        {101.0f, 1.0f, false}, {102.0f, 2.0f, false}});
+}
+} // namespace
+
+TEST(DetectorPipelineTest, StagesAreStaticallyDispatched) {
+    using Pipeline = DetectorPipeline<WeakPointStage<10.0f>, UpdateRaidStage, StealthEntryStage<>>;
+    static_assert(!std::is_polymorphic_v<Pipeline>);
+    static_assert(Pipeline::size() == 3);
+    static_assert(std::is_empty_v<WeakPointStage<10.0f>>);  // Config lives in the type
+}
+
+TEST(DetectorPipelineTest, FeaturesReadTheBookOnce) {
+    OrderBook book;
+    fill_thin_book(book);
+    const std::vector<OrderBook::Order> updates{{100.0f, 0.5f, true}, {101.0f, 0.25f, false}};
+
+    const TickFeatures f = make_tick_features(1, book, updates);
+    EXPECT_FLOAT_EQ(f.book.best_bid, 100.0f);
+    EXPECT_FLOAT_EQ(f.book.best_ask, 101.0f);
+    EXPECT_FLOAT_EQ(f.book.mid, 100.5f);
+    EXPECT_FLOAT_EQ(f.book.bid_volume, 3.0f);
+    EXPECT_FLOAT_EQ(f.book.bid_depth, 1.0f);    // 99 is outside the 10 bps band
+    EXPECT_FLOAT_EQ(f.update_volume, 0.75f);
+}
+
+TEST(DetectorPipelineTest, RunsStagesInDeclarationOrder) {
+    int calls = 0;
+    DetectorPipeline<CountingStage, WeakPointStage<10.0f>, OrderProbe> pipeline(
+        CountingStage{&calls}, WeakPointStage<10.0f>{}, OrderProbe{});
+
+    OrderBook book;
+    fill_thin_book(book);
+    pipeline.on_tick(make_tick_features(1, book, {}));
+    pipeline.on_tick(make_tick_features(2, book, {}));
+
+    EXPECT_EQ(calls, 2);
+    EXPECT_TRUE(pipeline.stage<OrderProbe>().saw_weak_point);
+}
+
+TEST(DetectorPipelineTest, StealthEntryNeedsWeakPointAndTrigger) {
+    OrderBook book;
+    fill_thin_book(book);
+    const std::vector<OrderBook::Order> big{{100.0f, 500.0f, true}};
+
+    DetectorPipeline<WeakPointStage<10.0f>, UpdateRaidStage, StealthEntryStage<>> weak;
+    const TickDecision entered = weak.on_tick(make_tick_features(1, book, big));
+    EXPECT_TRUE(entered.raid);
+    EXPECT_TRUE(entered.enter);
+    EXPECT_FLOAT_EQ(entered.entry_price, 100.0f * 0.998f);
+
+    DetectorPipeline<WeakPointStage<1.0f>, UpdateRaidStage, StealthEntryStage<>> strong;
+    EXPECT_FALSE(strong.on_tick(make_tick_features(1, book, big)).enter);
+
+    EXPECT_FALSE(weak.on_tick(make_tick_features(2, book, {})).enter);
+}
+
+TEST(DetectorPipelineTest, PhaseStageBuildsBarsFromTapePrints) {
+    constexpr std::array<BarAggregator::Timeframe, 1> timeframes{{{.period = std::chrono::seconds(1)}}};
+    BarAggregator bars(timeframes);
+    TradeTape tape(64);
+    tape.append(5, 99.0f, 7.0f, true);   // Before the stage existed: not replayed
+    PhaseStage<0> stage(bars, tape);
+
+    OrderBook book;
+    fill_thin_book(book);
+    tape.append(10, 103.0f, 2.0f, true);
+    tape.append(11, 98.0f, 3.0f, false);
+
+    TickDecision d;
+    stage.on_tick(make_tick_features(1'000, book, {}), d);
+    stage.on_tick(make_tick_features(2'000, book, {}), d);   // Nothing new on the tape
+
+    const Bar* bar = bars.current(0);
+    ASSERT_NE(bar, nullptr);
+    EXPECT_EQ(bar->trade_count, 2u);
+    EXPECT_FLOAT_EQ(bar->volume, 5.0f);
+    EXPECT_FLOAT_EQ(bar->high, 103.0f);
+    EXPECT_FLOAT_EQ(bar->low, 98.0f);
+    EXPECT_FLOAT_EQ(bar->close, 100.5f);   // Then the quote
+}
+
+TEST(DetectorPipelineTest, GammaStageFiresOnBookAndTapeFlow) {
+    // Quiet two-sided book, then offers drain while bids stack and buyers
+    // lift: the same shape TestGammaSqueezeDetector replays directly
+    const auto run = [](bool with_prints) {
+        TradeTape tape(1024);
+        GammaStage<> stage(tape);
+        std::mt19937 gen(11);
+        std::normal_distribution<float> depth(100.0f, 5.0f);
+        std::uniform_real_distribution<float> amount(0.1f, 2.0f);
+        uint64_t ts = 0;
+        int fired = 0;
+
+        const auto tick = [&](float bid_depth, float ask_depth) {
+            TickFeatures f;
+            f.ts_ns = ++ts;
+            f.book.bid_depth = bid_depth;
+            f.book.ask_depth = ask_depth;
+            TickDecision d;
+            stage.on_tick(f, d);
+            if (d.squeeze == GammaSqueezeDetector::Direction::UP) ++fired;
+        };
+        for (int i = 0; i < 200; ++i) {
+            tick(depth(gen), depth(gen));
+            if (with_prints) tape.append(ts, 100.0f, amount(gen), i % 2 != 0);
+        }
+        for (int i = 0; i < 30; ++i) {
+            tick(100.0f + 4.0f * i, 100.0f * (1.0f - static_cast<float>(i + 1) / 35.0f));
+            if (with_prints) tape.append(ts, 100.0f, 3.0f, true);
+        }
+        return fired;
+    };
+
+    EXPECT_GT(run(true), 0);
+    EXPECT_EQ(run(false), 0);   // Depth alone can't reach the trigger
+}
@@ -0,0 +1,184 @@
+#include "Sim/ExchangeSimulator.hpp"
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <sys/socket.h>
+#include <thread>
+
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+
+#include "Clients/BinanceWire.hpp"
+#include "Clients/BinanceWSClient.hpp"
+#include "Core/MarketData.hpp"
+#include "Utils/Metrics.hpp"
+
+namespace {
+ExchangeSimulator::Config binary_only() {
+    ExchangeSimulator::Config cfg;
+    cfg.binary_port = 0;
+    cfg.serve_websocket = false;
+    cfg.rate = 5000.0;
+    return cfg;
+}
+
+// Polls until `done` holds or the deadline passes
+template <typename F>
+bool poll_until(MarketData& md, F done, std::chrono::seconds limit = std::chrono::seconds(5)) {
+    const auto deadline = std::chrono::steady_clock::now() + limit;
+    while (std::chrono::steady_clock::now() < deadline) {
+        md.poll(10);
+        if (done()) return true;
+    }
+    return false;
+}
+}
+
+TEST(DepthGeneratorTest, GapsSkipSequenceIds) {
+    DepthGenerator gen;
+    const uint64_t first = gen.update_id();
+    gen.next();
+    EXPECT_EQ(gen.update_id(), first + 1);
+    gen.next(10);
+    EXPECT_EQ(gen.update_id(), first + 12);
+}
+
+TEST(DepthGeneratorTest, JsonRoundTripsThroughTheParser) {
+    DepthGenerator::Config cfg;
+    cfg.levels = 5;
+    DepthGenerator gen(cfg);
+
+    std::string frame;
+    gen.encode_json(frame, 1'700'000'000'000);
+
+    std::vector<OrderBook::Order> levels;
+    ASSERT_TRUE(BinanceWire::parse_depth(frame, levels));
+    ASSERT_EQ(levels.size(), 10u);
+    EXPECT_EQ(BinanceWire::sequence_id(frame), gen.update_id());
+    EXPECT_NEAR(levels[0].price, gen.levels()[0].price, 0.01f);
+}
+
+TEST(ExchangeSimulatorTest, MarketDataReceivesBooksAndRecoversFromDrop) {
+    ExchangeSimulator sim(binary_only());
+    sim.start();
+    ASSERT_NE(sim.binary_port(), 0);
+
+    MarketData md("127.0.0.1", sim.binary_port());
+    std::size_t levels = 0;
+    ASSERT_TRUE(poll_until(md, [&] {
+        levels += md.get_updates().size();
+        return levels > 0;
+    }));
+    EXPECT_EQ(levels % 40, 0u);   // Whole books only: 20 levels a side
+
+    sim.inject_disconnect();
+    EXPECT_EQ(sim.stats().disconnects.load(), 1u);
+
+    // The handler notices the drop, reconnects and keeps receiving
+    ASSERT_TRUE(poll_until(md, [&] { return sim.stats().sessions_opened.load() == 2; }));
+    levels = 0;
+    ASSERT_TRUE(poll_until(md, [&] {
+        levels += md.get_updates().size();
+        return levels > 0;
+    }));
+    sim.stop();
+}
+
+TEST(ExchangeSimulatorTest, ServesDepthOverTlsWebSocket) {
+    ExchangeSimulator::Config cfg;
+    cfg.serve_binary = false;
+    cfg.ws_port = 0;
+    cfg.rate = 2000.0;
+    ExchangeSimulator sim(cfg);
+    sim.start();
+
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context ctx(boost::asio::ssl::context::tlsv12_client);   // No peer verification
+    BinanceWSClient client(ioc, ctx, "btcusdt");
+    client.set_endpoint("127.0.0.1", std::to_string(sim.ws_port()));
+
+    std::atomic<int> books{0};
+    client.on_depth([&](std::span<const OrderBook::Order> levels) {
+        if (levels.size() == 40) ++books;
+    });
+    client.start();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (books < 100 && std::chrono::steady_clock::now() < deadline) {
+        ioc.run_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GE(books.load(), 100);
+
+    client.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+    EXPECT_EQ(sim.stats().sessions_live.load(), 0u);
+}
+
+// A client offering permessage-deflate gets deflated frames, one that
+// doesn't gets plain ones, and both parse into whole depth20 books
+TEST(ExchangeSimulatorTest, DeflatesDepthForClientsThatOfferIt) {
+    ExchangeSimulator::Config cfg;
+    cfg.serve_binary = false;
+    cfg.ws_port = 0;
+    cfg.rate = 2000.0;
+    cfg.compression = true;
+    cfg.stamp_frames = true;
+    ExchangeSimulator sim(cfg);
+    sim.start();
+
+    boost::asio::io_context ioc;
+    boost::asio::ssl::context ctx(boost::asio::ssl::context::tlsv12_client);   // No peer verification
+    BinanceWSClient deflated(ioc, ctx, "xrpusdt");
+    BinanceWSClient plain(ioc, ctx, "dogeusdt");
+    deflated.enable_compression();
+
+    // Whole books only: 20 bids then 20 asks, best bid under best ask
+    const auto count_books = [](std::atomic<int>& books) {
+        return [&books](std::span<const OrderBook::Order> levels) {
+            if (levels.size() != 40) return;
+            for (std::size_t i = 0; i < levels.size(); ++i) {
+                if (levels[i].is_bid != (i < 20)) return;
+            }
+            if (levels[0].price < levels[20].price) ++books;
+        };
+    };
+    std::atomic<int> deflated_books{0};
+    std::atomic<int> plain_books{0};
+    for (auto* client : {&deflated, &plain}) {
+        client->set_endpoint("127.0.0.1", std::to_string(sim.ws_port()));
+    }
+    deflated.on_depth(count_books(deflated_books));
+    plain.on_depth(count_books(plain_books));
+    deflated.start();
+    plain.start();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while ((deflated_books < 100 || plain_books < 100) && std::chrono::steady_clock::now() < deadline) {
+        ioc.run_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GE(deflated_books.load(), 100);
+    EXPECT_GE(plain_books.load(), 100);
+    EXPECT_EQ(sim.stats().sessions_opened.load(), 2u);
+    EXPECT_EQ(sim.stats().deflate_sessions.load(), 1u);
+
+    // The socket the deflate bench reads TCP_INFO from: each client's own
+    for (const auto* client : {&deflated, &plain}) {
+        sockaddr_in peer{};
+        socklen_t len = sizeof(peer);
+        ASSERT_EQ(getpeername(client->native_handle(), reinterpret_cast<sockaddr*>(&peer), &len), 0);
+        EXPECT_EQ(ntohs(peer.sin_port), sim.ws_port());
+    }
+    EXPECT_NE(deflated.native_handle(), plain.native_handle());
+
+    Metrics::Registry& metrics = Metrics::global();
+    EXPECT_EQ(metrics.counter(R"(ocean_ws_parse_errors_total{symbol="xrpusdt"})").total(), 0u);
+    EXPECT_EQ(metrics.counter(R"(ocean_ws_parse_errors_total{symbol="dogeusdt"})").total(), 0u);
+
+    deflated.stop();
+    plain.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+}
@@ -0,0 +1,68 @@
+#include "Clients/FirstArrivalArbiter.hpp"
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "Clients/BinanceWire.hpp"
+
+TEST(FirstArrivalArbiterTest, FirstCopyWinsAndLaggardIsMeasured) {
+    FirstArrivalArbiter arb(2);
+
+    EXPECT_TRUE(arb.accept(0, 100, 1'000));
+    EXPECT_FALSE(arb.accept(1, 100, 1'250));   // Same update, 250ns late
+    EXPECT_TRUE(arb.accept(1, 101, 2'000));    // Leg 1 is faster this time
+    EXPECT_FALSE(arb.accept(0, 101, 2'100));
+    EXPECT_EQ(arb.last_id(), 101u);
+
+    const auto leg0 = arb.stats(0);
+    const auto leg1 = arb.stats(1);
+    EXPECT_EQ(leg0.wins, 1u);
+    EXPECT_EQ(leg0.duplicates, 1u);
+    EXPECT_DOUBLE_EQ(leg0.mean_lag_ns, 100.0);
+    EXPECT_EQ(leg1.wins, 1u);
+    EXPECT_EQ(leg1.max_lag_ns, 250u);
+}
+
+TEST(FirstArrivalArbiterTest, StaleIdsAreDroppedWithoutLagSample) {
+    FirstArrivalArbiter arb(2);
+    ASSERT_TRUE(arb.accept(0, 500, 10));
+    // A snapshot sampled earlier on the other connection: older, never seen
+    EXPECT_FALSE(arb.accept(1, 499, 20));
+
+    const auto leg1 = arb.stats(1);
+    EXPECT_EQ(leg1.duplicates, 1u);
+    EXPECT_EQ(leg1.lag_samples, 0u);
+}
+
+TEST(FirstArrivalArbiterTest, ConcurrentLegsNeverBothWin) {
+    constexpr uint64_t kIds = 200'000;
+    FirstArrivalArbiter arb(4);
+
+    std::vector<std::thread> legs;
+    for (std::size_t leg = 0; leg < 4; ++leg) {
+        legs.emplace_back([&, leg] {
+            for (uint64_t id = 1; id <= kIds; ++id) arb.accept(leg, id, id);
+        });
+    }
+    for (auto& t : legs) t.join();
+
+    uint64_t wins = 0, seen = 0;
+    for (std::size_t leg = 0; leg < 4; ++leg) {
+        wins += arb.stats(leg).wins;
+        seen += arb.stats(leg).wins + arb.stats(leg).duplicates;
+    }
+    EXPECT_EQ(seen, 4 * kIds);
+    EXPECT_LE(wins, kIds);
+    EXPECT_EQ(arb.last_id(), kIds);
+}
+
+TEST(FirstArrivalArbiterTest, SequenceIdsFromBinanceFrames) {
+    EXPECT_EQ(BinanceWire::sequence_id(R"({"lastUpdateId":160,"bids":[],"asks":[]})"), 160u);
+    EXPECT_EQ(BinanceWire::sequence_id(
+                  R"({"e":"depthUpdate","E":1,"s":"BNBBTC","U":157,"u":160,"b":[],"a":[]})"), 160u);
+    EXPECT_EQ(BinanceWire::sequence_id(
+                  R"({"stream":"bnbbtc@aggTrade","data":{"e":"aggTrade","E":1,"s":"BNBBTC","a":12345,"p":"0.001","q":"100","T":1,"m":true}})"),
+              12345u);
+    EXPECT_FALSE(BinanceWire::sequence_id(R"({"result":null,"id":1})"));
+}
@@ -0,0 +1,92 @@
+#include "Strategy/GammaSqueezeDetector.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace {
+// One recorded feed event: either a near-BBO depth snapshot or a print
+struct ReplayEvent {
+    bool is_trade;
+    float a;       // bid depth | trade amount
+    float b;       // ask depth | is_buy (1/0)
+};
+
+using Replay = std::vector<ReplayEvent>;
+
+Replay quiet_market(size_t n, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> depth(100.0f, 5.0f);
+    std::uniform_real_distribution<float> amount(0.1f, 2.0f);
+    Replay replay;
+    for (size_t i = 0; i < n; ++i) {
+        replay.push_back({false, depth(gen), depth(gen)});
+        replay.push_back({true, amount(gen), static_cast<float>(i % 2)});
+    }
+    return replay;
+}
+
+// Offers get lifted level by level while bids stack up underneath
+Replay squeeze(bool upward, size_t n) {
+    Replay replay;
+    for (size_t i = 0; i < n; ++i) {
+        const float drained = 100.0f * (1.0f - static_cast<float>(i + 1) / (n + 5));
+        const float building = 100.0f + 4.0f * i;
+        replay.push_back(upward ? ReplayEvent{false, building, drained}
+                                : ReplayEvent{false, drained, building});
+        replay.push_back({true, 3.0f, upward ? 1.0f : 0.0f});
+    }
+    return replay;
+}
+
+GammaSqueezeDetector::Signal play(GammaSqueezeDetector& detector, const Replay& replay,
+                                  int* fired = nullptr) {
+    for (const auto& e : replay) {
+        if (e.is_trade) detector.on_trade(e.a, e.b != 0.0f);
+        else detector.on_book(e.a, e.b);
+        if (fired && detector.signal().direction != GammaSqueezeDetector::Direction::NONE) ++*fired;
+    }
+    return detector.signal();
+}
+} // namespace
+
+TEST(GammaSqueezeDetectorTest, SilentBeforeWarmup) {
+    GammaSqueezeDetector detector;
+    const auto sig = play(detector, squeeze(true, 20));
+    EXPECT_FALSE(detector.warmed_up());
+    EXPECT_EQ(sig.direction, GammaSqueezeDetector::Direction::NONE);
+}
+
+TEST(GammaSqueezeDetectorTest, QuietTapeNeverFires) {
+    GammaSqueezeDetector detector;
+    int fired = 0;
+    play(detector, quiet_market(5000, 3), &fired);
+    EXPECT_EQ(fired, 0);
+}
+
+TEST(GammaSqueezeDetectorTest, DetectsUpwardSqueezeAfterQuietTape) {
+    GammaSqueezeDetector detector;
+    play(detector, quiet_market(200, 11));
+    const auto sig = play(detector, squeeze(true, 30));
+    EXPECT_EQ(sig.direction, GammaSqueezeDetector::Direction::UP);
+    EXPECT_GT(sig.ask_depletion, 0.4f);
+    EXPECT_GT(sig.flow_momentum, 0.5f);
+}
+
+TEST(GammaSqueezeDetectorTest, DetectsDownwardSqueezeAfterQuietTape) {
+    GammaSqueezeDetector detector;
+    play(detector, quiet_market(200, 13));
+    const auto sig = play(detector, squeeze(false, 30));
+    EXPECT_EQ(sig.direction, GammaSqueezeDetector::Direction::DOWN);
+    EXPECT_GT(sig.bid_depletion, 0.4f);
+    EXPECT_LT(sig.flow_momentum, -0.5f);
+}
+
+TEST(GammaSqueezeDetectorTest, ResetClearsState) {
+    GammaSqueezeDetector detector;
+    play(detector, quiet_market(200, 17));
+    play(detector, squeeze(true, 30));
+    detector.reset();
+    EXPECT_FALSE(detector.warmed_up());
+    EXPECT_EQ(detector.signal().score, 0.0f);
+}
@@ -0,0 +1,102 @@
+#include "Utils/HugePageArena.hpp"
+#include "Core/OrderBook.hpp"
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace {
+HugePageArena::Config small(bool huge_pages = false) {
+    return HugePageArena::Config{.name = "test", .chunk_bytes = 64 << 10, .huge_pages = huge_pages};
+}
+}
+
+TEST(HugePageArenaTest, TracksBytesInUseAndHighWater) {
+    HugePageArena arena(small());
+    {
+        std::pmr::vector<uint64_t> a(100, 0, &arena);
+        std::pmr::vector<uint64_t> b(50, 0, &arena);
+        EXPECT_EQ(arena.stats().bytes_in_use, 150 * sizeof(uint64_t));
+    }
+    std::pmr::vector<uint64_t> c(10, 0, &arena);
+
+    const auto stats = arena.stats();
+    EXPECT_EQ(stats.bytes_in_use, 10 * sizeof(uint64_t));
+    EXPECT_EQ(stats.high_water, 150 * sizeof(uint64_t));
+    EXPECT_EQ(stats.allocations, 3u);
+    EXPECT_GE(stats.bytes_held, std::size_t{64 << 10});
+}
+
+TEST(HugePageArenaTest, SteadyChurnStopsMapping) {
+    HugePageArena arena(small());
+    std::pmr::map<float, int> levels(&arena);
+    const auto churn = [&](int round) {
+        for (int i = 0; i < 2000; ++i) levels[static_cast<float>(i + round)] = i;
+        for (int i = 0; i < 2000; ++i) levels.erase(static_cast<float>(i + round));
+    };
+
+    churn(0);
+    const std::size_t held = arena.stats().bytes_held;
+    for (int round = 1; round < 50; ++round) churn(round);
+
+    // Freed nodes are reused from the pools; nothing new is mapped
+    EXPECT_EQ(arena.stats().bytes_held, held);
+    EXPECT_EQ(arena.stats().bytes_in_use, 0u);
+}
+
+TEST(HugePageArenaTest, LargeBlocksGoBackOnFree) {
+    HugePageArena arena(small());
+    const std::size_t before = arena.stats().bytes_held;
+    {
+        std::pmr::vector<std::byte> big(1 << 20, std::byte{1}, &arena);
+        EXPECT_GE(arena.stats().bytes_held, before + (1 << 20));
+        EXPECT_EQ(big[12345], std::byte{1});
+    }
+    EXPECT_EQ(arena.stats().bytes_held, before);
+}
+
+TEST(HugePageArenaTest, HugePageChunksAreAlignedAndCounted) {
+    const HugePages::Totals before = HugePages::totals();
+    {
+        HugePageArena arena(HugePageArena::Config{.name = "test"});
+        std::pmr::vector<int> v(16, 0, &arena);
+        const auto stats = arena.stats();
+        EXPECT_EQ(stats.bytes_held, HugePages::kPageSize);
+        EXPECT_EQ(HugePages::totals().bytes_held, before.bytes_held + HugePages::kPageSize);
+        EXPECT_GE(HugePages::totals().high_water, HugePages::totals().bytes_held);
+
+        // THP or hugetlb, either way the chunk starts on a 2 MB boundary
+        const HugePages::Mapping m = HugePages::map(HugePages::kPageSize);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(m.base) % HugePages::kPageSize, 0u);
+        HugePages::unmap(m);
+    }
+    EXPECT_EQ(HugePages::totals().bytes_held, before.bytes_held);
+}
+
+TEST(HugePageArenaTest, OrderBookLevelsLiveInItsArena) {
+    OrderBook book;
+    std::vector<OrderBook::Order> orders;
+    for (int i = 0; i < 100; ++i) {
+        orders.push_back({.price = 100.0f + static_cast<float>(i), .amount = 1.0f, .is_bid = i < 50});
+    }
+    book.update(orders);
+
+    const auto stats = book.memory_stats();
+    EXPECT_EQ(stats.allocations, 100u);
+    EXPECT_GT(stats.bytes_in_use, 0u);
+    EXPECT_LT(stats.bytes_held, HugePages::kPageSize);   // Many books per process: no 2 MB each
+    EXPECT_FLOAT_EQ(book.get_bbo().first, 149.0f);
+}
+
+TEST(HugePageArenaTest, OrderBooksCanShareAnArena) {
+    HugePageArena arena(HugePageArena::Config{.name = "test-books", .chunk_bytes = 1 << 20, .huge_pages = false});
+    OrderBook btc(&arena);
+    OrderBook eth(&arena);
+    btc.update(std::vector<OrderBook::Order>{{.price = 100.0f, .amount = 1.0f, .is_bid = true}});
+    eth.update(std::vector<OrderBook::Order>{{.price = 10.0f, .amount = 2.0f, .is_bid = false},
+                                             {.price = 11.0f, .amount = 2.0f, .is_bid = false}});
+
+    EXPECT_EQ(arena.stats().allocations, 3u);
+    EXPECT_EQ(btc.memory_stats().allocations, 3u);
+    EXPECT_EQ(arena.stats().bytes_held, std::size_t{1} << 20);
+    EXPECT_FLOAT_EQ(eth.get_bbo().second, 10.0f);
+}
@@ -8,13 +8,16 @@ TEST(LiquidityDetectorTest, DetectsVolumeSpike) {
     LiquidityDetector::Config cfg;
     LiquidityDetector detector(cfg);
 
+    // The spike has to be the latest print, and price has to run past
+    // the range by min_wick_ratio of its width: (108 - 100) / (104 - 100) = 2
     std::vector<OrderBook::Order> trades = {
         {100.0f, 10.0f, true},
         {101.0f, 10.0f, true},
         {102.0f, 10.0f, true},
-        {103.0f, 50.0f, true},  // Volume spike
-        {104.0f, 10.0f, true}
+        {104.0f, 10.0f, true},
+        {103.0f, 50.0f, true}   // Volume spike
     };
 
-    EXPECT_TRUE(detector.detect_raid(trades, 103.5f));
+    EXPECT_TRUE(detector.detect_raid(trades, 108.0f));
+    EXPECT_FALSE(detector.detect_raid(trades, 103.5f));   // Still inside the range
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "Analysis/MarketPhaseDetector.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+// Straight port of the original three-pass detector, used as the oracle
+SunTzu::MarketPhase referencePhase(const std::vector<float>& prices) {
+    const auto n = static_cast<float>(prices.size());
+    float up = 0.0f, down = 0.0f, range = 0.0f;
+    for (size_t i = 1; i < prices.size(); ++i) {
+        const float change = prices[i] - prices[i - 1];
+        up += std::max(change, 0.0f);
+        down += std::abs(std::min(change, 0.0f));
+        range += std::abs(change);
+    }
+    const float mean = std::accumulate(prices.begin(), prices.end(), 0.0f) / n;
+    float variance = 0.0f;
+    for (float p : prices) variance += (p - mean) * (p - mean);
+    const float vol = prices.empty() ? 0.0f : std::sqrt(variance / n);
+
+    if (prices.size() >= 10 && range / n > 2.0f * vol) return SunTzu::MarketPhase::CHAOS;
+    if (prices.size() >= 20) {
+        const float strength = std::abs(up / n - down / n) / (up / n + down / n + 1e-5f);
+        if (strength > 0.3f) return SunTzu::MarketPhase::TRENDING;
+    }
+    return SunTzu::MarketPhase::RANGING;
+}
+} // namespace
+
+TEST(MarketPhaseDetectorTest, NeedsWarmup) {
+    MarketPhaseDetector detector;
+    for (int i = 0; i < 5; ++i) detector.update(100.0f + i);
+    EXPECT_EQ(detector.getPhase(), SunTzu::MarketPhase::RANGING);
+}
+
+TEST(MarketPhaseDetectorTest, DetectsSteadyTrend) {
+    MarketPhaseDetector detector(50);
+    for (int i = 0; i < 200; ++i) detector.update(100.0f + 0.5f * i);
+    EXPECT_EQ(detector.size(), 50u);
+    EXPECT_EQ(detector.getPhase(), SunTzu::MarketPhase::TRENDING);
+}
+
+TEST(MarketPhaseDetectorTest, WhipsawIsRanging) {
+    MarketPhaseDetector detector(40);
+    for (int i = 0; i < 120; ++i) detector.update(i % 2 ? 101.0f : 99.0f);
+    EXPECT_EQ(detector.getPhase(), SunTzu::MarketPhase::RANGING);
+}
+
+TEST(MarketPhaseDetectorTest, SlidingWindowMatchesFullRecompute) {
+    constexpr size_t kWindow = 64;
+    MarketPhaseDetector detector(kWindow);
+    std::vector<float> window;
+
+    std::mt19937 gen(42);
+    std::normal_distribution<float> step(0.02f, 1.0f);
+    float price = 25000.0f;
+
+    for (int i = 0; i < 5000; ++i) {
+        price += step(gen);
+        detector.update(price);
+        window.push_back(price);
+        if (window.size() > kWindow) window.erase(window.begin());
+
+        ASSERT_EQ(detector.getPhase(), referencePhase(window)) << "tick " << i;
+    }
+}
@@ -0,0 +1,159 @@
+#include "Sim/MatchingSimulator.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <vector>
+
+#include "Execution/OrderGateway.hpp"
+
+namespace {
+using Event = MatchingSimulator::MarketEvent;
+using Kind = MatchingSimulator::EventKind;
+
+Event depth(uint64_t ts, double price, float amount, bool is_bid) {
+    return {.ts_ns = ts, .price = price, .amount = amount, .kind = Kind::Depth, .is_bid = is_bid};
+}
+
+Event trade(uint64_t ts, double price, float amount, bool buyer_aggressor) {
+    return {.ts_ns = ts, .price = price, .amount = amount, .kind = Kind::Trade, .is_bid = buyer_aggressor};
+}
+
+struct Capture {
+    std::vector<OrderWire::Report> reports;
+    void on_report(const OrderWire::Report& r) { reports.push_back(r); }
+};
+
+void send_new(MatchingSimulator& sim, uint64_t id, bool is_buy, double price, double quantity) {
+    const OrderWire::NewOrder msg{
+        .client_id = id, .symbol = 0, .is_buy = is_buy, .price = price, .quantity = quantity};
+    ASSERT_TRUE(sim.send(OrderWire::bytes_of(msg)));
+}
+
+// Two-sided book around 100: bids 99.99/99.98, asks 100.01/100.02
+void seed_book(MatchingSimulator& sim, uint64_t ts = 1) {
+    sim.on_market(depth(ts, 99.99, 5.0f, true));
+    sim.on_market(depth(ts, 99.98, 5.0f, true));
+    sim.on_market(depth(ts, 100.01, 1.0f, false));
+    sim.on_market(depth(ts, 100.02, 2.0f, false));
+}
+}
+
+TEST(MatchingSimulatorTest, TradesEatTheQueueBeforeUs) {
+    MatchingSimulator sim;
+    seed_book(sim);
+    send_new(sim, 1, true, 99.99, 1.0);
+    EXPECT_DOUBLE_EQ(sim.queue_ahead(1), 5.0);
+
+    sim.on_market(trade(2, 99.99, 3.0f, false));
+    EXPECT_NEAR(sim.queue_ahead(1), 2.0, 1e-9);
+
+    Capture out;
+    sim.poll(out);
+    ASSERT_EQ(out.reports.size(), 1u);   // Ack only
+    EXPECT_EQ(out.reports[0].exec, OrderWire::ExecType::Ack);
+
+    sim.on_market(trade(3, 99.99, 2.5f, false));   // 2 ahead, 0.5 reaches us
+    out.reports.clear();
+    sim.poll(out);
+    ASSERT_EQ(out.reports.size(), 1u);
+    EXPECT_EQ(out.reports[0].exec, OrderWire::ExecType::Fill);
+    EXPECT_NEAR(out.reports[0].last_quantity, 0.5, 1e-9);
+    EXPECT_NEAR(out.reports[0].last_price, 99.99, 1e-9);
+    EXPECT_EQ(sim.resting(), 1u);
+
+    sim.on_market(trade(4, 99.98, 0.1f, false));   // Printed through our price
+    EXPECT_EQ(sim.resting(), 0u);
+    EXPECT_NEAR(sim.stats().filled_quantity, 1.0, 1e-9);
+}
+
+TEST(MatchingSimulatorTest, UnexplainedShrinkIsCanceledAcrossTheQueue) {
+    MatchingSimulator sim;
+    seed_book(sim);
+    send_new(sim, 1, true, 99.99, 1.0);           // 5 ahead
+    sim.on_market(depth(2, 99.99, 10.0f, true));  // Joins behind us
+    EXPECT_DOUBLE_EQ(sim.queue_ahead(1), 5.0);
+
+    sim.on_market(trade(3, 99.99, 1.0f, false));  // 4 ahead; level prints 1
+    sim.on_market(depth(4, 99.99, 7.0f, true));   // 10 -> 7: 1 traded, 2 canceled
+    EXPECT_NEAR(sim.queue_ahead(1), 4.0 - 2.0 * (4.0 / 10.0), 1e-9);
+
+    sim.on_market(depth(5, 99.99, 1.0f, true));   // Never more ahead than is left
+    EXPECT_LE(sim.queue_ahead(1), 1.0);
+}
+
+TEST(MatchingSimulatorTest, CrossingOrdersTakeVisibleLiquidity) {
+    MatchingSimulator sim;
+    seed_book(sim);
+    send_new(sim, 1, true, 100.02, 2.0);
+
+    Capture out;
+    sim.poll(out);
+    ASSERT_EQ(out.reports.size(), 3u);
+    EXPECT_NEAR(out.reports[1].last_price, 100.01, 1e-9);
+    EXPECT_NEAR(out.reports[2].last_price, 100.02, 1e-9);
+    EXPECT_NEAR(sim.best_ask(), 100.02, 1e-9);
+    EXPECT_NEAR(sim.level(100.02, false), 1.0, 1e-9);
+    EXPECT_EQ(sim.resting(), 0u);
+    EXPECT_EQ(sim.stats().taker_fills, 2u);
+}
+
+TEST(MatchingSimulatorTest, LatencyDelaysEveryPath) {
+    MatchingSimulator sim({.md_latency_ns = 10, .order_latency_ns = 100, .report_latency_ns = 50});
+    EXPECT_EQ(sim.on_market(depth(1000, 99.99, 5.0f, true)), 1010u);
+
+    send_new(sim, 1, true, 99.99, 1.0);           // Reaches the venue at 1110
+    Capture out;
+    EXPECT_EQ(sim.on_market(trade(1100, 99.99, 5.0f, false)), 1110u);
+    EXPECT_DOUBLE_EQ(sim.queue_ahead(1), -1.0);   // Still in flight
+    EXPECT_EQ(sim.poll(out), 0u);
+
+    sim.on_market(depth(1140, 99.99, 2.0f, true));   // Order queued behind 2
+    EXPECT_DOUBLE_EQ(sim.queue_ahead(1), 2.0);
+    EXPECT_EQ(sim.poll(out), 0u);                 // Ack is due at 1160
+    sim.advance(1160);
+    EXPECT_EQ(sim.poll(out), 1u);
+}
+
+TEST(MatchingSimulatorTest, JitterKeepsEachPathInOrder) {
+    MatchingSimulator sim({.order_latency_ns = 100, .report_latency_ns = 100, .jitter_ns = 1000, .seed = 7});
+    sim.on_market(depth(1, 99.99, 5.0f, true));
+    for (uint64_t id = 1; id <= 50; ++id) send_new(sim, id, true, 99.0, 1.0);
+    sim.drain();
+
+    Capture out;
+    sim.poll(out);
+    ASSERT_EQ(out.reports.size(), 50u);
+    for (uint64_t i = 0; i < 50; ++i) EXPECT_EQ(out.reports[i].client_id, i + 1);
+}
+
+TEST(MatchingSimulatorTest, DrivesAnOrderGateway) {
+    MatchingSimulator sim;
+    OrderGateway<MatchingSimulator> gateway(sim, 8);
+    seed_book(sim);
+
+    const auto resting = gateway.submit(0, false, 1.0, 100.01, sim.now());   // Joins 1 ahead
+    const auto crossing = gateway.submit(0, true, 1.0, 100.01, sim.now());   // Takes that 1
+    sim.poll(gateway);
+    EXPECT_EQ(gateway.find(crossing.id), nullptr);
+    EXPECT_EQ(gateway.find(resting.id)->state, OrderState::New);
+
+    ASSERT_TRUE(gateway.cancel(resting.id));
+    sim.poll(gateway);
+    EXPECT_EQ(gateway.find(resting.id), nullptr);
+    EXPECT_EQ(gateway.stats().canceled, 1u);
+    EXPECT_EQ(gateway.stats().filled, 1u);
+}
+
+TEST(MatchingSimulatorTest, RecordingsRoundTrip) {
+    const std::vector<Event> events{depth(1, 99.99, 5.0f, true), trade(2, 100.01, 0.5f, true)};
+    const std::string path = ::testing::TempDir() + "matching_sim_events.bin";
+    MatchingSimulator::save(path, events);
+
+    const auto loaded = MatchingSimulator::load(path);
+    std::remove(path.c_str());
+    ASSERT_EQ(loaded.size(), events.size());
+    EXPECT_EQ(loaded[1].ts_ns, 2u);
+    EXPECT_EQ(loaded[1].kind, Kind::Trade);
+    EXPECT_TRUE(loaded[1].is_bid);
+    EXPECT_THROW(MatchingSimulator::load(path), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+#include "Utils/Metrics.hpp"
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <unistd.h>
+
+namespace {
+class MetricsTest : public ::testing::Test {
+protected:
+    std::string path = ::testing::TempDir() + "ocean-metrics-" + std::to_string(::getpid());
+
+    void TearDown() override { ::unlink(path.c_str()); }
+
+    Metrics::Registry::Config config() const {
+        Metrics::Registry::Config cfg;
+        cfg.path = path;
+        return cfg;
+    }
+
+    static const Metrics::Sample* find(const std::vector<Metrics::Sample>& samples, std::string_view name) {
+        for (const auto& s : samples) {
+            if (s.name == name) return &s;
+        }
+        return nullptr;
+    }
+};
+}
+
+TEST_F(MetricsTest, CountersSumAcrossWriterThreads) {
+    Metrics::Registry registry(config());
+    const Metrics::Counter frames = registry.counter("frames_total", "Frames seen");
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&] {
+                for (int i = 0; i < 10'000; ++i) frames.add();
+            });
+        }
+    }
+    frames.add(5);
+    EXPECT_EQ(frames.total(), 40'005u);
+
+    const Metrics::Reader reader(path);
+    const auto samples = reader.snapshot();
+    ASSERT_NE(find(samples, "frames_total"), nullptr);
+    EXPECT_EQ(find(samples, "frames_total")->value, 40'005);
+    EXPECT_EQ(find(samples, "frames_total")->help, "Frames seen");
+    EXPECT_EQ(reader.pid(), static_cast<uint32_t>(::getpid()));
+}
+
+TEST_F(MetricsTest, GaugesHoldTheLastValue) {
+    Metrics::Registry registry(config());
+    const Metrics::Gauge depth = registry.gauge("queue_depth");
+    depth.set(12);
+    std::jthread([&] { depth.add(-20); }).join();
+    EXPECT_EQ(depth.value(), -8);
+
+    const auto samples = Metrics::Reader(path).snapshot();
+    EXPECT_EQ(find(samples, "queue_depth")->value, -8);
+    EXPECT_EQ(find(samples, "queue_depth")->kind, Metrics::Kind::Gauge);
+}
+
+TEST_F(MetricsTest, HistogramsBucketByPowerOfTwo) {
+    Metrics::Registry registry(config());
+    const Metrics::Histogram latency = registry.histogram("latency_ns");
+    for (uint64_t v : {0ull, 1ull, 3ull, 1000ull, 1023ull, 1024ull}) latency.observe(v);
+
+    const auto* s = find(Metrics::Reader(path).snapshot(), "latency_ns");
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->buckets[0], 1u);
+    EXPECT_EQ(s->buckets[1], 1u);
+    EXPECT_EQ(s->buckets[2], 1u);
+    EXPECT_EQ(s->buckets[10], 2u);
+    EXPECT_EQ(s->buckets[11], 1u);
+}
+
+TEST_F(MetricsTest, NamesAreRegisteredOnce) {
+    Metrics::Registry registry(config());
+    registry.counter("reconnects_total").add(2);
+    registry.counter("reconnects_total").add(3);
+    EXPECT_THROW((void)registry.gauge("reconnects_total"), std::invalid_argument);
+
+    const auto samples = Metrics::Reader(path).snapshot();
+    EXPECT_EQ(samples.size(), 1u);
+    EXPECT_EQ(find(samples, "reconnects_total")->value, 5);
+}
+
+TEST_F(MetricsTest, FullRegistryHandsOutInertHandles) {
+    Metrics::Registry::Config cfg = config();
+    cfg.max_metrics = 2;
+    Metrics::Registry registry(cfg);
+    const auto a = registry.counter("a");
+    const auto b = registry.counter("b");
+    const auto c = registry.counter("c");
+    a.add();
+    b.add();
+    c.add();   // Lands in scratch memory
+
+    const auto samples = Metrics::Reader(path).snapshot();
+    EXPECT_EQ(samples.size(), 2u);
+    EXPECT_EQ(find(samples, "c"), nullptr);
+}
+
+TEST_F(MetricsTest, ReaderRejectsOtherFiles) {
+    EXPECT_THROW(Metrics::Reader("/nonexistent/ocean-metrics"), std::runtime_error);
+    EXPECT_THROW(Metrics::Reader("/proc/self/cmdline"), std::runtime_error);
+}
+
+TEST_F(MetricsTest, PrometheusTextCarriesLabels) {
+    Metrics::Registry registry(config());
+    registry.counter("ocean_ws_frames_total{symbol=\"btcusdt\"}", "WebSocket frames read").add(7);
+    registry.counter("ocean_ws_frames_total{symbol=\"ethusdt\"}", "WebSocket frames read").add(1);
+    registry.histogram("ocean_tick_ns{stage=\"book\"}").observe(5);
+
+    const std::string text = Metrics::to_prometheus(Metrics::Reader(path).snapshot());
+    EXPECT_NE(text.find("# HELP ocean_ws_frames_total WebSocket frames read\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE ocean_ws_frames_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("ocean_ws_frames_total{symbol=\"btcusdt\"} 7\n"), std::string::npos);
+    EXPECT_NE(text.find("ocean_ws_frames_total{symbol=\"ethusdt\"} 1\n"), std::string::npos);
+    EXPECT_EQ(text.find("# TYPE ocean_ws_frames_total", text.find("ethusdt")), std::string::npos);
+
+    EXPECT_NE(text.find("# TYPE ocean_tick_ns histogram\n"), std::string::npos);
+    EXPECT_NE(text.find("ocean_tick_ns_bucket{stage=\"book\",le=\"3\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("ocean_tick_ns_bucket{stage=\"book\",le=\"7\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("ocean_tick_ns_bucket{stage=\"book\",le=\"+Inf\"} 1\n"), std::string::npos);
+    EXPECT_NE(text.find("ocean_tick_ns_count{stage=\"book\"} 1\n"), std::string::npos);
+}
+
+TEST_F(MetricsTest, GlobalRegistryStaysPrivateUnlessPublished) {
+    Metrics::global().counter("ocean_test_private_total").add();
+    EXPECT_TRUE(Metrics::global().path().empty());
+
+    // Too late once global() has run: nothing is created at `path`
+    EXPECT_FALSE(Metrics::publish(path));
+    EXPECT_NE(::access(path.c_str(), F_OK), 0);
+}
@@ -0,0 +1,38 @@
+#include "Core/OrderBook.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+TEST(OrderBookTest, UpdateAddsToLevels) {
+    OrderBook book;
+    const std::vector<OrderBook::Order> diff{{100.0f, 1.0f, true}, {101.0f, 2.0f, false}};
+    book.update(diff);
+    book.update(diff);
+    EXPECT_FLOAT_EQ(book.total_bid_volume(), 2.0f);
+
+    book.update(std::vector<OrderBook::Order>{{100.0f, -2.0f, true}});
+    EXPECT_FLOAT_EQ(book.total_bid_volume(), 0.0f);
+    EXPECT_FLOAT_EQ(book.get_bbo().first, 0.0f);
+}
+
+TEST(OrderBookTest, SnapshotReplacesBothSides) {
+    OrderBook book;
+    const std::vector<OrderBook::Order> first{
+        {100.0f, 1.0f, true}, {99.5f, 2.0f, true}, {100.5f, 1.5f, false}, {101.0f, 3.0f, false}};
+    book.apply_snapshot(first);
+    book.apply_snapshot(first);
+    book.apply_snapshot(first);
+    EXPECT_FLOAT_EQ(book.total_bid_volume(), 3.0f);   // Not tripled
+    EXPECT_FLOAT_EQ(book.total_ask_volume(), 4.5f);
+
+    // Price moved down: levels missing from the snapshot leave the book
+    const std::vector<OrderBook::Order> lower{
+        {99.0f, 4.0f, true}, {98.5f, 1.0f, true}, {99.5f, 2.0f, false}, {100.0f, 0.5f, false}};
+    book.apply_snapshot(lower);
+    const auto [bid, ask] = book.get_bbo();
+    EXPECT_FLOAT_EQ(bid, 99.0f);
+    EXPECT_FLOAT_EQ(ask, 99.5f);
+    EXPECT_LT(bid, ask);
+    EXPECT_FLOAT_EQ(book.total_bid_volume(), 5.0f);
+    EXPECT_FLOAT_EQ(book.total_ask_volume(), 2.5f);
+}
@@ -0,0 +1,140 @@
+#include "Execution/OrderGateway.hpp"
+#include <gtest/gtest.h>
+
+#include "Execution/MockVenue.hpp"
+
+namespace {
+using Gateway = OrderGateway<MockVenue>;
+using Status = Gateway::SubmitStatus;
+
+OrderWire::Report report(OrderWire::ExecType exec, ClientOrderId id, double qty = 0.0, double px = 0.0) {
+    OrderWire::Report r{};
+    r.exec = exec;
+    r.client_id = id;
+    r.last_quantity = qty;
+    r.last_price = px;
+    return r;
+}
+}
+
+TEST(OrderStateTest, TransitionsFollowTheLifecycle) {
+    using S = OrderState;
+    using E = OrderEvent;
+    static_assert(next_state(S::PendingNew, E::Ack) == S::New);
+    static_assert(next_state(S::New, E::Fill, false) == S::PartiallyFilled);
+    static_assert(next_state(S::PartiallyFilled, E::Fill, true) == S::Filled);
+    static_assert(next_state(S::PendingCancel, E::Fill, false) == S::PendingCancel);
+    static_assert(next_state(S::PendingCancel, E::CancelReject, false, true) == S::PartiallyFilled);
+    static_assert(!next_state(S::Filled, E::Fill));
+    static_assert(!next_state(S::Canceled, E::CancelRequest));
+    static_assert(!next_state(S::New, E::CancelAck));
+}
+
+TEST(OrderPoolTest, IdsAreSlotsAndGoStaleOnReuse) {
+    OrderPool pool(2);
+    Order* a = pool.acquire();
+    Order* b = pool.acquire();
+    ASSERT_TRUE(a && b);
+    EXPECT_EQ(pool.acquire(), nullptr);
+
+    const ClientOrderId old_id = a->id;
+    pool.release(*a);
+    EXPECT_EQ(pool.find(old_id), nullptr);
+
+    Order* c = pool.acquire();
+    ASSERT_EQ(c, a);                      // Same slot...
+    EXPECT_NE(c->id, old_id);             // ...new id
+    EXPECT_EQ(pool.find(c->id), c);
+    EXPECT_EQ(pool.find(old_id), nullptr);
+}
+
+TEST(OrderGatewayTest, FillsSettleRiskAndPnl) {
+    MockVenue venue({.fill = true, .fill_slices = 2});
+    Gateway gateway(venue, 8);
+    RiskEngine risk(1, 1);
+    PnlEngine pnl(1, 10'000.0);
+    pnl.attachRisk(risk, 0);
+    gateway.attach_risk(risk, 0);
+    gateway.attach_pnl(pnl);
+
+    const auto sent = gateway.submit(0, true, 2.0, 100.0, 0);
+    ASSERT_EQ(sent.status, Status::Sent);
+    EXPECT_EQ(risk.exposure(0, 0), 2.0);
+
+    EXPECT_EQ(venue.poll(gateway), 3u);   // Ack and two half fills
+    EXPECT_EQ(gateway.find(sent.id), nullptr);
+    EXPECT_EQ(gateway.open_orders(), 0u);
+    EXPECT_EQ(gateway.stats().fills, 2u);
+    EXPECT_EQ(gateway.stats().filled, 1u);
+    EXPECT_DOUBLE_EQ(risk.position(0, 0), 2.0);
+    EXPECT_DOUBLE_EQ(pnl.position(0).quantity, 2.0);
+    EXPECT_EQ(gateway.stats().tick_to_wire_count, 1u);
+}
+
+TEST(OrderGatewayTest, CancelReleasesReservedHeadroom) {
+    MockVenue venue({.fill = false});
+    Gateway gateway(venue, 8);
+    RiskEngine risk(1, 1);
+    risk.startDay(0, 1e6);
+    gateway.attach_risk(risk, 0);
+
+    const auto sent = gateway.submit(0, false, 3.0, 50.0, 0);
+    venue.poll(gateway);
+    ASSERT_EQ(gateway.find(sent.id)->state, OrderState::New);
+
+    ASSERT_TRUE(gateway.cancel(sent.id));
+    EXPECT_EQ(gateway.find(sent.id)->state, OrderState::PendingCancel);
+    EXPECT_FALSE(gateway.cancel(sent.id));   // Already pending
+
+    venue.poll(gateway);
+    EXPECT_EQ(gateway.find(sent.id), nullptr);
+    EXPECT_EQ(gateway.stats().canceled, 1u);
+    EXPECT_DOUBLE_EQ(risk.exposure(0, 0), 0.0);
+}
+
+TEST(OrderGatewayTest, FailuresNeverLeakSlotsOrHeadroom) {
+    MockVenue venue({.fill = false});
+    Gateway gateway(venue, 1);
+    RiskEngine risk(1, 1);
+    risk.startDay(0, 1e6);
+    risk.setSymbolLimits(0, 0, {.maxOrderNotional = 1e9, .maxPosition = 5.0});
+    gateway.attach_risk(risk, 0);
+
+    EXPECT_EQ(gateway.submit(0, true, 6.0, 10.0, 0).status, Status::RiskRejected);
+    ASSERT_EQ(gateway.submit(0, true, 1.0, 10.0, 0).status, Status::Sent);
+    EXPECT_EQ(gateway.submit(0, true, 1.0, 10.0, 0).status, Status::PoolExhausted);
+    EXPECT_DOUBLE_EQ(risk.exposure(0, 0), 1.0);
+
+    MockVenue down({.fill = false});
+    down.set_connected(false);
+    Gateway offline(down, 4);
+    EXPECT_EQ(offline.submit(0, true, 1.0, 10.0, 0).status, Status::TransportFailed);
+    EXPECT_EQ(offline.open_orders(), 0u);
+}
+
+TEST(OrderGatewayTest, BadReportsAreCountedNotApplied) {
+    MockVenue venue({.fill = false});
+    Gateway gateway(venue, 4);
+    const auto sent = gateway.submit(0, true, 1.0, 10.0, 0);
+    venue.poll(gateway);
+
+    gateway.on_report(report(OrderWire::ExecType::Fill, sent.id + 1, 1.0, 10.0));   // Unknown id
+    gateway.on_report(report(OrderWire::ExecType::Canceled, sent.id));             // No cancel sent
+    EXPECT_EQ(gateway.stats().protocol_errors, 2u);
+    EXPECT_EQ(gateway.find(sent.id)->state, OrderState::New);
+
+    gateway.on_report(report(OrderWire::ExecType::Fill, sent.id, 5.0, 10.0));      // Overfill is capped
+    EXPECT_EQ(gateway.find(sent.id), nullptr);
+    EXPECT_EQ(gateway.stats().filled, 1u);
+}
+
+TEST(OrderGatewayTest, RoundedPartialsStillComplete) {
+    MockVenue venue({.fill = false});
+    Gateway gateway(venue, 4);
+    const auto sent = gateway.submit(0, true, 0.01, 10.0, 0);
+    venue.poll(gateway);
+
+    for (int i = 0; i < 3; ++i) gateway.on_report(report(OrderWire::ExecType::Fill, sent.id, 0.01 / 3, 10.0));
+    EXPECT_EQ(gateway.find(sent.id), nullptr);
+    EXPECT_EQ(gateway.stats().filled, 1u);
+}
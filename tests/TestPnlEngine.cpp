@@ -0,0 +1,99 @@
+#include "Risk/PnlEngine.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+#include <thread>
+
+TEST(PnlEngineTest, AverageCostRealizesOnReduceAndFlip) {
+    PnlEngine pnl(1, 1'000.0);
+
+    pnl.onFill(0, true, 2.0, 100.0);
+    pnl.onFill(0, true, 2.0, 110.0);
+    EXPECT_DOUBLE_EQ(pnl.position(0).averagePrice, 105.0);
+
+    pnl.onFill(0, false, 1.0, 115.0);                 // +10 on one unit
+    EXPECT_DOUBLE_EQ(pnl.position(0).quantity, 3.0);
+    EXPECT_DOUBLE_EQ(pnl.totals().realized, 10.0);
+
+    pnl.onFill(0, false, 5.0, 100.0, 0.5);            // -15 closing 3, then short 2 at 100
+    EXPECT_DOUBLE_EQ(pnl.position(0).quantity, -2.0);
+    EXPECT_DOUBLE_EQ(pnl.position(0).averagePrice, 100.0);
+    EXPECT_DOUBLE_EQ(pnl.totals().realized, -5.5);
+}
+
+TEST(PnlEngineTest, MarksLongsAtBidAndShortsAtAsk) {
+    PnlEngine pnl(2, 10'000.0);
+    pnl.onFill(0, true, 1.0, 100.0);
+    pnl.onFill(1, false, 2.0, 50.0);
+
+    pnl.onBbo(0, 104.0, 106.0);
+    pnl.onBbo(1, 48.0, 49.0);
+
+    const auto t = pnl.totals();
+    EXPECT_DOUBLE_EQ(t.unrealized, 4.0 + 2.0);
+    EXPECT_DOUBLE_EQ(t.netExposure, 105.0 - 97.0);
+    EXPECT_DOUBLE_EQ(t.grossExposure, 105.0 + 97.0);
+    EXPECT_DOUBLE_EQ(t.equity, 10'006.0);
+}
+
+TEST(PnlEngineTest, IncrementalTotalsMatchRecompute) {
+    constexpr std::size_t kSymbols = 200;
+    PnlEngine pnl(kSymbols, 1e6);
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<uint32_t> symbol(0, kSymbols - 1);
+    std::normal_distribution<double> move(0.0, 0.5);
+    std::vector<double> mid(kSymbols, 100.0);
+
+    for (int i = 0; i < 50'000; ++i) {
+        const uint32_t s = symbol(gen);
+        mid[s] += move(gen);
+        if (i % 10 == 0) pnl.onFill(s, i % 20 == 0, 1.0 + (i % 3), mid[s]);
+        pnl.onBbo(s, mid[s] - 0.01, mid[s] + 0.01);
+    }
+
+    double unrealized = 0.0, realized = 0.0, gross = 0.0;
+    for (uint32_t s = 0; s < kSymbols; ++s) {
+        const auto& p = pnl.position(s);
+        unrealized += p.unrealized;
+        realized += p.realized;
+        gross += std::abs(p.quantity * (p.bid + p.ask) / 2.0);
+    }
+    const auto t = pnl.totals();
+    EXPECT_NEAR(t.unrealized, unrealized, 1e-6);
+    EXPECT_NEAR(t.realized, realized, 1e-6);
+    EXPECT_NEAR(t.grossExposure, gross, 1e-6);
+}
+
+TEST(PnlEngineTest, MarkedLossTripsRiskOnTheTick) {
+    RiskEngine risk(1, 1);
+    PnlEngine pnl(1, 1'000.0);
+    pnl.attachRisk(risk, 0);
+
+    pnl.onFill(0, true, 1.0, 100.0);
+    pnl.onBbo(0, 90.0, 91.0);
+    EXPECT_FALSE(pnl.dailyLossBreached());
+    pnl.onBbo(0, 69.0, 70.0);                       // Down 31 of 1000
+    EXPECT_TRUE(pnl.dailyLossBreached());
+    EXPECT_NEAR(pnl.totals().dailyLoss, 0.031, 1e-12);
+
+    pnl.startDay();                                 // New baseline, position carried
+    EXPECT_FALSE(pnl.dailyLossBreached());
+    EXPECT_DOUBLE_EQ(pnl.totals().realized, 0.0);
+    EXPECT_DOUBLE_EQ(pnl.totals().unrealized, -31.0);
+}
+
+TEST(PnlEngineTest, ReadersSeeConsistentTotals) {
+    PnlEngine pnl(1, 1'000.0);
+    pnl.onFill(0, true, 1.0, 100.0);
+    std::atomic<bool> done{false};
+
+    std::jthread writer([&] {
+        for (int i = 0; i < 200'000; ++i) pnl.onBbo(0, 100.0 + (i % 50), 101.0 + (i % 50));
+        done = true;
+    });
+    while (!done) {
+        const auto t = pnl.totals();
+        ASSERT_DOUBLE_EQ(t.equity, 1'000.0 + t.realized + t.unrealized);
+    }
+}
@@ -1,7 +1,117 @@
 #include <gtest/gtest.h>
 #include "Utils/QuestDBLogger.hpp"
 
+#include <thread>
+
+#include "Sim/TcpSink.hpp"
+
+namespace {
+QuestDBLogger::Config to(const TcpSink& sink) {
+    QuestDBLogger::Config cfg;
+    cfg.port = sink.port();
+    cfg.flush_interval = std::chrono::milliseconds(5);
+    cfg.reconnect_backoff = std::chrono::milliseconds(5);
+    return cfg;
+}
+
+template <typename F>
+bool wait_until(F done, std::chrono::seconds limit = std::chrono::seconds(5)) {
+    const auto deadline = std::chrono::steady_clock::now() + limit;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (done()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+}
+
 TEST(QuestDBLoggerTest, BasicLogging) {
     QuestDBLogger logger;
     ASSERT_NO_THROW(logger.log("TestMethod", 42));
-}
\ No newline at end of file
+}
+
+TEST(QuestDBLoggerTest, WritesLineProtocol) {
+    TcpSink sink;
+    sink.start();
+    QuestDBLogger logger(to(sink));
+
+    logger.log("TestMethod", 42);
+    ASSERT_TRUE(logger.record("with space,comma", -7));
+    ASSERT_TRUE(logger.flush());
+    ASSERT_TRUE(wait_until([&] { return sink.lines() == 2; }));
+
+    const std::string got = sink.received();
+    EXPECT_EQ(got.rfind("execution_times,methodName=TestMethod durationMs=42i ", 0), 0u) << got;
+    EXPECT_NE(got.find("methodName=with\\ space\\,comma durationMs=-7i "), std::string::npos) << got;
+    EXPECT_EQ(logger.stats().written.load(), 2u);
+    EXPECT_EQ(logger.stats().connects.load(), 1u);
+}
+
+TEST(QuestDBLoggerTest, BatchesManyRecordsOverOneConnection) {
+    TcpSink sink({.keep = false});
+    sink.start();
+    QuestDBLogger logger(to(sink));
+
+    constexpr int kRecords = 5000;
+    for (int i = 0; i < kRecords; ++i) {
+        while (!logger.record("hot", i)) std::this_thread::yield();
+    }
+    ASSERT_TRUE(logger.flush(std::chrono::seconds(5)));
+    ASSERT_TRUE(wait_until([&] { return sink.lines() == kRecords; }));
+    EXPECT_EQ(sink.connections(), 1u);
+    EXPECT_LT(logger.stats().batches.load(), static_cast<uint64_t>(kRecords));
+}
+
+TEST(QuestDBLoggerTest, FullRingDropsAndCounts) {
+    QuestDBLogger::Config cfg;
+    cfg.port = 1;              // Nothing listens; the writer holds one batch and waits
+    cfg.capacity = 16;
+    cfg.batch_bytes = 1;       // One line per batch, so the ring backs up
+    cfg.reconnect_backoff = std::chrono::seconds(10);
+    QuestDBLogger logger(cfg);
+
+    int dropped = 0;
+    for (int i = 0; i < 100; ++i) dropped += logger.record("x", i) ? 0 : 1;
+    EXPECT_GT(dropped, 0);
+    EXPECT_EQ(logger.stats().dropped.load(), static_cast<uint64_t>(dropped));
+    EXPECT_FALSE(logger.flush(std::chrono::milliseconds(20)));
+}
+
+TEST(QuestDBLoggerTest, ReconnectsAndRetriesAfterTheServerDrops) {
+    TcpSink sink;
+    sink.start();
+    QuestDBLogger logger(to(sink));
+
+    logger.record("before", 1);
+    ASSERT_TRUE(logger.flush());
+    ASSERT_TRUE(wait_until([&] { return sink.lines() == 1; }));
+
+    sink.inject_disconnect();
+    // Sends into the dead socket fail within a few writes; keep logging until they do
+    ASSERT_TRUE(wait_until([&] {
+        logger.record("after", 2);
+        logger.flush(std::chrono::milliseconds(50));
+        return sink.connections() == 2;
+    }));
+    ASSERT_TRUE(logger.flush());
+    EXPECT_GE(logger.stats().send_failures.load(), 1u);
+    EXPECT_GE(logger.stats().connects.load(), 2u);
+    EXPECT_NE(sink.received().find("methodName=after"), std::string::npos);
+}
+
+TEST(QuestDBLoggerTest, LatencySummariesGetTheirOwnTableAndNanosecondFields) {
+    TcpSink sink;
+    sink.start();
+    QuestDBLogger logger(to(sink));
+
+    logger.log_latency(LatencySummary{.probe = "tick", .count = 1000, .min_ns = 80, .p50_ns = 250,
+                                      .p90_ns = 400, .p99_ns = 900, .p999_ns = 1500, .max_ns = 4000});
+    ASSERT_TRUE(logger.flush());
+    ASSERT_TRUE(wait_until([&] { return sink.lines() == 1; }));
+
+    const std::string got = sink.received();
+    EXPECT_EQ(got.rfind("latency,probe=tick count=1000i,min_ns=80i,p50_ns=250i,p90_ns=400i,"
+                        "p99_ns=900i,p999_ns=1500i,max_ns=4000i ", 0), 0u) << got;
+    EXPECT_EQ(got.find("durationMs"), std::string::npos) << got;
+    EXPECT_EQ(logger.stats().written.load(), 1u);
+}
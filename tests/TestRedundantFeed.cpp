@@ -0,0 +1,116 @@
+#include "Clients/RedundantFeed.hpp"
+#include "Sim/ExchangeSimulator.hpp"
+#include "Utils/Metrics.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <functional>
+
+// Both legs against the simulator; every drop takes both down at once,
+// and each must come back on a fresh TLS stream, not just the first time
+TEST(RedundantFeedTest, BothLegsDeliverAgainAfterEveryDrop) {
+    ExchangeSimulator::Config sim_cfg;
+    sim_cfg.serve_binary = false;
+    sim_cfg.ws_port = 0;
+    sim_cfg.rate = 200.0;
+    ExchangeSimulator sim(sim_cfg);
+    sim.start();
+
+    net::io_context ioc;
+    ssl::context ctx(ssl::context::tlsv12_client);   // No peer verification
+    RedundantFeed feed(ioc, ctx, "btcusdt");
+    feed.set_endpoint("127.0.0.1", std::to_string(sim.ws_port()));
+
+    uint64_t frames = 0;
+    feed.on_depth([&](std::span<const OrderBook::Order>) { ++frames; });
+    feed.start();
+
+    const auto run_until = [&](const std::function<bool()>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            ioc.run_for(std::chrono::milliseconds(10));
+        }
+        return done();
+    };
+    // Frames a leg put through the arbiter, winning or not
+    const auto delivered = [&](std::size_t leg) {
+        const auto s = feed.depth_stats(leg);
+        return s.wins + s.duplicates;
+    };
+    const auto wins = [&] { return feed.depth_stats(0).wins + feed.depth_stats(1).wins; };
+
+    ASSERT_TRUE(run_until([&] { return delivered(0) > 0 && delivered(1) > 0; }));
+    EXPECT_EQ(feed.connected_legs(), 2u);
+
+    for (int drop = 1; drop <= 3; ++drop) {
+        const uint64_t opened = sim.stats().sessions_opened.load();
+        sim.inject_disconnect();
+        ASSERT_TRUE(run_until([&] { return sim.stats().sessions_opened.load() >= opened + 2; }))
+            << "legs did not reconnect after drop " << drop;
+
+        const std::array<uint64_t, 2> before{delivered(0), delivered(1)};
+        const uint64_t wins_before = wins();
+        const uint64_t frames_before = frames;
+        ASSERT_TRUE(run_until([&] {
+            return delivered(0) >= before[0] + 20 && delivered(1) >= before[1] + 20;
+        })) << "a leg went quiet after drop " << drop;
+        EXPECT_EQ(feed.connected_legs(), 2u);
+
+        // Ids run on across the reconnect, so the arbiter keeps picking winners
+        EXPECT_GE(wins(), wins_before + 20);
+        EXPECT_GE(frames, frames_before + 20);
+    }
+
+    feed.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+}
+
+// Each leg reports under its own leg label: one leg's state never
+// overwrites the other's connected gauge or merges into its counters
+TEST(RedundantFeedTest, LegsKeepSeparateMetricSeries) {
+    ExchangeSimulator::Config sim_cfg;
+    sim_cfg.serve_binary = false;
+    sim_cfg.ws_port = 0;
+    sim_cfg.rate = 200.0;
+    ExchangeSimulator sim(sim_cfg);
+    sim.start();
+
+    net::io_context ioc;
+    ssl::context ctx(ssl::context::tlsv12_client);
+    RedundantFeed feed(ioc, ctx, "ltcusdt");
+    feed.set_endpoint("127.0.0.1", std::to_string(sim.ws_port()));
+    feed.start();
+
+    Metrics::Registry& registry = Metrics::global();
+    const std::array<Metrics::Gauge, 2> connected{
+        registry.gauge(R"(ocean_ws_connected{symbol="ltcusdt",leg="0"})"),
+        registry.gauge(R"(ocean_ws_connected{symbol="ltcusdt",leg="1"})")};
+    const std::array<Metrics::Counter, 2> frames{
+        registry.counter(R"(ocean_ws_frames_total{symbol="ltcusdt",leg="0"})"),
+        registry.counter(R"(ocean_ws_frames_total{symbol="ltcusdt",leg="1"})")};
+
+    const auto run_until = [&](const std::function<bool()>& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            ioc.run_for(std::chrono::milliseconds(10));
+        }
+        return done();
+    };
+    ASSERT_TRUE(run_until([&] { return frames[0].total() >= 20 && frames[1].total() >= 20; }));
+    EXPECT_EQ(connected[0].value(), 1);
+    EXPECT_EQ(connected[1].value(), 1);
+
+    // Both legs share the symbol, yet each counter holds only its own frames
+    const uint64_t leg0 = feed.depth_stats(0).wins + feed.depth_stats(0).duplicates;
+    const uint64_t leg1 = feed.depth_stats(1).wins + feed.depth_stats(1).duplicates;
+    EXPECT_GE(frames[0].total(), leg0);
+    EXPECT_LT(frames[0].total(), leg0 + leg1);
+
+    feed.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(connected[0].value(), 0);
+    EXPECT_EQ(connected[1].value(), 0);
+    sim.stop();
+}
@@ -0,0 +1,109 @@
+#include "Risk/RiskEngine.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Tactics/SunTzuTactics.hpp"
+
+namespace {
+using Verdict = RiskEngine::Verdict;
+
+RiskEngine::Order buy(double qty, double price, double stop = 0.0) {
+    return {.account = 0, .symbol = 0, .isBuy = true, .quantity = qty, .price = price, .stopPrice = stop};
+}
+}
+
+TEST(RiskEngineTest, EachLimitRejectsOnItsOwn) {
+    RiskEngine risk(1, 1);
+    risk.startDay(0, 10'000.0);
+    risk.setSymbolLimits(0, 0, {.maxOrderNotional = 5'000.0, .maxPosition = 10.0});
+
+    EXPECT_EQ(risk.check(buy(1.0, 100.0)), Verdict::Accepted);
+    EXPECT_EQ(risk.check(buy(60.0, 100.0)), Verdict::Notional);
+    EXPECT_EQ(risk.check(buy(11.0, 100.0)), Verdict::Position);
+    // 1% of 10k is 100 at risk; 2 units x 60 to the stop is 120
+    EXPECT_EQ(risk.check(buy(2.0, 100.0, 40.0)), Verdict::MaxRisk);
+    EXPECT_EQ(risk.check(buy(0.0, 100.0)), Verdict::InvalidOrder);
+    EXPECT_EQ(risk.check({.account = 1, .quantity = 1.0, .price = 1.0}), Verdict::InvalidOrder);
+
+    risk.setBalance(0, 9'700.0);   // Down 3%
+    EXPECT_TRUE(risk.dailyLossBreached(0));
+    EXPECT_EQ(risk.check(buy(1.0, 100.0)), Verdict::DailyLoss);
+
+    risk.startDay(0, 9'700.0);
+    risk.halt(0);
+    EXPECT_EQ(risk.check(buy(1.0, 100.0)), Verdict::Halted);
+}
+
+TEST(RiskEngineTest, MarketPhaseScalesPerOrderRisk) {
+    RiskEngine risk(2, 1);
+    risk.startDay(0, 10'000.0);
+    risk.startDay(1, 10'000.0);
+
+    SunTzu::adjustForMarketPhase(risk, 0, SunTzu::MarketPhase::CHAOS);
+    EXPECT_DOUBLE_EQ(risk.currentMaxRisk(0), 0.0025);
+    EXPECT_DOUBLE_EQ(risk.currentMaxRisk(1), 0.01);   // Other accounts untouched
+    EXPECT_DOUBLE_EQ(risk.positionSize(0, 100.0, 95.0), 5.0);
+
+    risk.adjustForVolatility(0, 100.0);
+    EXPECT_DOUBLE_EQ(risk.currentMaxRisk(0), RiskEngine::kMinRiskFraction);
+}
+
+TEST(RiskEngineTest, ReserveReleaseAndFill) {
+    RiskEngine risk(1, 1);
+    risk.startDay(0, 1e6);
+    risk.setSymbolLimits(0, 0, {.maxOrderNotional = 1e9, .maxPosition = 5.0});
+
+    ASSERT_EQ(risk.reserve(buy(3.0, 10.0)), Verdict::Accepted);
+    EXPECT_EQ(risk.reserve(buy(3.0, 10.0)), Verdict::Position);
+    risk.onFill(0, 0, true, 2.0);
+    risk.release(0, 0, true, 1.0);     // The rest was cancelled
+    EXPECT_DOUBLE_EQ(risk.position(0, 0), 2.0);
+    EXPECT_DOUBLE_EQ(risk.exposure(0, 0), 2.0);
+    EXPECT_EQ(risk.reserve(buy(3.0, 10.0)), Verdict::Accepted);
+}
+
+TEST(RiskEngineTest, RestingBuysAndSellsNeverOffset) {
+    RiskEngine risk(1, 1);
+    risk.startDay(0, 1e9);
+    risk.setSymbolLimits(0, 0, {.maxOrderNotional = 1e9, .maxPosition = 1'000.0});
+    RiskEngine::Order sell = buy(1'000.0, 10.0);
+    sell.isBuy = false;
+
+    ASSERT_EQ(risk.reserve(buy(1'000.0, 10.0)), Verdict::Accepted);
+    ASSERT_EQ(risk.reserve(sell), Verdict::Accepted);
+    EXPECT_DOUBLE_EQ(risk.exposure(0, 0), 1'000.0);
+    EXPECT_EQ(risk.check(buy(1'000.0, 10.0)), Verdict::Position);
+    EXPECT_EQ(risk.reserve(buy(1'000.0, 10.0)), Verdict::Position);
+
+    risk.onFill(0, 0, false, 1'000.0);   // The sell filled: short 1000, buy still resting
+    EXPECT_DOUBLE_EQ(risk.position(0, 0), -1'000.0);
+    EXPECT_DOUBLE_EQ(risk.exposure(0, 0), 1'000.0);
+    EXPECT_EQ(risk.reserve(sell), Verdict::Position);
+    risk.release(0, 0, true, 1'000.0);
+    EXPECT_EQ(risk.reserve(buy(1'000.0, 10.0)), Verdict::Accepted);
+}
+
+TEST(RiskEngineTest, ConcurrentReservesNeverExceedPosition) {
+    constexpr int kThreads = 8;
+    constexpr double kLimit = 1'000.0;
+    RiskEngine risk(1, 1);
+    risk.startDay(0, 1e9);
+    risk.setSymbolLimits(0, 0, {.maxOrderNotional = 1e9, .maxPosition = kLimit});
+
+    std::atomic<int> accepted{0};
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 1'000; ++i) {
+                if (risk.reserve(buy(1.0, 10.0)) == Verdict::Accepted) ++accepted;
+            }
+        });
+    }
+    threads.clear();
+
+    EXPECT_EQ(accepted.load(), static_cast<int>(kLimit));
+    EXPECT_DOUBLE_EQ(risk.exposure(0, 0), kLimit);
+}
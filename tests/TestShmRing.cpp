@@ -0,0 +1,361 @@
+#include "Core/Fanout.hpp"
+#include "Core/ShmRing.hpp"
+#include <gtest/gtest.h>
+
+#include <csignal>
+#include <cstring>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <zmq.h>
+
+using namespace std::chrono_literals;
+
+namespace {
+class ShmRingTest : public ::testing::Test {
+protected:
+    std::string path = ::testing::TempDir() + "ocean-ring-" + std::to_string(::getpid());
+
+    void TearDown() override { ::unlink(path.c_str()); }
+
+    ShmRingWriter::Config config(std::size_t capacity = 64, std::size_t max_readers = 4) const {
+        return ShmRingWriter::Config{path, capacity, max_readers};
+    }
+
+    // Every field derived from n, so a torn copy shows
+    static FanoutEvent event(uint64_t n) {
+        FanoutEvent e;
+        e.ts_ns = n;
+        e.update_count = static_cast<uint32_t>(n);
+        e.best_bid = static_cast<float>(n % 1000);
+        e.amount = static_cast<float>(n % 1000);
+        return e;
+    }
+};
+}
+
+TEST_F(ShmRingTest, ReaderStartsAtTheNewestEvent) {
+    ShmRingWriter writer(config());
+    writer.publish(event(1));
+
+    ShmRingReader reader(path);
+    FanoutEvent out;
+    EXPECT_EQ(reader.poll(out), ShmRingReader::Status::Empty);
+
+    for (uint64_t n = 2; n <= 5; ++n) writer.publish(event(n));
+    for (uint64_t n = 2; n <= 5; ++n) {
+        ASSERT_EQ(reader.poll(out), ShmRingReader::Status::Ok);
+        EXPECT_EQ(out.ts_ns, n);
+        EXPECT_EQ(out.update_count, n);
+    }
+    EXPECT_EQ(reader.poll(out), ShmRingReader::Status::Empty);
+    EXPECT_EQ(reader.lost(), 0u);
+}
+
+TEST_F(ShmRingTest, WriterNeverWaitsForALappedReader) {
+    ShmRingWriter writer(config(8));
+    ShmRingReader reader(path);
+    for (uint64_t n = 0; n < 20; ++n) writer.publish(event(n));
+
+    FanoutEvent out;
+    ASSERT_EQ(reader.poll(out), ShmRingReader::Status::Lapped);
+    EXPECT_EQ(reader.lost(), 16u);   // Resumes half a ring behind the head
+    for (uint64_t n = 16; n < 20; ++n) {
+        ASSERT_EQ(reader.poll(out), ShmRingReader::Status::Ok);
+        EXPECT_EQ(out.ts_ns, n);
+    }
+    EXPECT_EQ(reader.poll(out), ShmRingReader::Status::Empty);
+}
+
+TEST_F(ShmRingTest, WriterSeesEachReadersLag) {
+    ShmRingWriter writer(config());
+    ShmRingReader fast(path);
+    ShmRingReader slow(path);
+    for (uint64_t n = 0; n < 10; ++n) writer.publish(event(n));
+
+    FanoutEvent out;
+    while (fast.poll(out) == ShmRingReader::Status::Ok) {}
+    ASSERT_EQ(slow.poll(out), ShmRingReader::Status::Ok);
+
+    const auto readers = writer.readers();
+    ASSERT_EQ(readers.size(), 2u);
+    EXPECT_EQ(readers[0].lag, 0u);
+    EXPECT_EQ(readers[1].lag, 9u);
+    EXPECT_TRUE(readers[1].alive);
+    EXPECT_EQ(readers[1].pid, static_cast<uint32_t>(::getpid()));
+    EXPECT_EQ(readers[0].slot, fast.slot());
+    EXPECT_EQ(readers[1].slot, slow.slot());
+}
+
+TEST_F(ShmRingTest, ReaderSlotsAreReleased) {
+    ShmRingWriter writer(config(64, 1));
+    {
+        ShmRingReader first(path);
+        EXPECT_THROW(ShmRingReader second(path), std::runtime_error);
+    }
+    EXPECT_NO_THROW(ShmRingReader again(path));
+    EXPECT_TRUE(writer.readers().empty());
+}
+
+TEST_F(ShmRingTest, RejectsOtherFiles) {
+    EXPECT_THROW(ShmRingReader("/nonexistent/ocean-ring"), std::runtime_error);
+    EXPECT_THROW(ShmRingReader("/proc/self/cmdline"), std::runtime_error);
+}
+
+TEST_F(ShmRingTest, WaitWakesOnPublishAndClose) {
+    auto writer = std::make_unique<ShmRingWriter>(config());
+    ShmRingReader reader(path);
+
+    std::jthread producer([&] {
+        std::this_thread::sleep_for(5ms);
+        writer->publish(event(7));
+    });
+    const auto start = std::chrono::steady_clock::now();
+    reader.wait(5s, 16);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 4s);
+    producer.join();
+
+    FanoutEvent out;
+    ASSERT_EQ(reader.poll(out), ShmRingReader::Status::Ok);
+    EXPECT_EQ(out.ts_ns, 7u);
+
+    writer.reset();
+    reader.wait(5s, 16);
+    EXPECT_EQ(reader.poll(out), ShmRingReader::Status::Closed);
+}
+
+TEST_F(ShmRingTest, ConcurrentReaderNeverSeesATornEvent) {
+    constexpr uint64_t kEvents = 200'000;
+    ShmRingWriter writer(config(256));
+    ShmRingReader reader(path);
+
+    std::jthread producer([&] {
+        for (uint64_t n = 0; n < kEvents; ++n) writer.publish(event(n));
+    });
+
+    uint64_t seen = 0;
+    uint64_t next = 0;
+    FanoutEvent out;
+    while (next < kEvents) {
+        switch (reader.poll(out)) {
+            case ShmRingReader::Status::Ok:
+                ASSERT_EQ(out.ts_ns, next);
+                ASSERT_EQ(out.update_count, static_cast<uint32_t>(next));
+                ASSERT_EQ(out.amount, static_cast<float>(next % 1000));
+                ++next;
+                ++seen;
+                break;
+            case ShmRingReader::Status::Lapped:
+                next = reader.position();
+                break;
+            default:
+                break;
+        }
+    }
+    EXPECT_EQ(seen + reader.lost(), kEvents);
+}
+
+TEST_F(ShmRingTest, ReaderInAnotherProcess) {
+    ShmRingWriter writer(config(1024));
+    int ready[2];
+    ASSERT_EQ(::pipe(ready), 0);
+
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ShmRingReader reader(path);
+        const char go = 1;
+        if (::write(ready[1], &go, 1) != 1) ::_exit(2);
+        uint64_t sum = 0;
+        FanoutEvent out;
+        for (int n = 0; n < 100;) {
+            const auto status = reader.poll(out);
+            if (status == ShmRingReader::Status::Ok) {
+                sum += out.ts_ns;
+                ++n;
+            } else if (status == ShmRingReader::Status::Empty) {
+                reader.wait(1s);
+            } else {
+                ::_exit(3);
+            }
+        }
+        ::_exit(sum == 4950 ? 0 : 1);
+    }
+
+    char go = 0;
+    ASSERT_EQ(::read(ready[0], &go, 1), 1);
+    ASSERT_EQ(writer.readers().size(), 1u);
+    EXPECT_EQ(writer.readers()[0].pid, static_cast<uint32_t>(child));
+    for (uint64_t n = 0; n < 100; ++n) writer.publish(event(n));
+
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    ::close(ready[0]);
+    ::close(ready[1]);
+}
+
+TEST_F(ShmRingTest, ReaderKilledAsleepIsTakenOffTheSleeperCount) {
+    ShmRingWriter writer(config());
+    const pid_t child = ::fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        ShmRingReader reader(path);
+        for (;;) reader.wait(1h, 0);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (writer.sleepers() == 0 && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(1ms);
+    ASSERT_EQ(writer.sleepers(), 1u);
+    ASSERT_EQ(writer.readers().size(), 1u);
+    EXPECT_EQ(writer.sleepers(), 1u);   // Alive: left alone
+
+    ::kill(child, SIGKILL);
+    int status = 0;
+    ASSERT_EQ(::waitpid(child, &status, 0), child);
+    EXPECT_FALSE(writer.readers()[0].alive);
+    EXPECT_EQ(writer.sleepers(), 0u);
+
+    ShmRingReader next(path);   // Takes over the dead reader's slot
+    EXPECT_EQ(next.slot(), 0u);
+    EXPECT_EQ(writer.sleepers(), 0u);
+}
+
+TEST_F(ShmRingTest, PublisherReportsSlowReaders) {
+    FanoutPublisher::Config cfg;
+    cfg.stream = "test.book";
+    cfg.ring_path = path;
+    cfg.ring_capacity = 64;
+    cfg.max_lag = 4;
+    FanoutPublisher publisher(cfg);
+
+    ShmRingReader reader(path);
+    BookEvent book{};
+    book.recv_ns = 42;
+    book.book.best_bid = 100.0f;
+    for (int n = 0; n < 10; ++n) publisher.on_book(book);
+    EXPECT_EQ(publisher.check_readers(), 1u);
+
+    FanoutEvent out;
+    while (reader.poll(out) == ShmRingReader::Status::Ok) {}
+    EXPECT_EQ(out.kind, FanoutEvent::Kind::Book);
+    EXPECT_EQ(out.best_bid, 100.0f);
+    EXPECT_EQ(publisher.check_readers(), 0u);
+
+    for (int n = 0; n < 100; ++n) publisher.on_trade(n, 1.0f, 2.0f, true);
+    EXPECT_EQ(reader.poll(out), ShmRingReader::Status::Lapped);
+    while (reader.poll(out) == ShmRingReader::Status::Ok) {}
+    EXPECT_EQ(out.kind, FanoutEvent::Kind::Trade);
+    EXPECT_EQ(publisher.check_readers(), 1u);   // Caught up, but lost events since the last check
+    EXPECT_EQ(publisher.check_readers(), 0u);
+}
+
+TEST_F(ShmRingTest, PublisherReportsTheBridgeApart) {
+    FanoutPublisher::Config cfg;
+    cfg.stream = "test.bridge";
+    cfg.ring_path = path;
+    cfg.zmq_endpoint = "inproc://test.bridge";
+    FanoutPublisher publisher(cfg);
+    EXPECT_TRUE(publisher.readers().empty());
+    ASSERT_TRUE(publisher.bridge().has_value());
+
+    ShmRingReader reader(path);
+    const auto readers = publisher.readers();
+    ASSERT_EQ(readers.size(), 1u);
+    EXPECT_EQ(readers[0].slot, reader.slot());
+    EXPECT_NE(publisher.bridge()->slot, reader.slot());
+}
+
+namespace {
+// OceanTap's side of the zmq transport: a SUB socket filtered on the stream topic
+struct Subscriber {
+    void* context = zmq_ctx_new();
+    void* socket = zmq_socket(context, ZMQ_SUB);
+
+    Subscriber(const std::string& endpoint, const std::string& topic) {
+        const int timeout_ms = 10;
+        const int linger = 0;
+        const int hwm = 1;
+        const int rcvbuf = 4096;   // With hwm 1, keeps the backlog a stalled tap can absorb small
+        zmq_setsockopt(socket, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms));
+        zmq_setsockopt(socket, ZMQ_LINGER, &linger, sizeof(linger));
+        zmq_setsockopt(socket, ZMQ_RCVHWM, &hwm, sizeof(hwm));
+        zmq_setsockopt(socket, ZMQ_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+        zmq_setsockopt(socket, ZMQ_SUBSCRIBE, topic.data(), topic.size());
+        zmq_connect(socket, endpoint.c_str());
+    }
+    ~Subscriber() {
+        zmq_close(socket);
+        zmq_ctx_term(context);
+    }
+
+    // The subscription reaches the PUB some time after connect; until then
+    // the publisher has no one to send to. Publishes until the first arrives.
+    int join(FanoutPublisher& publisher, char* topic, std::size_t size) const {
+        int n = -1;
+        for (uint64_t i = 1; i <= 1000 && n < 0; ++i) {
+            FanoutEvent e;
+            e.ts_ns = i;
+            e.update_count = static_cast<uint32_t>(i);
+            publisher.publish(e);
+            n = zmq_recv(socket, topic, size, 0);
+        }
+        return n;
+    }
+};
+}
+
+TEST_F(ShmRingTest, PublisherSendsTopicAndEventOverZmq) {
+    FanoutPublisher::Config cfg;
+    cfg.stream = "test.zmq";
+    cfg.ring_path = path;
+    cfg.zmq_endpoint = "tcp://127.0.0.1:*";
+    FanoutPublisher publisher(cfg);
+    ASSERT_EQ(publisher.zmq_endpoint().rfind("tcp://127.0.0.1:", 0), 0u);
+    ASSERT_EQ(publisher.zmq_endpoint().find('*'), std::string::npos);
+
+    const Subscriber sub(publisher.zmq_endpoint(), cfg.stream);
+    char topic[64];
+    const int n = sub.join(publisher, topic, sizeof(topic));
+    ASSERT_GT(n, 0) << "no message on " << publisher.zmq_endpoint();
+    EXPECT_EQ(std::string(topic, n), cfg.stream);
+
+    int more = 0;
+    std::size_t more_size = sizeof(more);
+    ASSERT_EQ(zmq_getsockopt(sub.socket, ZMQ_RCVMORE, &more, &more_size), 0);
+    ASSERT_EQ(more, 1);
+
+    // Received into a bigger buffer, so a longer frame would show
+    alignas(FanoutEvent) char frame[2 * sizeof(FanoutEvent)];
+    ASSERT_EQ(zmq_recv(sub.socket, frame, sizeof(frame), 0), 56);
+    FanoutEvent out;
+    std::memcpy(&out, frame, sizeof(out));
+    EXPECT_EQ(out.kind, FanoutEvent::Kind::Book);
+    EXPECT_GT(out.ts_ns, 0u);
+    EXPECT_EQ(out.update_count, out.ts_ns);
+    EXPECT_GT(Metrics::global().counter(R"(ocean_fanout_zmq_sent_total{stream="test.zmq"})").total(), 0u);
+}
+
+TEST_F(ShmRingTest, PublisherCountsZmqDropsPastTheHighWaterMark) {
+    FanoutPublisher::Config cfg;
+    cfg.stream = "test.zmq.hwm";
+    cfg.ring_path = path;
+    cfg.zmq_endpoint = "tcp://127.0.0.1:*";
+    cfg.zmq_hwm = 1;
+    FanoutPublisher publisher(cfg);
+    const Metrics::Counter dropped =
+        Metrics::global().counter(R"(ocean_fanout_zmq_dropped_total{stream="test.zmq.hwm"})");
+
+    const Subscriber sub(publisher.zmq_endpoint(), cfg.stream);
+    char topic[64];
+    ASSERT_GT(sub.join(publisher, topic, sizeof(topic)), 0);
+
+    // The tap stops reading; once the socket buffers fill, the bridge drops
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (dropped.total() == 0 && std::chrono::steady_clock::now() < deadline) {
+        for (int i = 0; i < 1000; ++i) publisher.publish(event(i));
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_GT(dropped.total(), 0u);
+}
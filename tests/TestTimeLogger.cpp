@@ -0,0 +1,113 @@
+#include "Utils/TimeLogger.hpp"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+struct CaptureSink : ILogger {
+    std::vector<LatencySummary> summaries;
+    std::vector<std::string> names;   // Keeps the views in `summaries` alive
+
+    void log(const std::string&, long) override {}
+    void log_latency(const LatencySummary& s) override {
+        names.emplace_back(s.probe);
+        summaries.push_back(s);
+        summaries.back().probe = names.back();
+    }
+
+    const LatencySummary* find(std::string_view probe) const {
+        for (const auto& s : summaries) {
+            if (s.probe == probe) return &s;
+        }
+        return nullptr;
+    }
+};
+
+struct FlatSink : ILogger {
+    std::map<std::string, long> values;
+    void log(const std::string& name, long value) override { values[name] = value; }
+};
+}
+
+TEST(LatencyHistogramTest, BucketsStayWithinPrecision) {
+    for (uint64_t v : {0ull, 1ull, 127ull, 128ull, 255ull, 256ull, 1000ull, 123'456ull, 987'654'321ull}) {
+        const uint64_t reported = LatencyHistogram::value_of(LatencyHistogram::bucket_of(v));
+        EXPECT_GE(reported, v);
+        EXPECT_LE(reported, v + v / LatencyHistogram::kSubBuckets) << v;
+    }
+    EXPECT_EQ(LatencyHistogram::bucket_of(~0ull), LatencyHistogram::kBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfAUniformRange) {
+    LatencyHistogram h;
+    for (uint64_t v = 1; v <= 10'000; ++v) h.add(v);
+    EXPECT_EQ(h.count(), 10'000u);
+    EXPECT_NEAR(static_cast<double>(h.percentile(0.5)), 5000.0, 50.0);
+    EXPECT_NEAR(static_cast<double>(h.percentile(0.99)), 9900.0, 99.0);
+    EXPECT_EQ(h.min(), 1u);
+    EXPECT_NEAR(static_cast<double>(h.max()), 10'000.0, 100.0);
+}
+
+TEST(TimeLoggerTest, InternIsStablePerName) {
+    const ProbeId a = TimeLogger::intern("test.intern.a");
+    EXPECT_EQ(TimeLogger::intern("test.intern.a"), a);
+    EXPECT_NE(TimeLogger::intern("test.intern.b"), a);
+    EXPECT_EQ(Probe<"test.intern.a">::id, a);
+}
+
+TEST(TimeLoggerTest, ScopeTimersReportNanoseconds) {
+    TimeLogger logger(std::chrono::milliseconds(0));
+    CaptureSink sink;
+    logger.add_sink(sink);
+
+    for (int i = 0; i < 5; ++i) {
+        ScopeTimer<"test.sleep"> timer;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    logger.collect();
+
+    const LatencySummary* s = sink.find("test.sleep");
+    ASSERT_NE(s, nullptr);
+    EXPECT_EQ(s->count, 5u);
+    EXPECT_GE(s->min_ns, 1'800'000u);
+    EXPECT_LT(s->p50_ns, 200'000'000u);
+    EXPECT_LE(s->p50_ns, s->max_ns);
+}
+
+TEST(TimeLoggerTest, MergesThreadsAndExportsOnlyNewSamples) {
+    TimeLogger logger(std::chrono::milliseconds(0));
+    CaptureSink sink;
+    logger.add_sink(sink);
+    const ProbeId probe = TimeLogger::intern("test.threads");
+
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([probe] {
+            for (uint64_t i = 0; i < 1000; ++i) TimeLogger::record(probe, 100 + i);
+        });
+    }
+    threads.clear();
+    logger.collect();
+    ASSERT_NE(sink.find("test.threads"), nullptr);
+    EXPECT_EQ(sink.find("test.threads")->count, 4000u);
+
+    sink.summaries.clear();
+    logger.collect();
+    EXPECT_EQ(sink.find("test.threads"), nullptr);   // Nothing new since
+    EXPECT_EQ(TimeLogger::total("test.threads").count(), 4000u);
+}
+
+TEST(TimeLoggerTest, PlainSinksGetOneValuePerStatistic) {
+    TimeLogger logger(std::chrono::milliseconds(0));
+    FlatSink sink;
+    logger.add_sink(sink);
+
+    TimeLogger::record(TimeLogger::intern("test.flat"), 1000);
+    logger.collect();
+    EXPECT_EQ(sink.values.at("test.flat.count"), 1);
+    EXPECT_TRUE(sink.values.contains("test.flat.p99"));
+    EXPECT_TRUE(sink.values.contains("test.flat.max"));
+}
@@ -0,0 +1,173 @@
+#include "Core/TradeTape.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "Tactics/SunTzuTactics.hpp"
+
+using namespace std::chrono_literals;
+
+TEST(TradeTapeTest, EmptyTapeAnswersZero) {
+    TradeTape tape(16);
+    const auto stats = tape.window(0, UINT64_MAX);
+    EXPECT_EQ(stats.count, 0u);
+    EXPECT_EQ(stats.volume, 0.0);
+    EXPECT_EQ(tape.latest_ns(), 0u);
+}
+
+TEST(TradeTapeTest, WindowStatsMatchBruteForceAcrossWrap) {
+    TradeTape tape(256);
+    std::vector<TradeTape::Print> all;
+
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> price(99.0f, 101.0f);
+    std::uniform_real_distribution<float> amount(0.1f, 5.0f);
+    std::uniform_int_distribution<uint64_t> gap(0, 3000);
+
+    uint64_t ts = 1'000'000;
+    for (int i = 0; i < 1000; ++i) {
+        ts += gap(gen);
+        const TradeTape::Print p{ts, price(gen), amount(gen), i % 3 == 0};
+        tape.append(p.ts_ns, p.price, p.amount, p.is_buy);
+        all.push_back(p);
+    }
+    ASSERT_EQ(tape.size(), 256u);
+
+    const std::vector<TradeTape::Print> kept(all.end() - 256, all.end());
+    std::uniform_int_distribution<size_t> pick(0, kept.size() - 1);
+
+    for (int q = 0; q < 200; ++q) {
+        uint64_t from = kept[pick(gen)].ts_ns, to = kept[pick(gen)].ts_ns;
+        if (from > to) std::swap(from, to);
+
+        size_t count = 0;
+        double volume = 0.0, notional = 0.0;
+        float high = -1e9f, low = 1e9f;
+        for (const auto& p : kept) {
+            if (p.ts_ns < from || p.ts_ns > to) continue;
+            ++count;
+            volume += p.amount;
+            notional += static_cast<double>(p.price) * p.amount;
+            high = std::max(high, p.price);
+            low = std::min(low, p.price);
+        }
+
+        const auto stats = tape.window(from, to);
+        ASSERT_EQ(stats.count, count);
+        EXPECT_NEAR(stats.volume, volume, 1e-6 * (1.0 + volume));
+        EXPECT_NEAR(stats.notional, notional, 1e-6 * (1.0 + notional));
+        EXPECT_FLOAT_EQ(stats.high, high);
+        EXPECT_FLOAT_EQ(stats.low, low);
+
+        const auto [first, second] = tape.prints(from, to);
+        EXPECT_EQ(first.size() + second.size(), count);
+    }
+}
+
+TEST(TradeTapeTest, TrailingWindowEndsAtNewestPrint) {
+    TradeTape tape(64);
+    for (uint64_t s = 0; s < 10; ++s) {
+        tape.append(s * 1'000'000'000ULL, 100.0f + s, 1.0f, true);
+    }
+    const auto stats = tape.last(3s);
+    EXPECT_EQ(stats.count, 4u); // t = 6, 7, 8, 9
+    EXPECT_FLOAT_EQ(stats.vwap, 107.5f);
+    EXPECT_FLOAT_EQ(stats.low, 106.0f);
+    EXPECT_FLOAT_EQ(stats.high, 109.0f);
+}
+
+TEST(TradeTapeTest, TrailingSplitsRecentFromBaseline) {
+    TradeTape tape(64);
+    EXPECT_EQ(tape.trailing(3s, 2).recent.count, 0u);
+
+    for (uint64_t s = 0; s < 10; ++s) {
+        tape.append(s * 1'000'000'000ULL, 100.0f + s, 1.0f + s, true);
+    }
+    const auto t = tape.trailing(3s, 2);
+    const auto recent = tape.last(3s);
+    EXPECT_EQ(t.recent.count, recent.count);   // t = 6..9
+    EXPECT_DOUBLE_EQ(t.recent.volume, recent.volume);
+
+    // Two spans before t = 6: prints at 0..5, none counted twice
+    EXPECT_EQ(t.baseline.count, 6u);
+    EXPECT_DOUBLE_EQ(t.baseline.volume, tape.last(9s).volume - recent.volume);
+    EXPECT_FLOAT_EQ(t.baseline.high, 105.0f);
+    EXPECT_EQ(t.baseline_ns, 6'000'000'000ULL);
+
+    // More history asked for than the tape holds: covered only back to the oldest print
+    const auto wide = tape.trailing(3s, 10);
+    EXPECT_EQ(wide.baseline.count, 6u);
+    EXPECT_EQ(wide.baseline_ns, 6'000'000'000ULL);
+}
+
+TEST(TradeTapeTest, ReadSinceVisitsEachPrintOnce) {
+    TradeTape tape(8);
+    tape.append(1, 100.0f, 1.0f, true);
+    uint64_t cursor = tape.sequence();
+    for (uint64_t s = 2; s < 6; ++s) tape.append(s, 100.0f + s, 1.0f, true);
+
+    std::vector<float> seen;
+    const auto collect = [&](const TradeTape::Print& p) { seen.push_back(p.price); };
+    tape.read_since(cursor, collect);
+    tape.read_since(cursor, collect);
+    EXPECT_EQ(seen, (std::vector<float>{102.0f, 103.0f, 104.0f, 105.0f}));
+    EXPECT_EQ(cursor, 5u);
+
+    // A reader lapped by the ring resumes at the oldest print still held
+    for (uint64_t s = 6; s < 20; ++s) tape.append(s, 100.0f + s, 1.0f, true);
+    seen.clear();
+    tape.read_since(cursor, collect);
+    ASSERT_EQ(seen.size(), 8u);
+    EXPECT_FLOAT_EQ(seen.front(), 112.0f);
+}
+
+TEST(TradeTapeTest, LiquidityRaidNeedsSpikeOverBaseline) {
+    TradeTape tape(1024);
+    const SunTzu::LiquidityRaidConfig cfg{
+        .volume_spike_multiplier = 2.5f,
+        .time_window_seconds = 1.0f,
+        .min_volume_threshold = 5.0f
+    };
+
+    // Ten quiet seconds, 10 units each
+    for (uint64_t ms = 0; ms < 10'000; ms += 100) {
+        tape.append(ms * 1'000'000ULL, 100.0f, 1.0f, true);
+    }
+    EXPECT_FALSE(SunTzu::isLiquidityRaid(tape, cfg));
+
+    // Then a burst: 50 units inside the last second
+    for (uint64_t ms = 10'100; ms < 11'000; ms += 20) {
+        tape.append(ms * 1'000'000ULL, 100.0f, 1.0f, false);
+    }
+    EXPECT_TRUE(SunTzu::isLiquidityRaid(tape, cfg));
+
+    // The floor is a quantity: 4500 notional is only 45 units
+    SunTzu::LiquidityRaidConfig large = cfg;
+    large.min_volume_threshold = 100.0f;
+    EXPECT_FALSE(SunTzu::isLiquidityRaid(tape, large));
+}
+
+TEST(TradeTapeTest, LiquidityRaidBaselineCoversOnlyTheHistoryHeld) {
+    TradeTape tape(1024);
+    const SunTzu::LiquidityRaidConfig cfg{
+        .volume_spike_multiplier = 2.5f,
+        .time_window_seconds = 1.0f,
+        .min_volume_threshold = 5.0f
+    };
+
+    // Half a second of history is no baseline at all
+    for (uint64_t ms = 0; ms < 1'000; ms += 100) {
+        tape.append(ms * 1'000'000ULL, 100.0f, ms < 500 ? 1.0f : 2.0f, true);
+    }
+    EXPECT_FALSE(SunTzu::isLiquidityRaid(tape, cfg));
+
+    // Two seconds at 10 units, then 12: ordinary flow, not a raid. Averaged
+    // over ten windows the baseline would read 2 and fire.
+    TradeTape warm(1024);
+    for (uint64_t ms = 0; ms < 2'000; ms += 100) warm.append(ms * 1'000'000ULL, 100.0f, 1.0f, true);
+    for (uint64_t ms = 2'050; ms < 3'000; ms += 80) warm.append(ms * 1'000'000ULL, 100.0f, 1.0f, false);
+    EXPECT_FALSE(SunTzu::isLiquidityRaid(warm, cfg));
+    EXPECT_EQ(warm.oldest_ns(), 0u);
+}
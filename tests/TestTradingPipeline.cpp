@@ -0,0 +1,313 @@
+#include "Core/TradingPipeline.hpp"
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+// Minimal binary-protocol peer on an ephemeral localhost port
+class FrameServer {
+public:
+    FrameServer() {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(listen_fd_, 1);
+        socklen_t len = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+    }
+
+    ~FrameServer() {
+        if (client_fd_ >= 0) close(client_fd_);
+        close(listen_fd_);
+    }
+
+    uint16_t port() const { return port_; }
+
+    void accept_client() { client_fd_ = accept(listen_fd_, nullptr, nullptr); }
+
+    void send_frame(const std::vector<MarketData::BinOrder>& orders, uint32_t magic = MarketData::kBookMagic) {
+        const auto frame = encode(orders, magic);
+        ASSERT_EQ(send(client_fd_, frame.data(), frame.size(), 0), static_cast<ssize_t>(frame.size()));
+    }
+
+    // Book frames in one write, so the reader gets them in one batch
+    void send_frames(const std::vector<std::vector<MarketData::BinOrder>>& frames) {
+        std::vector<std::byte> bytes;
+        for (const auto& orders : frames) {
+            const auto frame = encode(orders, MarketData::kBookMagic);
+            bytes.insert(bytes.end(), frame.begin(), frame.end());
+        }
+        ASSERT_EQ(send(client_fd_, bytes.data(), bytes.size(), 0), static_cast<ssize_t>(bytes.size()));
+    }
+
+private:
+    static std::vector<std::byte> encode(const std::vector<MarketData::BinOrder>& orders, uint32_t magic) {
+        std::vector<std::byte> frame(sizeof(MarketData::BinMessage) +
+                                     orders.size() * sizeof(MarketData::BinOrder));
+        MarketData::BinMessage header{};
+        header.magic = magic;
+        header.timestamp = 42;
+        header.count = static_cast<uint16_t>(orders.size());
+        std::memcpy(frame.data(), &header, sizeof(header));
+        std::memcpy(frame.data() + sizeof(header), orders.data(),
+                    orders.size() * sizeof(MarketData::BinOrder));
+
+        header.crc32 = crc32(0L, reinterpret_cast<const Bytef*>(frame.data()) + MarketData::kCrcOffset,
+                             frame.size() - MarketData::kCrcOffset);
+        std::memcpy(frame.data(), &header, sizeof(header));
+        return frame;
+    }
+
+    int listen_fd_ = -1;
+    int client_fd_ = -1;
+    uint16_t port_ = 0;
+};
+
+struct RecordingStrategy {
+    std::vector<BookEvent> events;
+    std::atomic<size_t> count{0};
+    void on_book(const BookEvent& e) {
+        events.push_back(e);
+        count.fetch_add(1, std::memory_order_release);
+    }
+};
+
+bool wait_for(const std::atomic<size_t>& count, size_t target) {
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (count.load(std::memory_order_acquire) < target) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+} // namespace
+
+TEST(TradingPipelineTest, FramesFlowFromSocketToStrategy) {
+    FrameServer server;
+    PipelineConfig cfg;
+    cfg.endpoint = "127.0.0.1";
+    cfg.port = server.port();
+    cfg.book.ring_size = 8;        // Force backpressure on the first frame
+    cfg.strategy.ring_size = 4;
+
+    MarketData market(cfg.endpoint, cfg.port);
+    OrderBook book;
+    RecordingStrategy strategy;
+    TradingPipeline<RecordingStrategy> pipeline(cfg, market, book, strategy);
+    pipeline.start();
+    server.accept_client();
+
+    std::vector<MarketData::BinOrder> levels;
+    for (int i = 0; i < 20; ++i) {
+        levels.push_back({100.0f - i, 1.0f, 0});
+        levels.push_back({101.0f + i, 2.0f, 1});
+    }
+    server.send_frame(levels);
+    ASSERT_TRUE(wait_for(strategy.count, 1));
+
+    server.send_frame({{100.5f, 3.0f, 0}});
+    ASSERT_TRUE(wait_for(strategy.count, 2));
+    pipeline.stop();
+
+    EXPECT_EQ(strategy.events[0].update_count, 40u);
+    EXPECT_FLOAT_EQ(strategy.events[0].update_volume, 60.0f);
+    EXPECT_FLOAT_EQ(strategy.events[0].book.best_bid, 100.0f);
+    EXPECT_FLOAT_EQ(strategy.events[0].book.best_ask, 101.0f);
+    EXPECT_FLOAT_EQ(strategy.events[1].book.best_bid, 100.5f);
+
+    EXPECT_EQ(pipeline.feed_metrics().processed.load(), 2u);
+    EXPECT_EQ(pipeline.book_metrics().processed.load(), 41u);
+    EXPECT_EQ(pipeline.strategy_metrics().processed.load(), 2u);
+    EXPECT_GT(pipeline.feed_metrics().stalls.load(), 0u);
+    EXPECT_LE(pipeline.book_metrics().max_queue_depth.load(), 8u);
+}
+
+TEST(TradingPipelineTest, TradesDoNotRepublishTheBook) {
+    FrameServer server;
+    PipelineConfig cfg;
+    cfg.endpoint = "127.0.0.1";
+    cfg.port = server.port();
+
+    MarketData market(cfg.endpoint, cfg.port);
+    OrderBook book;
+    RecordingStrategy strategy;
+    TradingPipeline<RecordingStrategy> pipeline(cfg, market, book, strategy);
+    pipeline.start();
+    server.accept_client();
+
+    server.send_frame({{100.0f, 1.0f, 0}});
+    ASSERT_TRUE(wait_for(strategy.count, 1));
+    for (int i = 0; i < 3; ++i) server.send_frame({{100.0f, 0.5f, 0}}, MarketData::kTradeMagic);
+    server.send_frame({{99.0f, 2.0f, 0}});
+    ASSERT_TRUE(wait_for(strategy.count, 2));
+    pipeline.stop();
+
+    // Same stream order: the prints were read before the second book frame
+    ASSERT_EQ(strategy.events.size(), 2u);
+    EXPECT_EQ(strategy.events[1].update_count, 1u);
+    EXPECT_FLOAT_EQ(strategy.events[1].book.bid_volume, 3.0f);
+    EXPECT_EQ(pipeline.book_metrics().processed.load(), 2u);
+}
+
+TEST(TradingPipelineTest, CoalescedFramesEachGetASnapshot) {
+    FrameServer server;
+    PipelineConfig cfg;
+    cfg.endpoint = "127.0.0.1";
+    cfg.port = server.port();
+
+    MarketData market(cfg.endpoint, cfg.port);
+    OrderBook book;
+    RecordingStrategy strategy;
+    TradingPipeline<RecordingStrategy> pipeline(cfg, market, book, strategy);
+    pipeline.start();
+    server.accept_client();
+
+    server.send_frames({
+        {{100.0f, 1.0f, 0}, {101.0f, 1.0f, 1}},
+        {{100.5f, 2.0f, 0}},
+        {{100.8f, 3.0f, 1}, {100.9f, 1.0f, 1}, {99.0f, 4.0f, 0}}
+    });
+    ASSERT_TRUE(wait_for(strategy.count, 3));
+    pipeline.stop();
+
+    ASSERT_EQ(strategy.events.size(), 3u);
+    EXPECT_EQ(strategy.events[0].update_count, 2u);
+    EXPECT_FLOAT_EQ(strategy.events[0].book.best_bid, 100.0f);
+    EXPECT_EQ(strategy.events[1].update_count, 1u);
+    EXPECT_FLOAT_EQ(strategy.events[1].book.best_bid, 100.5f);
+    EXPECT_FLOAT_EQ(strategy.events[1].book.best_ask, 101.0f);
+    EXPECT_EQ(strategy.events[2].update_count, 3u);
+    EXPECT_FLOAT_EQ(strategy.events[2].update_volume, 8.0f);
+    EXPECT_FLOAT_EQ(strategy.events[2].book.best_ask, 100.8f);
+}
+
+TEST(MarketDataTest, TradeWakeupDoesNotReplayBook) {
+    FrameServer server;
+    MarketData market("127.0.0.1", server.port());
+    int prints = 0;
+    market.set_trade_handler([&](uint64_t, float, float, bool) { ++prints; });
+    market.poll();   // Connects
+    server.accept_client();
+
+    const auto poll_until = [&](auto done) {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!done()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            market.poll(10);
+        }
+        return true;
+    };
+
+    OrderBook book;
+    server.send_frame({{100.0f, 1.0f, 0}});
+    std::size_t applied = 0;
+    ASSERT_TRUE(poll_until([&] {
+        const auto updates = market.get_updates();
+        book.update(updates);
+        applied += updates.size();
+        return applied > 0;
+    }));
+
+    // The print wakes consumers, but the book batch was already taken
+    const uint32_t seen = market.notifier().sequence();
+    server.send_frame({{100.0f, 0.5f, 0}}, MarketData::kTradeMagic);
+    ASSERT_TRUE(poll_until([&] { return prints == 1; }));
+    EXPECT_NE(market.notifier().sequence(), seen);
+    const auto updates = market.get_updates();
+    EXPECT_TRUE(updates.empty());
+    book.update(updates);
+    EXPECT_FLOAT_EQ(book.total_bid_volume(), 1.0f);
+}
+
+TEST(MarketDataTest, BatchOutlivesLaterReads) {
+    FrameServer server;
+    MarketData market("127.0.0.1", server.port());
+    market.poll();   // Connects
+    server.accept_client();
+
+    const auto deliver = [&](float price) {
+        const uint32_t seen = market.notifier().sequence();
+        server.send_frame({{price, 1.0f, 0}});
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (market.notifier().sequence() == seen) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            market.poll(10);
+        }
+        return true;
+    };
+
+    ASSERT_TRUE(deliver(100.0f));
+    const auto batch = market.get_updates();
+    ASSERT_EQ(batch.size(), 1u);
+
+    // The io side recycles batch storage; never the one still being read
+    ASSERT_TRUE(deliver(101.0f));
+    ASSERT_TRUE(deliver(102.0f));
+    EXPECT_FLOAT_EQ(batch[0].price, 100.0f);
+
+    const auto next = market.get_updates();
+    ASSERT_EQ(next.size(), 2u);
+    EXPECT_FLOAT_EQ(next[0].price, 101.0f);
+    EXPECT_FLOAT_EQ(next[1].price, 102.0f);
+    // Two frames merged into one batch still show where each ended
+    EXPECT_EQ(std::vector<uint16_t>(market.frame_sizes().begin(), market.frame_sizes().end()),
+              (std::vector<uint16_t>{1, 1}));
+}
+
+TEST(PipelineConfigTest, LoadsStagesAndKeepsDefaults) {
+    const std::string path = ::testing::TempDir() + "pipeline_test.json";
+    std::ofstream(path) << R"({
+        "port": 9000,
+        "stages": {
+            "feed": { "cpu": 2, "wait": "busy_spin" },
+            "strategy": { "wait": "eventfd", "ring_size": 128, "spins": 7 }
+        }
+    })";
+
+    const PipelineConfig cfg = load_pipeline_config(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(cfg.endpoint, "127.0.0.1");
+    EXPECT_EQ(cfg.port, 9000);
+    EXPECT_EQ(cfg.feed.cpu, 2);
+    EXPECT_EQ(cfg.feed.wait, WaitPolicy::BusySpin);
+    EXPECT_EQ(cfg.book.cpu, -1);
+    EXPECT_EQ(cfg.book.wait, WaitPolicy::SpinThenFutex);
+    EXPECT_EQ(cfg.strategy.wait, WaitPolicy::EventFd);
+    EXPECT_EQ(cfg.strategy.ring_size, 128u);
+    EXPECT_EQ(cfg.strategy.spins, 7u);
+}
+
+TEST(PipelineConfigTest, LoadsFanout) {
+    const std::string path = ::testing::TempDir() + "pipeline_fanout.json";
+    std::ofstream(path) << R"({ "fanout": { "stream": "ethusdt", "zmq_endpoint": "ipc:///tmp/eth", "max_lag": 64 } })";
+    const PipelineConfig cfg = load_pipeline_config(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(cfg.fanout.stream, "ethusdt");
+    EXPECT_EQ(cfg.fanout.zmq_endpoint, "ipc:///tmp/eth");
+    EXPECT_TRUE(cfg.fanout.zmq_trade_endpoint.empty());
+    EXPECT_EQ(cfg.fanout.max_lag, 64u);
+    EXPECT_EQ(cfg.fanout.ring_capacity, 1u << 16);
+}
+
+TEST(PipelineConfigTest, RejectsUnknownWaitPolicy) {
+    const std::string path = ::testing::TempDir() + "pipeline_bad.json";
+    std::ofstream(path) << R"({ "stages": { "book": { "wait": "nap" } } })";
+    EXPECT_THROW(load_pipeline_config(path), std::runtime_error);
+    std::remove(path.c_str());
+}
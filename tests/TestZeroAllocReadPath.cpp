@@ -0,0 +1,189 @@
+#include "Clients/BinanceStreamMux.hpp"
+#include "Clients/BinanceWSClient.hpp"
+#include "Clients/BinanceWire.hpp"
+#include "Sim/ExchangeSimulator.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string>
+
+//------------------------------------------------------------------
+// Allocation counter: only the thread that opts in is counted, so the
+// simulator's own allocations stay out of the numbers
+//------------------------------------------------------------------
+namespace {
+thread_local bool t_counting = false;
+thread_local uint64_t t_allocations = 0;
+
+struct CountAllocations {
+    CountAllocations() { t_allocations = 0; t_counting = true; }
+    ~CountAllocations() { t_counting = false; }
+    uint64_t count() const { return t_allocations; }
+};
+
+// Out of line, so the compiler never pairs an inlined malloc with a free
+[[gnu::noinline]] void* counted_alloc(std::size_t n) {
+    if (t_counting) ++t_allocations;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void counted_free(void* p) noexcept { std::free(p); }
+}
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+
+namespace {
+const std::string kDepthFrame =
+    R"({"stream":"btcusdt@depth5@100ms","data":{"lastUpdateId":160,)"
+    R"("bids":[["67000.10","1.5"],["67000.00","2.25"],["66999.90","0.5"],["66999.80","3"],["66999.70","1"]],)"
+    R"("asks":[["67000.20","0.75"],["67000.30","2"],["67000.40","1.25"],["67000.50","4"],["67000.60","0.1"]]}})";
+
+const std::string kTradeFrame =
+    R"({"e":"aggTrade","E":1700000000001,"s":"BTCUSDT","a":26129,"p":"67000.10","q":"0.250",)"
+    R"("f":100,"l":105,"T":1700000000000,"m":true,"M":true})";
+}
+
+TEST(BinanceWireTest, ParsesDepthAndTradeFrames) {
+    std::vector<OrderBook::Order> levels;
+    ASSERT_TRUE(BinanceWire::parse_depth(kDepthFrame, levels));
+    ASSERT_EQ(levels.size(), 10u);
+    EXPECT_TRUE(levels[0].is_bid);
+    EXPECT_FLOAT_EQ(levels[0].price, 67000.10f);
+    EXPECT_FLOAT_EQ(levels[1].amount, 2.25f);
+    EXPECT_FALSE(levels[5].is_bid);
+    EXPECT_FLOAT_EQ(levels[5].price, 67000.20f);
+
+    ASSERT_TRUE(BinanceWire::parse_depth(R"({"e":"depthUpdate","b":[["10.5","1"]],"a":[]})", levels));
+    EXPECT_EQ(levels.size(), 1u);
+
+    EXPECT_FALSE(BinanceWire::parse_depth(R"({"bids":[["1.0","2"],"asks":[]})", levels));
+    EXPECT_FALSE(BinanceWire::parse_depth(R"({"result":null,"id":1})", levels));
+
+    EXPECT_TRUE(BinanceWire::is_agg_trade(kTradeFrame));
+    EXPECT_FALSE(BinanceWire::is_agg_trade(kDepthFrame));
+    EXPECT_TRUE(BinanceWire::is_depth_update(R"({"e":"depthUpdate","b":[],"a":[]})"));
+    EXPECT_FALSE(BinanceWire::is_depth_update(kDepthFrame));
+    const auto trade = BinanceWire::parse_agg_trade(kTradeFrame);
+    ASSERT_TRUE(trade);
+    EXPECT_EQ(trade->trade_time_ms, 1700000000000u);
+    EXPECT_FLOAT_EQ(trade->price, 67000.10f);
+    EXPECT_FLOAT_EQ(trade->quantity, 0.25f);
+    EXPECT_TRUE(trade->buyer_is_maker);
+}
+
+TEST(BinanceWireTest, ParsingDoesNotAllocateOnceWarm) {
+    std::vector<OrderBook::Order> levels;
+    levels.reserve(10);
+    ASSERT_TRUE(BinanceWire::parse_depth(kDepthFrame, levels));
+
+    CountAllocations counter;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(BinanceWire::parse_depth(kDepthFrame, levels));
+        ASSERT_TRUE(BinanceWire::parse_agg_trade(kTradeFrame));
+    }
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+// The real client over TLS against the exchange simulator. The client's
+// io_context runs on this thread, so the count covers the read chain,
+// the TLS record layer and the depth parse, and none of the server.
+TEST(ZeroAllocReadPathTest, ClientReadPathDoesNotAllocateOnceWarm) {
+    constexpr int kWarmup = 256;
+    constexpr int kFrames = 2048;
+
+    ExchangeSimulator::Config cfg;
+    cfg.serve_binary = false;
+    cfg.ws_port = 0;
+    cfg.rate = 20000.0;
+    ExchangeSimulator sim(cfg);
+    sim.start();
+
+    net::io_context ioc;
+    ssl::context ctx(ssl::context::tlsv12_client);   // No peer verification
+    BinanceWSClient client(ioc, ctx, "btcusdt");
+    client.set_endpoint("127.0.0.1", std::to_string(sim.ws_port()));
+
+    int frames = 0;
+    uint64_t allocations = 0;
+    std::optional<CountAllocations> counter;
+    client.on_depth([&](std::span<const OrderBook::Order> levels) {
+        ASSERT_EQ(levels.size(), 40u);
+        if (++frames == kWarmup) counter.emplace();
+        if (frames == kWarmup + kFrames) {
+            allocations = counter->count();
+            counter.reset();
+            ioc.stop();
+        }
+    });
+    client.start();
+    ioc.run_for(std::chrono::seconds(10));
+
+    EXPECT_EQ(frames, kWarmup + kFrames);
+    EXPECT_EQ(allocations, 0u);
+
+    ioc.restart();
+    client.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+}
+
+// The mux on a combined stream: stream-name routing, the directory lookup
+// under the shared lock and the snapshot into each book, on this thread
+TEST(ZeroAllocReadPathTest, MuxReadPathDoesNotAllocateOnceWarm) {
+    constexpr int kWarmup = 256;
+    constexpr int kFrames = 2048;
+
+    ExchangeSimulator::Config cfg;
+    cfg.serve_binary = false;
+    cfg.ws_port = 0;
+    cfg.rate = 20000.0;
+    ExchangeSimulator sim(cfg);
+    sim.start();
+
+    net::io_context ioc;
+    ssl::context ctx(ssl::context::tlsv12_client);   // No peer verification
+    BinanceStreamMux::Config mux_cfg;
+    mux_cfg.host = "127.0.0.1";
+    mux_cfg.port = std::to_string(sim.ws_port());
+    BinanceStreamMux mux(ioc, ctx, mux_cfg);
+
+    std::array<OrderBook, 2> books;
+    ASSERT_NE(mux.subscribe("btcusdt", books[0]), BinanceStreamMux::kNoSymbol);
+    ASSERT_NE(mux.subscribe("ethusdt", books[1]), BinanceStreamMux::kNoSymbol);
+
+    int frames = 0;
+    std::array<int, 2> per_symbol{};
+    uint64_t allocations = 0;
+    std::optional<CountAllocations> counter;
+    mux.on_depth([&](BinanceStreamMux::SymbolId id, std::span<const OrderBook::Order> levels) {
+        ASSERT_EQ(levels.size(), 40u);
+        ++per_symbol[id];
+        if (++frames == kWarmup) counter.emplace();
+        if (frames == kWarmup + kFrames) {
+            allocations = counter->count();
+            counter.reset();
+            ioc.stop();
+        }
+    });
+    mux.start();
+    ioc.run_for(std::chrono::seconds(10));
+
+    EXPECT_EQ(frames, kWarmup + kFrames);
+    EXPECT_GT(per_symbol[0], kFrames / 4);   // Both streams carried traffic
+    EXPECT_GT(per_symbol[1], kFrames / 4);
+    EXPECT_EQ(allocations, 0u);
+
+    ioc.restart();
+    mux.stop();
+    ioc.run_for(std::chrono::milliseconds(100));
+    sim.stop();
+}
@@ -0,0 +1,198 @@
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Utils/Metrics.hpp"
+
+//--------------------------------------------------------------------
+// OceanMetrics: reads a running OceanMain's metrics file. The trading
+// process pays nothing for this: every read here is a load from the
+// shared mapping.
+//   OceanMetrics                    print every metric once
+//   OceanMetrics --watch 1000       reprint each second, with rates
+//   OceanMetrics --prometheus       Prometheus text once
+//   OceanMetrics --serve 9464       Prometheus text on 127.0.0.1:9464
+// --path overrides $OCEAN_METRICS_PATH and /dev/shm/ocean-metrics.
+//--------------------------------------------------------------------
+namespace {
+std::atomic<bool> g_running{true};
+
+void on_signal(int) {
+    g_running = false;
+}
+
+struct Options {
+    std::string path;
+    bool prometheus = false;
+    int64_t watch_ms = 0;
+    uint16_t serve_port = 0;
+};
+
+template <typename T>
+bool parse(std::string_view text, T& out) {
+    const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+    return ec == std::errc{} && end == text.data() + text.size();
+}
+
+void usage() {
+    std::cerr << "usage: OceanMetrics [--path FILE] [--prometheus] [--watch MS] [--serve PORT]\n";
+}
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view flag = argv[i];
+        bool ok = true;
+        if (flag == "--prometheus") {
+            opt.prometheus = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const std::string_view value = argv[++i];
+        if (flag == "--path") {
+            opt.path = value;
+        } else if (flag == "--watch") {
+            ok = parse(value, opt.watch_ms) && opt.watch_ms > 0;
+        } else if (flag == "--serve") {
+            ok = parse(value, opt.serve_port) && opt.serve_port != 0;
+        } else {
+            ok = false;
+        }
+        if (!ok) return false;
+    }
+    return true;
+}
+
+// Upper bound of the bucket holding quantile q
+uint64_t quantile(const Metrics::Sample& s, double q) {
+    uint64_t total = 0;
+    for (uint64_t n : s.buckets) total += n;
+    if (total == 0) return 0;
+    const auto rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (std::size_t b = 0; b < s.buckets.size(); ++b) {
+        seen += s.buckets[b];
+        if (seen >= rank) return b == 0 ? 0 : (uint64_t{1} << b) - 1;
+    }
+    return ~uint64_t{0};
+}
+
+void print_table(const std::vector<Metrics::Sample>& samples, std::map<std::string, int64_t>& last, double seconds) {
+    for (const auto& s : samples) {
+        std::cout << std::left << std::setw(60) << s.name << ' ';
+        if (s.kind == Metrics::Kind::Histogram) {
+            uint64_t count = 0;
+            for (uint64_t n : s.buckets) count += n;
+            std::cout << "count=" << count << " p50<=" << quantile(s, 0.50) << " p99<=" << quantile(s, 0.99)
+                      << " max<=" << quantile(s, 1.0);
+        } else {
+            std::cout << s.value;
+            if (s.kind == Metrics::Kind::Counter && seconds > 0 && last.contains(s.name)) {
+                std::cout << "  (" << static_cast<double>(s.value - last[s.name]) / seconds << "/s)";
+            }
+            last[s.name] = s.value;
+        }
+        std::cout << '\n';
+    }
+}
+
+// Answers every connection with the current exposition, whatever it asked for
+int serve(const std::string& path, uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    const int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 16) != 0) {
+        std::cerr << "[METRICS] Cannot listen on 127.0.0.1:" << port << "\n";
+        if (fd >= 0) ::close(fd);
+        return 1;
+    }
+    std::cout << "[METRICS] Serving " << path << " on http://127.0.0.1:" << port << "/metrics\n";
+
+    while (g_running) {
+        pollfd pfd{.fd = fd, .events = POLLIN, .revents = 0};
+        if (::poll(&pfd, 1, 200) <= 0) continue;
+        const int client = ::accept4(fd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) continue;
+
+        char request[1024];
+        [[maybe_unused]] const auto n = ::recv(client, request, sizeof(request), 0);
+
+        std::string body;
+        std::string status = "200 OK";
+        try {
+            body = Metrics::to_prometheus(Metrics::Reader(path).snapshot());
+        } catch (const std::exception& e) {
+            status = "503 Service Unavailable";
+            body = std::string(e.what()) + "\n";
+        }
+        const std::string response = "HTTP/1.1 " + status + "\r\n"
+            "Content-Type: text/plain; version=0.0.4\r\n"
+            "Content-Length: " + std::to_string(body.size()) + "\r\n"
+            "Connection: close\r\n\r\n" + body;
+        for (std::size_t sent = 0; sent < response.size();) {
+            const auto w = ::send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (w <= 0) break;
+            sent += static_cast<std::size_t>(w);
+        }
+        ::close(client);
+    }
+    ::close(fd);
+    return 0;
+}
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) {
+        usage();
+        return 2;
+    }
+    if (opt.path.empty()) {
+        const char* env = std::getenv("OCEAN_METRICS_PATH");
+        opt.path = env && *env ? env : "/dev/shm/ocean-metrics";
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    if (opt.serve_port) return serve(opt.path, opt.serve_port);
+
+    try {
+        if (opt.prometheus) {
+            std::cout << Metrics::to_prometheus(Metrics::Reader(opt.path).snapshot());
+            return 0;
+        }
+
+        std::map<std::string, int64_t> last;
+        auto previous = std::chrono::steady_clock::now();
+        do {
+            // Remapped each round: a restarted OceanMain writes a new file
+            const Metrics::Reader reader(opt.path);
+            const auto now = std::chrono::steady_clock::now();
+            if (opt.watch_ms) std::cout << "\n[METRICS] pid " << reader.pid() << "\n";
+            print_table(reader.snapshot(), last, std::chrono::duration<double>(now - previous).count());
+            previous = now;
+            if (opt.watch_ms) std::this_thread::sleep_for(std::chrono::milliseconds(opt.watch_ms));
+        } while (opt.watch_ms && g_running);
+    } catch (const std::exception& e) {
+        std::cerr << "[METRICS] " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
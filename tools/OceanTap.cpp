@@ -0,0 +1,125 @@
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <zmq.h>
+
+#include "Core/ShmRing.hpp"
+
+//--------------------------------------------------------------------
+// OceanTap: a subscriber to an OceanMain --publish stream, for checking
+// a publisher and as a template for strategy processes.
+//   OceanTap /dev/shm/ocean-btcusdt.book            shm ring
+//   OceanTap --zmq tcp://127.0.0.1:5556 [topic]     PUB socket
+// Prints the event rate, events lost to laps and the newest event once
+// a second.
+//--------------------------------------------------------------------
+namespace {
+std::atomic<bool> g_running{true};
+
+void on_signal(int) {
+    g_running = false;
+}
+
+void print(const FanoutEvent& e) {
+    if (e.kind == FanoutEvent::Kind::Trade) {
+        std::cout << "  trade " << (e.is_buy ? "buy " : "sell ") << e.amount << " @ " << e.price << "\n";
+    } else {
+        std::cout << "  book " << e.best_bid << " / " << e.best_ask << " mid=" << e.mid
+                  << " updates=" << e.update_count << "\n";
+    }
+}
+
+class Report {
+public:
+    void event(const FanoutEvent& e) noexcept {
+        ++events_;
+        last_ = e;
+    }
+
+    void tick(uint64_t lost) {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - since_ < std::chrono::seconds(1)) return;
+        const double secs = std::chrono::duration<double>(now - since_).count();
+        std::cout << "[TAP] " << static_cast<uint64_t>(static_cast<double>(events_) / secs) << " events/s, "
+                  << lost << " lost\n";
+        if (events_) print(last_);
+        events_ = 0;
+        since_ = now;
+    }
+
+private:
+    uint64_t events_ = 0;
+    FanoutEvent last_;
+    std::chrono::steady_clock::time_point since_ = std::chrono::steady_clock::now();
+};
+
+int tap_ring(const std::string& path) {
+    ShmRingReader reader(path);
+    Report report;
+    FanoutEvent event;
+    while (g_running) {
+        switch (reader.poll(event)) {
+            case ShmRingReader::Status::Ok:
+                report.event(event);
+                break;
+            case ShmRingReader::Status::Lapped:
+                break;
+            case ShmRingReader::Status::Empty:
+                reader.wait(std::chrono::milliseconds(100));
+                break;
+            case ShmRingReader::Status::Closed:
+                std::cout << "[TAP] Publisher closed " << path << "\n";
+                return 0;
+        }
+        report.tick(reader.lost());
+    }
+    return 0;
+}
+
+int tap_zmq(const std::string& endpoint, const std::string& topic) {
+    void* context = zmq_ctx_new();
+    void* socket = zmq_socket(context, ZMQ_SUB);
+    const int timeout_ms = 100;
+    if (zmq_setsockopt(socket, ZMQ_RCVTIMEO, &timeout_ms, sizeof(timeout_ms)) != 0 ||
+        zmq_setsockopt(socket, ZMQ_SUBSCRIBE, topic.data(), topic.size()) != 0 ||
+        zmq_connect(socket, endpoint.c_str()) != 0) {
+        std::cerr << "[TAP] " << endpoint << ": " << zmq_strerror(zmq_errno()) << "\n";
+        zmq_close(socket);
+        zmq_ctx_term(context);
+        return 1;
+    }
+
+    Report report;
+    while (g_running) {
+        char name[256];
+        FanoutEvent event;
+        if (zmq_recv(socket, name, sizeof(name), 0) >= 0 &&
+            zmq_recv(socket, &event, sizeof(event), 0) == static_cast<int>(sizeof(event))) {
+            report.event(event);
+        }
+        report.tick(0);   // PUB drops silently; see ocean_fanout_zmq_dropped_total
+    }
+    zmq_close(socket);
+    zmq_ctx_term(context);
+    return 0;
+}
+}
+
+int main(int argc, char** argv) {
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    try {
+        if (argc >= 3 && std::string(argv[1]) == "--zmq") {
+            return tap_zmq(argv[2], argc > 3 ? argv[3] : "");
+        }
+        if (argc == 2) return tap_ring(argv[1]);
+    } catch (const std::exception& e) {
+        std::cerr << "[TAP] " << e.what() << "\n";
+        return 1;
+    }
+    std::cerr << "usage: OceanTap RING | OceanTap --zmq ENDPOINT [TOPIC]\n";
+    return 2;
+}